@@ -28,6 +28,7 @@
 #include "monster.h"
 #include "npc.h"
 #include "options.h"
+#include "pathfinding.h"
 #include "point.h"
 #include "projectile.h"
 #include "rng.h"
@@ -179,6 +180,13 @@ static void drop_or_embed_projectile( const dealt_projectile_attack &attack )
     }
 }
 
+// Asks the pathfinding cache instead of the map, it's cheaper for tiles along a trajectory
+static bool impassable_for_projectile( const map &here, const tripoint_bub_ms &p )
+{
+    const std::optional<PathfindingFlags> flags = here.pathfinding_flags( p );
+    return flags ? flags->is_set( PathfindingFlag::Obstacle ) : here.impassable( p );
+}
+
 static size_t blood_trail_len( int damage )
 {
     if( damage > 50 ) {
@@ -408,9 +416,13 @@ dealt_projectile_attack projectile_attack( const projectile &proj_arg,
             }
         }
 
-        if( in_veh != nullptr ) {
+        const std::optional<PathfindingFlags> tile_flags = here.pathfinding_flags( tp );
+        const bool maybe_vehicle = !tile_flags || tile_flags->is_set( PathfindingFlag::Vehicle );
+        const bool own_vehicle_here = in_veh != nullptr && maybe_vehicle &&
+                                      veh_pointer_or_null( here.veh_at( tp ) ) == in_veh;
+        if( own_vehicle_here ) {
             const optional_vpart_position other = here.veh_at( tp );
-            if( in_veh == veh_pointer_or_null( other ) && other->is_inside() ) {
+            if( other->is_inside() ) {
                 // Turret is on the roof and can't hit anything inside
                 continue;
             }
@@ -449,8 +461,7 @@ dealt_projectile_attack projectile_attack( const projectile &proj_arg,
         }
 
         if( critter != nullptr && cur_missed_by < 1.0 ) {
-            if( in_veh != nullptr && veh_pointer_or_null( here.veh_at( tp ) ) == in_veh &&
-                critter->is_avatar() ) {
+            if( own_vehicle_here && critter->is_avatar() ) {
                 // Turret either was aimed by the player (who is now ducking) and shoots from above
                 // Or was just IFFing, giving lots of warnings and time to get out of the line of fire
                 continue;
@@ -495,7 +506,7 @@ dealt_projectile_attack projectile_attack( const projectile &proj_arg,
             } else {
                 attack.missed_by = aim.missed_by;
             }
-        } else if( in_veh != nullptr && veh_pointer_or_null( here.veh_at( tp ) ) == in_veh ) {
+        } else if( own_vehicle_here ) {
             // Don't do anything, especially don't call map::shoot as this would damage the vehicle
         } else {
             if( proj.count > 1 ) {
@@ -512,7 +523,7 @@ dealt_projectile_attack projectile_attack( const projectile &proj_arg,
             proj.count = 1;
         }
 
-        if( ( !has_momentum || !is_bullet ) && here.impassable( tp ) ) {
+        if( ( !has_momentum || !is_bullet ) && impassable_for_projectile( here, tp ) ) {
             // Don't let flamethrowers go through walls
             // TODO: Let them go through bars
             traj_len = i;
@@ -2802,7 +2802,7 @@ bionic_uid Character::add_bionic( const bionic_id &b, bionic_uid parent_uid,
     if( !b->enchantments.empty() ) {
         recalculate_enchantment_cache();
     }
-    effect_on_conditions::process_reactivate( *this );
+    effect_on_conditions::process_reactivate( *this, eoc_reactivation::bionics );
 
     return bio_uid;
 }
@@ -2886,7 +2886,7 @@ void Character::remove_bionic( const bionic &bio )
     }
     // clean up any changes from bionic limbs
     recalculate_bodyparts();
-    effect_on_conditions::process_reactivate( *this );
+    effect_on_conditions::process_reactivate( *this, eoc_reactivation::bionics );
 }
 
 int Character::num_bionics() const
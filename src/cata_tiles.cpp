@@ -214,6 +214,13 @@ cata_tiles::cata_tiles( const SDL_Renderer_Ptr &renderer, const GeometryRenderer
 {
     cata_assert( renderer );
 
+    SDL_RendererInfo info;
+    if( !printErrorIf( SDL_GetRendererInfo( renderer.get(), &info ) != 0,
+                       "SDL_GetRendererInfo failed" ) ) {
+        // The software renderer keeps every sprite on its own texture, see sheet_params
+        batch.set_enabled( !( info.flags & SDL_RENDERER_SOFTWARE ) );
+    }
+
     tile_height = 0;
     tile_width = 0;
 
@@ -407,52 +414,23 @@ static void get_tile_information( const cata_path &config_path, std::string &jso
     }
 }
 
-template<typename PixelConverter>
-static SDL_Surface_Ptr apply_color_filter( const SDL_Surface_Ptr &original,
-        PixelConverter pixel_converter )
-{
-    cata_assert( original );
-    SDL_Surface_Ptr surf = create_surface_32( original->w, original->h );
-    cata_assert( surf );
-    throwErrorIf( SDL_BlitSurface( original.get(), nullptr, surf.get(), nullptr ) != 0,
-                  "SDL_BlitSurface failed" );
-
-    SDL_Color *pix = static_cast<SDL_Color *>( surf->pixels );
-
-    for( int y = 0, ey = surf->h; y < ey; ++y ) {
-        for( int x = 0, ex = surf->w; x < ex; ++x, ++pix ) {
-            if( pix->a == 0x00 ) {
-                // This check significantly improves the performance since
-                // vast majority of pixels in the tilesets are completely transparent.
-                continue;
-            }
-            *pix = pixel_converter( *pix );
-        }
-    }
-
-    return surf;
-}
-
-static bool is_contained( const SDL_Rect &smaller, const SDL_Rect &larger )
-{
-    return smaller.x >= larger.x &&
-           smaller.y >= larger.y &&
-           smaller.x + smaller.w <= larger.x + larger.w &&
-           smaller.y + smaller.h <= larger.y + larger.h;
-}
-
 void tileset_cache::loader::copy_surface_to_texture( const SDL_Surface_Ptr &surf,
         const point &offset, std::vector<texture> &target )
 {
     cata_assert( surf );
-    const rect_range<SDL_Rect> input_range( sprite_width, sprite_height,
-                                            point( surf->w / sprite_width,
-                                                    surf->h / sprite_height ) );
-
     const std::shared_ptr<SDL_Texture> texture_ptr = CreateTextureFromSurface( renderer, surf );
     cata_assert( texture_ptr );
+    assign_textures( texture_ptr, SDL_Rect{ 0, 0, surf->w, surf->h }, offset, target );
+}
+
+void tileset_cache::loader::assign_textures( const std::shared_ptr<SDL_Texture> &texture_ptr,
+        const SDL_Rect &area, const point &offset, std::vector<texture> &target )
+{
+    const rect_range<SDL_Rect> input_range( sprite_width, sprite_height,
+                                            point( area.w / sprite_width,
+                                                    area.h / sprite_height ) );
 
-    for( const SDL_Rect rect : input_range ) {
+    for( SDL_Rect rect : input_range ) {
         cata_assert( offset.x % sprite_width == 0 );
         cata_assert( offset.y % sprite_height == 0 );
         const point pos( offset + point( rect.x, rect.y ) );
@@ -462,36 +440,37 @@ void tileset_cache::loader::copy_surface_to_texture( const SDL_Surface_Ptr &surf
                              ( tile_atlas_width / sprite_width );
         cata_assert( index < target.size() );
         cata_assert( target[index].dimension() == std::make_pair( 0, 0 ) );
+        rect.x += area.x;
+        rect.y += area.y;
         target[index] = texture( texture_ptr, rect );
     }
 }
 
-void tileset_cache::loader::create_textures_from_tile_atlas( const SDL_Surface_Ptr &tile_atlas,
-        const point &offset )
+void tileset_cache::loader::create_textures_from_sheet_part( const tileset_sheet &sheet,
+        const tileset_sheet::part &part )
 {
-    cata_assert( tile_atlas );
-
-    /** perform color filter conversion here */
-    using tiles_pixel_color_entry = std::tuple<std::vector<texture>*, std::string>;
-    std::array<tiles_pixel_color_entry, 5> tile_values_data = {{
-            { std::make_tuple( &ts.tile_values, "color_pixel_none" ) },
-            { std::make_tuple( &ts.shadow_tile_values, "color_pixel_grayscale" ) },
-            { std::make_tuple( &ts.night_tile_values, "color_pixel_nightvision" ) },
-            { std::make_tuple( &ts.overexposed_tile_values, "color_pixel_overexposed" ) },
-            { std::make_tuple( &ts.memory_tile_values, tilecontext->memory_map_mode ) }
+    const std::array<std::vector<texture> *, tileset_sheet::color_variants> tile_values_data = {{
+            &ts.tile_values, &ts.shadow_tile_values, &ts.night_tile_values,
+            &ts.overexposed_tile_values, &ts.memory_tile_values
         }
     };
-    for( tiles_pixel_color_entry &entry : tile_values_data ) {
-        std::vector<texture> *tile_values = std::get<0>( entry );
-        color_pixel_function_pointer color_pixel_function = get_color_pixel_function( std::get<1>
-                ( entry ) );
-        if( !color_pixel_function ) {
-            // TODO: Move it inside apply_color_filter.
-            copy_surface_to_texture( tile_atlas, offset, *tile_values );
-        } else {
-            copy_surface_to_texture( apply_color_filter( tile_atlas, color_pixel_function ), offset,
-                                     *tile_values );
+    if( !sheet.packed ) {
+        cata_assert( part.surfaces.size() == tile_values_data.size() );
+        for( size_t i = 0; i < tile_values_data.size(); ++i ) {
+            copy_surface_to_texture( part.surfaces[i], part.offset, *tile_values_data[i] );
         }
+        return;
+    }
+    // The variants are one below the other on the same texture, so the sprites
+    // of a lit tile and of its shaded neighbour are drawn together.
+    cata_assert( part.surfaces.size() == 1 );
+    const SDL_Surface_Ptr &surf = part.surfaces.front();
+    const std::shared_ptr<SDL_Texture> texture_ptr = CreateTextureFromSurface( renderer, surf );
+    cata_assert( texture_ptr );
+    const int h = surf->h / tileset_sheet::color_variants;
+    for( size_t i = 0; i < tile_values_data.size(); ++i ) {
+        assign_textures( texture_ptr, SDL_Rect{ 0, static_cast<int>( i ) * h, surf->w, h },
+                         part.offset, *tile_values_data[i] );
     }
 }
 
@@ -501,20 +480,15 @@ static void extend_vector_by( std::vector<T> &vec, const size_t additional_size
     vec.resize( vec.size() + additional_size );
 }
 
-void tileset_cache::loader::load_tileset( const cata_path &img_path, const bool pump_events )
+tileset_sheet_params tileset_cache::loader::sheet_params( const cata_path &img_path ) const
 {
     cata_assert( sprite_width > 0 );
     cata_assert( sprite_height > 0 );
-    const SDL_Surface_Ptr tile_atlas = load_image( img_path.get_unrelative_path().u8string().c_str() );
-    cata_assert( tile_atlas );
-    tile_atlas_width = tile_atlas->w;
-
-    if( R >= 0 && R <= 255 && G >= 0 && G <= 255 && B >= 0 && B <= 255 ) {
-        const Uint32 key = SDL_MapRGB( tile_atlas->format, 0, 0, 0 );
-        throwErrorIf( SDL_SetColorKey( tile_atlas.get(), SDL_TRUE, key ) != 0,
-                      "SDL_SetColorKey failed" );
-        throwErrorIf( SDL_SetSurfaceRLE( tile_atlas.get(), 1 ), "SDL_SetSurfaceRLE failed" );
-    }
+    tileset_sheet_params params;
+    params.image_path = img_path;
+    params.sprite_width = sprite_width;
+    params.sprite_height = sprite_height;
+    params.color_key = R >= 0 && R <= 255 && G >= 0 && G <= 255 && B >= 0 && B <= 255;
 
     SDL_RendererInfo info;
     throwErrorIf( SDL_GetRendererInfo( renderer.get(), &info ) != 0, "SDL_GetRendererInfo failed" );
@@ -557,49 +531,42 @@ void tileset_cache::loader::load_tileset( const cata_path &img_path, const bool
 
     // Number of tiles in each dimension that fits into a (maximal) SDL texture.
     // If the tile atlas contains more than that, we have to split it.
-    const int max_tile_xcount = info.max_texture_width / sprite_width;
-    const int max_tile_ycount = info.max_texture_height / sprite_height;
-    // Range over the tile atlas, wherein each rectangle fits into the maximal
-    // SDL texture size. In other words: a range over the parts into which the
-    // tile atlas needs to be split.
-    const rect_range<SDL_Rect> output_range(
-        max_tile_xcount * sprite_width,
-        max_tile_ycount * sprite_height,
-        point( divide_round_up( tile_atlas->w, info.max_texture_width ),
-               divide_round_up( tile_atlas->h, info.max_texture_height ) ) );
-
-    const int expected_tilecount = ( tile_atlas->w / sprite_width ) *
-                                   ( tile_atlas->h / sprite_height );
+    params.max_tile_xcount = info.max_texture_width / sprite_width;
+    params.max_tile_ycount = info.max_texture_height / sprite_height;
+
+    params.color_filters = {{
+            "color_pixel_none", "color_pixel_grayscale", "color_pixel_nightvision",
+            "color_pixel_overexposed", tilecontext->memory_map_mode
+        }
+    };
+    if( tilecontext->memory_map_mode == "color_pixel_custom" ) {
+        params.filter_settings = string_format( "%d %d %d %d %d %d %g",
+                                                get_option<int>( "MEMORY_RGB_DARK_RED" ),
+                                                get_option<int>( "MEMORY_RGB_DARK_GREEN" ),
+                                                get_option<int>( "MEMORY_RGB_DARK_BLUE" ),
+                                                get_option<int>( "MEMORY_RGB_BRIGHT_RED" ),
+                                                get_option<int>( "MEMORY_RGB_BRIGHT_GREEN" ),
+                                                get_option<int>( "MEMORY_RGB_BRIGHT_BLUE" ),
+                                                get_option<float>( "MEMORY_GAMMA" ) );
+    }
+    params.cache_dir = ( PATH_INFO::base_path() / "cache" / "tilesets" ).get_unrelative_path();
+    return params;
+}
+
+void tileset_cache::loader::load_tileset( const tileset_sheet &sheet, const bool pump_events )
+{
+    tile_atlas_width = sheet.width;
+
+    const int expected_tilecount = ( sheet.width / sprite_width ) *
+                                   ( sheet.height / sprite_height );
     extend_vector_by( ts.tile_values, expected_tilecount );
     extend_vector_by( ts.shadow_tile_values, expected_tilecount );
     extend_vector_by( ts.night_tile_values, expected_tilecount );
     extend_vector_by( ts.overexposed_tile_values, expected_tilecount );
     extend_vector_by( ts.memory_tile_values, expected_tilecount );
 
-    for( const SDL_Rect sub_rect : output_range ) {
-        cata_assert( sub_rect.x % sprite_width == 0 );
-        cata_assert( sub_rect.y % sprite_height == 0 );
-        cata_assert( sub_rect.w % sprite_width == 0 );
-        cata_assert( sub_rect.h % sprite_height == 0 );
-        SDL_Surface_Ptr smaller_surf;
-
-        if( is_contained( SDL_Rect{ 0, 0, tile_atlas->w, tile_atlas->h }, sub_rect ) ) {
-            // can use tile_atlas directly, it is completely contained in the output rectangle
-        } else {
-            // Need a temporary surface that contains the parts of the tile atlas that fit
-            // into sub_rect. But doesn't always need to be as large as sub_rect.
-            const int w = std::min( tile_atlas->w - sub_rect.x, sub_rect.w );
-            const int h = std::min( tile_atlas->h - sub_rect.y, sub_rect.h );
-            smaller_surf = ::create_surface_32( w, h );
-            cata_assert( smaller_surf );
-            const SDL_Rect inp{ sub_rect.x, sub_rect.y, w, h };
-            throwErrorIf( SDL_BlitSurface( tile_atlas.get(), &inp, smaller_surf.get(),
-                                           nullptr ) != 0, "SDL_BlitSurface failed" );
-        }
-        const SDL_Surface_Ptr &surf_to_use = smaller_surf ? smaller_surf : tile_atlas;
-        cata_assert( surf_to_use );
-
-        create_textures_from_tile_atlas( surf_to_use, point( sub_rect.x, sub_rect.y ) );
+    for( const tileset_sheet::part &part : sheet.parts ) {
+        create_textures_from_sheet_part( sheet, part );
 
         if( pump_events ) {
             inp_mngr.pump_events();
@@ -796,10 +763,7 @@ void tileset_cache::loader::load_internal( const JsonObject &config,
 {
     if( config.has_array( "tiles-new" ) ) {
         // new system, several entries
-        // When loading multiple tileset images this defines where
-        // the tiles from the most recently loaded image start from.
-        for( const JsonObject tile_part_def : config.get_array( "tiles-new" ) ) {
-            const cata_path tileset_image_path = tileset_root / tile_part_def.get_string( "file" );
+        const auto load_sprite_format = [&]( const JsonObject & tile_part_def ) {
             R = -1;
             G = -1;
             B = -1;
@@ -811,6 +775,21 @@ void tileset_cache::loader::load_internal( const JsonObject &config,
             }
             sprite_width = tile_part_def.get_int( "sprite_width", ts.tile_width );
             sprite_height = tile_part_def.get_int( "sprite_height", ts.tile_height );
+        };
+        // The images are decoded and filtered on other threads while the tile
+        // definitions of the previous ones are loaded here.
+        std::vector<tileset_sheet_params> sheets;
+        for( const JsonObject tile_part_def : config.get_array( "tiles-new" ) ) {
+            load_sprite_format( tile_part_def );
+            sheets.push_back( sheet_params( tileset_root / tile_part_def.get_string( "file" ) ) );
+        }
+        tileset_sheet_queue queue( std::move( sheets ) );
+        size_t index = 0;
+        // When loading multiple tileset images this defines where
+        // the tiles from the most recently loaded image start from.
+        for( const JsonObject tile_part_def : config.get_array( "tiles-new" ) ) {
+            const cata_path tileset_image_path = tileset_root / tile_part_def.get_string( "file" );
+            load_sprite_format( tile_part_def );
             // Now load the tile definitions for the loaded tileset image.
             sprite_offset.x = tile_part_def.get_int( "sprite_offset_x", 0 );
             sprite_offset.y = tile_part_def.get_int( "sprite_offset_y", 0 );
@@ -833,7 +812,11 @@ void tileset_cache::loader::load_internal( const JsonObject &config,
             };
             // First load the tileset image to get the number of available tiles.
             dbg( D_INFO ) << "Attempting to Load Tileset file " << tileset_image_path;
-            load_tileset( tileset_image_path, pump_events );
+            load_tileset( queue.take( index++, [pump_events]() {
+                if( pump_events ) {
+                    inp_mngr.pump_events();
+                }
+            } ), pump_events );
             load_tilejson_from_file( tile_part_def );
             if( tile_part_def.has_member( "ascii" ) ) {
                 load_ascii( tile_part_def );
@@ -856,7 +839,7 @@ void tileset_cache::loader::load_internal( const JsonObject &config,
         B = -1;
         // old system, no tile file path entry, only one array of tiles
         dbg( D_INFO ) << "Attempting to Load Tileset file " << img_path;
-        load_tileset( img_path, pump_events );
+        load_tileset( tileset_sheet::load( sheet_params( img_path ) ), pump_events );
         load_tilejson_from_file( config );
         offset = size;
     }
@@ -1953,10 +1936,16 @@ void cata_tiles::draw( const point &dest, const tripoint_bub_ms &center, int wid
         }
     }
 
+    flush_sprites();
     printErrorIf( SDL_RenderSetClipRect( renderer.get(), nullptr ) != 0,
                   "SDL_RenderSetClipRect failed" );
 }
 
+void cata_tiles::flush_sprites()
+{
+    printErrorIf( batch.flush( renderer ) != 0, "SDL_RenderGeometry failed" );
+}
+
 void cata_tiles::set_draw_cache_dirty()
 {
     get_map().draw_points_cache_dirty = true;
@@ -3059,14 +3048,14 @@ bool cata_tiles::draw_sprite_at(
         if( rota == -1 ) {
             // flip horizontally
             ret = sprite_tex->render_copy_ex(
-                      renderer, &destination, 0, nullptr,
+                      batch, renderer, destination, 0,
                       static_cast<SDL_RendererFlip>( SDL_FLIP_HORIZONTAL ) );
         } else {
             switch( rota % 4 ) {
                 default:
                 case 0:
                     // unrotated (and 180, with just two sprites)
-                    ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr,
+                    ret = sprite_tex->render_copy_ex( batch, renderer, destination, 0,
                                                       SDL_FLIP_NONE );
                     break;
                 case 1:
@@ -3080,10 +3069,10 @@ bool cata_tiles::draw_sprite_at(
 #endif
                     if( !is_isometric() ) {
                         // never rotate isometric tiles
-                        ret = sprite_tex->render_copy_ex( renderer, &destination, -90, nullptr,
+                        ret = sprite_tex->render_copy_ex( batch, renderer, destination, -90,
                                                           SDL_FLIP_NONE );
                     } else {
-                        ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr,
+                        ret = sprite_tex->render_copy_ex( batch, renderer, destination, 0,
                                                           SDL_FLIP_NONE );
                     }
                     break;
@@ -3092,10 +3081,10 @@ bool cata_tiles::draw_sprite_at(
                     if( !is_isometric() ) {
                         // never flip isometric tiles vertically
                         ret = sprite_tex->render_copy_ex(
-                                  renderer, &destination, 0, nullptr,
+                                  batch, renderer, destination, 0,
                                   static_cast<SDL_RendererFlip>( SDL_FLIP_HORIZONTAL | SDL_FLIP_VERTICAL ) );
                     } else {
-                        ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr,
+                        ret = sprite_tex->render_copy_ex( batch, renderer, destination, 0,
                                                           SDL_FLIP_NONE );
                     }
                     break;
@@ -3110,10 +3099,10 @@ bool cata_tiles::draw_sprite_at(
 #endif
                     if( !is_isometric() ) {
                         // never rotate isometric tiles
-                        ret = sprite_tex->render_copy_ex( renderer, &destination, 90, nullptr,
+                        ret = sprite_tex->render_copy_ex( batch, renderer, destination, 90,
                                                           SDL_FLIP_NONE );
                     } else {
-                        ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr,
+                        ret = sprite_tex->render_copy_ex( batch, renderer, destination, 0,
                                                           SDL_FLIP_NONE );
                     }
                     break;
@@ -3121,10 +3110,10 @@ bool cata_tiles::draw_sprite_at(
         }
     } else {
         // don't rotate, same as case 0 above
-        ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr, SDL_FLIP_NONE );
+        ret = sprite_tex->render_copy_ex( batch, renderer, destination, 0, SDL_FLIP_NONE );
     }
 
-    printErrorIf( ret != 0, "SDL_RenderCopyEx() failed" );
+    printErrorIf( ret != 0, "Rendering sprite failed" );
     // this reference passes all the way back up the call chain back to
     // cata_tiles::draw() here.draw_points_cache[z][row][col].com.height_3d
     // where we are accumulating the height of every sprite stacked up in a tile
@@ -3263,6 +3252,7 @@ void cata_tiles::draw_square_below( const point_bub_ms &p, const nc_color &col,
         sdlrect.x = screen.x + divide_round_down( tile_width - sdlrect.w, 2 );
         sdlrect.y = screen.y + divide_round_down( tile_height - sdlrect.h, 2 );
     }
+    flush_sprites();
     geometry->rect( renderer, sdlrect, sdlcol );
 }
 
@@ -4340,6 +4330,7 @@ void cata_tiles::draw_zlevel_overlay( const tripoint_bub_ms &p, const lit_level
 
     // Change blend mode for transparency to work
     // Disable after to avoid visual bugs
+    flush_sprites();
     SetRenderDrawBlendMode( renderer, SDL_BLENDMODE_BLEND );
     geometry->rect( renderer, draw_rect, fog_color );
     SetRenderDrawBlendMode( renderer, SDL_BLENDMODE_NONE );
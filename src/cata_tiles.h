@@ -25,6 +25,8 @@
 #include "point.h"
 #include "sdl_wrappers.h"
 #include "sdl_geometry.h"
+#include "sdl_sprite_batch.h"
+#include "tileset_sheet.h"
 #include "type_id.h"
 #include "weather.h"
 #include "weighted_list.h"
@@ -132,14 +134,13 @@ class texture
         std::pair<int, int> dimension() const {
             return std::make_pair( srcrect.w, srcrect.h );
         }
-        /// Interface to @ref SDL_RenderCopyEx, using this as the texture, and
-        /// null as source rectangle (render the whole texture). Other parameters
-        /// are simply passed through.
-        int render_copy_ex( const SDL_Renderer_Ptr &renderer, const SDL_Rect *const dstrect,
-                            const double angle,
-                            const SDL_Point *const center, const SDL_RendererFlip flip ) const {
-            return SDL_RenderCopyEx( renderer.get(), sdl_texture_ptr.get(), &srcrect, dstrect, angle, center,
-                                     flip );
+        /// Interface to @ref sprite_batch::add, using this as the texture and its
+        /// part of the tile atlas as source rectangle. Other parameters are simply
+        /// passed through.
+        int render_copy_ex( sprite_batch &batch, const SDL_Renderer_Ptr &renderer,
+                            const SDL_Rect &dstrect, const int angle,
+                            const SDL_RendererFlip flip ) const {
+            return batch.add( renderer, sdl_texture_ptr.get(), srcrect, dstrect, angle, flip );
         }
 };
 
@@ -321,7 +322,14 @@ class tileset_cache::loader
 
         void copy_surface_to_texture( const SDL_Surface_Ptr &surf, const point &offset,
                                       std::vector<texture> &target );
-        void create_textures_from_tile_atlas( const SDL_Surface_Ptr &tile_atlas, const point &offset );
+        /** Sets the sprites of the part of the tile atlas at @p offset, which is at @p area of
+         * the texture. */
+        void assign_textures( const std::shared_ptr<SDL_Texture> &texture_ptr, const SDL_Rect &area,
+                              const point &offset, std::vector<texture> &target );
+        void create_textures_from_sheet_part( const tileset_sheet &sheet,
+                                              const tileset_sheet::part &part );
+        /** How to prepare the image at @p path for the current sprite format and renderer. */
+        tileset_sheet_params sheet_params( const cata_path &path ) const;
 
         void process_variations_after_loading( weighted_int_list<std::vector<int>> &v ) const;
 
@@ -341,14 +349,13 @@ class tileset_cache::loader
                                     std::string_view objname ) const;
 
         void load_ascii( const JsonObject &config );
-        /** Load tileset, R,G,B, are the color components of the transparent color
-         * Returns the number of tiles that have been loaded from this tileset image
+        /** Creates the textures of a tileset image prepared by @ref sheet_params
+         * Sets size to the number of tiles that have been loaded from this tileset image
          * @param pump_events Handle window events and refresh the screen when necessary.
          *        Please ensure that the tileset is not accessed when this method is
          *        executing if you set it to true.
-         * @throw std::exception If the image can not be loaded.
          */
-        void load_tileset( const cata_path &path, bool pump_events );
+        void load_tileset( const tileset_sheet &sheet, bool pump_events );
         /**
          * Load tiles from json data.This expects a "tiles" array in
          * <B>config</B>. That array should contain all the tile definition that
@@ -540,6 +547,8 @@ class cata_tiles
         bool draw_tile_at( const tile_type &tile, const point &, unsigned int loc_rand, int rota,
                            lit_level ll, bool apply_night_vision_goggles, int retract, int &height_3d,
                            const point &offset );
+        /** Renders the sprites queued so far, before drawing anything that isn't a sprite. */
+        void flush_sprites();
 
         /* Tile Picking */
         void get_tile_values( int t, const std::array<int, 4> &tn, int &subtile, int &rotation,
@@ -791,6 +800,7 @@ class cata_tiles
         /** Variables */
         const SDL_Renderer_Ptr &renderer;
         const GeometryRenderer_Ptr &geometry;
+        sprite_batch batch;
         tileset_cache &cache;
         std::shared_ptr<const tileset> tileset_ptr;
 
@@ -121,6 +121,7 @@
 #include "vehicle.h"
 #include "vehicle_selector.h"
 #include "viewer.h"
+#include "visitable-inl.h"
 #include "vitamin.h"
 #include "vpart_position.h"
 #include "vpart_range.h"
@@ -373,6 +374,17 @@ static const move_mode_id move_mode_walk( "walk" );
 
 static const mtype_id mon_player_blob( "mon_player_blob" );
 
+static const option_handle<float> option_NPC_HEALING_RATE( "NPC_HEALING_RATE" );
+static const option_handle<int> option_PLAYER_BASE_STAMINA_BURN_RATE( "PLAYER_BASE_STAMINA_BURN_RATE" );
+static const option_handle<float> option_PLAYER_BASE_STAMINA_REGEN_RATE( "PLAYER_BASE_STAMINA_REGEN_RATE" );
+static const option_handle<int> option_PLAYER_CARDIOFIT_STAMINA_SCALING( "PLAYER_CARDIOFIT_STAMINA_SCALING" );
+static const option_handle<float> option_PLAYER_HEALING_RATE( "PLAYER_HEALING_RATE" );
+static const option_handle<int> option_PLAYER_MAX_STAMINA_BASE( "PLAYER_MAX_STAMINA_BASE" );
+static const option_handle<float> option_PLAYER_SLEEPINESS_RATE( "PLAYER_SLEEPINESS_RATE" );
+static const option_handle<float> option_PLAYER_THIRST_RATE( "PLAYER_THIRST_RATE" );
+static const option_handle<int> option_SPEEDYDEX_DEX_SPEED( "SPEEDYDEX_DEX_SPEED" );
+static const option_handle<int> option_SPEEDYDEX_MIN_DEX( "SPEEDYDEX_MIN_DEX" );
+
 static const proficiency_id proficiency_prof_parkour( "prof_parkour" );
 static const proficiency_id proficiency_prof_spotting( "prof_spotting" );
 static const proficiency_id proficiency_prof_traps( "prof_traps" );
@@ -2005,7 +2017,7 @@ void Character::on_try_dodge()
     // Each attempt consumes an available dodge
     consume_dodge_attempts();
 
-    const int base_burn_rate = get_option<int>( STATIC( "PLAYER_BASE_STAMINA_BURN_RATE" ) );
+    const int base_burn_rate = option_PLAYER_BASE_STAMINA_BURN_RATE.get();
     const float dodge_skill_modifier = ( 20.0f - get_skill_level( skill_dodge ) ) / 20.0f;
     burn_energy_legs( - std::floor( static_cast<float>( base_burn_rate ) * 6.0f *
                                     dodge_skill_modifier ) );
@@ -3068,7 +3080,7 @@ std::vector<item_location> Character::nearby( const
 {
     std::vector<item_location> res;
 
-    visit_items( [&]( const item * e, const item * parent ) {
+    visit_items_inline( [&]( const item * e, const item * parent ) {
         if( func( e, parent ) ) {
             res.emplace_back( const_cast<Character &>( *this ), const_cast<item *>( e ) );
         }
@@ -3076,7 +3088,7 @@ std::vector<item_location> Character::nearby( const
     } );
 
     for( const map_cursor &cur : map_selector( pos_bub(), radius ) ) {
-        cur.visit_items( [&]( const item * e, const item * parent ) {
+        cur.visit_items_inline( [&]( const item * e, const item * parent ) {
             if( func( e, parent ) ) {
                 res.emplace_back( cur, const_cast<item *>( e ) );
             }
@@ -3085,7 +3097,7 @@ std::vector<item_location> Character::nearby( const
     }
 
     for( const vehicle_cursor &cur : vehicle_selector( pos_bub(), radius ) ) {
-        cur.visit_items( [&]( const item * e, const item * parent ) {
+        cur.visit_items_inline( [&]( const item * e, const item * parent ) {
             if( func( e, parent ) ) {
                 res.emplace_back( cur, const_cast<item *>( e ) );
             }
@@ -3195,6 +3207,7 @@ units::mass Character::weight_carried() const
 void Character::invalidate_weight_carried_cache()
 {
     cached_weight_carried = std::nullopt;
+    item_pocket::invalidate_contents_totals();
 }
 
 units::mass Character::best_nearby_lifting_assist() const
@@ -4285,11 +4298,9 @@ int Character::get_int_bonus() const
 
 static int get_speedydex_bonus( const int dex )
 {
-    static const std::string speedydex_min_dex( "SPEEDYDEX_MIN_DEX" );
-    static const std::string speedydex_dex_speed( "SPEEDYDEX_DEX_SPEED" );
     // this is the number to be multiplied by the increment
-    const int modified_dex = std::max( dex - get_option<int>( speedydex_min_dex ), 0 );
-    return modified_dex * get_option<int>( speedydex_dex_speed );
+    const int modified_dex = std::max( dex - option_SPEEDYDEX_MIN_DEX.get(), 0 );
+    return modified_dex * option_SPEEDYDEX_DEX_SPEED.get();
 }
 
 int Character::get_enchantment_speed_bonus() const
@@ -5236,11 +5247,8 @@ needs_rates Character::calc_needs_rates() const
 
     add_msg_debug_if( is_avatar(), debugmode::DF_CHAR_CALORIES, "Metabolic rate: %.2f", rates.hunger );
 
-    static const std::string player_thirst_rate( "PLAYER_THIRST_RATE" );
-    rates.thirst = get_option< float >( player_thirst_rate );
-
-    static const std::string player_sleepiness_rate( "PLAYER_SLEEPINESS_RATE" );
-    rates.sleepiness = get_option< float >( player_sleepiness_rate );
+    rates.thirst = option_PLAYER_THIRST_RATE.get();
+    rates.sleepiness = option_PLAYER_SLEEPINESS_RATE.get();
 
     if( asleep ) {
         calc_sleep_recovery_rate( rates );
@@ -6225,8 +6233,8 @@ float Character::healing_rate( float at_rest_quality ) const
 {
     float const rest = clamp( at_rest_quality, 0.0f, 1.0f );
     // TODO: Cache
-    float const base_heal_rate = is_avatar() ? get_option<float>( "PLAYER_HEALING_RATE" )
-                                 : get_option<float>( "NPC_HEALING_RATE" );
+    float const base_heal_rate = is_avatar() ? option_PLAYER_HEALING_RATE.get()
+                                 : option_NPC_HEALING_RATE.get();
     float const heal_rate = enchantment_cache->modify_value( enchant_vals::mod::REGEN_HP,
                             base_heal_rate );
     float awake_rate = ( 1.0f - rest ) * heal_rate;
@@ -6766,13 +6774,10 @@ int Character::get_stamina_max() const
     // Since adding cardio, 'player_max_stamina' is really 'base max stamina' and gets further modified
     // by your CV fitness.  Name has been kept this way to avoid needing to change the code.
     // Default base maximum stamina and cardio scaling are defined in data/core/game_balance.json
-    static const std::string player_max_stamina( "PLAYER_MAX_STAMINA_BASE" );
-    static const std::string player_cardiofit_stamina_scale( "PLAYER_CARDIOFIT_STAMINA_SCALING" );
-
     // Cardiofit stamina mod defaults to 5, and get_cardiofit() should return a value in the vicinity
     // of 1000-3000, so this should add somewhere between 3000 to 15000 stamina.
-    int max_stamina = get_option<int>( player_max_stamina ) +
-                      get_option<int>( player_cardiofit_stamina_scale ) * get_cardiofit();
+    int max_stamina = option_PLAYER_MAX_STAMINA_BASE.get() +
+                      option_PLAYER_CARDIOFIT_STAMINA_SCALING.get() * get_cardiofit();
     max_stamina = enchantment_cache->modify_value( enchant_vals::mod::MAX_STAMINA, max_stamina );
 
     return max_stamina;
@@ -6930,7 +6935,7 @@ void Character::burn_move_stamina( int moves )
         overburden_percentage = ( current_weight - max_weight ) * 100 / max_weight;
     }
 
-    int burn_ratio = get_option<int>( "PLAYER_BASE_STAMINA_BURN_RATE" );
+    int burn_ratio = option_PLAYER_BASE_STAMINA_BURN_RATE.get();
     for( const bionic_id &bid : get_bionic_fueled_with_muscle() ) {
         if( has_active_bionic( bid ) ) {
             burn_ratio = burn_ratio * 2 - 3;
@@ -6968,8 +6973,7 @@ void Character::burn_move_stamina( int moves )
 
 void Character::update_stamina( int turns )
 {
-    static const std::string player_base_stamina_regen_rate( "PLAYER_BASE_STAMINA_REGEN_RATE" );
-    const float base_regen_rate = get_option<float>( player_base_stamina_regen_rate );
+    const float base_regen_rate = option_PLAYER_BASE_STAMINA_REGEN_RATE.get();
     // Your stamina regen rate works as a function of how fit you are compared to your body size.
     // This allows it to scale more quickly than your stamina, so that at higher fitness levels you
     // recover stamina faster.
@@ -9768,7 +9772,7 @@ std::list<item> Character::use_charges( const itype_id &what, int qty, const int
 
     bool has_tool_with_UPS = false;
     // Detection of UPS tool
-    inv.visit_items( [ &what, &qty, &has_tool_with_UPS, &filter]( item * e, item * ) {
+    inv.visit_items_inline( [ &what, &qty, &has_tool_with_UPS, &filter]( item * e, item * ) {
         if( filter( *e ) && e->typeId() == what && e->has_flag( flag_USE_UPS ) ) {
             has_tool_with_UPS = true;
             return VisitResponse::ABORT;
@@ -9780,7 +9784,7 @@ std::list<item> Character::use_charges( const itype_id &what, int qty, const int
         get_map().use_charges( pos_bub(), radius, what, qty, return_true<item>, nullptr, in_tools );
     }
     if( qty > 0 ) {
-        visit_items( [this, &what, &qty, &res, &del, &filter, &in_tools]( item * e, item * ) {
+        visit_items_inline( [this, &what, &qty, &res, &del, &filter, &in_tools]( item * e, item * ) {
             if( e->use_charges( what, qty, res, pos_bub(), filter, this, in_tools ) ) {
                 del.push_back( e );
             }
@@ -9990,7 +9994,7 @@ void Character::on_item_acquire( const item &it )
     bool check_for_zoom = is_avatar();
     bool update_overmap_seen = false;
 
-    it.visit_items( [this, &check_for_zoom, &update_overmap_seen]( item * cont_it, item * ) {
+    it.visit_items_inline( [this, &check_for_zoom, &update_overmap_seen]( item * cont_it, item * ) {
         add_to_inv_search_caches( *cont_it );
         if( check_for_zoom && !update_overmap_seen && cont_it->has_flag( flag_ZOOM ) ) {
             update_overmap_seen = true;
@@ -10023,7 +10027,7 @@ void Character::on_mutation_gain( const trait_id &mid )
     morale->on_mutation_gain( mid );
     magic->on_mutation_gain( mid, *this );
     update_type_of_scent( mid );
-    effect_on_conditions::process_reactivate( *this );
+    effect_on_conditions::process_reactivate( *this, eoc_reactivation::traits );
     if( is_avatar() ) {
         as_avatar()->character_mood_face( true );
     }
@@ -10034,7 +10038,7 @@ void Character::on_mutation_loss( const trait_id &mid )
     morale->on_mutation_loss( mid );
     magic->on_mutation_loss( mid );
     update_type_of_scent( mid, false );
-    effect_on_conditions::process_reactivate( *this );
+    effect_on_conditions::process_reactivate( *this, eoc_reactivation::traits );
     if( is_avatar() ) {
         as_avatar()->character_mood_face( true );
     }
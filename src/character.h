@@ -3,6 +3,7 @@
 #define CATA_SRC_CHARACTER_H
 
 #include <algorithm>
+#include <array>
 #include <bitset>
 #include <climits>
 #include <cstdint>
@@ -302,71 +303,74 @@ struct queued_eoc {
         std::unordered_map<std::string, std::string> context;
 };
 
-struct eoc_compare {
-    bool operator()( const queued_eoc &lhs, const queued_eoc &rhs ) const {
-        return lhs.time > rhs.time;
-    }
-};
-
-struct queued_eocs {
-    using storage_iter = std::list<queued_eoc>::iterator;
+/**
+ * The EOCs waiting for their time, kept in a hierarchical timer wheel.
+ *
+ * Level 0 has a slot for each turn of the current block of 64 turns, and each level above has
+ * slots spanning 64 times as long as the ones below.  EOCs further away than the top level can
+ * reach wait in an overflow list.  Queuing an EOC is constant time, and a slot is only sorted when
+ * it comes due, so a turn's worth of EOCs is taken out at once.  EOCs due at the same time run in
+ * the order they were queued.
+ */
+class queued_eocs
+{
+    public:
+        using storage_iter = std::list<queued_eoc>::iterator;
 
-    struct eoc_compare : ::eoc_compare {
-        bool operator()( const storage_iter &lhs, const storage_iter &rhs ) const {
-            return ::eoc_compare::operator()( *lhs, *rhs );
-        }
-    };
-    std::priority_queue<storage_iter, std::vector<storage_iter>, eoc_compare> queue;
-    std::list<queued_eoc> list;
+        // Every queued EOC, including the ones taken out by take_due() that haven't been put back yet
+        std::list<queued_eoc> list;
 
-    queued_eocs() = default;
+        queued_eocs() = default;
+        queued_eocs( const queued_eocs &rhs );
+        queued_eocs( queued_eocs &&rhs ) noexcept = default;
+        queued_eocs &operator=( const queued_eocs &rhs );
+        queued_eocs &operator=( queued_eocs &&rhs ) noexcept = default;
 
-    queued_eocs( const queued_eocs &rhs ) {
-        list = rhs.list;
-        for( auto it = list.begin(), end = list.end(); it != end; ++it ) {
-            queue.emplace( it );
+        bool empty() const {
+            return list.empty();
         }
-    };
-    queued_eocs( queued_eocs &&rhs ) noexcept {
-        queue.swap( rhs.queue );
-        list.swap( rhs.list );
-    }
-
-    queued_eocs &operator=( const queued_eocs &rhs ) {
-        list = rhs.list;
-        // Why doesn't std::priority_queue have a clear() function.
-        queue = {};
-        for( auto it = list.begin(), end = list.end(); it != end; ++it ) {
-            queue.emplace( it );
+        size_t size() const {
+            return list.size();
         }
-        return *this;
-    }
-    queued_eocs &operator=( queued_eocs &&rhs ) noexcept {
-        queue.swap( rhs.queue );
-        list.swap( rhs.list );
-        return *this;
-    }
-
-    /* std::priority_queue compatibility layer where performance is less relevant */
+        void push( const queued_eoc &eoc );
+        void clear();
+        /** The queued EOCs in the order they will run. */
+        std::vector<const queued_eoc *> sorted() const;
 
-    bool empty() const {
-        return queue.empty();
-    }
-
-    const queued_eoc &top() const {
-        return *queue.top();
-    }
-
-    void push( const queued_eoc &eoc ) {
-        auto it = list.emplace( list.end(), eoc );
-        queue.push( it );
-    }
+        /**
+         * Takes the EOCs of the earliest turn that has any due at @p now out of the wheel, in the
+         * order they run.  They stay in @ref list until they are erased or rescheduled.
+         * Returns false if none are due.
+         */
+        bool take_due( const time_point &now, std::vector<storage_iter> &due );
+        /** Puts an EOC taken out by take_due() back into the wheel at its current time. */
+        void reschedule( storage_iter it );
+        /** Drops an EOC taken out by take_due(). */
+        void erase( storage_iter it );
 
-    void pop() {
-        auto it = queue.top();
-        queue.pop();
-        list.erase( it );
-    }
+    private:
+        struct entry {
+            storage_iter it;
+            // order of queuing, breaks ties between EOCs due at the same time
+            uint64_t seq;
+        };
+        static constexpr int slot_bits = 6;
+        static constexpr int64_t slots = 1 << slot_bits;
+        static constexpr int levels = 4;
+
+        std::array<std::vector<entry>, slots * levels> wheel;
+        std::vector<entry> overflow;
+        // the turn of the slot taken next, never later than the current turn
+        int64_t cursor = 0;
+        uint64_t next_seq = 0;
+
+        void insert( const entry &e );
+        /** The turn the next occupied slot after the cursor starts at. */
+        std::optional<int64_t> next_occupied() const;
+        /** Moves the cursor forward over empty slots, splitting up the slots it enters. */
+        void move_cursor( int64_t to );
+        /** Reinserts everything, for when the clock goes back. */
+        void rebuild( int64_t to );
 };
 
 struct aim_type {
@@ -3852,6 +3856,8 @@ class Character : public Creature, public visitable
         int max_quality( const quality_id &qual, int radius ) const;
         VisitResponse visit_items( const std::function<VisitResponse( item *, item * )> &func ) const
         override;
+        template<typename F>
+        VisitResponse visit_items_inline( F &&func ) const;
         std::list<item> remove_items_with( const std::function<bool( const item & )> &filter,
                                            int count = INT_MAX ) override;
         int charges_of(
@@ -4144,7 +4150,16 @@ class Character : public Creature, public visitable
             int moves;
             tripoint_bub_ms position;
             int radius;
+            bool clear_path;
             pimpl<inventory> crafting_inventory;
+            // Items found on the map around map_position. Kept when only the character's own
+            // items may have changed, and rebuilt when map::get_items_revision moves on.
+            bool map_valid = false; // other map_* fields are only valid if this flag is true
+            tripoint_bub_ms map_position;
+            int map_radius;
+            bool map_clear_path;
+            int map_revision;
+            pimpl<inventory> map_inventory;
         };
         mutable crafting_cache_type crafting_cache;
 
@@ -253,6 +253,8 @@ class outfit
         const item &i_at( int position ) const;
 
         VisitResponse visit_items( const std::function<VisitResponse( item *, item * )> &func ) const;
+        template<typename F>
+        VisitResponse visit_items_inline( F &func ) const;
         std::list<item> remove_items_with( Character &guy,
                                            const std::function<bool( const item & )> &filter, int &count );
 
@@ -109,6 +109,9 @@ void zone_manager::clear()
     // Do not clear types since it is needed for the next games.
     area_cache.clear();
     vzone_cache.clear();
+    area_bounds.clear();
+    vzone_bounds.clear();
+    near_cache.clear();
 }
 
 std::string zone_type::name() const
@@ -898,9 +901,30 @@ bool zone_manager::has_defined( const zone_type_id &type, const faction_id &fac
     return type_iter != area_cache.end();
 }
 
+void zone_manager::add_zone_to_cache( const zone_data &zone, point_cache &points,
+                                      bounds_cache &bounds )
+{
+    const std::string type_hash = zone.get_type_hash();
+    std::unordered_set<tripoint_abs_ms> &cache = points[type_hash];
+
+    // Draw marked area
+    for( const tripoint_abs_ms &p : tripoint_range<tripoint_abs_ms>(
+             zone.get_start_point(), zone.get_end_point() ) ) {
+        cache.insert( p );
+    }
+
+    zone_bounds added{ { zone.get_start_point(), zone.get_end_point() }, {} };
+    if( zone.get_type() == zone_type_LOOT_CUSTOM || zone.get_type() == zone_type_LOOT_ITEM_GROUP ) {
+        added.filter = dynamic_cast<const loot_options &>( zone.get_options() ).get_mark();
+    }
+    bounds[type_hash].push_back( std::move( added ) );
+}
+
 void zone_manager::cache_data( bool update_avatar )
 {
     area_cache.clear();
+    area_bounds.clear();
+    near_cache.clear();
     avatar &player_character = get_avatar();
     tripoint_abs_ms cached_shift = player_character.get_location();
     for( zone_data &elem : zones ) {
@@ -914,14 +938,7 @@ void zone_manager::cache_data( bool update_avatar )
             elem.update_cached_shift( cached_shift );
         }
 
-        const std::string &type_hash = elem.get_type_hash();
-        auto &cache = area_cache[type_hash];
-
-        // Draw marked area
-        for( const tripoint_abs_ms &p : tripoint_range<tripoint_abs_ms>(
-                 elem.get_start_point(), elem.get_end_point() ) ) {
-            cache.insert( p );
-        }
+        add_zone_to_cache( elem, area_cache, area_bounds );
     }
 }
 
@@ -956,6 +973,8 @@ void zone_manager::cache_avatar_location()
 void zone_manager::cache_vzones( map *pmap )
 {
     vzone_cache.clear();
+    vzone_bounds.clear();
+    near_cache.clear();
     map &here = pmap == nullptr ? get_map() : *pmap;
     auto vzones = here.get_vehicle_zones( here.get_abs_sub().z() );
     for( zone_data *elem : vzones ) {
@@ -963,25 +982,18 @@ void zone_manager::cache_vzones( map *pmap )
             continue;
         }
 
-        const std::string &type_hash = elem->get_type_hash();
-        auto &cache = vzone_cache[type_hash];
-
-        // TODO: looks very similar to the above cache_data - maybe merge it?
-
-        // Draw marked area
-        for( const tripoint_abs_ms &p : tripoint_range<tripoint_abs_ms>(
-                 elem->get_start_point(), elem->get_end_point() ) ) {
-            cache.insert( p );
-        }
+        add_zone_to_cache( *elem, vzone_cache, vzone_bounds );
     }
 }
 
-std::unordered_set<tripoint_abs_ms> zone_manager::get_point_set( const zone_type_id &type,
+static const std::unordered_set<tripoint_abs_ms> no_points;
+
+const std::unordered_set<tripoint_abs_ms> &zone_manager::get_point_set( const zone_type_id &type,
         const faction_id &fac ) const
 {
     const auto &type_iter = area_cache.find( zone_data::make_type_hash( type, fac ) );
     if( type_iter == area_cache.end() ) {
-        return std::unordered_set<tripoint_abs_ms>();
+        return no_points;
     }
 
     return type_iter->second;
@@ -998,7 +1010,7 @@ std::unordered_set<tripoint_bub_ms> zone_manager::get_point_set_loot( const trip
 {
     std::unordered_set<tripoint_bub_ms> res;
     map &here = get_map();
-    for( const std::pair<std::string, std::unordered_set<tripoint_abs_ms>> cache : area_cache ) {
+    for( const point_cache::value_type &cache : area_cache ) {
         zone_type_id type = zone_data::unhash_type( cache.first );
         faction_id z_fac = zone_data::unhash_fac( cache.first );
         if( fac == z_fac && type.str().substr( 0, 4 ) == "LOOT" ) {
@@ -1009,7 +1021,7 @@ std::unordered_set<tripoint_bub_ms> zone_manager::get_point_set_loot( const trip
             }
         }
     }
-    for( const std::pair<std::string, std::unordered_set<tripoint_abs_ms>> cache : vzone_cache ) {
+    for( const point_cache::value_type &cache : vzone_cache ) {
         zone_type_id type = zone_data::unhash_type( cache.first );
         faction_id z_fac = zone_data::unhash_fac( cache.first );
         if( fac == z_fac && type.str().substr( 0, 4 ) == "LOOT" ) {
@@ -1022,7 +1034,7 @@ std::unordered_set<tripoint_bub_ms> zone_manager::get_point_set_loot( const trip
     }
 
     if( npc_search ) {
-        for( const std::pair<std::string, std::unordered_set<tripoint_abs_ms>> cache : vzone_cache ) {
+        for( const point_cache::value_type &cache : vzone_cache ) {
             zone_type_id type = zone_data::unhash_type( cache.first );
             if( type == zone_type_NO_NPC_PICKUP ) {
                 for( tripoint_abs_ms point : cache.second ) {
@@ -1035,13 +1047,13 @@ std::unordered_set<tripoint_bub_ms> zone_manager::get_point_set_loot( const trip
     return res;
 }
 
-std::unordered_set<tripoint_abs_ms> zone_manager::get_vzone_set( const zone_type_id &type,
+const std::unordered_set<tripoint_abs_ms> &zone_manager::get_vzone_set( const zone_type_id &type,
         const faction_id &fac ) const
 {
     //Only regenerate the vehicle zone cache if any vehicles have moved
     const auto &type_iter = vzone_cache.find( zone_data::make_type_hash( type, fac ) );
     if( type_iter == vzone_cache.end() ) {
-        return std::unordered_set<tripoint_abs_ms>();
+        return no_points;
     }
 
     return type_iter->second;
@@ -1055,20 +1067,37 @@ bool zone_manager::has( const zone_type_id &type, const tripoint_abs_ms &where,
     return point_set.find( where ) != point_set.end() || vzone_set.find( where ) != vzone_set.end();
 }
 
+// Distance from @p where to the closest point of @p area
+static int square_dist_to_area( const inclusive_cuboid<tripoint_abs_ms> &area,
+                                const tripoint_abs_ms &where )
+{
+    return square_dist( clamp( where, area ), where );
+}
+
+// Vehicle zones only count on the z-level of the query
+static bool area_on_z_level( const inclusive_cuboid<tripoint_abs_ms> &area, int z )
+{
+    return area.p_min.z() <= z && z <= area.p_max.z();
+}
+
 bool zone_manager::has_near( const zone_type_id &type, const tripoint_abs_ms &where, int range,
                              const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
-    for( const tripoint_abs_ms &point : point_set ) {
-        if( square_dist( point, where ) <= range ) {
-            return true;
+    const std::string type_hash = zone_data::make_type_hash( type, fac );
+    const auto area_iter = area_bounds.find( type_hash );
+    if( area_iter != area_bounds.end() ) {
+        for( const zone_bounds &zone : area_iter->second ) {
+            if( square_dist_to_area( zone.area, where ) <= range ) {
+                return true;
+            }
         }
     }
 
-    const auto &vzone_set = get_vzone_set( type, fac );
-    for( const tripoint_abs_ms &point : vzone_set ) {
-        if( point.z() == where.z() ) {
-            if( square_dist( point, where ) <= range ) {
+    const auto vzone_iter = vzone_bounds.find( type_hash );
+    if( vzone_iter != vzone_bounds.end() ) {
+        for( const zone_bounds &zone : vzone_iter->second ) {
+            if( area_on_z_level( zone.area, where.z() ) &&
+                square_dist_to_area( zone.area, where ) <= range ) {
                 return true;
             }
         }
@@ -1148,6 +1177,24 @@ std::vector<zone_data const *> zone_manager::get_zones_at( const tripoint_abs_ms
     return ret;
 }
 
+// Whether the filter of a LOOT_CUSTOM or LOOT_ITEM_GROUP zone accepts @p it
+static bool loot_filter_has( const zone_type_id &ztype, const std::string &filter_string,
+                             const item &it )
+{
+    item const *const check_it = it.this_or_single_content();
+    if( ztype == zone_type_LOOT_CUSTOM ) {
+        auto const z = item_filter_from_string( filter_string );
+        return z( *check_it ) || ( check_it != &it && z( it ) );
+    } else if( ztype == zone_type_LOOT_ITEM_GROUP ) {
+        return item_group::group_contains_item( item_group_id( filter_string ),
+                                                check_it->typeId() ) ||
+               ( check_it != &it &&
+                 item_group::group_contains_item( item_group_id( filter_string ),
+                         it.typeId() ) );
+    }
+    return false;
+}
+
 bool zone_manager::custom_loot_has( const tripoint_abs_ms &where, const item *it,
                                     const zone_type_id &ztype, const faction_id &fac ) const
 {
@@ -1155,22 +1202,9 @@ bool zone_manager::custom_loot_has( const tripoint_abs_ms &where, const item *it
     if( zones.empty() || !it ) {
         return false;
     }
-    item const *const check_it = it->this_or_single_content();
     for( zone_data const *zone : zones ) {
         loot_options const &options = dynamic_cast<const loot_options &>( zone->get_options() );
-        std::string const filter_string = options.get_mark();
-        bool has = false;
-        if( ztype == zone_type_LOOT_CUSTOM ) {
-            auto const z = item_filter_from_string( filter_string );
-            has = z( *check_it ) || ( check_it != it && z( *it ) );
-        } else if( ztype == zone_type_LOOT_ITEM_GROUP ) {
-            has = item_group::group_contains_item( item_group_id( filter_string ),
-                                                   check_it->typeId() ) ||
-                  ( check_it != it &&
-                    item_group::group_contains_item( item_group_id( filter_string ),
-                            it->typeId() ) );
-        }
-        if( has ) {
+        if( loot_filter_has( ztype, options.get_mark(), *it ) ) {
             return true;
         }
     }
@@ -1181,30 +1215,45 @@ bool zone_manager::custom_loot_has( const tripoint_abs_ms &where, const item *it
 std::unordered_set<tripoint_abs_ms> zone_manager::get_near( const zone_type_id &type,
         const tripoint_abs_ms &where, int range, const item *it, const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
-    std::unordered_set<tripoint_abs_ms> near_point_set;
-
-    for( const tripoint_abs_ms &point : point_set ) {
-        if( square_dist( point, where ) <= range ) {
-            if( ( type != zone_type_LOOT_CUSTOM && type != zone_type_LOOT_ITEM_GROUP ) ||
-                ( it != nullptr && custom_loot_has( point, it, type, fac ) ) ) {
-                near_point_set.insert( point );
-            }
+    const bool filtered = type == zone_type_LOOT_CUSTOM || type == zone_type_LOOT_ITEM_GROUP;
+    if( filtered && it == nullptr ) {
+        return {};
+    }
+    const std::string type_hash = zone_data::make_type_hash( type, fac );
+    if( !filtered ) {
+        const auto cached = near_cache.find( type_hash );
+        if( cached != near_cache.end() && cached->second.where == where &&
+            cached->second.range == range ) {
+            return cached->second.points;
         }
     }
 
-    const auto &vzone_set = get_vzone_set( type, fac );
-    for( const tripoint_abs_ms &point : vzone_set ) {
-        if( point.z() == where.z() ) {
-            if( square_dist( point, where ) <= range ) {
-                if( ( type != zone_type_LOOT_CUSTOM && type != zone_type_LOOT_ITEM_GROUP ) ||
-                    ( it != nullptr && custom_loot_has( point, it, type, fac ) ) ) {
-                    near_point_set.insert( point );
-                }
+    std::unordered_set<tripoint_abs_ms> near_point_set;
+    const auto add_near = [&]( const bounds_cache & bounds, bool same_z ) {
+        const auto type_iter = bounds.find( type_hash );
+        if( type_iter == bounds.end() ) {
+            return;
+        }
+        const tripoint_rel_ms reach( range, range, same_z ? 0 : range );
+        for( const zone_bounds &zone : type_iter->second ) {
+            if( ( same_z && !area_on_z_level( zone.area, where.z() ) ) ||
+                square_dist_to_area( zone.area, where ) > range ||
+                ( filtered && !loot_filter_has( type, zone.filter, *it ) ) ) {
+                continue;
+            }
+            // Only the part of the zone that is in range
+            for( const tripoint_abs_ms &p : tripoint_range<tripoint_abs_ms>(
+                     clamp( where - reach, zone.area ), clamp( where + reach, zone.area ) ) ) {
+                near_point_set.insert( p );
             }
         }
-    }
+    };
+    add_near( area_bounds, false );
+    add_near( vzone_bounds, true );
 
+    if( !filtered ) {
+        near_cache[type_hash] = { where, range, near_point_set };
+    }
     return near_point_set;
 }
 
@@ -1217,26 +1266,23 @@ std::optional<tripoint_abs_ms> zone_manager::get_nearest( const zone_type_id &ty
 
     tripoint_abs_ms nearest_pos( INT_MIN, INT_MIN, INT_MIN );
     int nearest_dist = range + 1;
-    const std::unordered_set<tripoint_abs_ms> &point_set = get_point_set( type, fac );
-    for( const tripoint_abs_ms &p : point_set ) {
-        int cur_dist = square_dist( p, where );
-        if( cur_dist < nearest_dist ) {
-            nearest_dist = cur_dist;
-            nearest_pos = p;
-            if( nearest_dist == 0 ) {
-                return nearest_pos;
-            }
+    const std::string type_hash = zone_data::make_type_hash( type, fac );
+    for( const bounds_cache *bounds : {
+             &area_bounds, &vzone_bounds
+         } ) {
+        const auto type_iter = bounds->find( type_hash );
+        if( type_iter == bounds->end() ) {
+            continue;
         }
-    }
-
-    const std::unordered_set<tripoint_abs_ms> &vzone_set = get_vzone_set( type, fac );
-    for( const tripoint_abs_ms &p : vzone_set ) {
-        int cur_dist = square_dist( p, where );
-        if( cur_dist < nearest_dist ) {
-            nearest_dist = cur_dist;
-            nearest_pos = p;
-            if( nearest_dist == 0 ) {
-                return nearest_pos;
+        for( const zone_bounds &zone : type_iter->second ) {
+            const tripoint_abs_ms p = clamp( where, zone.area );
+            int cur_dist = square_dist( p, where );
+            if( cur_dist < nearest_dist ) {
+                nearest_dist = cur_dist;
+                nearest_pos = p;
+                if( nearest_dist == 0 ) {
+                    return nearest_pos;
+                }
             }
         }
     }
@@ -566,10 +566,32 @@ class zone_manager
         std::unordered_map<std::string, std::unordered_set<tripoint_abs_ms>> area_cache;
         // NOLINTNEXTLINE(cata-serialize)
         std::unordered_map<std::string, std::unordered_set<tripoint_abs_ms>> vzone_cache;
-        std::unordered_set<tripoint_abs_ms> get_point_set( const zone_type_id &type,
+        // Bounds of the enabled zones of each type and faction, so range queries check each zone
+        // instead of each of its points.  Rebuilt along with area_cache and vzone_cache.
+        struct zone_bounds {
+            inclusive_cuboid<tripoint_abs_ms> area;
+            // Filter of LOOT_CUSTOM and LOOT_ITEM_GROUP zones
+            std::string filter;
+        };
+        using point_cache = std::unordered_map<std::string, std::unordered_set<tripoint_abs_ms>>;
+        using bounds_cache = std::unordered_map<std::string, std::vector<zone_bounds>>;
+        bounds_cache area_bounds; // NOLINT(cata-serialize)
+        bounds_cache vzone_bounds; // NOLINT(cata-serialize)
+        // Last get_near result of each type and faction that doesn't depend on the item, looting
+        // asks the same question for every item it sorts
+        struct near_query {
+            tripoint_abs_ms where;
+            int range;
+            std::unordered_set<tripoint_abs_ms> points;
+        };
+        // NOLINTNEXTLINE(cata-serialize)
+        mutable std::unordered_map<std::string, near_query> near_cache;
+        const std::unordered_set<tripoint_abs_ms> &get_point_set( const zone_type_id &type,
                 const faction_id &fac = your_fac ) const;
-        std::unordered_set<tripoint_abs_ms> get_vzone_set( const zone_type_id &type,
+        const std::unordered_set<tripoint_abs_ms> &get_vzone_set( const zone_type_id &type,
                 const faction_id &fac = your_fac ) const;
+        static void add_zone_to_cache( const zone_data &zone, point_cache &points,
+                                       bounds_cache &bounds );
     public:
         zone_manager();
         ~zone_manager() = default;
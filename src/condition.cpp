@@ -386,9 +386,14 @@ tripoint_abs_ms get_tripoint_from_var( std::optional<var_info> var, const_dialog
                                        bool is_npc )
 {
     if( var.has_value() ) {
-        std::string value = read_var_value( var.value(), d );
-        if( !value.empty() ) {
-            return tripoint_abs_ms( tripoint::from_string( value ) );
+        var_value buffer;
+        const var_value *value = find_var_value( var.value(), d, buffer );
+        if( value == nullptr && !var->default_val.empty() ) {
+            buffer = var_value( var->default_val );
+            value = &buffer;
+        }
+        if( value != nullptr && !value->empty() ) {
+            return value->tripoint_abs();
         }
     }
     if( !d.has_actor( is_npc ) ) {
@@ -489,34 +494,39 @@ translation_var_info read_translation_var_info( const JsonObject &jo )
 void write_var_value( var_type type, const std::string &name, dialogue *d,
                       const std::string &value, int call_depth )
 {
-    global_variables &globvars = get_globals();
+    write_var_value( type, var_key( name ), d, var_value( value ), call_depth );
+}
+
+void write_var_value( var_type type, const var_key &key, dialogue *d,
+                      const var_value &value, int call_depth )
+{
     std::string ret;
     var_info vinfo( var_type::global, "" );
     switch( type ) {
         case var_type::global:
-            globvars.set_global_value( name, value );
+            get_globals().set_global_value( key, value );
             break;
         case var_type::var:
-            ret = d->get_value( name );
+            ret = d->get_value( key.str() );
             vinfo = process_variable( ret );
             if( call_depth > 1000 ) {
                 debugmsg( "Possible infinite loop detected: var_val points to itself or forms a cycle.  %s->%s %s",
-                          name, vinfo.name, d->get_callstack() );
+                          key.str(), vinfo.name, d->get_callstack() );
             } else {
-                write_var_value( vinfo.type, vinfo.name, d, value,
+                write_var_value( vinfo.type, vinfo.key, d, value,
                                  call_depth + 1 );
             }
             break;
         case var_type::u:
             if( d->has_alpha ) {
-                d->actor( false )->set_value( name, value );
+                d->actor( false )->set_var( key, value );
             } else {
                 debugmsg( "Tried to use an invalid alpha talker.  %s", d->get_callstack() );
             }
             break;
         case var_type::npc:
             if( d->has_beta ) {
-                d->actor( true )->set_value( name, value );
+                d->actor( true )->set_var( key, value );
             } else {
                 debugmsg( "Tried to use an invalid beta talker.  %s", d->get_callstack() );
             }
@@ -528,7 +538,7 @@ void write_var_value( var_type type, const std::string &name, dialogue *d,
             debugmsg( "Not implemented yet." );
             break;
         case var_type::context:
-            d->set_value( name, value );
+            d->set_value( key.str(), value.str() );
             break;
         default:
             debugmsg( "Invalid type." );
@@ -560,8 +570,13 @@ void write_var_value( var_type type, const std::string &name, const_dialogue con
 void write_var_value( var_type type, const std::string &name, dialogue *d,
                       double value )
 {
-    // NOLINTNEXTLINE(cata-translate-string-literal)
-    write_var_value( type, name, d, string_format( "%g", value ) );
+    write_var_value( type, var_key( name ), d, var_value( value ) );
+}
+
+void write_var_value( var_type type, const std::string &name, dialogue *d,
+                      const tripoint_abs_ms &value )
+{
+    write_var_value( type, var_key( name ), d, var_value( value ) );
 }
 
 static bodypart_id get_bp_from_str( const std::string &ctxt )
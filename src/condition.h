@@ -67,6 +67,11 @@ void write_var_value( var_type type, const std::string &name, dialogue *d,
                       const std::string &value, int call_depth = 0 );
 void write_var_value( var_type type, const std::string &name, dialogue *d,
                       double value );
+void write_var_value( var_type type, const std::string &name, dialogue *d,
+                      const tripoint_abs_ms &value );
+/** Global and creature variables keep the type of @p value, see var_value. */
+void write_var_value( var_type type, const var_key &key, dialogue *d,
+                      const var_value &value, int call_depth = 0 );
 void write_var_value( var_type type, const std::string &name, const_dialogue const &d,
                       const std::string &value );
 std::string get_talk_varname( const JsonObject &jo, std::string_view member,
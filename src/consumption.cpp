@@ -150,6 +150,8 @@ static const mtype_id mon_player_blob( "mon_player_blob" );
 
 static const mutation_category_id mutation_category_URSINE( "URSINE" );
 
+static const option_handle<float> option_PLAYER_HUNGER_RATE( "PLAYER_HUNGER_RATE" );
+
 static const skill_id skill_cooking( "cooking" );
 static const skill_id skill_survival( "survival" );
 
@@ -753,8 +755,7 @@ void Character::vitamin_set( const vitamin_id &vit, int qty )
 
 float Character::metabolic_rate_base() const
 {
-    static const std::string hunger_rate_string( "PLAYER_HUNGER_RATE" );
-    float hunger_rate = get_option< float >( hunger_rate_string );
+    float hunger_rate = option_PLAYER_HUNGER_RATE.get();
     const float final_hunger_rate = enchantment_cache->modify_value( enchant_vals::mod::METABOLISM,
                                     hunger_rate );
     return std::clamp( final_hunger_rate, 0.0f, float_max );
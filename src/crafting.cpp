@@ -643,17 +643,38 @@ const inventory &Character::crafting_inventory( const tripoint_bub_ms &src_pos,
     if( src_pos == tripoint_bub_ms::zero ) {
         inv_pos = pos_bub();
     }
+    const int items_revision = get_map().get_items_revision();
+    const bool map_valid = crafting_cache.map_valid
+                           && radius == crafting_cache.map_radius
+                           && clear_path == crafting_cache.map_clear_path
+                           && inv_pos == crafting_cache.map_position
+                           && items_revision == crafting_cache.map_revision;
     if( crafting_cache.valid
         && moves == crafting_cache.moves
         && radius == crafting_cache.radius
+        && clear_path == crafting_cache.clear_path
         && calendar::turn == crafting_cache.time
         && inv_pos == crafting_cache.position
+        && ( radius < 0 || map_valid )
       ) {
         return *crafting_cache.crafting_inventory;
     }
     crafting_cache.crafting_inventory->clear();
     if( radius >= 0 ) {
-        crafting_cache.crafting_inventory->form_from_map( inv_pos, radius, this, false, clear_path );
+        // The character acting or changing their own items leaves the map untouched,
+        // so only scan the surroundings again if something on the map changed.
+        if( !map_valid ) {
+            crafting_cache.map_inventory->clear();
+            crafting_cache.map_inventory->form_from_map( inv_pos, radius, this, false, clear_path );
+            crafting_cache.map_valid = true;
+            crafting_cache.map_position = inv_pos;
+            crafting_cache.map_radius = radius;
+            crafting_cache.map_clear_path = clear_path;
+            crafting_cache.map_revision = items_revision;
+        }
+        *crafting_cache.crafting_inventory = *crafting_cache.map_inventory;
+        // the copy would otherwise share the binned item pointers of the map inventory
+        crafting_cache.crafting_inventory->unsort();
     }
 
     std::map<itype_id, int> tmp_liq_list;
@@ -691,11 +712,13 @@ const inventory &Character::crafting_inventory( const tripoint_bub_ms &src_pos,
     crafting_cache.time = calendar::turn;
     crafting_cache.position = inv_pos;
     crafting_cache.radius = radius;
+    crafting_cache.clear_path = clear_path;
     return *crafting_cache.crafting_inventory;
 }
 
 void Character::invalidate_crafting_inventory()
 {
+    // The map part follows map::get_items_revision and doesn't need to be dropped
     crafting_cache.valid = false;
     crafting_cache.crafting_inventory->clear();
 }
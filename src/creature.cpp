@@ -2122,12 +2122,17 @@ bool Creature::has_trait( const trait_id &/*flag*/ ) const
 // Methods for setting/getting misc key/value pairs.
 void Creature::set_value( const std::string &key, const std::string &value )
 {
-    values[ key ] = value;
+    values.set( var_key( key ), var_value( value ) );
+}
+
+void Creature::set_value( const var_key &key, var_value value )
+{
+    values.set( key, std::move( value ) );
 }
 
 void Creature::remove_value( const std::string &key )
 {
-    values.erase( key );
+    values.erase( var_key( key ) );
 }
 
 std::string Creature::get_value( const std::string &key ) const
@@ -2137,8 +2142,13 @@ std::string Creature::get_value( const std::string &key ) const
 
 std::optional<std::string> Creature::maybe_get_value( const std::string &key ) const
 {
-    auto it = values.find( key );
-    return it == values.end() ? std::nullopt : std::optional<std::string> { it->second };
+    const var_value *val = values.find( var_key( key ) );
+    return val == nullptr ? std::nullopt : std::optional<std::string> { val->str() };
+}
+
+const var_value *Creature::find_value( const var_key &key ) const
+{
+    return values.find( key );
 }
 
 void Creature::clear_values()
@@ -3241,7 +3251,7 @@ bool Creature::is_symbol_highlighted() const
     return false;
 }
 
-std::unordered_map<std::string, std::string> &Creature::get_values()
+const var_store &Creature::get_values() const
 {
     return values;
 }
@@ -24,6 +24,7 @@
 #include "coords_fwd.h"
 #include "damage.h"
 #include "debug.h"
+#include "dialogue_vars.h"
 #include "effect_source.h"
 #include "enums.h"
 #include "pimpl.h"
@@ -689,9 +690,12 @@ class Creature : public viewer
 
         // Methods for setting/getting misc key/value pairs.
         void set_value( const std::string &key, const std::string &value );
+        void set_value( const var_key &key, var_value value );
         void remove_value( const std::string &key );
         std::string get_value( const std::string &key ) const;
         std::optional<std::string> maybe_get_value( const std::string &key ) const;
+        /** Returns nullptr if the value isn't set. */
+        const var_value *find_value( const var_key &key ) const;
         void clear_values();
 
         virtual units::mass get_weight() const = 0;
@@ -1196,7 +1200,7 @@ class Creature : public viewer
         virtual const std::string &symbol() const = 0;
         virtual bool is_symbol_highlighted() const;
 
-        std::unordered_map<std::string, std::string> &get_values();
+        const var_store &get_values() const;
         void clear_killer();
         // summoned creatures via spells
         void set_summon_time( const time_duration &length );
@@ -1226,7 +1230,7 @@ class Creature : public viewer
         std::vector<damage_over_time_data> damage_over_time_map;
 
         // Miscellaneous key/value pairs.
-        std::unordered_map<std::string, std::string> values;
+        var_store values;
 
         // used for innate bonuses like effects. weapon bonuses will be
         // handled separately
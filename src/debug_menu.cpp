@@ -117,6 +117,7 @@
 #include "translation.h"
 #include "translations.h"
 #include "try_parse_integer.h"
+#include "turn_profiler.h"
 #include "type_id.h"
 #include "ui.h"
 #include "uistate.h"
@@ -274,6 +275,7 @@ std::string enum_to_string<debug_menu::debug_menu_index>( debug_menu::debug_menu
 		case debug_menu::debug_menu_index::WRITE_CITY_LIST: return "WRITE_CITY_LIST";
         case debug_menu::debug_menu_index::TALK_TOPIC: return "TALK_TOPIC";
         case debug_menu::debug_menu_index::IMGUI_DEMO: return "IMGUI_DEMO";
+        case debug_menu::debug_menu_index::PROFILE_TURNS: return "PROFILE_TURNS";
         // *INDENT-ON*
         case debug_menu::debug_menu_index::last:
             break;
@@ -631,15 +633,16 @@ static void edit_character_npctalk_vars( Character &you )
     uilist char_var_list;
     char_var_list.desc_enabled = true;
     char_var_list.title = string_format( _( "Edit npctalkvar variables (%s)" ), you.disp_name() );
-    std::unordered_map<std::string, std::string> &char_vars = you.get_values();
+    const var_store &char_vars = you.get_values();
     // some ordering shennanigans so that i == 0 is the option to add a new var
     int i = 1;
     std::vector<std::string> keymap_index = {_( "Add new npctalkvar (local)" )};
     char_var_list.addentry_desc( 0, true, input_event(), keymap_index[0], "" );
-    for( std::pair<const std::string, std::string> &some_local : char_vars ) {
-        keymap_index.emplace_back( some_local.first );
-        std::string description = string_format( _( "raw var value: %s" ), some_local.second );
-        if( std::optional<double> localvar_as_dbl = svtod( some_local.second ); localvar_as_dbl ) {
+    for( const std::pair<const var_key, var_value> &some_local : char_vars ) {
+        keymap_index.emplace_back( some_local.first.str() );
+        std::string description = string_format( _( "raw var value: %s" ),
+                                  some_local.second.str() );
+        if( std::optional<double> localvar_as_dbl = some_local.second.dbl(); localvar_as_dbl ) {
             description += "\n";
             description += string_format( _( "as time_duration: %s" ),
                                           to_string( time_duration::from_turns( *localvar_as_dbl ) ) );
@@ -647,7 +650,7 @@ static void edit_character_npctalk_vars( Character &you )
             description += string_format( _( "as time_point: %s" ),
                                           to_string( calendar::turn_zero + time_duration::from_turns( *localvar_as_dbl ) ) );
         }
-        char_var_list.addentry_desc( i, true, input_event(), some_local.first, description );
+        char_var_list.addentry_desc( i, true, input_event(), some_local.first.str(), description );
         i++;
     }
     char_var_list.query();
@@ -903,6 +906,7 @@ static int info_uilist( bool display_all_entries = true )
             { uilist_entry( debug_menu_index::GENERATE_EFFECT_LIST, true, 'L', _( "Generate effect list" ) ) },
             { uilist_entry( debug_menu_index::WRITE_CITY_LIST, true, 'C', _( "Write city list to cities.output" ) ) },
             { uilist_entry( debug_menu_index::IMGUI_DEMO, true, 'u', _( "Open ImGui demo screen" ) ) },
+            { uilist_entry( debug_menu_index::PROFILE_TURNS, true, 'P', _( "Turn profiler" ) ) },
         };
         uilist_initializer.insert( uilist_initializer.begin(), debug_only_options.begin(),
                                    debug_only_options.end() );
@@ -2681,8 +2685,9 @@ static void character_edit_menu()
                 testfile << "Character Name: " + you.get_name() << std::endl;
                 testfile << "|;key;value;" << std::endl;
 
-                for( const auto &value : you.get_values() ) {
-                    testfile << "|;" << value.first << ";" << value.second << ";" << std::endl;
+                for( const std::pair<const var_key, var_value> &value : you.get_values() ) {
+                    testfile << "|;" << value.first.str() << ";" << value.second.str() << ";" <<
+                             std::endl;
                 }
 
             }, "var_list" );
@@ -3803,6 +3808,34 @@ static void write_city_list()
     popup( string_format( _( "city list written to cities.output" ) ) );
 }
 
+static void turn_profiler_menu()
+{
+    uilist smenu;
+    smenu.text = _( "Times the subsystems of the turn loop over the last turns." );
+    smenu.addentry( 0, true, 'e', turn_profiler::is_enabled() ? _( "Disable profiling" ) :
+                    _( "Enable profiling" ) );
+    smenu.addentry( 1, turn_profiler::is_enabled(), 's', _( "Show rolling table" ) );
+    smenu.addentry( 2, turn_profiler::is_enabled(), 'w', _( "Write trace to turn_profile.json" ) );
+    smenu.query();
+    switch( smenu.ret ) {
+        case 0:
+            turn_profiler::set_enabled( !turn_profiler::is_enabled() );
+            break;
+        case 1:
+            popup( "%s", turn_profiler::summary_table() );
+            break;
+        case 2:
+            write_to_file( "turn_profile.json", []( std::ostream & fout ) {
+                turn_profiler::write_chrome_trace( fout );
+            }, "turn profile" );
+            popup( _( "Trace of %d turns written to turn_profile.json" ),
+                   turn_profiler::history().size() );
+            break;
+        default:
+            break;
+    }
+}
+
 static void write_global_vars()
 {
     write_to_file( "var_list.output", [&]( std::ostream & testfile ) {
@@ -3860,7 +3893,8 @@ void debug()
         debug_menu_index::QUICKLOAD,
         debug_menu_index::QUIT_NOSAVE,
         debug_menu_index::EXPORT_FOLLOWER,
-        debug_menu_index::EXPORT_SELF
+        debug_menu_index::EXPORT_SELF,
+        debug_menu_index::PROFILE_TURNS
     };
     const bool should_disable_achievements = action && !is_debug_character() &&
             !non_cheaty_options.count( *action );
@@ -4353,6 +4387,10 @@ void debug()
             run_imgui_demo();
             break;
 
+        case debug_menu_index::PROFILE_TURNS:
+            turn_profiler_menu();
+            break;
+
         case debug_menu_index::TALK_TOPIC:
             display_talk_topic();
             break;
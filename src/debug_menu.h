@@ -114,6 +114,7 @@ enum class debug_menu_index : int {
     WRITE_CITY_LIST,
     TALK_TOPIC,
     IMGUI_DEMO,
+    PROFILE_TURNS,
     last
 };
 
@@ -45,6 +45,51 @@ std::optional<std::string> maybe_read_var_value( const var_info &, const_dialogu
 template std::optional<std::string> maybe_read_var_value( const translation_var_info &,
         const_dialogue const &, int call_depth );
 
+const var_value *find_var_value( const var_info &info, const_dialogue const &d,
+                                 var_value &buffer, int call_depth )
+{
+    const auto buffered = [&buffer]( std::optional<std::string> &&val ) -> const var_value * {
+        if( !val )
+        {
+            return nullptr;
+        }
+        buffer = var_value( std::move( *val ) );
+        return &buffer;
+    };
+    const auto from_actor = [&]( const_talker const *actor ) -> const var_value * {
+        if( const var_store *vars = actor->get_vars() )
+        {
+            return vars->find( info.key );
+        }
+        return buffered( actor->maybe_get_value( info.name ) );
+    };
+    switch( info.type ) {
+        case var_type::global:
+            return get_globals().find_global_value( info.key );
+        case var_type::context:
+            return buffered( d.maybe_get_value( info.name ) );
+        case var_type::u:
+            return from_actor( d.const_actor( false ) );
+        case var_type::npc:
+            return from_actor( d.const_actor( true ) );
+        case var_type::var: {
+            std::optional<std::string> const var_val = d.maybe_get_value( info.name );
+            if( call_depth > 1000 && var_val ) {
+                debugmsg( "Possible infinite loop detected: var_val points to itself or forms a cycle.  %s->%s %s",
+                          info.name, var_val.value(), d.get_callstack() );
+                return nullptr;
+            }
+            return var_val ? find_var_value( process_variable( *var_val ), d, buffer,
+                                             call_depth + 1 ) : nullptr;
+        }
+        case var_type::faction:
+        case var_type::party:
+        case var_type::last:
+            return nullptr;
+    }
+    return nullptr;
+}
+
 template<>
 std::string read_var_value( const var_info &info, const_dialogue const &d )
 {
@@ -158,7 +203,12 @@ double dbl_or_var_part::evaluate( const_dialogue const &d ) const
         return dbl_val.value();
     }
     if( var_val.has_value() ) {
-        std::string val = read_var_value( var_val.value(), d );
+        var_value buffer;
+        const var_value *typed = find_var_value( var_val.value(), d, buffer );
+        if( typed != nullptr && typed->is_dbl() ) {
+            return *typed->dbl();
+        }
+        std::string val = typed != nullptr ? typed->str() : var_val->default_val;
         if( !val.empty() ) {
             return std::stof( val );
         }
@@ -192,7 +242,12 @@ time_duration duration_or_var_part::evaluate( const_dialogue const &d ) const
         return dur_val.value();
     }
     if( var_val.has_value() ) {
-        std::string val = read_var_value( var_val.value(), d );
+        var_value buffer;
+        const var_value *typed = find_var_value( var_val.value(), d, buffer );
+        if( typed != nullptr && typed->is_dbl() ) {
+            return time_duration::from_turns( *typed->dbl() );
+        }
+        std::string val = typed != nullptr ? typed->str() : var_val->default_val;
         if( !val.empty() ) {
             time_duration ret_val;
             ret_val = time_duration::from_turns( std::stof( val ) );
@@ -36,12 +36,14 @@ struct dbl_or_var;
 template<class T>
 struct abstract_var_info {
     abstract_var_info( var_type in_type, std::string in_name ): type( in_type ),
-        name( std::move( in_name ) ) {}
+        name( std::move( in_name ) ), key( name ) {}
     abstract_var_info( var_type in_type, std::string in_name, T in_default_val ): type( in_type ),
-        name( std::move( in_name ) ), default_val( std::move( in_default_val ) ) {}
+        name( std::move( in_name ) ), key( name ), default_val( std::move( in_default_val ) ) {}
     abstract_var_info() : type( var_type::global ) {}
     var_type type;
     std::string name;
+    // interned name, used to look up global and creature variables
+    var_key key;
     T default_val;
 };
 #pragma GCC diagnostic pop
@@ -98,6 +100,14 @@ template<class T>
 std::optional<std::string> maybe_read_var_value(
     const abstract_var_info<T> &info, const_dialogue const &d, int call_depth = 0 );
 
+/**
+ * Looks the variable up without converting its value to a string.  Values that aren't stored
+ * typed (dialogue context, items, furniture) are copied into @p buffer.
+ * Returns nullptr if the variable isn't set.
+ */
+const var_value *find_var_value( const var_info &info, const_dialogue const &d,
+                                 var_value &buffer, int call_depth = 0 );
+
 var_info process_variable( const std::string &type );
 
 struct eoc_math {
@@ -0,0 +1,146 @@
+#include "dialogue_vars.h"
+
+#include <deque>
+
+#include "cata_utility.h"
+#include "coordinates.h"
+#include "json.h"
+#include "string_formatter.h"
+
+namespace
+{
+
+struct var_key_table {
+    std::unordered_map<std::string, int> ids;
+    // A deque, so the references returned by var_key::str() stay valid
+    std::deque<std::string> names = { std::string() };
+};
+
+var_key_table &get_var_key_table()
+{
+    static var_key_table table;
+    return table;
+}
+
+} // namespace
+
+var_key::var_key( const std::string &name )
+{
+    if( name.empty() ) {
+        return;
+    }
+    var_key_table &table = get_var_key_table();
+    const auto [it, inserted] = table.ids.emplace( name, static_cast<int>( table.names.size() ) );
+    if( inserted ) {
+        table.names.push_back( name );
+    }
+    id_ = it->second;
+}
+
+const std::string &var_key::str() const
+{
+    return get_var_key_table().names[id_];
+}
+
+var_value::var_value( const tripoint_abs_ms &p ) : data( p.raw() ) {}
+
+bool var_value::empty() const
+{
+    const std::string *str = std::get_if<std::string>( &data );
+    return str != nullptr && str->empty();
+}
+
+const std::string &var_value::str() const
+{
+    if( const std::string *str = std::get_if<std::string>( &data ) ) {
+        return *str;
+    }
+    if( !str_cache ) {
+        if( const double *dbl = std::get_if<double>( &data ) ) {
+            // NOLINTNEXTLINE(cata-translate-string-literal)
+            str_cache = string_format( "%g", *dbl );
+        } else {
+            str_cache = std::get<tripoint>( data ).to_string();
+        }
+    }
+    return *str_cache;
+}
+
+std::string var_value::saved_str() const
+{
+    const double *dbl = std::get_if<double>( &data );
+    if( dbl == nullptr || svtod( str() ) == *dbl ) {
+        return str();
+    }
+    // NOLINTNEXTLINE(cata-translate-string-literal)
+    return string_format( "%.17g", *dbl );
+}
+
+std::optional<double> var_value::dbl() const
+{
+    if( const double *dbl = std::get_if<double>( &data ) ) {
+        return *dbl;
+    }
+    if( const std::string *str = std::get_if<std::string>( &data ) ) {
+        if( !dbl_cache ) {
+            dbl_cache = svtod( *str );
+        }
+        return *dbl_cache;
+    }
+    return std::nullopt;
+}
+
+tripoint_abs_ms var_value::tripoint_abs() const
+{
+    if( const tripoint *p = std::get_if<tripoint>( &data ) ) {
+        return tripoint_abs_ms( *p );
+    }
+    return tripoint_abs_ms( tripoint::from_string( str() ) );
+}
+
+void var_store::set( const var_key &key, var_value value )
+{
+    values.insert_or_assign( key, std::move( value ) );
+}
+
+void var_store::erase( const var_key &key )
+{
+    values.erase( key );
+}
+
+const var_value *var_store::find( const var_key &key ) const
+{
+    const auto it = values.find( key );
+    return it == values.end() ? nullptr : &it->second;
+}
+
+void var_store::clear()
+{
+    values.clear();
+}
+
+std::unordered_map<std::string, std::string> var_store::to_strings() const
+{
+    std::unordered_map<std::string, std::string> strings;
+    for( const std::pair<const var_key, var_value> &v : values ) {
+        strings.emplace( v.first.str(), v.second.saved_str() );
+    }
+    return strings;
+}
+
+void var_store::from_strings( const std::unordered_map<std::string, std::string> &strings )
+{
+    values.clear();
+    for( const std::pair<const std::string, std::string> &v : strings ) {
+        values.emplace( var_key( v.first ), var_value( v.second ) );
+    }
+}
+
+void var_store::serialize( JsonOut &jsout ) const
+{
+    jsout.start_object();
+    for( const std::pair<const var_key, var_value> &v : values ) {
+        jsout.member( v.first.str(), v.second.saved_str() );
+    }
+    jsout.end_object();
+}
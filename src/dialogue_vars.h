@@ -0,0 +1,136 @@
+#pragma once
+#ifndef CATA_SRC_DIALOGUE_VARS_H
+#define CATA_SRC_DIALOGUE_VARS_H
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+
+#include "coords_fwd.h"
+#include "point.h"
+
+class JsonOut;
+
+/**
+ * Interned name of a dialogue variable.
+ *
+ * Every distinct name gets a small integer the first time it is seen, so looking a variable up
+ * hashes an int instead of the whole name.  Names are never released, they are parsed from JSON
+ * or built from a bounded set of strings.
+ */
+class var_key
+{
+    public:
+        var_key() = default;
+        explicit var_key( const std::string &name );
+
+        const std::string &str() const;
+        int id() const {
+            return id_;
+        }
+        bool empty() const {
+            return id_ == 0;
+        }
+
+        friend bool operator==( const var_key &lhs, const var_key &rhs ) {
+            return lhs.id_ == rhs.id_;
+        }
+        friend bool operator!=( const var_key &lhs, const var_key &rhs ) {
+            return lhs.id_ != rhs.id_;
+        }
+
+    private:
+        // 0 is the empty name
+        int id_ = 0;
+};
+
+template<>
+struct std::hash<var_key> {
+    std::size_t operator()( const var_key &k ) const noexcept {
+        return std::hash<int>()( k.id() );
+    }
+};
+
+/**
+ * Value of a dialogue variable.
+ *
+ * The value is kept in the type it was written with.  Numbers and points are only formatted when
+ * read as a string, and strings are only parsed once when read as a number, so math expressions
+ * working on variables don't convert them on every evaluation.  The string form is the one saves
+ * have always used: numbers are formatted with "%g" and points with tripoint::to_string.
+ */
+class var_value
+{
+    public:
+        var_value() = default;
+        explicit var_value( std::string str ) : data( std::move( str ) ) {}
+        explicit var_value( double dbl ) : data( dbl ) {}
+        explicit var_value( const tripoint_abs_ms &p );
+
+        bool is_str() const {
+            return std::holds_alternative<std::string>( data );
+        }
+        bool is_dbl() const {
+            return std::holds_alternative<double>( data );
+        }
+        bool is_tripoint() const {
+            return std::holds_alternative<tripoint>( data );
+        }
+        /** True for the empty string. */
+        bool empty() const;
+
+        const std::string &str() const;
+        /**
+         * The string the value is saved as.  Same as str(), except for numbers that "%g" doesn't
+         * read back exactly, which are written with all their digits.
+         */
+        std::string saved_str() const;
+        /** Returns nullopt for strings that aren't numbers. */
+        std::optional<double> dbl() const;
+        /** Strings are parsed with tripoint::from_string. */
+        tripoint_abs_ms tripoint_abs() const;
+
+    private:
+        std::variant<std::string, double, tripoint> data;
+        // str() of numbers and points
+        mutable std::optional<std::string> str_cache;
+        // dbl() of strings
+        mutable std::optional<std::optional<double>> dbl_cache;
+};
+
+/** The variables of a creature or of the global scope. */
+class var_store
+{
+    public:
+        using container = std::unordered_map<var_key, var_value>;
+
+        void set( const var_key &key, var_value value );
+        void erase( const var_key &key );
+        /** Returns nullptr if there is no variable called @p key. */
+        const var_value *find( const var_key &key ) const;
+        void clear();
+        bool empty() const {
+            return values.empty();
+        }
+
+        container::const_iterator begin() const {
+            return values.begin();
+        }
+        container::const_iterator end() const {
+            return values.end();
+        }
+
+        /** The values as strings, keyed by name, the way they are saved. */
+        std::unordered_map<std::string, std::string> to_strings() const;
+        void from_strings( const std::unordered_map<std::string, std::string> &strings );
+        void serialize( JsonOut &jsout ) const;
+
+    private:
+        container values;
+};
+
+#endif // CATA_SRC_DIALOGUE_VARS_H
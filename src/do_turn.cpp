@@ -50,6 +50,7 @@
 #include "mtype.h"
 #include "music.h"
 #include "npc.h"
+#include "npc_travel_schedule.h"
 #include "options.h"
 #include "output.h"
 #include "overmapbuffer.h"
@@ -65,6 +66,7 @@
 #include "string_formatter.h"
 #include "timed_event.h"
 #include "translations.h"
+#include "turn_profiler.h"
 #include "type_id.h"
 #include "ui.h"
 #include "ui_manager.h"
@@ -88,6 +90,11 @@ static const efftype_id effect_sleep( "sleep" );
 
 static const event_statistic_id event_statistic_last_words( "last_words" );
 
+static const option_handle<bool> option_AUTOSAVE( "AUTOSAVE" );
+static const option_handle<int> option_AUTOSAVE_TURNS( "AUTOSAVE_TURNS" );
+static const option_handle<bool> option_FORCE_REDRAW( "FORCE_REDRAW" );
+static const option_handle<bool> option_WANDER_SPAWNS( "WANDER_SPAWNS" );
+
 static const trait_id trait_HAS_NEMESIS( "HAS_NEMESIS" );
 
 #if defined(__ANDROID__)
@@ -265,75 +272,82 @@ namespace
 {
 void monmove()
 {
+    PROFILE_ZONE( "monmove" );
     g->cleanup_dead();
     map &m = get_map();
     avatar &u = get_avatar();
 
-    for( monster &critter : g->all_monsters() ) {
-        // Critters in impassable tiles get pushed away, unless it's not impassable for them
-        if( !critter.is_dead() && ( m.impassable( critter.pos_bub() ) &&
-                                    !m.get_impassable_field_at( critter.pos_bub() ).has_value() ) &&
-            !critter.can_move_to( critter.pos_bub() ) ) {
-            dbg( D_ERROR ) << "game:monmove: " << critter.name()
-                           << " can't move to its location!  (" << critter.posx()
-                           << ":" << critter.posy() << ":" << critter.posz() << "), "
-                           << m.tername( critter.pos_bub() );
-            add_msg_debug( debugmode::DF_MONSTER, "%s can't move to its location!  (%d,%d,%d), %s",
-                           critter.name(),
-                           critter.posx(), critter.posy(), critter.posz(), m.tername( critter.pos_bub() ) );
-            bool okay = false;
-            for( const tripoint_bub_ms &dest : m.points_in_radius( critter.pos_bub(), 3 ) ) {
-                if( critter.can_move_to( dest ) && g->is_empty( dest ) ) {
-                    critter.setpos( dest );
-                    okay = true;
-                    break;
+    {
+        PROFILE_ZONE( "monsters" );
+        for( monster &critter : g->all_monsters() ) {
+            // Critters in impassable tiles get pushed away, unless it's not impassable for them
+            if( !critter.is_dead() && ( m.impassable( critter.pos_bub() ) &&
+                                        !m.get_impassable_field_at(
+                                            critter.pos_bub() ).has_value() ) &&
+                !critter.can_move_to( critter.pos_bub() ) ) {
+                dbg( D_ERROR ) << "game:monmove: " << critter.name()
+                               << " can't move to its location!  (" << critter.posx()
+                               << ":" << critter.posy() << ":" << critter.posz() << "), "
+                               << m.tername( critter.pos_bub() );
+                add_msg_debug( debugmode::DF_MONSTER,
+                               "%s can't move to its location!  (%d,%d,%d), %s",
+                               critter.name(), critter.posx(), critter.posy(), critter.posz(),
+                               m.tername( critter.pos_bub() ) );
+                bool okay = false;
+                for( const tripoint_bub_ms &dest : m.points_in_radius( critter.pos_bub(), 3 ) ) {
+                    if( critter.can_move_to( dest ) && g->is_empty( dest ) ) {
+                        critter.setpos( dest );
+                        okay = true;
+                        break;
+                    }
+                }
+                if( !okay ) {
+                    // die of "natural" cause (overpopulation is natural)
+                    critter.die( nullptr );
                 }
             }
-            if( !okay ) {
-                // die of "natural" cause (overpopulation is natural)
-                critter.die( nullptr );
-            }
-        }
 
-        if( !critter.is_dead() ) {
-            critter.process_turn();
-        }
+            if( !critter.is_dead() ) {
+                critter.process_turn();
+            }
 
-        m.creature_in_field( critter );
-        if( calendar::once_every( 1_days ) ) {
-            if( critter.has_flag( mon_flag_MILKABLE ) ) {
-                critter.refill_udders();
+            m.creature_in_field( critter );
+            if( calendar::once_every( 1_days ) ) {
+                if( critter.has_flag( mon_flag_MILKABLE ) ) {
+                    critter.refill_udders();
+                }
+                critter.try_biosignature();
+                critter.try_reproduce();
+                critter.digest_food();
             }
-            critter.try_biosignature();
-            critter.try_reproduce();
-            critter.digest_food();
-        }
-        while( critter.get_moves() > 0 && !critter.is_dead() && !critter.has_effect( effect_ridden ) ) {
-            critter.made_footstep = false;
-            // Controlled critters don't make their own plans
-            if( !critter.has_effect( effect_controlled ) ) {
-                // Formulate a path to follow
-                critter.plan();
-            } else {
-                critter.set_moves( 0 );
-                break;
+            while( critter.get_moves() > 0 && !critter.is_dead() &&
+                   !critter.has_effect( effect_ridden ) ) {
+                critter.made_footstep = false;
+                // Controlled critters don't make their own plans
+                if( !critter.has_effect( effect_controlled ) ) {
+                    // Formulate a path to follow
+                    critter.plan();
+                } else {
+                    critter.set_moves( 0 );
+                    break;
+                }
+                critter.move(); // Move one square, possibly hit u
+                critter.process_triggers();
+                m.creature_in_field( critter );
             }
-            critter.move(); // Move one square, possibly hit u
-            critter.process_triggers();
-            m.creature_in_field( critter );
-        }
 
-        if( !critter.is_dead() &&
-            u.has_active_bionic( bio_alarm ) &&
-            u.get_power_level() >= bio_alarm->power_trigger &&
-            rl_dist( u.pos_bub(), critter.pos_bub() ) <= 5 &&
-            !critter.is_hallucination() ) {
-            u.mod_power_level( -bio_alarm->power_trigger );
-            add_msg( m_warning, _( "Your motion alarm goes off!" ) );
-            g->cancel_activity_or_ignore_query( distraction_type::motion_alarm,
-                                                _( "Your motion alarm goes off!" ) );
-            if( u.has_effect( effect_sleep ) ) {
-                u.wake_up();
+            if( !critter.is_dead() &&
+                u.has_active_bionic( bio_alarm ) &&
+                u.get_power_level() >= bio_alarm->power_trigger &&
+                rl_dist( u.pos_bub(), critter.pos_bub() ) <= 5 &&
+                !critter.is_hallucination() ) {
+                u.mod_power_level( -bio_alarm->power_trigger );
+                add_msg( m_warning, _( "Your motion alarm goes off!" ) );
+                g->cancel_activity_or_ignore_query( distraction_type::motion_alarm,
+                                                    _( "Your motion alarm goes off!" ) );
+                if( u.has_effect( effect_sleep ) ) {
+                    u.wake_up();
+                }
             }
         }
     }
@@ -345,48 +359,53 @@ void monmove()
     // monster::die function is not called.
     g->despawn_nonlocal_monsters();
 
-    // Now, do active NPCs.
-    for( npc &guy : g->all_npcs() ) {
-        int turns = 0;
-        int real_count = 0;
-        const int count_limit = std::max( 10, guy.get_moves() / 64 );
-        if( guy.is_mounted() ) {
-            guy.check_mount_is_spooked();
-        }
-        m.creature_in_field( guy );
-        if( !guy.has_effect( effect_npc_suspend ) ) {
-            guy.process_turn();
-        }
-        while( !guy.is_dead() && ( !guy.in_sleep_state() || guy.activity.id() == ACT_OPERATION ) &&
-               guy.get_moves() > 0 && turns < 10 ) {
-            const int moves = guy.get_moves();
-            const bool has_destination = guy.has_destination_activity();
-            guy.move();
-            if( moves == guy.get_moves() ) {
-                // Count every time we exit npc::move() without spending any moves.
-                real_count++;
-                if( has_destination == guy.has_destination_activity() || real_count > count_limit ) {
-                    turns++;
-                }
+    {
+        PROFILE_ZONE( "npcs" );
+        // Now, do active NPCs.
+        for( npc &guy : g->all_npcs() ) {
+            int turns = 0;
+            int real_count = 0;
+            const int count_limit = std::max( 10, guy.get_moves() / 64 );
+            if( guy.is_mounted() ) {
+                guy.check_mount_is_spooked();
             }
-            // Turn on debug mode when in infinite loop
-            // It has to be done before the last turn, otherwise
-            // there will be no meaningful debug output.
-            if( turns == 9 ) {
-                debugmsg( "NPC '%s' entered infinite loop, npc activity id: '%s'",
-                          guy.get_name(), guy.activity.id().str() );
+            m.creature_in_field( guy );
+            if( !guy.has_effect( effect_npc_suspend ) ) {
+                guy.process_turn();
+            }
+            while( !guy.is_dead() &&
+                   ( !guy.in_sleep_state() || guy.activity.id() == ACT_OPERATION ) &&
+                   guy.get_moves() > 0 && turns < 10 ) {
+                const int moves = guy.get_moves();
+                const bool has_destination = guy.has_destination_activity();
+                guy.move();
+                if( moves == guy.get_moves() ) {
+                    // Count every time we exit npc::move() without spending any moves.
+                    real_count++;
+                    if( has_destination == guy.has_destination_activity() ||
+                        real_count > count_limit ) {
+                        turns++;
+                    }
+                }
+                // Turn on debug mode when in infinite loop
+                // It has to be done before the last turn, otherwise
+                // there will be no meaningful debug output.
+                if( turns == 9 ) {
+                    debugmsg( "NPC '%s' entered infinite loop, npc activity id: '%s'",
+                              guy.get_name(), guy.activity.id().str() );
+                }
             }
-        }
 
-        // If we spun too long trying to decide what to do (without spending moves),
-        // Invoke cognitive suspension to prevent an infinite loop.
-        if( turns == 10 ) {
-            add_msg( _( "%s faints!" ), guy.get_name() );
-            guy.reboot();
-        }
+            // If we spun too long trying to decide what to do (without spending moves),
+            // Invoke cognitive suspension to prevent an infinite loop.
+            if( turns == 10 ) {
+                add_msg( _( "%s faints!" ), guy.get_name() );
+                guy.reboot();
+            }
 
-        if( !guy.is_dead() ) {
-            guy.npc_update_body();
+            if( !guy.is_dead() ) {
+                guy.npc_update_body();
+            }
         }
     }
     g->cleanup_dead();
@@ -394,47 +413,8 @@ void monmove()
 
 void overmap_npc_move()
 {
-    avatar &u = get_avatar();
-    std::vector<npc *> travelling_npcs;
     static constexpr int move_search_radius = 600;
-    for( auto &elem : overmap_buffer.get_npcs_near_player( move_search_radius ) ) {
-        if( !elem ) {
-            continue;
-        }
-        npc *npc_to_add = elem.get();
-        if( ( !npc_to_add->is_active() || rl_dist( u.pos_bub(), npc_to_add->pos_bub() ) > SEEX * 2 ) &&
-            npc_to_add->mission == NPC_MISSION_TRAVELLING ) {
-            travelling_npcs.push_back( npc_to_add );
-        }
-    }
-    bool npcs_need_reload = false;
-    for( npc *&elem : travelling_npcs ) {
-        if( elem->has_omt_destination() ) {
-            if( !elem->omt_path.empty() ) {
-                if( rl_dist( elem->omt_path.back(), elem->global_omt_location() ) > 2 ) {
-                    // recalculate path, we got distracted doing something else probably
-                    elem->omt_path.clear();
-                } else if( elem->omt_path.back() == elem->global_omt_location() ) {
-                    elem->omt_path.pop_back();
-                }
-            }
-            if( elem->omt_path.empty() ) {
-                elem->omt_path = overmap_buffer.get_travel_path( elem->global_omt_location(), elem->goal,
-                                 overmap_path_params::for_npc() ).points;
-                if( elem->omt_path.empty() ) { // goal is unreachable, or already reached goal, reset it
-                    elem->goal = npc::no_goal_point;
-                }
-            } else {
-                elem->travel_overmap( elem->omt_path.back() );
-                npcs_need_reload = true;
-            }
-        }
-        if( !elem->has_omt_destination() && calendar::once_every( 1_hours ) && one_in( 3 ) ) {
-            // travelling destination is reached/not set, try different one
-            elem->set_omt_destination();
-        }
-    }
-    if( npcs_need_reload ) {
+    if( g->npc_travel_schedule_ptr->update( get_avatar().get_location(), move_search_radius ) ) {
         g->reload_npcs();
     }
 }
@@ -465,6 +445,7 @@ bool do_turn()
         g->gamemode->per_turn();
         calendar::turn += 1_turns;
     }
+    PROFILE_TURN( to_turn<int>( calendar::turn ) );
 
     play_music( music::get_music_id_string() );
 
@@ -475,9 +456,14 @@ bool do_turn()
         g->load_npcs();
     }
 
-    timed_event_manager &timed_events = get_timed_events();
-    timed_events.process();
-    mission::process_all();
+    {
+        PROFILE_ZONE( "timed_events" );
+        get_timed_events().process();
+    }
+    {
+        PROFILE_ZONE( "missions" );
+        mission::process_all();
+    }
     avatar &u = get_avatar();
     map &m = get_map();
     // If controlling a vehicle that is owned by someone else
@@ -499,13 +485,15 @@ bool do_turn()
         u.check_mount_is_spooked();
     }
     if( calendar::once_every( 1_days ) ) {
+        PROFILE_ZONE( "process_mongroups" );
         overmap_buffer.process_mongroups();
     }
 
     // Move hordes every 2.5 min
     if( calendar::once_every( time_duration::from_minutes( 2.5 ) ) ) {
+        PROFILE_ZONE( "move_hordes" );
 
-        if( get_option<bool>( "WANDER_SPAWNS" ) ) {
+        if( option_WANDER_SPAWNS.get() ) {
             overmap_buffer.move_hordes();
         }
         if( u.has_trait( trait_HAS_NEMESIS ) ) {
@@ -521,18 +509,25 @@ bool do_turn()
     u.update_body();
 
     // Auto-save if autosave is enabled
-    if( get_option<bool>( "AUTOSAVE" ) &&
-        calendar::once_every( 1_turns * get_option<int>( "AUTOSAVE_TURNS" ) ) &&
+    if( option_AUTOSAVE.get() &&
+        calendar::once_every( 1_turns * option_AUTOSAVE_TURNS.get() ) &&
         !u.is_dead_state() ) {
+        PROFILE_ZONE( "autosave" );
         g->autosave();
     }
 
-    weather.update_weather();
-    g->reset_light_level();
+    {
+        PROFILE_ZONE( "update_weather" );
+        weather.update_weather();
+        g->reset_light_level();
+    }
 
     g->perhaps_add_random_npc( /* ignore_spawn_timers_and_rates = */ false );
-    while( u.get_moves() > 0 && u.activity ) {
-        u.activity.do_turn( u );
+    {
+        PROFILE_ZONE( "player_activity" );
+        while( u.get_moves() > 0 && u.activity ) {
+            u.activity.do_turn( u );
+        }
     }
 
     // Process NPC sound events before they move or they hear themselves talking
@@ -553,6 +548,8 @@ bool do_turn()
 
     if( !u.has_effect( effect_sleep ) || g->uquit == QUIT_WATCH ) {
         if( u.get_moves() > 0 || g->uquit == QUIT_WATCH ) {
+            // includes the time spent waiting for input
+            PROFILE_ZONE( "player_actions" );
             while( u.get_moves() > 0 || g->uquit == QUIT_WATCH ) {
                 m.process_falling();
                 g->cleanup_dead();
@@ -631,34 +628,63 @@ bool do_turn()
     }
 
     scent_map &scent = get_scent();
-    // No-scent debug mutation has to be processed here or else it takes time to start working
-    if( !u.has_flag( STATIC( json_character_flag( "NO_SCENT" ) ) ) ) {
-        scent.set( u.pos_bub(), u.scent, u.get_type_of_scent() );
-        overmap_buffer.set_scent( u.global_omt_location(),  u.scent );
+    {
+        PROFILE_ZONE( "scent" );
+        // No-scent debug mutation has to be processed here or else it takes time to start working
+        if( !u.has_flag( STATIC( json_character_flag( "NO_SCENT" ) ) ) ) {
+            scent.set( u.pos_bub(), u.scent, u.get_type_of_scent() );
+            overmap_buffer.set_scent( u.global_omt_location(),  u.scent );
+        }
+        scent.update( u.pos_bub(), m );
     }
-    scent.update( u.pos_bub(), m );
 
-    // We need floor cache before checking falling 'n stuff
-    m.build_floor_caches();
+    {
+        PROFILE_ZONE( "build_floor_caches" );
+        // We need floor cache before checking falling 'n stuff
+        m.build_floor_caches();
+    }
 
-    m.process_falling();
-    m.vehmove();
-    m.process_fields();
-    m.process_items();
-    explosion_handler::process_explosions();
+    {
+        PROFILE_ZONE( "process_falling" );
+        m.process_falling();
+    }
+    {
+        PROFILE_ZONE( "vehmove" );
+        m.vehmove();
+    }
+    {
+        PROFILE_ZONE( "process_fields" );
+        m.process_fields();
+    }
+    {
+        PROFILE_ZONE( "process_items" );
+        m.process_items();
+    }
+    {
+        PROFILE_ZONE( "process_explosions" );
+        explosion_handler::process_explosions();
+    }
     m.creature_in_field( u );
 
-    // Apply sounds from previous turn to monster and NPC AI.
-    sounds::process_sounds();
+    {
+        PROFILE_ZONE( "process_sounds" );
+        // Apply sounds from previous turn to monster and NPC AI.
+        sounds::process_sounds();
+    }
     const int levz = m.get_abs_sub().z();
-    // Update vision caches for monsters. If this turns out to be expensive,
-    // consider a stripped down cache just for monsters.
-    m.build_map_cache( levz, true );
+    {
+        PROFILE_ZONE( "build_map_cache" );
+        // Update vision caches for monsters. If this turns out to be expensive,
+        // consider a stripped down cache just for monsters.
+        m.build_map_cache( levz, true );
+    }
     monmove();
     if( calendar::once_every( time_between_npc_OM_moves ) ) {
+        PROFILE_ZONE( "overmap_npc_move" );
         overmap_npc_move();
     }
     if( calendar::once_every( 10_seconds ) ) {
+        PROFILE_ZONE( "emissions" );
         for( const tripoint_bub_ms &elem : m.get_furn_field_locations() ) {
             const furn_t &furn = *m.furn( elem );
             for( const emit_id &e : furn.emissions ) {
@@ -673,13 +699,17 @@ bool do_turn()
         }
     }
     g->mon_info_update();
-    u.process_turn();
-    if( u.get_moves() < 0 && get_option<bool>( "FORCE_REDRAW" ) ) {
+    {
+        PROFILE_ZONE( "player_process_turn" );
+        u.process_turn();
+    }
+    if( u.get_moves() < 0 && option_FORCE_REDRAW.get() ) {
         ui_manager::redraw();
         refresh_display();
     }
 
     if( levz >= 0 && !u.is_underwater() ) {
+        PROFILE_ZONE( "weather_effects" );
         handle_weather_effects( weather.weather_id );
     }
 
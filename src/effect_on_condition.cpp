@@ -2,10 +2,13 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <list>
+#include <optional>
 #include <ostream>
-#include <queue>
 #include <set>
+#include <utility>
+#include <vector>
 
 #include "avatar.h"
 #include "calendar.h"
@@ -74,6 +77,52 @@ void effect_on_conditions::check_consistency()
 {
 }
 
+// The changes that can flip the result of a condition, all of them if it can't be told
+static enum_bitset<eoc_reactivation> changes_affecting( const JsonValue &jv )
+{
+    enum_bitset<eoc_reactivation> any;
+    any.set();
+    if( !jv.test_object() ) {
+        return any;
+    }
+    const auto is_name_list = []( const JsonValue & names ) {
+        if( names.test_string() ) {
+            return true;
+        }
+        if( !names.test_array() ) {
+            return false;
+        }
+        for( const JsonValue &name : names.get_array() ) {
+            if( !name.test_string() ) {
+                return false;
+            }
+        }
+        return true;
+    };
+    enum_bitset<eoc_reactivation> ret;
+    JsonObject jo = jv.get_object();
+    jo.allow_omitted_members();
+    for( const JsonMember &jm : jo ) {
+        const std::string &name = jm.name();
+        if( name == "not" ) {
+            ret |= changes_affecting( jm );
+        } else if( ( name == "and" || name == "or" ) && jm.test_array() ) {
+            for( const JsonValue &cond : jm.get_array() ) {
+                ret |= changes_affecting( cond );
+            }
+        } else if( ( name == "u_has_trait" || name == "u_has_any_trait" ) && is_name_list( jm ) ) {
+            ret.set( eoc_reactivation::traits );
+        } else if( name == "u_has_bionics" && jm.test_string() ) {
+            ret.set( eoc_reactivation::bionics );
+        } else if( name == "is_weather" && jm.test_string() ) {
+            ret.set( eoc_reactivation::weather );
+        } else {
+            return any;
+        }
+    }
+    return ret;
+}
+
 void effect_on_condition::load( const JsonObject &jo, const std::string_view src )
 {
     mandatory( jo, was_loaded, "id", id );
@@ -92,6 +141,7 @@ void effect_on_condition::load( const JsonObject &jo, const std::string_view src
     if( jo.has_member( "deactivate_condition" ) ) {
         read_condition( jo, "deactivate_condition", deactivate_condition, false );
         has_deactivate_condition = true;
+        reactivated_by = changes_affecting( jo.get_member( "deactivate_condition" ) );
     }
     if( jo.has_member( "condition" ) ) {
         read_condition( jo, "condition", condition, false );
@@ -131,6 +181,175 @@ effect_on_condition_id effect_on_conditions::load_inline_eoc( const JsonValue &j
     }
 }
 
+queued_eocs::queued_eocs( const queued_eocs &rhs )
+{
+    *this = rhs;
+}
+
+queued_eocs &queued_eocs::operator=( const queued_eocs &rhs )
+{
+    if( this == &rhs ) {
+        return *this;
+    }
+    clear();
+    for( const queued_eoc *eoc : rhs.sorted() ) {
+        push( *eoc );
+    }
+    return *this;
+}
+
+void queued_eocs::push( const queued_eoc &eoc )
+{
+    storage_iter it = list.emplace( list.end(), eoc );
+    if( list.size() == 1 ) {
+        cursor = std::min( to_turn<int64_t>( eoc.time ), to_turn<int64_t>( calendar::turn ) );
+    }
+    insert( entry{ it, next_seq++ } );
+}
+
+void queued_eocs::clear()
+{
+    list.clear();
+    for( std::vector<entry> &slot : wheel ) {
+        slot.clear();
+    }
+    overflow.clear();
+}
+
+std::vector<const queued_eoc *> queued_eocs::sorted() const
+{
+    // the list is kept in the order of queuing
+    std::vector<const queued_eoc *> ret;
+    ret.reserve( list.size() );
+    for( const queued_eoc &eoc : list ) {
+        ret.push_back( &eoc );
+    }
+    std::stable_sort( ret.begin(), ret.end(),
+    []( const queued_eoc * lhs, const queued_eoc * rhs ) {
+        return lhs->time < rhs->time;
+    } );
+    return ret;
+}
+
+void queued_eocs::insert( const entry &e )
+{
+    // Anything already due goes into the slot taken next
+    const int64_t turn = std::max( to_turn<int64_t>( e.it->time ), cursor );
+    const uint64_t diff = static_cast<uint64_t>( turn ^ cursor );
+    for( int level = 0; level < levels; ++level ) {
+        const int shift = slot_bits * level;
+        if( diff >> ( shift + slot_bits ) == 0 ) {
+            wheel[level * slots + ( ( turn >> shift ) & ( slots - 1 ) )].push_back( e );
+            return;
+        }
+    }
+    overflow.push_back( e );
+}
+
+std::optional<int64_t> queued_eocs::next_occupied() const
+{
+    for( int level = 0; level < levels; ++level ) {
+        const int shift = slot_bits * level;
+        const int64_t block_start = cursor & ~( ( slots << shift ) - 1 );
+        for( int64_t i = ( ( cursor >> shift ) & ( slots - 1 ) ) + 1; i < slots; ++i ) {
+            if( !wheel[level * slots + i].empty() ) {
+                return block_start + ( i << shift );
+            }
+        }
+    }
+    std::optional<int64_t> ret;
+    for( const entry &e : overflow ) {
+        const int64_t turn = to_turn<int64_t>( e.it->time );
+        ret = ret ? std::min( *ret, turn ) : turn;
+    }
+    return ret;
+}
+
+void queued_eocs::move_cursor( int64_t to )
+{
+    const int64_t from = cursor;
+    cursor = to;
+    const auto reinsert = [this]( std::vector<entry> &entries ) {
+        std::vector<entry> moved;
+        moved.swap( entries );
+        for( const entry &e : moved ) {
+            insert( e );
+        }
+    };
+    if( from >> ( slot_bits * levels ) != to >> ( slot_bits * levels ) ) {
+        reinsert( overflow );
+    }
+    // From the top, so what comes down from one level is split up further by the next
+    for( int level = levels - 1; level > 0; --level ) {
+        const int shift = slot_bits * level;
+        if( from >> shift != to >> shift ) {
+            reinsert( wheel[level * slots + ( ( to >> shift ) & ( slots - 1 ) )] );
+        }
+    }
+}
+
+void queued_eocs::rebuild( int64_t to )
+{
+    std::vector<entry> entries;
+    for( std::vector<entry> &slot : wheel ) {
+        entries.insert( entries.end(), slot.begin(), slot.end() );
+        slot.clear();
+    }
+    entries.insert( entries.end(), overflow.begin(), overflow.end() );
+    overflow.clear();
+    std::sort( entries.begin(), entries.end(), []( const entry & lhs, const entry & rhs ) {
+        return lhs.seq < rhs.seq;
+    } );
+    cursor = to;
+    for( const entry &e : entries ) {
+        insert( e );
+    }
+}
+
+bool queued_eocs::take_due( const time_point &now, std::vector<storage_iter> &due )
+{
+    due.clear();
+    const int64_t now_turn = to_turn<int64_t>( now );
+    if( now_turn < cursor ) {
+        // Only happens when the time is set back from the debug menu
+        rebuild( now_turn );
+    }
+    while( true ) {
+        std::vector<entry> &slot = wheel[cursor & ( slots - 1 )];
+        if( !slot.empty() ) {
+            std::sort( slot.begin(), slot.end(), []( const entry & lhs, const entry & rhs ) {
+                return std::make_pair( lhs.it->time, lhs.seq ) <
+                       std::make_pair( rhs.it->time, rhs.seq );
+            } );
+            for( const entry &e : slot ) {
+                due.push_back( e.it );
+            }
+            slot.clear();
+            return true;
+        }
+        const std::optional<int64_t> next = next_occupied();
+        if( !next || *next > now_turn ) {
+            // Nothing is due, catch up with the clock so new EOCs go to the right levels
+            if( cursor < now_turn ) {
+                move_cursor( now_turn );
+            }
+            return false;
+        }
+        move_cursor( *next );
+    }
+}
+
+void queued_eocs::reschedule( storage_iter it )
+{
+    list.splice( list.end(), list, it );
+    insert( entry{ it, next_seq++ } );
+}
+
+void queued_eocs::erase( storage_iter it )
+{
+    list.erase( it );
+}
+
 static time_duration next_recurrence( const effect_on_condition_id &eoc, dialogue &d )
 {
     return eoc->recurrence.evaluate( d );
@@ -166,15 +385,14 @@ static void process_new_eocs( queued_eocs &eoc_queue,
                               std::map<effect_on_condition_id, bool> &new_eocs, bool global_queue )
 {
     queued_eocs temp_queued_eocs;
-    while( !eoc_queue.empty() ) {
+    for( const queued_eoc *eoc : eoc_queue.sorted() ) {
         // Check if EoC is moved from global to local, or vice versa
-        if( global_queue == eoc_queue.top().eoc->global ) {
-            if( eoc_queue.top().eoc.is_valid() ) {
-                temp_queued_eocs.push( eoc_queue.top() );
+        if( global_queue == eoc->eoc->global ) {
+            if( eoc->eoc.is_valid() ) {
+                temp_queued_eocs.push( *eoc );
             }
-            new_eocs[eoc_queue.top().eoc] = false;
+            new_eocs[eoc->eoc] = false;
         }
-        eoc_queue.pop();
     }
     eoc_queue = std::move( temp_queued_eocs );
     for( auto eoc = eoc_vector.begin();
@@ -233,38 +451,37 @@ static void process_eocs( queued_eocs &eoc_queue, std::vector<effect_on_conditio
 {
     static std::vector<queued_eocs::storage_iter> eocs_to_queue;
     eocs_to_queue.clear();
-
-    while( !eoc_queue.empty() &&
-           eoc_queue.top().time <= calendar::turn ) {
-        queued_eocs::storage_iter it = eoc_queue.queue.top();
-        queued_eoc &top = *it;
-        eoc_queue.queue.pop();
-
-        dialogue nested_d{ d };
-        for( const auto &val : top.context ) {
-            nested_d.set_value( val.first, val.second );
-        }
-        bool activated = top.eoc->activate( nested_d );
-        if( top.eoc->type == eoc_type::RECURRING ) {
-            if( activated ) { // It worked so add it back
-                it->time = calendar::turn + next_recurrence( top.eoc, d );
-                eocs_to_queue.emplace_back( it );
-            } else {
-                if( !top.eoc->check_deactivate(
-                        nested_d ) ) { // It failed but shouldn't be deactivated so add it back
+    std::vector<queued_eocs::storage_iter> due;
+
+    while( eoc_queue.take_due( calendar::turn, due ) ) {
+        for( const queued_eocs::storage_iter &it : due ) {
+            queued_eoc &top = *it;
+            dialogue nested_d{ d };
+            for( const auto &val : top.context ) {
+                nested_d.set_value( val.first, val.second );
+            }
+            bool activated = top.eoc->activate( nested_d );
+            if( top.eoc->type == eoc_type::RECURRING ) {
+                if( activated ) { // It worked so add it back
                     it->time = calendar::turn + next_recurrence( top.eoc, d );
                     eocs_to_queue.emplace_back( it );
-                } else { // It failed and should be deactivated for now
-                    eoc_vector.push_back( top.eoc );
-                    eoc_queue.list.erase( it );
+                } else {
+                    if( !top.eoc->check_deactivate(
+                            nested_d ) ) { // It failed but shouldn't be deactivated so add it back
+                        it->time = calendar::turn + next_recurrence( top.eoc, d );
+                        eocs_to_queue.emplace_back( it );
+                    } else { // It failed and should be deactivated for now
+                        eoc_vector.push_back( top.eoc );
+                        eoc_queue.erase( it );
+                    }
                 }
+            } else {
+                eoc_queue.erase( it );
             }
-        } else {
-            eoc_queue.list.erase( it );
         }
     }
-    for( queued_eocs::storage_iter &q_eoc : eocs_to_queue ) {
-        eoc_queue.queue.emplace( q_eoc );
+    for( const queued_eocs::storage_iter &q_eoc : eocs_to_queue ) {
+        eoc_queue.reschedule( q_eoc );
     }
 }
 
@@ -281,11 +498,13 @@ void effect_on_conditions::process_effect_on_conditions( Character &you )
 
 static void process_reactivation( std::vector<effect_on_condition_id>
                                   &inactive_effect_on_condition_vector,
-                                  queued_eocs &queued_effect_on_conditions, dialogue &d )
+                                  queued_eocs &queued_effect_on_conditions, dialogue &d,
+                                  std::optional<eoc_reactivation> cause )
 {
     std::vector<effect_on_condition_id> ids_to_reactivate;
     for( const effect_on_condition_id &eoc : inactive_effect_on_condition_vector ) {
-        if( !eoc->check_deactivate( d ) ) {
+        // Conditions the change can't affect stay true, so they aren't checked
+        if( ( !cause || eoc->reactivated_by[*cause] ) && !eoc->check_deactivate( d ) ) {
             ids_to_reactivate.push_back( eoc );
         }
     }
@@ -297,17 +516,19 @@ static void process_reactivation( std::vector<effect_on_condition_id>
     }
 }
 
-void effect_on_conditions::process_reactivate( Character &you )
+void effect_on_conditions::process_reactivate( Character &you, eoc_reactivation cause )
 {
     dialogue d( get_talker_for( you ), nullptr );
-    process_reactivation( you.inactive_effect_on_condition_vector, you.queued_effect_on_conditions, d );
+    process_reactivation( you.inactive_effect_on_condition_vector,
+                          you.queued_effect_on_conditions, d, cause );
 }
 
 void effect_on_conditions::process_reactivate()
 {
     dialogue d( get_talker_for( get_avatar() ), nullptr );
+    // Weather changes are the only time global EOCs are reactivated, so they are all checked
     process_reactivation( g->inactive_global_effect_on_condition_vector,
-                          g->queued_global_effect_on_conditions, d );
+                          g->queued_global_effect_on_conditions, d, std::nullopt );
 }
 
 bool effect_on_condition::activate( dialogue &d, bool require_callstack_check ) const
@@ -365,13 +586,9 @@ void effect_on_condition::apply_true_effects( dialogue &d )  const
 
 void effect_on_conditions::clear( Character &you )
 {
-    while( !you.queued_effect_on_conditions.empty() ) {
-        you.queued_effect_on_conditions.pop();
-    }
+    you.queued_effect_on_conditions.clear();
     you.inactive_effect_on_condition_vector.clear();
-    while( !g->queued_global_effect_on_conditions.empty() ) {
-        g->queued_global_effect_on_conditions.pop();
-    }
+    g->queued_global_effect_on_conditions.clear();
     g->inactive_global_effect_on_condition_vector.clear();
 }
 
@@ -382,19 +599,9 @@ void effect_on_conditions::write_eocs_to_file( Character &you )
         testfile << "id;timepoint;recurring" << std::endl;
 
         testfile << "queued eocs:" << std::endl;
-        std::vector<queued_eoc> temp_queue;
-        while( !you.queued_effect_on_conditions.empty() ) {
-            temp_queue.push_back( you.queued_effect_on_conditions.top() );
-            you.queued_effect_on_conditions.pop();
-        }
-
-        for( const queued_eoc &queue_entry : temp_queue ) {
-            time_duration temp = queue_entry.time - calendar::turn;
-            testfile << queue_entry.eoc.c_str() << ";" << to_string( temp ) << std::endl;
-        }
-
-        for( const queued_eoc &queued : temp_queue ) {
-            you.queued_effect_on_conditions.push( queued );
+        for( const queued_eoc *queue_entry : you.queued_effect_on_conditions.sorted() ) {
+            time_duration temp = queue_entry->time - calendar::turn;
+            testfile << queue_entry->eoc.c_str() << ";" << to_string( temp ) << std::endl;
         }
 
         testfile << "inactive eocs:" << std::endl;
@@ -412,19 +619,9 @@ void effect_on_conditions::write_global_eocs_to_file( )
         testfile << "id;timepoint;recurring" << std::endl;
 
         testfile << "queued eocs:" << std::endl;
-        std::vector<queued_eoc> temp_queue;
-        while( !g->queued_global_effect_on_conditions.empty() ) {
-            temp_queue.push_back( g->queued_global_effect_on_conditions.top() );
-            g->queued_global_effect_on_conditions.pop();
-        }
-
-        for( const queued_eoc &queue_entry : temp_queue ) {
-            time_duration temp = queue_entry.time - calendar::turn;
-            testfile << queue_entry.eoc.c_str() << ";" << to_string( temp ) << std::endl;
-        }
-
-        for( const queued_eoc &queued : temp_queue ) {
-            g->queued_global_effect_on_conditions.push( queued );
+        for( const queued_eoc *queue_entry : g->queued_global_effect_on_conditions.sorted() ) {
+            time_duration temp = queue_entry->time - calendar::turn;
+            testfile << queue_entry->eoc.c_str() << ";" << to_string( temp ) << std::endl;
         }
 
         testfile << "inactive eocs:" << std::endl;
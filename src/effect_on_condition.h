@@ -13,6 +13,7 @@
 
 #include "dialogue.h"
 #include "dialogue_helpers.h"
+#include "enum_bitset.h"
 #include "event.h"
 #include "event_subscriber.h"
 #include "type_id.h"
@@ -37,6 +38,19 @@ enum eoc_type {
     NUM_EOC_TYPES
 };
 
+/** The changes process_reactivate() looks for inactive EOCs to reactivate after. */
+enum class eoc_reactivation : int {
+    traits = 0,
+    bionics,
+    weather,
+    last
+};
+
+template<>
+struct enum_traits<eoc_reactivation> {
+    static constexpr eoc_reactivation last = eoc_reactivation::last;
+};
+
 class eoc_events : public event_subscriber
 {
     public:
@@ -65,6 +79,8 @@ struct effect_on_condition {
         talk_effect_t true_effect;
         talk_effect_t false_effect;
         bool has_deactivate_condition = false;
+        /** The changes that can make the deactivate condition false, all of them if it can't be told. */
+        enum_bitset<eoc_reactivation> reactivated_by;
         bool has_condition = false;
         bool has_false_effect = false;
         event_type required_event;
@@ -102,7 +118,8 @@ void queue_effect_on_condition( time_duration duration, effect_on_condition_id e
 /** called every turn to process the queued eocs */
 void process_effect_on_conditions( Character &you );
 /** called after certain events to test whether to reactivate eocs */
-void process_reactivate( Character &you );
+void process_reactivate( Character &you, eoc_reactivation cause );
+/** called after the weather changed to test whether to reactivate global eocs */
 void process_reactivate();
 /** clear all queued and inactive eocs */
 void clear( Character &you );
@@ -10,9 +10,7 @@
 #include <map>
 #include <memory>
 #include <optional>
-#include <queue>
 #include <random>
-#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -177,6 +175,88 @@ float gurney_spherical( const double charge, const double mass )
                                          -0.5 ) * TYPICAL_GURNEY_CONSTANT );
 }
 
+// Scratch buffers too big to allocate for every explosion.  Explosions can be processed
+// recursively, loading a map processes the explosions queued there, so every explosion borrows
+// buffers of its own and gives them back when it's done.
+template<typename T>
+class scratch_buffer
+{
+    public:
+        scratch_buffer() {
+            std::vector<std::unique_ptr<T>> &available = free_buffers();
+            if( available.empty() ) {
+                buffer = std::make_unique<T>();
+            } else {
+                buffer = std::move( available.back() );
+                available.pop_back();
+            }
+        }
+        scratch_buffer( const scratch_buffer & ) = delete;
+        scratch_buffer &operator=( const scratch_buffer & ) = delete;
+        ~scratch_buffer() {
+            free_buffers().push_back( std::move( buffer ) );
+        }
+
+        T &operator*() {
+            return *buffer;
+        }
+
+    private:
+        static std::vector<std::unique_ptr<T>> &free_buffers() {
+            static std::vector<std::unique_ptr<T>> available;
+            return available;
+        }
+
+        std::unique_ptr<T> buffer;
+};
+
+struct blast_tile {
+    // The other members are only valid if this is the stamp of the current blast
+    uint32_t stamp = 0;
+    bool closed = false;
+    bool bashed = false;
+    bool reached = false;
+    float dist = 0.0f;
+};
+
+// The state of the blast flood fill of do_blast, in flat arrays over the whole map.
+class blast_buffers
+{
+    public:
+        std::vector<std::pair<float, tripoint_bub_ms>> open;
+        // In the order they were closed
+        std::vector<tripoint_bub_ms> closed;
+
+        void start( const map &m ) {
+            const int new_size = m.getmapsize() * SEEX;
+            if( new_size != size ) {
+                size = new_size;
+                tiles.assign( static_cast<size_t>( size ) * size * OVERMAP_LAYERS, blast_tile() );
+                stamp = 0;
+            }
+            if( ++stamp == 0 ) {
+                std::fill( tiles.begin(), tiles.end(), blast_tile() );
+                stamp = 1;
+            }
+            open.clear();
+            closed.clear();
+        }
+        // Only valid for points in bounds
+        blast_tile &at( const tripoint_bub_ms &p ) {
+            blast_tile &tile = tiles[( ( p.z() + OVERMAP_DEPTH ) * size + p.y() ) * size + p.x()];
+            if( tile.stamp != stamp ) {
+                tile = blast_tile();
+                tile.stamp = stamp;
+            }
+            return tile;
+        }
+
+    private:
+        std::vector<blast_tile> tiles;
+        int size = 0;
+        uint32_t stamp = 0;
+};
+
 // (C1001) Compiler Internal Error on Visual Studio 2015 with Update 2
 static void do_blast( map *m, const Creature *source, const tripoint_bub_ms &p, const float power,
                       const float distance_factor, const bool fire )
@@ -194,26 +274,37 @@ static void do_blast( map *m, const Creature *source, const tripoint_bub_ms &p,
     const size_t max_index = 10;
 
     m->bash( p, fire ? power : ( 2 * power ), true, false, false );
+    if( !m->inbounds( p ) ) {
+        return;
+    }
 
-    std::priority_queue< std::pair<float, tripoint_bub_ms>, std::vector< std::pair<float, tripoint_bub_ms> >, pair_greater_cmp_first >
-    open;
-    std::set<tripoint_bub_ms> closed;
-    std::set<tripoint_bub_ms> bashed{ p };
-    std::map<tripoint_bub_ms, float> dist_map;
-    open.emplace( 0.0f, p );
-    dist_map[p] = 0.0f;
+    scratch_buffer<blast_buffers> buffers;
+    blast_buffers &buf = *buffers;
+    buf.start( *m );
+    const auto is_closed = [m, &buf]( const tripoint_bub_ms & pt ) {
+        return m->inbounds( pt ) && buf.at( pt ).closed;
+    };
+    // The same heap operations std::priority_queue uses, so tiles at the same distance are
+    // visited in the same order, but without allocating a new heap for every blast
+    std::vector<std::pair<float, tripoint_bub_ms>> &open = buf.open;
+    const pair_greater_cmp_first open_cmp;
+    buf.at( p ).bashed = true;
+    buf.at( p ).reached = true;
+    open.emplace_back( 0.0f, p );
     // Find all points to blast
     while( !open.empty() ) {
         // Add some random factor to effective distance to make it look cooler
-        const float distance = open.top().first * rng_float( 1.0f, 1.2f );
-        const tripoint_bub_ms pt = open.top().second;
-        open.pop();
+        const float distance = open.front().first * rng_float( 1.0f, 1.2f );
+        const tripoint_bub_ms pt = open.front().second;
+        std::pop_heap( open.begin(), open.end(), open_cmp );
+        open.pop_back();
 
-        if( closed.count( pt ) != 0 ) {
+        if( buf.at( pt ).closed ) {
             continue;
         }
 
-        closed.insert( pt );
+        buf.at( pt ).closed = true;
+        buf.closed.push_back( pt );
 
         const float force = power * std::pow( distance_factor, distance );
         if( force <= 1.0f ) {
@@ -230,7 +321,7 @@ static void do_blast( map *m, const Creature *source, const tripoint_bub_ms &p,
         int empty_neighbors = 0;
         for( size_t i = 0; i < 8; i++ ) {
             tripoint_bub_ms dest( pt + tripoint_rel_ms( x_offset[i], y_offset[i], z_offset[i] ) );
-            if( closed.count( dest ) == 0 && m->valid_move( pt, dest, false, true ) ) {
+            if( !is_closed( dest ) && m->valid_move( pt, dest, false, true ) ) {
                 empty_neighbors++;
             }
         }
@@ -239,12 +330,12 @@ static void do_blast( map *m, const Creature *source, const tripoint_bub_ms &p,
         // Iterate over all neighbors. Bash all of them, propagate to some
         for( size_t i = 0; i < max_index; i++ ) {
             tripoint_bub_ms dest( pt + tripoint_rel_ms( x_offset[i], y_offset[i], z_offset[i] ) );
-            if( closed.count( dest ) != 0 || !m->inbounds( dest ) ) {
+            if( !m->inbounds( dest ) || buf.at( dest ).closed ) {
                 continue;
             }
 
-            if( bashed.count( dest ) == 0 ) {
-                bashed.insert( dest );
+            if( !buf.at( dest ).bashed ) {
+                buf.at( dest ).bashed = true;
                 // Up to 200% bonus for shaped charge
                 // But not if the explosion is fiery, then only half the force and no bonus
                 const float bash_force = !fire ?
@@ -273,12 +364,18 @@ static void do_blast( map *m, const Creature *source, const tripoint_bub_ms &p,
                 next_dist += zlev_dist;
             }
 
-            if( dist_map.count( dest ) == 0 || dist_map[dest] > next_dist ) {
-                open.emplace( next_dist, dest );
-                dist_map[dest] = next_dist;
+            blast_tile &dest_tile = buf.at( dest );
+            if( !dest_tile.reached || dest_tile.dist > next_dist ) {
+                dest_tile.reached = true;
+                dest_tile.dist = next_dist;
+                open.emplace_back( next_dist, dest );
+                std::push_heap( open.begin(), open.end(), open_cmp );
             }
         }
     }
+    // The damage is dealt in the order of the positions, like it always was
+    std::vector<tripoint_bub_ms> &closed = buf.closed;
+    std::sort( closed.begin(), closed.end() );
 
     // Draw the explosion, but only if the explosion center is within the reality bubble
     map &bubble_map = get_map();
@@ -294,7 +391,7 @@ static void do_blast( map *m, const Creature *source, const tripoint_bub_ms &p,
                 continue;
             }
 
-            const float force = power * std::pow( distance_factor, dist_map.at( pt ) );
+            const float force = power * std::pow( distance_factor, buf.at( pt ).dist );
             nc_color col = c_red;
             if( force < 10 ) {
                 col = c_white;
@@ -312,7 +409,7 @@ static void do_blast( map *m, const Creature *source, const tripoint_bub_ms &p,
     // Must use the reality bubble pos, because that's what the creature tracker works with.
     Creature *mutable_source = source == nullptr ? nullptr : creatures.creature_at( source->pos_bub() );
     for( const tripoint_bub_ms &pt : closed ) {
-        const float force = power * std::pow( distance_factor, dist_map.at( pt ) );
+        const float force = power * std::pow( distance_factor, buf.at( pt ).dist );
         if( force < 1.0f ) {
             // Too weak to matter
             continue;
@@ -399,6 +496,11 @@ static void do_blast( map *m, const Creature *source, const tripoint_bub_ms &p,
     }
 }
 
+struct shrapnel_caches {
+    cata::mdarray<fragment_cloud, point_bub_ms> obstacle_cache;
+    cata::mdarray<fragment_cloud, point_bub_ms> visited_cache;
+};
+
 static std::vector<tripoint_bub_ms> shrapnel( map *m, const Creature *source,
         const tripoint_bub_ms &src, int power,
         int casing_mass, float per_fragment_mass, int range = -1 )
@@ -417,14 +519,11 @@ static std::vector<tripoint_bub_ms> shrapnel( map *m, const Creature *source,
     proj.range = range;
     proj.proj_effects.insert( ammo_effect_NULL_SOURCE );
 
-    struct local_caches {
-        cata::mdarray<fragment_cloud, point_bub_ms> obstacle_cache;
-        cata::mdarray<fragment_cloud, point_bub_ms> visited_cache;
-    };
-
-    std::unique_ptr<local_caches> caches = std::make_unique<local_caches>();
-    cata::mdarray<fragment_cloud, point_bub_ms> &obstacle_cache = caches->obstacle_cache;
-    cata::mdarray<fragment_cloud, point_bub_ms> &visited_cache = caches->visited_cache;
+    scratch_buffer<shrapnel_caches> caches;
+    cata::mdarray<fragment_cloud, point_bub_ms> &obstacle_cache = ( *caches ).obstacle_cache;
+    cata::mdarray<fragment_cloud, point_bub_ms> &visited_cache = ( *caches ).visited_cache;
+    obstacle_cache.fill( fragment_cloud() );
+    visited_cache.fill( fragment_cloud() );
 
     // TODO: Calculate range based on max effective range for projectiles.
     // Basically bisect between 0 and map diameter using shrapnel_calc().
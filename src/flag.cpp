@@ -1,10 +1,15 @@
 #include "flag.h"
 
+#include <algorithm>
+#include <bitset>
+
 #include "debug.h"
+#include "flag_set.h"
 #include "flexbuffer_json-inl.h"
 #include "flexbuffer_json.h"
 #include "generic_factory.h"
 #include "init.h"
+#include "json.h"
 #include "json_error.h"
 #include "type_id.h"
 
@@ -467,3 +472,133 @@ const std::vector<json_flag> &json_flag::get_all()
 {
     return json_flags_all.get_all();
 }
+
+flag_set::flag_set( std::initializer_list<flag_id> flags )
+{
+    for( const flag_id &flag : flags ) {
+        insert( flag );
+    }
+}
+
+int flag_set::index_of( const flag_id &flag )
+{
+    return json_flags_all.convert( flag, int_id<json_flag>( -1 ), false ).to_i();
+}
+
+const flag_id &flag_set::flag_at( size_t index )
+{
+    return json_flags_all.convert( int_id<json_flag>( static_cast<int>( index ) ) );
+}
+
+size_t flag_set::size() const
+{
+    size_t result = 0;
+    for( const uint64_t word : words ) {
+        result += std::bitset<bits_per_word>( word ).count();
+    }
+    return result;
+}
+
+bool flag_set::insert( const flag_id &flag )
+{
+    const int index = index_of( flag );
+    if( index < 0 || test( static_cast<size_t>( index ) ) ) {
+        return false;
+    }
+    const size_t word = static_cast<size_t>( index ) / bits_per_word;
+    if( word >= words.size() ) {
+        words.resize( word + 1, 0 );
+    }
+    words[word] |= uint64_t( 1 ) << ( static_cast<size_t>( index ) % bits_per_word );
+    return true;
+}
+
+size_t flag_set::erase( const flag_id &flag )
+{
+    const int index = index_of( flag );
+    if( index < 0 || !test( static_cast<size_t>( index ) ) ) {
+        return 0;
+    }
+    const size_t word = static_cast<size_t>( index ) / bits_per_word;
+    words[word] &= ~( uint64_t( 1 ) << ( static_cast<size_t>( index ) % bits_per_word ) );
+    trim();
+    return 1;
+}
+
+flag_set::const_iterator flag_set::erase( const const_iterator it )
+{
+    const size_t word = it.index / bits_per_word;
+    words[word] &= ~( uint64_t( 1 ) << ( it.index % bits_per_word ) );
+    const size_t next = next_index( it.index + 1 );
+    trim();
+    // Trimming may have moved the end
+    return const_iterator( this, std::min( next, words.size() * bits_per_word ) );
+}
+
+flag_set &flag_set::operator|=( const flag_set &rhs )
+{
+    if( words.size() < rhs.words.size() ) {
+        words.resize( rhs.words.size(), 0 );
+    }
+    for( size_t i = 0; i < rhs.words.size(); ++i ) {
+        words[i] |= rhs.words[i];
+    }
+    return *this;
+}
+
+bool flag_set::equal_ignoring( const flag_set &rhs, const flag_set &ignored ) const
+{
+    const size_t len = std::max( words.size(), rhs.words.size() );
+    for( size_t i = 0; i < len; ++i ) {
+        const uint64_t mask = i < ignored.words.size() ? ~ignored.words[i] : ~uint64_t( 0 );
+        const uint64_t lhs_word = i < words.size() ? words[i] : 0;
+        const uint64_t rhs_word = i < rhs.words.size() ? rhs.words[i] : 0;
+        if( ( lhs_word & mask ) != ( rhs_word & mask ) ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t flag_set::next_index( size_t index ) const
+{
+    for( size_t word = index / bits_per_word; word < words.size(); ++word ) {
+        uint64_t remaining = words[word];
+        size_t bit = 0;
+        if( word == index / bits_per_word ) {
+            bit = index % bits_per_word;
+            remaining >>= bit;
+        }
+        for( ; remaining != 0; remaining >>= 1, ++bit ) {
+            if( remaining & 1 ) {
+                return word * bits_per_word + bit;
+            }
+        }
+    }
+    return words.size() * bits_per_word;
+}
+
+void flag_set::trim()
+{
+    while( !words.empty() && words.back() == 0 ) {
+        words.pop_back();
+    }
+}
+
+void flag_set::serialize( JsonOut &jsout ) const
+{
+    jsout.start_array();
+    for( const flag_id &flag : *this ) {
+        jsout.write( flag );
+    }
+    jsout.end_array();
+}
+
+void flag_set::deserialize( const JsonArray &ja )
+{
+    clear();
+    // flags that are no longer defined are dropped
+    for( const std::string flag : ja ) {
+        insert( flag_id( flag ) );
+    }
+}
@@ -0,0 +1,139 @@
+#pragma once
+#ifndef CATA_SRC_FLAG_SET_H
+#define CATA_SRC_FLAG_SET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+#include "type_id.h"
+
+class JsonArray;
+class JsonOut;
+
+/**
+ * Set of @ref json_flag ids stored as a bitset indexed by the flag's position in the
+ * flag factory, so membership tests are a single bit test rather than a tree lookup.
+ *
+ * Words are only allocated up to the highest flag present, so an empty set owns no
+ * heap memory. Ids that are not loaded flags cannot be stored: @ref insert ignores them.
+ * Iteration visits flags in load order.
+ *
+ * The indices are only meaningful while the same set of flags is loaded; sets must not
+ * outlive a reload of the flag definitions.
+ */
+class flag_set
+{
+    public:
+        class const_iterator
+        {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = flag_id;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const flag_id *;
+                using reference = const flag_id &;
+
+                const_iterator() = default;
+
+                reference operator*() const {
+                    return flag_set::flag_at( index );
+                }
+                pointer operator->() const {
+                    return &flag_set::flag_at( index );
+                }
+                const_iterator &operator++() {
+                    index = set->next_index( index + 1 );
+                    return *this;
+                }
+                const_iterator operator++( int ) {
+                    const_iterator prev = *this;
+                    ++*this;
+                    return prev;
+                }
+                bool operator==( const const_iterator &rhs ) const {
+                    return index == rhs.index;
+                }
+                bool operator!=( const const_iterator &rhs ) const {
+                    return index != rhs.index;
+                }
+
+            private:
+                friend class flag_set;
+                const_iterator( const flag_set *set, size_t index ) : set( set ), index( index ) {}
+
+                const flag_set *set = nullptr;
+                size_t index = 0;
+        };
+        using iterator = const_iterator;
+        using value_type = flag_id;
+
+        flag_set() = default;
+        flag_set( std::initializer_list<flag_id> flags );
+
+        bool empty() const {
+            return words.empty();
+        }
+        size_t size() const;
+
+        size_t count( const flag_id &flag ) const {
+            const int index = index_of( flag );
+            return index >= 0 && test( static_cast<size_t>( index ) ) ? 1 : 0;
+        }
+
+        /** Adds the flag, returns false if it was already present or is not a loaded flag. */
+        bool insert( const flag_id &flag );
+        /** Removes the flag, returns the number of removed elements like std::set::erase. */
+        size_t erase( const flag_id &flag );
+        /** Removes the flag at @p it, returns the iterator to the next flag. */
+        const_iterator erase( const_iterator it );
+        void clear() {
+            words.clear();
+        }
+
+        /** Adds all flags of another set. */
+        flag_set &operator|=( const flag_set &rhs );
+
+        /** Whether both sets contain the same flags once those in @p ignored are disregarded. */
+        bool equal_ignoring( const flag_set &rhs, const flag_set &ignored ) const;
+
+        bool operator==( const flag_set &rhs ) const {
+            return words == rhs.words;
+        }
+        bool operator!=( const flag_set &rhs ) const {
+            return words != rhs.words;
+        }
+
+        const_iterator begin() const {
+            return const_iterator( this, next_index( 0 ) );
+        }
+        const_iterator end() const {
+            return const_iterator( this, words.size() * bits_per_word );
+        }
+
+        void serialize( JsonOut &jsout ) const;
+        void deserialize( const JsonArray &ja );
+
+    private:
+        static constexpr size_t bits_per_word = 64;
+
+        /** Position of the flag in the flag factory or -1 if it is not a loaded flag. */
+        static int index_of( const flag_id &flag );
+        static const flag_id &flag_at( size_t index );
+
+        bool test( size_t index ) const {
+            const size_t word = index / bits_per_word;
+            return word < words.size() &&
+                   ( words[word] >> ( index % bits_per_word ) & 1 ) != 0;
+        }
+        /** First set bit at or after @p index, or the end index. */
+        size_t next_index( size_t index ) const;
+        /** Drops trailing zero words so equal sets have equal storage. */
+        void trim();
+
+        std::vector<uint64_t> words;
+};
+
+#endif // CATA_SRC_FLAG_SET_H
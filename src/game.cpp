@@ -156,6 +156,7 @@
 #include "move_mode.h"
 #include "mtype.h"
 #include "npc.h"
+#include "npc_travel_schedule.h"
 #include "npctrade.h"
 #include "omdata.h"
 #include "options.h"
@@ -831,6 +832,7 @@ void game::setup()
     clear_zombies();
     critter_tracker->clear_npcs();
     faction_manager_ptr->clear();
+    *npc_travel_schedule_ptr = npc_travel_schedule();
     mission::clear_all();
     Messages::clear_messages();
     timed_events = timed_event_manager();
@@ -7572,6 +7574,8 @@ void game::zones_manager()
         }
 
         zones.cache_data();
+        // Vehicle zones are edited in place, their cache keeps the filters they had
+        zones.cache_vzones();
     }
 
     u.view_offset = stored_view_offset;
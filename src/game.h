@@ -87,6 +87,7 @@ class memorial_logger;
 class monster;
 class npc;
 class npc_template;
+class npc_travel_schedule;
 class overmap;
 class save_t;
 class scenario;
@@ -1115,6 +1116,8 @@ class game
 
         pimpl<creature_tracker> critter_tracker;
         pimpl<faction_manager> faction_manager_ptr; // NOLINT(cata-serialize)
+        /** NPCs travelling outside the reality bubble, rebuilt from the NPCs after loading. */
+        pimpl<npc_travel_schedule> npc_travel_schedule_ptr; // NOLINT(cata-serialize)
 
         /** Used in main.cpp to determine what type of quit is being performed. */
         quit_status uquit; // NOLINT(cata-serialize)
@@ -1,8 +1,14 @@
 #pragma once
 #ifndef CATA_SRC_GLOBAL_VARS_H
 #define CATA_SRC_GLOBAL_VARS_H
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 
+#include "dialogue_vars.h"
 #include "json.h"
 
 enum class var_type : int {
@@ -21,16 +27,23 @@ class global_variables
     public:
         // Methods for setting/getting misc key/value pairs.
         void set_global_value( const std::string &key, const std::string &value ) {
-            global_values[ key ] = value;
+            global_values.set( var_key( key ), var_value( value ) );
+        }
+        void set_global_value( const var_key &key, var_value value ) {
+            global_values.set( key, std::move( value ) );
         }
 
         void remove_global_value( const std::string &key ) {
-            global_values.erase( key );
+            global_values.erase( var_key( key ) );
         }
 
         std::optional<std::string> maybe_get_global_value( const std::string &key ) const {
-            auto it = global_values.find( key );
-            return it == global_values.end() ? std::nullopt : std::optional<std::string> { it->second };
+            const var_value *val = global_values.find( var_key( key ) );
+            return val == nullptr ? std::nullopt : std::optional<std::string> { val->str() };
+        }
+        /** Returns nullptr if the variable isn't set. */
+        const var_value *find_global_value( const var_key &key ) const {
+            return global_values.find( key );
         }
 
         std::string get_global_value( const std::string &key ) const {
@@ -38,15 +51,15 @@ class global_variables
         }
 
         std::unordered_map<std::string, std::string> get_global_values() const {
-            return global_values;
+            return global_values.to_strings();
         }
 
         void clear_global_values() {
             global_values.clear();
         }
 
-        void set_global_values( std::unordered_map<std::string, std::string> input ) {
-            global_values = std::move( input );
+        void set_global_values( const std::unordered_map<std::string, std::string> &input ) {
+            global_values.from_strings( input );
         }
         void unserialize( JsonObject &jo );
         void serialize( JsonOut &jsout ) const;
@@ -55,7 +68,7 @@ class global_variables
         static void load_migrations( const JsonObject &jo, const std::string_view &src );
 
     private:
-        std::unordered_map<std::string, std::string> global_values;
+        var_store global_values;
 };
 global_variables &get_globals();
 
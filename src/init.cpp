@@ -77,10 +77,12 @@
 #include "npc.h"
 #include "npc_class.h"
 #include "omdata.h"
+#include "options.h"
 #include "overlay_ordering.h"
 #include "overmap.h"
 #include "overmap_connection.h"
 #include "overmap_location.h"
+#include "pathfinding.h"
 #include "profession.h"
 #include "profession_group.h"
 #include "proficiency.h"
@@ -814,6 +816,7 @@ void DynamicDataLoader::finalize_loaded_data()
             { _( "Traps" ), &trap::finalize },
             { _( "Terrain" ), &set_ter_ids },
             { _( "Furniture" ), &set_furn_ids },
+            { _( "Pathfinding" ), &pathfinding_base::finalize },
             { _( "Overmap land use codes" ), &overmap_land_use_codes::finalize },
             { _( "Overmap terrain" ), &overmap_terrains::finalize },
             { _( "Overmap connections" ), &overmap_connections::finalize },
@@ -878,6 +881,12 @@ void DynamicDataLoader::check_consistency()
     const std::vector<named_entry> entries = {{
             { _( "Flags" ), &json_flag::check_consistency },
             { _( "Option sliders" ), &option_slider::check_consistency },
+            {
+                _( "Option handles" ), []()
+                {
+                    get_options().check_handles();
+                }
+            },
             {
                 _( "Crafting requirements" ), []()
                 {
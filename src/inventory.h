@@ -255,6 +255,8 @@ class inventory : public visitable
         bool has_quality( const quality_id &qual, int level = 1, int qty = 1 ) const override;
         VisitResponse visit_items( const std::function<VisitResponse( item *, item * )> &func ) const
         override;
+        template<typename F>
+        VisitResponse visit_items_inline( F &&func ) const;
         std::list<item> remove_items_with( const std::function<bool( const item & )> &filter,
                                            int count = INT_MAX ) override;
         int charges_of( const itype_id &what, int limit = INT_MAX,
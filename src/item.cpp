@@ -61,6 +61,7 @@
 #include "item_category.h"
 #include "item_factory.h"
 #include "item_group.h"
+#include "item_pocket.h"
 #include "item_tname.h"
 #include "iteminfo_query.h"
 #include "itype.h"
@@ -646,6 +647,7 @@ item item::make_corpse( const mtype_id &mt, time_point turn, const std::string &
 
 item &item::convert( const itype_id &new_type, Character *carrier )
 {
+    item_pocket::invalidate_contents_totals();
     // Carry over relative rot similar to crafting
     const double rel_rot = get_relative_rot();
     type = find_type( new_type );
@@ -736,6 +738,7 @@ units::energy item::mod_energy( const units::energy &qty )
 
 item &item::ammo_set( const itype_id &ammo, int qty )
 {
+    item_pocket::invalidate_contents_totals();
     if( !ammo->ammo ) {
         if( !has_flag( flag_USES_BIONIC_POWER ) ) {
             debugmsg( "can't set ammo %s in %s as it is not an ammo", ammo.c_str(), type_name() );
@@ -854,6 +857,7 @@ item &item::ammo_set( const itype_id &ammo, int qty )
 
 item &item::ammo_unset()
 {
+    item_pocket::invalidate_contents_totals();
     if( !is_tool() && !is_gun() && !is_magazine() ) {
         // do nothing
     } else if( is_magazine() ) {
@@ -1703,7 +1707,7 @@ stacking_info item::stacks_with( const item &rhs, bool check_components, bool co
 
     if( combine_liquid && same_type && has_temperature() && made_of_from_type( phase_id::LIQUID ) ) {
         // we can combine liquids of same type and different temperatures
-        bits.set( tname::segments::TAGS, equal_ignoring_elements( rhs.get_flags(), get_flags(),
+        bits.set( tname::segments::TAGS, get_flags().equal_ignoring( rhs.get_flags(),
         { flag_COLD, flag_FROZEN, flag_HOT, flag_NO_PARASITES, flag_FROM_FROZEN_LIQUID } ) );
         bits.set( tname::segments::TEMPERATURE );
     } else {
@@ -1834,6 +1838,7 @@ void item::force_insert_item( const item &it, pocket_type pk_type )
 
 void item::set_var( const std::string &name, const int value )
 {
+    item_pocket::invalidate_contents_totals();
     std::ostringstream tmpstream;
     tmpstream.imbue( std::locale::classic() );
     tmpstream << value;
@@ -1842,6 +1847,7 @@ void item::set_var( const std::string &name, const int value )
 
 void item::set_var( const std::string &name, const long long value )
 {
+    item_pocket::invalidate_contents_totals();
     std::ostringstream tmpstream;
     tmpstream.imbue( std::locale::classic() );
     tmpstream << value;
@@ -1851,6 +1857,7 @@ void item::set_var( const std::string &name, const long long value )
 // NOLINTNEXTLINE(cata-no-long)
 void item::set_var( const std::string &name, const long value )
 {
+    item_pocket::invalidate_contents_totals();
     std::ostringstream tmpstream;
     tmpstream.imbue( std::locale::classic() );
     tmpstream << value;
@@ -1859,6 +1866,7 @@ void item::set_var( const std::string &name, const long value )
 
 void item::set_var( const std::string &name, const double value )
 {
+    item_pocket::invalidate_contents_totals();
     item_vars[name] = string_format( "%f", value );
 }
 
@@ -1901,6 +1909,7 @@ double item::get_var( const std::string &name, const double default_value ) cons
 
 void item::set_var( const std::string &name, const tripoint_abs_omt &value )
 {
+    item_pocket::invalidate_contents_totals();
     item_vars[name] = value.to_string();
 }
 
@@ -1936,6 +1945,7 @@ tripoint_abs_omt item::get_var( const std::string &name,
 
 void item::set_var( const std::string &name, const std::string &value )
 {
+    item_pocket::invalidate_contents_totals();
     item_vars[name] = value;
 }
 
@@ -1966,11 +1976,13 @@ bool item::has_var( const std::string &name ) const
 
 void item::erase_var( const std::string &name )
 {
+    item_pocket::invalidate_contents_totals();
     item_vars.erase( name );
 }
 
 void item::clear_vars()
 {
+    item_pocket::invalidate_contents_totals();
     item_vars.clear();
 }
 
@@ -6779,10 +6791,10 @@ void item::update_inherited_flags()
 {
     inherited_tags_cache.clear();
 
-    auto const inehrit_flags = [this]( FlagsSetType const & Flags ) {
+    auto const inehrit_flags = [this]( auto const & Flags ) {
         for( flag_id const &f : Flags ) {
             if( f->inherit() ) {
-                inherited_tags_cache.emplace( f );
+                inherited_tags_cache.insert( f );
             }
         }
     };
@@ -6810,7 +6822,7 @@ void item::update_prefix_suffix_flags()
 {
     prefix_tags_cache.clear();
     suffix_tags_cache.clear();
-    auto const insert_prefix_suffix_flags = [this]( FlagsSetType const & Flags ) {
+    auto const insert_prefix_suffix_flags = [this]( auto const & Flags ) {
         for( flag_id const &f : Flags ) {
             update_prefix_suffix_flags( f );
         }
@@ -6823,15 +6835,16 @@ void item::update_prefix_suffix_flags()
 void item::update_prefix_suffix_flags( const flag_id &f )
 {
     if( !f->item_prefix().empty() ) {
-        prefix_tags_cache.emplace( f );
+        prefix_tags_cache.insert( f );
     }
     if( !f->item_suffix().empty() ) {
-        suffix_tags_cache.emplace( f );
+        suffix_tags_cache.insert( f );
     }
 }
 
 void item::on_contents_changed()
 {
+    item_pocket::invalidate_contents_totals();
     contents.update_open_pockets();
     cached_relative_encumbrance.reset();
     encumbrance_update_ = true;
@@ -7679,6 +7692,7 @@ int item::current_reach_range( const Character &guy ) const
 
 void item::unset_flags()
 {
+    item_pocket::invalidate_contents_totals();
     item_tags.clear();
     requires_tags_processing = true;
 }
@@ -7700,7 +7714,7 @@ bool item::has_fault_flag( const std::string &searched_flag ) const
 
 bool item::has_own_flag( const flag_id &f ) const
 {
-    return item_tags.find( f ) != item_tags.end();
+    return item_tags.count( f ) != 0;
 }
 
 bool item::has_flag( const flag_id &f ) const
@@ -7711,7 +7725,7 @@ bool item::has_flag( const flag_id &f ) const
         return false;
     }
 
-    ret = inherited_tags_cache.find( f ) != inherited_tags_cache.end();
+    ret = inherited_tags_cache.count( f ) != 0;
     if( ret ) {
         return ret;
     }
@@ -7730,6 +7744,7 @@ bool item::has_flag( const flag_id &f ) const
 item &item::set_flag( const flag_id &flag )
 {
     if( flag.is_valid() ) {
+        item_pocket::invalidate_contents_totals();
         item_tags.insert( flag );
         update_prefix_suffix_flags( flag );
         requires_tags_processing = true;
@@ -7765,6 +7780,7 @@ item &item::set_fault( const fault_id &fault_id )
 
 item &item::unset_flag( const flag_id &flag )
 {
+    item_pocket::invalidate_contents_totals();
     item_tags.erase( flag );
     update_prefix_suffix_flags();
     requires_tags_processing = true;
@@ -9874,6 +9890,7 @@ units::temperature item::get_freeze_point() const
 
 void item::set_mtype( const mtype *const m )
 {
+    item_pocket::invalidate_contents_totals();
     // This is potentially dangerous, e.g. for corpse items, which *must* have a valid mtype pointer.
     if( m == nullptr ) {
         debugmsg( "setting item::corpse of %s to NULL", tname() );
@@ -11233,6 +11250,7 @@ bool item::ammo_sufficient( const Character *carrier, const std::string &method,
 
 int item::ammo_consume( int qty, const tripoint_bub_ms &pos, Character *carrier )
 {
+    item_pocket::invalidate_contents_totals();
     if( qty < 0 ) {
         debugmsg( "Cannot consume negative quantity of ammo for %s", tname() );
         return 0;
@@ -14684,6 +14702,7 @@ bool item::process_internal( map &here, Character *carrier, const tripoint_bub_m
 
 void item::mod_charges( int mod )
 {
+    item_pocket::invalidate_contents_totals();
     if( has_infinite_charges() ) {
         return;
     }
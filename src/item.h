@@ -21,6 +21,7 @@
 #include "cata_utility.h"
 #include "compatibility.h"
 #include "enums.h"
+#include "flag_set.h"
 #include "gun_mode.h"
 #include "io_tags.h"
 #include "item_components.h"
@@ -198,7 +199,7 @@ struct stacking_info {
 class item : public visitable
 {
     public:
-        using FlagsSetType = std::set<flag_id>;
+        using FlagsSetType = flag_set;
 
         item();
 
@@ -2977,12 +2978,16 @@ class item : public visitable
         // inherited from visitable
         VisitResponse visit_items( const std::function<VisitResponse( item *, item * )> &func ) const
         override;
+        template<typename F>
+        VisitResponse visit_items_inline( F &&func ) const;
         /**
          * @relates visitable
          * NOTE: upon expansion, this may need to be filtered by type enum depending on accessibility
          */
         VisitResponse visit_contents( const std::function<VisitResponse( item *, item * )> &func,
                                       item *parent = nullptr );
+        template<typename F>
+        VisitResponse visit_contents_inline( F &func, item *parent = nullptr );
         void remove_internal( const std::function<bool( item & )> &filter,
                               int &count, std::list<item> &res );
         std::list<item> remove_items_with( const std::function<bool( const item & )> &filter,
@@ -3170,10 +3175,10 @@ class item : public visitable
          * This flag is reset to `true` if item tags are changed.
          */
         bool requires_tags_processing = true;
-        cata::heap<FlagsSetType> item_tags; // generic item specific flags
-        cata::heap<FlagsSetType> inherited_tags_cache;
-        cata::heap<FlagsSetType> prefix_tags_cache; // flags that will add prefixes to this item
-        cata::heap<FlagsSetType> suffix_tags_cache; // flags that will add suffixes to this item
+        FlagsSetType item_tags; // generic item specific flags
+        FlagsSetType inherited_tags_cache;
+        FlagsSetType prefix_tags_cache; // flags that will add prefixes to this item
+        FlagsSetType suffix_tags_cache; // flags that will add suffixes to this item
         lazy<safe_reference_anchor> anchor;
         cata::heap<std::map<std::string, std::string>> item_vars;
         const mtype *corpse = nullptr;
@@ -15,6 +15,7 @@
 #include "enum_conversions.h"
 #include "enums.h"
 #include "flat_set.h"
+#include "hash_utils.h"
 #include "imgui/imgui.h"
 #include "input.h"
 #include "input_popup.h"
@@ -2599,6 +2600,15 @@ units::volume item_contents::item_size_modifier() const
     return total_vol;
 }
 
+size_t item_contents::contents_state() const
+{
+    size_t seed = 0;
+    for( const item_pocket &pocket : contents ) {
+        cata::hash_combine( seed, pocket.contents_state() );
+    }
+    return seed;
+}
+
 units::mass item_contents::item_weight_modifier() const
 {
     units::mass total_mass = 0_gram;
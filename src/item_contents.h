@@ -172,6 +172,8 @@ class item_contents
         const item &legacy_front() const;
 
         units::volume item_size_modifier() const;
+        /** Combined item_pocket::contents_state of every pocket. */
+        size_t contents_state() const;
         units::mass item_weight_modifier() const;
         units::length item_length_modifier() const;
 
@@ -383,6 +385,8 @@ class item_contents
          */
         VisitResponse visit_contents( const std::function<VisitResponse( item *, item * )> &func,
                                       item *parent = nullptr );
+        template<typename F>
+        VisitResponse visit_contents_inline( F &func, item *parent = nullptr );
         void remove_internal( const std::function<bool( item & )> &filter,
                               int &count, std::list<item> &res );
 
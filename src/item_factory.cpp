@@ -751,6 +751,11 @@ void Item_factory::finalize_post( itype &obj )
         }
         return false;
     } );
+    obj.item_tag_bits.clear();
+    for( const flag_id &f : obj.item_tags ) {
+        obj.item_tag_bits.insert( f );
+    }
+    obj.item_tag_bits_ready = true;
 
     if( obj.gun && !obj.gunmod && !obj.has_flag( flag_PRIMITIVE_RANGED_WEAPON ) ) {
         const quality_id qual_gun_skill( to_upper_case( obj.gun->skill_used.str() ) );
@@ -18,6 +18,7 @@
 #include "flag.h"
 #include "generic_factory.h"
 #include "handle_liquid.h"
+#include "hash_utils.h"
 #include "item.h"
 #include "item_category.h"
 #include "item_factory.h"
@@ -246,6 +247,7 @@ bool item_pocket::same_contents( const item_pocket &rhs ) const
 
 void item_pocket::restack()
 {
+    invalidate_contents_totals();
     if( contents.size() <= 1 ) {
         return;
     }
@@ -290,6 +292,7 @@ void item_pocket::restack()
 
 item *item_pocket::restack( /*const*/ item *it )
 {
+    invalidate_contents_totals();
     item *ret = it;
     if( contents.size() <= 1 ) {
         return ret;
@@ -547,6 +550,7 @@ const item &item_pocket::front() const
 
 void item_pocket::pop_back()
 {
+    invalidate_contents_totals();
     contents.pop_back();
 }
 
@@ -609,10 +613,7 @@ units::volume item_pocket::item_size_modifier() const
     if( data->rigid ) {
         return 0_ml;
     }
-    units::volume total_vol = 0_ml;
-    for( const item &it : contents ) {
-        total_vol += it.volume( is_type( pocket_type::MOD ) );
-    }
+    units::volume total_vol = get_volume_totals().modifier;
     total_vol -= data->magazine_well;
     total_vol *= data->volume_multiplier;
     return std::max( 0_ml, total_vol );
@@ -620,15 +621,65 @@ units::volume item_pocket::item_size_modifier() const
 
 units::mass item_pocket::item_weight_modifier() const
 {
-    units::mass total_mass = 0_gram;
+    return get_weight_totals().modifier;
+}
+
+// bumped whenever any pocket's contents may have changed
+static uint64_t contents_totals_generation = 1;
+
+void item_pocket::invalidate_contents_totals()
+{
+    ++contents_totals_generation;
+}
+
+size_t item_pocket::contents_state() const
+{
+    size_t seed = contents.size();
     for( const item &it : contents ) {
-        if( is_type( pocket_type::MOD ) ) {
-            total_mass += it.weight( true, true ) * data->weight_multiplier;
-        } else {
-            total_mass += it.weight() * data->weight_multiplier;
+        cata::hash_combine( seed, it.type );
+        cata::hash_combine( seed, it.get_corpse_mon() );
+        cata::hash_combine( seed, it.charges );
+        cata::hash_combine( seed, it.get_contents().contents_state() );
+    }
+    return seed;
+}
+
+const item_pocket::weight_totals &item_pocket::get_weight_totals() const
+{
+    const size_t state = contents_state();
+    if( cached_weight.generation != contents_totals_generation || cached_weight.state != state ) {
+        const uint64_t generation = contents_totals_generation;
+        cached_weight = weight_totals();
+        for( const item &it : contents ) {
+            const units::mass weight = it.weight();
+            cached_weight.contained += weight;
+            if( is_type( pocket_type::MOD ) ) {
+                cached_weight.modifier += it.weight( true, true ) * data->weight_multiplier;
+            } else {
+                cached_weight.modifier += weight * data->weight_multiplier;
+            }
         }
+        cached_weight.generation = generation;
+        cached_weight.state = state;
     }
-    return total_mass;
+    return cached_weight;
+}
+
+const item_pocket::volume_totals &item_pocket::get_volume_totals() const
+{
+    const size_t state = contents_state();
+    if( cached_volume.generation != contents_totals_generation || cached_volume.state != state ) {
+        const uint64_t generation = contents_totals_generation;
+        cached_volume = volume_totals();
+        for( const item &it : contents ) {
+            const units::volume volume = it.volume();
+            cached_volume.contained += volume;
+            cached_volume.modifier += is_type( pocket_type::MOD ) ? it.volume( true ) : volume;
+        }
+        cached_volume.generation = generation;
+        cached_volume.state = state;
+    }
+    return cached_volume;
 }
 
 units::length item_pocket::item_length_modifier() const
@@ -708,6 +759,7 @@ itype_id item_pocket::magazine_default() const
 
 int item_pocket::ammo_consume( int qty )
 {
+    invalidate_contents_totals();
     int need = qty;
     int used = 0;
     std::list<item>::iterator it;
@@ -768,6 +820,7 @@ std::set<ammotype> item_pocket::ammo_types() const
 
 void item_pocket::casings_handle( const std::function<bool( item & )> &func )
 {
+    invalidate_contents_totals();
     for( auto it = contents.begin(); it != contents.end(); ) {
         if( it->has_flag( flag_CASING ) ) {
             it->unset_flag( flag_CASING );
@@ -784,6 +837,7 @@ void item_pocket::casings_handle( const std::function<bool( item & )> &func )
 
 void item_pocket::handle_liquid_or_spill( Character &guy, const item *avoid )
 {
+    invalidate_contents_totals();
     if( guy.is_npc() ) {
         spill_contents( guy.pos_bub() );
         return;
@@ -811,6 +865,7 @@ void item_pocket::handle_liquid_or_spill( Character &guy, const item *avoid )
 
 bool item_pocket::use_amount( const itype_id &it, int &quantity, std::list<item> &used )
 {
+    invalidate_contents_totals();
     bool used_item = false;
     for( auto a = contents.begin(); a != contents.end() && quantity > 0; ) {
         if( a->use_amount( it, quantity, used ) ) {
@@ -889,6 +944,7 @@ std::string item_pocket::translated_sealed_prefix() const
 
 bool item_pocket::detonate( const tripoint_bub_ms &pos, std::vector<item> &drops )
 {
+    invalidate_contents_totals();
     const auto new_end = std::remove_if( contents.begin(), contents.end(), [&pos, &drops]( item & it ) {
         return it.detonate( pos, drops );
     } );
@@ -903,6 +959,7 @@ bool item_pocket::detonate( const tripoint_bub_ms &pos, std::vector<item> &drops
 
 void item_pocket::remove_all_ammo( Character &guy )
 {
+    invalidate_contents_totals();
     for( auto iter = contents.begin(); iter != contents.end(); ) {
         if( iter->is_irremovable() ) {
             iter++;
@@ -915,6 +972,7 @@ void item_pocket::remove_all_ammo( Character &guy )
 
 void item_pocket::remove_all_mods( Character &guy )
 {
+    invalidate_contents_totals();
     for( auto iter = contents.begin(); iter != contents.end(); ) {
         if( iter->is_toolmod() ) {
             guy.i_add_or_drop( *iter );
@@ -928,6 +986,7 @@ void item_pocket::remove_all_mods( Character &guy )
 
 void item_pocket::set_item_defaults()
 {
+    invalidate_contents_totals();
     for( item &contained_item : contents ) {
         /* for guns and other items defined to have a magazine but don't use "ammo" */
         if( contained_item.is_magazine() ) {
@@ -1711,6 +1770,7 @@ bool item_pocket::can_reload_with( const item &ammo, const bool now ) const
 
 std::optional<item> item_pocket::remove_item( const item &it )
 {
+    invalidate_contents_totals();
     item ret( it );
     const size_t sz = contents.size();
     contents.remove_if( [&it]( const item & rhs ) {
@@ -1726,6 +1786,7 @@ std::optional<item> item_pocket::remove_item( const item &it )
 bool item_pocket::remove_internal( const std::function<bool( item & )> &filter,
                                    int &count, std::list<item> &res )
 {
+    invalidate_contents_totals();
     for( auto it = contents.begin(); it != contents.end(); ) {
         if( filter( *it ) ) {
             res.splice( res.end(), contents, it++ );
@@ -1742,6 +1803,7 @@ bool item_pocket::remove_internal( const std::function<bool( item & )> &filter,
 
 std::optional<item> item_pocket::remove_item( const item_location &it )
 {
+    invalidate_contents_totals();
     if( !it ) {
         return std::nullopt;
     }
@@ -1781,6 +1843,7 @@ static void move_to_parent_pocket_recursive( const tripoint &pos, item &it,
 
 void item_pocket::overflow( const tripoint_bub_ms &pos, const item_location &loc )
 {
+    invalidate_contents_totals();
     if( is_type( pocket_type::MOD ) || is_type( pocket_type::CORPSE ) ||
         is_type( pocket_type::EBOOK ) || is_type( pocket_type::CABLE ) ) {
         return;
@@ -1889,6 +1952,7 @@ void item_pocket::overflow( const tripoint_bub_ms &pos, const item_location &loc
 
 void item_pocket::on_pickup( Character &guy, item *avoid )
 {
+    invalidate_contents_totals();
     if( will_spill() ) {
         while( !empty() ) {
             handle_liquid_or_spill( guy, avoid );
@@ -1899,12 +1963,14 @@ void item_pocket::on_pickup( Character &guy, item *avoid )
 
 void item_pocket::on_contents_changed()
 {
+    invalidate_contents_totals();
     unseal();
     restack();
 }
 
 bool item_pocket::spill_contents( const tripoint_bub_ms &pos )
 {
+    invalidate_contents_totals();
     if( is_type( pocket_type::EBOOK ) || is_type( pocket_type::CORPSE ) ||
         is_type( pocket_type::CABLE ) ) {
         return false;
@@ -1921,6 +1987,7 @@ bool item_pocket::spill_contents( const tripoint_bub_ms &pos )
 
 void item_pocket::clear_items()
 {
+    invalidate_contents_totals();
     contents.clear();
 }
 
@@ -1934,6 +2001,7 @@ bool item_pocket::has_item( const item &it ) const
 
 item *item_pocket::get_item_with( const std::function<bool( const item & )> &filter )
 {
+    invalidate_contents_totals();
     for( item &it : contents ) {
         if( filter( it ) ) {
             return &it;
@@ -1954,6 +2022,7 @@ const item *item_pocket::get_item_with( const std::function<bool( const item & )
 
 void item_pocket::remove_items_if( const std::function<bool( item & )> &filter )
 {
+    invalidate_contents_totals();
     contents.remove_if( filter );
     on_contents_changed();
 }
@@ -1962,6 +2031,7 @@ void item_pocket::process( map &here, Character *carrier, const tripoint_bub_ms
                            float insulation,
                            temperature_flag flag, float spoil_multiplier_parent, bool watertight_container )
 {
+    invalidate_contents_totals();
     for( auto iter = contents.begin(); iter != contents.end(); ) {
         if( iter->process( here, carrier, pos, insulation, flag,
                            // spoil multipliers on pockets are not additive or multiplicative, they choose the best
@@ -1978,6 +2048,7 @@ void item_pocket::process( map &here, Character *carrier, const tripoint_bub_ms
 void item_pocket::leak( map &here, Character *carrier, const tripoint_bub_ms &pos,
                         item_pocket *pocke )
 {
+    invalidate_contents_totals();
     std::vector<item *> erases;
     for( auto iter = contents.begin(); iter != contents.end(); ) {
         if( iter->leak( here, carrier, pos, this ) ) {
@@ -2094,6 +2165,7 @@ const pocket_data *item_pocket::get_pocket_data() const
 
 void item_pocket::add( const item &it, item **ret )
 {
+    invalidate_contents_totals();
     contents.push_back( it );
     if( ret == nullptr ) {
         restack();
@@ -2104,6 +2176,7 @@ void item_pocket::add( const item &it, item **ret )
 
 void item_pocket::add( const item &it, const int copies, std::vector<item *> &added )
 {
+    invalidate_contents_totals();
     for( auto iter = contents.insert( contents.end(), copies, it ); iter != contents.end(); iter++ ) {
         added.push_back( &*iter );
     }
@@ -2124,6 +2197,7 @@ bool item_pocket::can_unload_liquid() const
 int item_pocket::fill_with( const item &contained, Character &guy, int amount,
                             bool allow_unseal, bool ignore_settings )
 {
+    invalidate_contents_totals();
     int num_contained = 0;
 
     if( !contained.count_by_charges() || amount <= 0 ) {
@@ -2169,12 +2243,14 @@ int item_pocket::fill_with( const item &contained, Character &guy, int amount,
 
 std::list<item> &item_pocket::edit_contents()
 {
+    invalidate_contents_totals();
     return contents;
 }
 
 ret_val<item *> item_pocket::insert_item( const item &it,
         const bool into_bottom, bool restack_charges, bool ignore_contents )
 {
+    invalidate_contents_totals();
     ret_val<item_pocket::contain_code> containable = can_contain( it, ignore_contents );
 
     if( !containable.success() ) {
@@ -2199,6 +2275,7 @@ std::pair<item_location, item_pocket *> item_pocket::best_pocket_in_contents(
     item_location &this_loc, const item &it, const item *avoid,
     const bool allow_sealed, const bool ignore_settings )
 {
+    invalidate_contents_totals();
     std::pair<item_location, item_pocket *> ret( this_loc, nullptr );
     // If the current pocket has restrictions or blacklists the item or is a holster,
     // try the nested pocket regardless of whether it's soft or rigid.
@@ -2285,20 +2362,12 @@ units::length item_pocket::min_containable_length() const
 
 units::volume item_pocket::contains_volume() const
 {
-    units::volume vol = 0_ml;
-    for( const item &it : contents ) {
-        vol += it.volume();
-    }
-    return vol;
+    return get_volume_totals().contained;
 }
 
 units::mass item_pocket::contains_weight() const
 {
-    units::mass weight = 0_gram;
-    for( const item &it : contents ) {
-        weight += it.weight();
-    }
-    return weight;
+    return get_weight_totals().contained;
 }
 
 units::mass item_pocket::remaining_weight() const
@@ -2353,6 +2422,7 @@ int item_pocket::best_quality( const quality_id &id ) const
 
 void item_pocket::heat_up()
 {
+    invalidate_contents_totals();
     for( item &it : contents ) {
         if( it.has_temperature() ) {
             it.heat_up();
@@ -3,6 +3,7 @@
 #define CATA_SRC_ITEM_POCKET_H
 
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iosfwd>
 #include <list>
@@ -232,6 +233,24 @@ class item_pocket
         units::mass item_weight_modifier() const;
         units::length item_length_modifier() const;
 
+        /**
+         * Drops the cached weight and volume totals of every pocket.
+         *
+         * Each pocket caches the summed weight and volume of its contents. Because a pocket
+         * does not know its parent, any change to contents invalidates the totals of all
+         * pockets, so that parent containers never report stale sums. The pocket's own mutating
+         * functions call this, as do the item mutators (set_var, set_flag, convert, ammo_set,
+         * on_contents_changed, ...) and Character::invalidate_weight_carried_cache.
+         * Fields that are written directly, like item::charges, are checked through
+         * @ref contents_state instead.
+         */
+        static void invalidate_contents_totals();
+        /**
+         * Hash of the type, corpse and charges of every contained item, nested ones included.
+         * The cached totals are only used while it's unchanged.
+         */
+        size_t contents_state() const;
+
         /** gets the spoilage multiplier depending on sealed data */
         float spoil_multiplier() const;
 
@@ -360,6 +379,8 @@ class item_pocket
         // @relates visitable
         VisitResponse visit_contents( const std::function<VisitResponse( item *, item * )> &func,
                                       item *parent = nullptr );
+        template<typename F>
+        VisitResponse visit_contents_inline( F &func, item *parent = nullptr );
 
         void general_info( std::vector<iteminfo> &info, int pocket_number, bool disp_pocket_number ) const;
         void contents_info( std::vector<iteminfo> &info, int pocket_number, bool disp_pocket_number ) const;
@@ -416,6 +437,29 @@ class item_pocket
         // list of sub body parts that can't currently support rigid ablative armor
         std::set<sub_bodypart_id> no_rigid;
 
+        // totals over contents, valid while generation matches the one bumped by
+        // invalidate_contents_totals() and state matches contents_state()
+        struct weight_totals {
+            uint64_t generation = 0;
+            size_t state = 0;
+            // sum of item::weight()
+            units::mass contained = 0_gram;
+            // item_weight_modifier()
+            units::mass modifier = 0_gram;
+        };
+        struct volume_totals {
+            uint64_t generation = 0;
+            size_t state = 0;
+            // sum of item::volume()
+            units::volume contained = 0_ml;
+            // sum of the item volumes added to the parent, before rigidity and magazine well
+            units::volume modifier = 0_ml;
+        };
+        mutable weight_totals cached_weight; // NOLINT(cata-serialize)
+        mutable volume_totals cached_volume; // NOLINT(cata-serialize)
+        const weight_totals &get_weight_totals() const;
+        const volume_totals &get_volume_totals() const;
+
         ret_val<contain_code> _can_contain( const item &it, int &copies_remaining,
                                             bool ignore_contents ) const;
 };
@@ -1,5 +1,6 @@
 #include "item_tname.h"
 
+#include <algorithm>
 #include <set>
 #include <string>
 #include <vector>
@@ -119,11 +120,19 @@ std::string burn( item const &it, unsigned int /* quantity */,
     return {};
 }
 
+// Flag sets iterate in load order, names shouldn't depend on it
+std::vector<flag_id> sorted_by_id( const item::FlagsSetType &flags )
+{
+    std::vector<flag_id> sorted( flags.begin(), flags.end() );
+    std::sort( sorted.begin(), sorted.end(), flag_id::LexCmp() );
+    return sorted;
+}
+
 std::string custom_item_prefix( item const &it, unsigned int /* quantity */,
                                 segment_bitset const &/* segments */ )
 {
     std::string prefix;
-    for( const flag_id &f : it.get_prefix_flags() ) {
+    for( const flag_id &f : sorted_by_id( it.get_prefix_flags() ) ) {
         prefix += f->item_prefix().translated();
     }
     return prefix;
@@ -133,7 +142,7 @@ std::string custom_item_suffix( item const &it, unsigned int /* quantity */,
                                 segment_bitset const &/* segments */ )
 {
     std::string suffix;
-    for( const flag_id &f : it.get_suffix_flags() ) {
+    for( const flag_id &f : sorted_by_id( it.get_suffix_flags() ) ) {
         suffix.insert( 0, f->item_suffix().translated() );
     }
     return suffix;
@@ -163,6 +163,9 @@ bool itype::has_use() const
 
 bool itype::has_flag( const flag_id &flag ) const
 {
+    if( item_tag_bits_ready ) {
+        return item_tag_bits.count( flag );
+    }
     return item_tags.count( flag );
 }
 
@@ -19,6 +19,7 @@
 #include "damage.h"
 #include "enums.h" // point
 #include "explosion.h"
+#include "flag_set.h"
 #include "game_constants.h"
 #include "item_pocket.h"
 #include "iuse.h" // use_function
@@ -1383,6 +1384,9 @@ struct itype {
         mtype_id source_monster = mtype_id::NULL_ID();
     private:
         FlagsSetType item_tags;
+        /** Copy of @ref item_tags as a bitset, built by Item_factory once the flags are final. */
+        flag_set item_tag_bits;
+        bool item_tag_bits_ready = false;
 
     public:
         // memory card related per-type static data
@@ -22,12 +22,14 @@ struct level_cache {
         level_cache();
         level_cache( const level_cache &other ) = default;
 
+        // The dirty flags and floor gaps are per submap, indexed by x * MAPSIZE + y
         std::bitset<MAPSIZE *MAPSIZE> transparency_cache_dirty;
-        bool outside_cache_dirty = false;
-        bool floor_cache_dirty = false;
+        std::bitset<MAPSIZE *MAPSIZE> outside_cache_dirty;
+        std::bitset<MAPSIZE *MAPSIZE> floor_cache_dirty;
         bool seen_cache_dirty = false;
         // This is a single value indicating that the entire level is floored.
         bool no_floor_gaps = false;
+        std::bitset<MAPSIZE *MAPSIZE> floor_gaps;
 
         cata::mdarray<four_quadrants, point_bub_ms> lm;
         cata::mdarray<float, point_bub_ms> sm;
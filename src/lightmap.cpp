@@ -38,6 +38,7 @@
 #include "string_formatter.h"
 #include "submap.h"
 #include "tileray.h"
+#include "turn_profiler.h"
 #include "type_id.h"
 #include "units.h"
 #include "units_utility.h"
@@ -100,6 +101,7 @@ void map::add_light_from_items( const tripoint_bub_ms &p, const item_stack &item
 // TODO: Consider making this just clear the cache and dynamically fill it in as is_transparent() is called
 bool map::build_transparency_cache( const int zlev )
 {
+    PROFILE_ZONE( "build_transparency_cache" );
     level_cache &map_cache = get_cache( zlev );
     auto &transparent_cache_wo_fields = map_cache.transparent_cache_wo_fields;
     auto &transparency_cache = map_cache.transparency_cache;
@@ -443,6 +445,7 @@ void map::build_sunlight_cache( int pzlev )
 
 void map::generate_lightmap( const int zlev )
 {
+    PROFILE_ZONE( "generate_lightmap" );
     level_cache &map_cache = get_cache( zlev );
     auto &lm = map_cache.lm;
     auto &sm = map_cache.sm;
@@ -1050,6 +1053,7 @@ castLightAll<fragment_cloud, fragment_cloud, shrapnel_calc, shrapnel_check,
 void map::build_seen_cache( const tripoint_bub_ms &origin, const int target_z, int extension_range,
                             bool cumulative, bool camera, int penalty )
 {
+    PROFILE_ZONE( "build_seen_cache" );
     level_cache &map_cache = get_cache( target_z );
     using mdarray = cata::mdarray<float, point_bub_ms>;
     mdarray &transparency_cache = map_cache.vision_transparency_cache;
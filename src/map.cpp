@@ -5,6 +5,7 @@
 #include <climits>
 #include <cmath>
 #include <cstdlib>
+#include <numeric>
 #include <optional>
 #include <ostream>
 #include <queue>
@@ -93,6 +94,7 @@
 #include "tileray.h"
 #include "translations.h"
 #include "trap.h"
+#include "turn_profiler.h"
 #include "ui_manager.h"
 #include "units.h"
 #include "value_ptr.h"
@@ -315,17 +317,49 @@ void map::set_seen_cache_dirty( const int zlevel )
     }
 }
 
+// Whether the tile above can be seen through or fallen through, unless furniture below roofs it
+static bool leaves_floor_gap( const ter_t &terrain )
+{
+    return terrain.has_flag( ter_furn_flag::TFLAG_NO_FLOOR ) ||
+           terrain.has_flag( ter_furn_flag::TFLAG_NO_FLOOR_WATER ) ||
+           terrain.has_flag( ter_furn_flag::TFLAG_GOES_DOWN ) ||
+           terrain.has_flag( ter_furn_flag::TFLAG_TRANSPARENT_FLOOR );
+}
+
 void map::set_outside_cache_dirty( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
-        get_cache( zlev ).outside_cache_dirty = true;
+        get_cache( zlev ).outside_cache_dirty.set();
+    }
+}
+
+void map::set_outside_cache_dirty( const tripoint_bub_ms &p )
+{
+    if( !inbounds( p ) ) {
+        return;
+    }
+    level_cache &cache = get_cache( p.z() );
+    // Being indoors also shelters the tiles around it, which may be on the next submap
+    for( const tripoint_bub_ms &near : points_in_radius( p, 1 ) ) {
+        if( inbounds( near ) ) {
+            const tripoint_bub_sm smp = coords::project_to<coords::sm>( near );
+            cache.outside_cache_dirty.set( smp.x() * MAPSIZE + smp.y() );
+        }
     }
 }
 
 void map::set_floor_cache_dirty( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
-        get_cache( zlev ).floor_cache_dirty = true;
+        get_cache( zlev ).floor_cache_dirty.set();
+    }
+}
+
+void map::set_floor_cache_dirty( const tripoint_bub_ms &p )
+{
+    if( inbounds( p ) ) {
+        const tripoint_bub_sm smp = coords::project_to<coords::sm>( p );
+        get_cache( smp.z() ).floor_cache_dirty.set( smp.x() * MAPSIZE + smp.y() );
     }
 }
 
@@ -401,9 +435,9 @@ void map::invalidate_map_cache( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
         level_cache &ch = get_cache( zlev );
-        ch.floor_cache_dirty = true;
+        ch.floor_cache_dirty.set();
         ch.seen_cache_dirty = true;
-        ch.outside_cache_dirty = true;
+        ch.outside_cache_dirty.set();
         set_transparency_cache_dirty( zlev );
     }
 }
@@ -487,6 +521,8 @@ void map::add_vehicle_to_cache( vehicle *veh )
         debugmsg( "Tried to add null vehicle to cache" );
         return;
     }
+    // Cables find the vehicles they are plugged into through the cache
+    vehicle::invalidate_power_grids();
 
     // Get parts
     for( const vpart_reference &vpr : veh->get_all_parts_with_fakes() ) {
@@ -598,6 +634,7 @@ std::unique_ptr<vehicle> map::detach_vehicle( vehicle *veh )
         debugmsg( "map::detach_vehicle was passed nullptr" );
         return std::unique_ptr<vehicle>();
     }
+    vehicle::invalidate_power_grids();
 
     int z = veh->sm_pos.z;
     if( z < -OVERMAP_DEPTH || z > OVERMAP_HEIGHT ) {
@@ -663,7 +700,90 @@ void map::on_vehicle_moved( const int smz )
     set_pathfinding_cache_dirty( smz );
 }
 
-void map::vehmove()
+// The tiles a vehicle can touch while it spends its moves this turn.  Generous: a tile of margin
+// for turning and skidding, and every z-level for vehicles that can fall or fly.
+static inclusive_cuboid<tripoint_bub_ms> vehicle_reach( const vehicle &veh )
+{
+    tripoint_bub_ms p_min = veh.pos_bub();
+    tripoint_bub_ms p_max = p_min;
+    for( const tripoint_bub_ms &p : veh.get_points() ) {
+        p_min.x() = std::min( p_min.x(), p.x() );
+        p_min.y() = std::min( p_min.y(), p.y() );
+        p_min.z() = std::min( p_min.z(), p.z() );
+        p_max.x() = std::max( p_max.x(), p.x() );
+        p_max.y() = std::max( p_max.y(), p.y() );
+        p_max.z() = std::max( p_max.z(), p.z() );
+    }
+    int reach = 1;
+    if( veh.of_turn > 0.0f ) {
+        reach += static_cast<int>( std::ceil( veh.of_turn * std::abs( veh.velocity ) /
+                                              vehicles::vmiph_per_tile ) );
+    }
+    // Ramps can take it up or down a level for every tile
+    p_min -= tripoint_rel_ms( reach, reach, reach );
+    p_max += tripoint_rel_ms( reach, reach, reach );
+    if( veh.is_falling || veh.vertical_velocity != 0 || veh.is_rotorcraft() ) {
+        p_min.z() = -OVERMAP_DEPTH;
+        p_max.z() = OVERMAP_HEIGHT;
+    }
+    return inclusive_cuboid<tripoint_bub_ms>( p_min, p_max );
+}
+
+// Splits the vehicles into groups that can't touch each other this turn, vehicles that tow
+// each other are in the same group.  Returns the group of every vehicle.
+static std::vector<size_t> group_vehicles_by_reach( const VehicleList &vehicles )
+{
+    std::vector<inclusive_cuboid<tripoint_bub_ms>> reach;
+    std::unordered_map<const vehicle *, size_t> index;
+    reach.reserve( vehicles.size() );
+    for( size_t i = 0; i < vehicles.size(); ++i ) {
+        reach.push_back( vehicle_reach( *vehicles[i].v ) );
+        index.emplace( vehicles[i].v, i );
+    }
+
+    std::vector<size_t> group( vehicles.size() );
+    std::iota( group.begin(), group.end(), 0 );
+    const auto find = [&group]( size_t i ) {
+        while( group[i] != i ) {
+            group[i] = group[group[i]];
+            i = group[i];
+        }
+        return i;
+    };
+    const auto unite = [&group, &find]( size_t a, size_t b ) {
+        group[find( a )] = find( b );
+    };
+
+    // Sweep along x, so only vehicles close along x are compared
+    std::vector<size_t> order( vehicles.size() );
+    std::iota( order.begin(), order.end(), 0 );
+    std::sort( order.begin(), order.end(), [&reach]( size_t a, size_t b ) {
+        return reach[a].p_min.x() < reach[b].p_min.x();
+    } );
+    for( size_t i = 0; i < order.size(); ++i ) {
+        const inclusive_cuboid<tripoint_bub_ms> &a = reach[order[i]];
+        for( size_t j = i + 1; j < order.size() && reach[order[j]].p_min.x() <= a.p_max.x(); ++j ) {
+            const inclusive_cuboid<tripoint_bub_ms> &b = reach[order[j]];
+            if( a.p_min.y() <= b.p_max.y() && b.p_min.y() <= a.p_max.y() &&
+                a.p_min.z() <= b.p_max.z() && b.p_min.z() <= a.p_max.z() ) {
+                unite( order[i], order[j] );
+            }
+        }
+    }
+    for( size_t i = 0; i < vehicles.size(); ++i ) {
+        const auto towed = index.find( vehicles[i].v->tow_data.get_towed() );
+        if( towed != index.end() ) {
+            unite( i, towed->second );
+        }
+    }
+
+    for( size_t i = 0; i < vehicles.size(); ++i ) {
+        group[i] = find( i );
+    }
+    return group;
+}
+
+void map::vehmove( bool broad_phase )
 {
     // give vehicles movement points
     VehicleList vehicle_list;
@@ -690,13 +810,43 @@ void map::vehmove()
         }
     }
 
+    // Vehicles that can't touch any other vehicle this turn don't need to take turns with them,
+    // each spends all its moves at once.  The others take turns, fastest first.
+    VehicleList grouped_vehicles;
+    VehicleList &serial_list = broad_phase ? grouped_vehicles : vehicle_list;
+    if( broad_phase ) {
+        const std::vector<size_t> group = group_vehicles_by_reach( vehicle_list );
+        std::vector<int> group_size( vehicle_list.size() );
+        for( const size_t root : group ) {
+            ++group_size[root];
+        }
+        for( size_t i = 0; i < vehicle_list.size(); ++i ) {
+            if( group_size[group[i]] > 1 ) {
+                grouped_vehicles.push_back( vehicle_list[i] );
+                continue;
+            }
+            // The same choice vehproceed makes, for just this vehicle
+            vehicle *veh = vehicle_list[i].v;
+            for( int count = 0; count < 100 && veh != nullptr; count++ ) {
+                if( veh->of_turn <= 0.0f && !veh->is_falling &&
+                    !( veh->is_rotorcraft() && veh->get_z_change() != 0 ) ) {
+                    break;
+                }
+                veh = veh->act_on_map();
+            }
+        }
+    }
     // 15 equals 3 >50mph vehicles, or up to 15 slow (1 square move) ones
     // But 15 is too low for V12 death-bikes, let's put 100 here
     for( int count = 0; count < 100; count++ ) {
-        if( !vehproceed( vehicle_list ) ) {
+        if( !vehproceed( serial_list ) ) {
             break;
         }
     }
+    if( broad_phase ) {
+        // Vehicles may have been destroyed while moving alone
+        vehicle_list = get_vehicles();
+    }
     // Process item removal on the vehicles that were modified this turn.
     // Use a copy because part_removal_cleanup can modify the container.
     auto temp = dirty_vehicle_list;
@@ -1461,6 +1611,7 @@ void map::unboard_vehicle( const tripoint_bub_ms &p, bool dead_passenger )
 bool map::displace_vehicle( vehicle &veh, const tripoint_rel_ms &dp, const bool adjust_pos,
                             const std::set<int> &parts_to_move )
 {
+    bump_items_revision();
     const tripoint_bub_ms src = veh.pos_bub();
     // handle vehicle ramps
     int ramp_offset = 0;
@@ -1807,6 +1958,7 @@ bool map::furn_set( const tripoint_bub_ms &p, const furn_id &new_furniture, cons
 
     current_submap->set_furn( l, new_target_furniture );
     current_submap->set_map_damage( point_sm_ms( l ), 0 );
+    bump_items_revision();
 
     // Set the dirty flags
     const furn_t &old_f = old_id.obj();
@@ -1858,19 +2010,19 @@ bool map::furn_set( const tripoint_bub_ms &p, const furn_id &new_furniture, cons
 
     if( old_f.has_flag( ter_furn_flag::TFLAG_INDOORS ) != new_f.has_flag(
             ter_furn_flag::TFLAG_INDOORS ) ) {
-        set_outside_cache_dirty( p.z() );
+        set_outside_cache_dirty( p );
     }
 
     if( old_f.has_flag( ter_furn_flag::TFLAG_NO_FLOOR ) != new_f.has_flag(
             ter_furn_flag::TFLAG_NO_FLOOR ) ) {
-        set_floor_cache_dirty( p.z() );
+        set_floor_cache_dirty( p );
         set_seen_cache_dirty( p );
         get_creature_tracker().invalidate_reachability_cache();
     }
 
     if( old_f.has_flag( ter_furn_flag::TFLAG_SUN_ROOF_ABOVE ) != new_f.has_flag(
             ter_furn_flag::TFLAG_SUN_ROOF_ABOVE ) ) {
-        set_floor_cache_dirty( p.z() + 1 );
+        set_floor_cache_dirty( p + tripoint_rel_ms::above );
     }
 
     invalidate_max_populated_zlev( p.z() );
@@ -2313,6 +2465,7 @@ bool map::ter_set( const tripoint_bub_ms &p, const ter_id &new_terrain, bool avo
 
     current_submap->set_ter( l, new_terrain );
     current_submap->set_map_damage( point_sm_ms( l ), 0 );
+    bump_items_revision();
 
     // Set the dirty flags
     const ter_t &old_t = old_id.obj();
@@ -2343,12 +2496,15 @@ bool map::ter_set( const tripoint_bub_ms &p, const ter_id &new_terrain, bool avo
 
     if( old_t.has_flag( ter_furn_flag::TFLAG_INDOORS ) != new_t.has_flag(
             ter_furn_flag::TFLAG_INDOORS ) ) {
-        set_outside_cache_dirty( p.z() );
+        set_outside_cache_dirty( p );
+    }
+
+    if( leaves_floor_gap( new_t ) != leaves_floor_gap( old_t ) ) {
+        set_floor_cache_dirty( p );
     }
 
     if( new_t.has_flag( ter_furn_flag::TFLAG_NO_FLOOR ) != old_t.has_flag(
             ter_furn_flag::TFLAG_NO_FLOOR ) ) {
-        set_floor_cache_dirty( p.z() );
         // It's a set, not a flag
         support_cache_dirty.insert( p );
         set_seen_cache_dirty( p );
@@ -4708,8 +4864,40 @@ void map::crush( const tripoint_bub_ms &p )
         vp->vehicle().damage( *this, vp->part_index(), rng( 100, 1000 ), damage_bash, false );
     }
 }
+static void leave_projectile_trail( map &here, const tripoint_bub_ms &p,
+                                    const std::set<ammo_effect_str_id> &proj_effects )
+{
+    for( const ammo_effect &ae : ammo_effects::get_all() ) {
+        if( proj_effects.count( ae.id ) > 0 ) {
+            if( x_in_y( ae.trail_chance, 100 ) ) {
+                here.add_field( p, ae.trail_field_type, rng( ae.trail_intensity_min, ae.trail_intensity_max ) );
+            }
+        }
+    }
+}
+
 void map::shoot( const tripoint_bub_ms &p, projectile &proj, const bool hit_items )
 {
+    if( !hit_items ) {
+        const std::optional<PathfindingFlags> flags = pathfinding_flags( p );
+        if( flags && !flags->is_set( PathfindingFlag::ShotObstacle ) ) {
+            // Nothing here can slow the projectile down, it only leaves its trail
+            float damage = 0.0f;
+            for( const damage_unit &dam : proj.impact ) {
+                damage += dam.amount * dam.damage_multiplier * dam.unconditional_damage_mult +
+                          dam.res_pen * dam.res_mult * dam.unconditional_res_mult;
+            }
+            if( damage < 0 ) {
+                return;
+            }
+            leave_projectile_trail( *this, p, proj.proj_effects );
+            if( damage == 0 ) {
+                proj.impact.damage_units.clear();
+            }
+            return;
+        }
+    }
+
     // TODO: make bashing better a destroying, worse at penetrating
     std::map<damage_type_id, float> dmg_by_type {};
     for( const damage_unit &dam : proj.impact ) {
@@ -4806,13 +4994,7 @@ void map::shoot( const tripoint_bub_ms &p, projectile &proj, const bool hit_item
     }
     dam = std::max( 0.0f, dam );
 
-    for( const ammo_effect &ae : ammo_effects::get_all() ) {
-        if( ammo_effects.count( ae.id ) > 0 ) {
-            if( x_in_y( ae.trail_chance, 100 ) ) {
-                add_field( p, ae.trail_field_type, rng( ae.trail_intensity_min, ae.trail_intensity_max ) );
-            }
-        }
-    }
+    leave_projectile_trail( *this, p, ammo_effects );
 
     // Check fields?
     field &fields_there = field_at( p );
@@ -5256,6 +5438,7 @@ map_stack::iterator map::i_rem( const tripoint_bub_ms &p, const map_stack::const
     }
 
     current_submap->update_lum_rem( l, *it );
+    bump_items_revision();
 
     return current_submap->get_items( l ).erase( it );
 }
@@ -5290,6 +5473,7 @@ void map::i_clear( const tripoint_bub_ms &p )
 
     current_submap->set_lum( l, 0 );
     current_submap->get_items( l ).clear();
+    bump_items_revision();
 }
 
 std::vector<item *> map::spawn_items( const tripoint_bub_ms &p, const std::vector<item> &new_items )
@@ -5462,6 +5646,7 @@ std::pair<item *, tripoint_bub_ms> map::_add_item_or_charges( const tripoint_bub
         {
             for( item &e : i_at( tile ) ) {
                 if( e.merge_charges( obj ) ) {
+                    bump_items_revision();
                     return e;
                 }
             }
@@ -5637,6 +5822,7 @@ item &map::add_item( const tripoint_bub_ms &p, item new_item, int copies )
     invalidate_max_populated_zlev( p.z() );
 
     current_submap->update_lum_add( l, new_item );
+    bump_items_revision();
 
     const map_stack::iterator new_pos = current_submap->get_items( l ).insert( new_item );
     while( --copies > 0 ) {
@@ -6255,6 +6441,8 @@ std::list<item> map::use_amount( const std::vector<tripoint_bub_ms> &reachable_p
                                  const itype_id &type,
                                  int &quantity, const std::function<bool( const item & )> &filter, bool select_ind )
 {
+    // items are consumed in place, without going through i_rem
+    bump_items_revision();
     std::list<item> ret;
     if( select_ind && !type->count_by_charges() ) {
         std::vector<item_location> locs;
@@ -6364,6 +6552,8 @@ std::list<item> map::use_charges( const std::vector<tripoint_bub_ms> &reachable_
                                   const std::function<bool( const item & )> &filter,
                                   basecamp *bcp, bool in_tools )
 {
+    // charges are consumed in place, without going through i_rem
+    bump_items_revision();
     std::list<item> ret;
 
     // We prefer infinite map sources where available, so search for those
@@ -6927,6 +7117,7 @@ bool map::add_field( const tripoint_bub_ms &p, const field_type_id &type_id, int
     invalidate_max_populated_zlev( p.z() );
 
     if( current_submap->get_field( l ).add_field( converted_type_id, intensity, age ) ) {
+        bump_items_revision();
         //Only adding it to the count if it doesn't exist.
         if( !current_submap->field_count++ ) {
             get_cache( p.z() ).field_cache.set(
@@ -6967,6 +7158,7 @@ void map::delete_field( const tripoint_bub_ms &p, const field_type_id &field_to_
         if( it->second.get_field_type() == field_to_remove ) {
             --current_submap->field_count;
             curfield.remove_field( it );
+            bump_items_revision();
             break;
         }
     }
@@ -6996,7 +7188,7 @@ void map::on_field_modified( const tripoint_bub_ms &p, const field_type &fd_type
         set_seen_cache_dirty( p );
     }
 
-    if( fd_type.is_dangerous() ) {
+    if( fd_type.is_dangerous() || fd_type.bash_info ) {
         set_pathfinding_cache_dirty( p );
     }
 
@@ -8260,6 +8452,7 @@ void map::load( const tripoint_abs_sm &w, const bool update_vehicle,
     for( auto &traps : traplocs ) {
         traps.clear();
     }
+    bump_items_revision();
     field_furn_locs.clear();
     field_ter_locs.clear();
     submaps_with_active_items.clear();
@@ -8373,6 +8566,7 @@ void map::shift( const point_rel_sm &sp )
     if( sp == point_rel_sm::zero ) {
         return; // Skip this?
     }
+    bump_items_revision();
 
     if( std::abs( sp.x() ) > 1 || std::abs( sp.y() ) > 1 ) {
         debugmsg( "map::shift called with a shift of more than one submap" );
@@ -9710,24 +9904,58 @@ int map::determine_wall_corner( const tripoint_bub_ms &p ) const
 void map::build_outside_cache( const int zlev )
 {
     auto *ch_lazy = get_cache_lazy( zlev );
-    if( !ch_lazy || !ch_lazy->outside_cache_dirty ) {
+    if( !ch_lazy || ch_lazy->outside_cache_dirty.none() ) {
         return;
     }
     level_cache &ch = *ch_lazy;
 
-    // Make a bigger cache to avoid bounds checking
-    // We will later copy it to our regular cache
-    const size_t padded_w = MAPSIZE_X + 2;
-    const size_t padded_h = MAPSIZE_Y + 2;
-    cata::mdarray<bool, point_bub_ms, padded_w, padded_h> padded_cache;
-
     auto &outside_cache = ch.outside_cache;
     if( zlev < 0 ) {
         std::uninitialized_fill_n(
             &outside_cache[0][0], MAPSIZE_X * MAPSIZE_Y, false );
+        ch.outside_cache_dirty.reset();
         return;
     }
 
+    if( !ch.outside_cache_dirty.all() ) {
+        // Only some submaps changed, look at the tiles around each of their tiles
+        const auto indoors = [this]( const tripoint_bub_ms & p ) {
+            point_sm_ms l;
+            const submap *cur_submap = unsafe_get_submap_at( p, l );
+            return cur_submap != nullptr &&
+                   ( cur_submap->get_ter( l ).obj().has_flag( ter_furn_flag::TFLAG_INDOORS ) ||
+                     cur_submap->get_furn( l ).obj().has_flag( ter_furn_flag::TFLAG_INDOORS ) );
+        };
+        for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
+            for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+                if( !ch.outside_cache_dirty[smx * MAPSIZE + smy] ) {
+                    continue;
+                }
+                for( int sx = 0; sx < SEEX; ++sx ) {
+                    for( int sy = 0; sy < SEEY; ++sy ) {
+                        const tripoint_bub_ms p( sx + smx * SEEX, sy + smy * SEEY, zlev );
+                        bool outside = true;
+                        for( const tripoint_bub_ms &near : points_in_radius( p, 1 ) ) {
+                            if( inbounds( near ) && indoors( near ) ) {
+                                outside = false;
+                                break;
+                            }
+                        }
+                        outside_cache[p.x()][p.y()] = outside;
+                    }
+                }
+            }
+        }
+        ch.outside_cache_dirty.reset();
+        return;
+    }
+
+    // Make a bigger cache to avoid bounds checking
+    // We will later copy it to our regular cache
+    const size_t padded_w = MAPSIZE_X + 2;
+    const size_t padded_h = MAPSIZE_Y + 2;
+    cata::mdarray<bool, point_bub_ms, padded_w, padded_h> padded_cache;
+
     padded_cache.fill( true );
 
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
@@ -9762,7 +9990,7 @@ void map::build_outside_cache( const int zlev )
         std::copy_n( &padded_cache[x + 1][1], SEEX * my_MAPSIZE, &outside_cache[x][0] );
     }
 
-    ch.outside_cache_dirty = false;
+    ch.outside_cache_dirty.reset();
 }
 
 void map::build_obstacle_cache(
@@ -9866,22 +10094,29 @@ std::bitset<OVERMAP_LAYERS> map::get_inter_level_visibility( const int origin_zl
 
 bool map::build_floor_cache( const int zlev )
 {
+    PROFILE_ZONE( "build_floor_cache" );
     auto *ch_lazy = get_cache_lazy( zlev );
-    if( !ch_lazy || !ch_lazy->floor_cache_dirty ) {
+    if( !ch_lazy || ch_lazy->floor_cache_dirty.none() ) {
         return false;
     }
     level_cache &ch = *ch_lazy;
 
     auto &floor_cache = ch.floor_cache;
-    std::uninitialized_fill_n(
-        &floor_cache[0][0], MAPSIZE_X * MAPSIZE_Y, true );
-    bool &no_floor_gaps = ch.no_floor_gaps;
-    no_floor_gaps = true;
+    const bool rebuild_all = ch.floor_cache_dirty.all();
+    if( rebuild_all ) {
+        std::uninitialized_fill_n(
+            &floor_cache[0][0], MAPSIZE_X * MAPSIZE_Y, true );
+        ch.floor_gaps.reset();
+    }
 
     bool lowest_z_lev = zlev <= -OVERMAP_DEPTH;
 
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+            const int sm_index = smx * MAPSIZE + smy;
+            if( !rebuild_all && !ch.floor_cache_dirty[sm_index] ) {
+                continue;
+            }
             const submap *cur_submap = get_submap_at_grid( tripoint_rel_sm{ smx, smy, zlev } );
             const submap *below_submap = !lowest_z_lev ? get_submap_at_grid( tripoint_rel_sm{ smx, smy, zlev - 1 } ) :
                                          nullptr;
@@ -9896,28 +10131,28 @@ bool map::build_floor_cache( const int zlev )
                 continue;
             }
 
+            bool gaps = false;
             for( int sx = 0; sx < SEEX; ++sx ) {
                 for( int sy = 0; sy < SEEY; ++sy ) {
                     point_sm_ms sp( sx, sy );
-                    const ter_t &terrain = cur_submap->get_ter( sp ).obj();
-                    if( terrain.has_flag( ter_furn_flag::TFLAG_NO_FLOOR ) ||
-                        terrain.has_flag( ter_furn_flag::TFLAG_NO_FLOOR_WATER ) ||
-                        terrain.has_flag( ter_furn_flag::TFLAG_GOES_DOWN ) ||
-                        terrain.has_flag( ter_furn_flag::TFLAG_TRANSPARENT_FLOOR ) ) {
+                    const point p( sx + smx * SEEX, sy + smy * SEEY );
+                    floor_cache[p.x][p.y] = true;
+                    if( leaves_floor_gap( cur_submap->get_ter( sp ).obj() ) ) {
                         if( below_submap &&
                             below_submap->get_furn( sp ).obj().has_flag( ter_furn_flag::TFLAG_SUN_ROOF_ABOVE ) ) {
                             continue;
                         }
-                        const point p( sx + smx * SEEX, sy + smy * SEEY );
                         floor_cache[p.x][p.y] = false;
-                        no_floor_gaps = false;
+                        gaps = true;
                     }
                 }
             }
+            ch.floor_gaps[sm_index] = gaps;
         }
     }
 
-    ch.floor_cache_dirty = false;
+    ch.no_floor_gaps = ch.floor_gaps.none();
+    ch.floor_cache_dirty.reset();
     return zlevels;
 }
 
@@ -10895,73 +11130,65 @@ const pathfinding_cache &map::get_pathfinding_cache_ref( int zlev ) const
     return cache;
 }
 
+std::optional<PathfindingFlags> map::pathfinding_flags( const tripoint_bub_ms &p ) const
+{
+    if( !inbounds( p ) ) {
+        return std::nullopt;
+    }
+    return get_pathfinding_cache_ref( p.z() ).special[p.xy()];
+}
+
 void map::update_pathfinding_cache( const tripoint_bub_ms &p ) const
 {
     if( !inbounds( p ) ) {
         return;
     }
     pathfinding_cache &cache = get_pathfinding_cache( p.z() );
-    PathfindingFlags cur_value = PathfindingFlag::Ground;
 
     const_maptile tile = maptile_at_internal( p );
 
-    const ter_t &terrain = tile.get_ter_t();
-    const furn_t &furniture = tile.get_furn_t();
     const field &field = tile.get_field();
     const map &here = get_map();
     int part;
     const vehicle *veh = veh_at_internal( p, part );
+    const pathfinding_base base = pathfinding_base::of( tile.get_ter(), tile.get_furn() );
 
-    const int cost = move_cost_internal( furniture, terrain, field, veh, part );
+    // Only fields and vehicles change what the terrain and furniture cost to move through
+    const int cost = veh == nullptr && field.field_count() == 0 ? base.movecost :
+                     move_cost_internal( tile.get_furn_t(), tile.get_ter_t(), field, veh, part );
 
+    PathfindingFlags cur_value = PathfindingFlag::Ground | base.flags;
     if( cost > 2 ) {
         cur_value |= PathfindingFlag::Slow;
     } else if( cost <= 0 ) {
-        cur_value |= PathfindingFlag::Obstacle;
-        if( terrain.has_flag( ter_furn_flag::TFLAG_CLIMBABLE ) ) {
-            cur_value |= PathfindingFlag::Climbable;
-        }
+        cur_value |= PathfindingFlag::Obstacle | base.obstacle_flags;
     }
 
     if( veh != nullptr ) {
         cur_value |= PathfindingFlag::Vehicle;
     }
 
-    for( const auto &fld : tile.get_field() ) {
+    // Everything map::shoot does more than leaving a trail for
+    if( veh != nullptr || cost <= 0 ) {
+        cur_value |= PathfindingFlag::ShotObstacle;
+    }
+
+    for( const auto &fld : field ) {
         const field_entry &cur = fld.second;
         if( cur.is_dangerous() ) {
             cur_value |= PathfindingFlag::DangerousField;
         }
+        if( cur.get_field_type()->bash_info ) {
+            cur_value |= PathfindingFlag::ShotObstacle;
+        }
     }
 
-    if( ( !tile.get_trap_t().is_benign() || !terrain.trap.obj().is_benign() ) &&
-        !here.has_vehicle_floor( p ) ) {
-        cur_value |= PathfindingFlag::DangerousTrap;
-    }
-
-    if( terrain.has_flag( ter_furn_flag::TFLAG_GOES_UP ) ) {
-        cur_value |= PathfindingFlag::GoesUp;
-    }
-
-    if( terrain.has_flag( ter_furn_flag::TFLAG_GOES_DOWN ) ) {
-        cur_value |= PathfindingFlag::GoesDown;
-    }
-
-    if( terrain.has_flag( ter_furn_flag::TFLAG_RAMP ) ||
-        terrain.has_flag( ter_furn_flag::TFLAG_RAMP_UP ) ) {
-        cur_value |= PathfindingFlag::GoesUp | PathfindingFlag::RampUp;
-    }
-
-    if( terrain.has_flag( ter_furn_flag::TFLAG_RAMP_DOWN ) ) {
-        cur_value |= PathfindingFlag::GoesDown | PathfindingFlag::RampDown;
-    }
-
-    if( terrain.has_flag( ter_furn_flag::TFLAG_SHARP ) && !here.has_vehicle_floor( p ) ) {
-        cur_value |= PathfindingFlag::Sharp;
+    PathfindingFlags floor_flags = base.floor_flags;
+    if( !tile.get_trap_t().is_benign() ) {
+        floor_flags |= PathfindingFlag::DangerousTrap;
     }
-
-    if( terrain.has_flag( ter_furn_flag::TFLAG_SMALL_PASSAGE ) ) {
-        cur_value |= ( PathfindingFlag::RestrictLarge | PathfindingFlag::RestrictHuge );
+    if( floor_flags && !here.has_vehicle_floor( p ) ) {
+        cur_value |= floor_flags;
     }
 
     cache.special[p.x()][p.y()] = cur_value;
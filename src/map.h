@@ -418,7 +418,11 @@ class map
         // invalidates seen cache for the whole zlevel unconditionally
         void set_seen_cache_dirty( int zlevel );
         void set_outside_cache_dirty( int zlev );
+        // only the submaps of p and the tiles around it, p is in local coords ("ms")
+        void set_outside_cache_dirty( const tripoint_bub_ms &p );
         void set_floor_cache_dirty( int zlev );
+        // only the submap of p, p is in local coords ("ms")
+        void set_floor_cache_dirty( const tripoint_bub_ms &p );
         void set_pathfinding_cache_dirty( int zlev );
         void set_pathfinding_cache_dirty( const tripoint_bub_ms &p );
         /*@}*/
@@ -817,8 +821,9 @@ class map
         // Removes vehicle from map and returns it in unique_ptr
         std::unique_ptr<vehicle> detach_vehicle( vehicle *veh );
         void destroy_vehicle( vehicle *veh );
-        // Vehicle movement
-        void vehmove();
+        // Vehicle movement.  Vehicles too far apart to touch each other this turn move on their
+        // own, without the broad phase every vehicle takes turns with all others, fastest first.
+        void vehmove( bool broad_phase = true );
         // Selects a vehicle to move, returns false if no moving vehicles
         bool vehproceed( VehicleList &vehicle_list );
 
@@ -1430,6 +1435,18 @@ class map
         // TODO: fix point types (remove the first overload)
         void i_rem( const tripoint &p, item *it );
         void i_rem( const tripoint_bub_ms &p, item *it );
+        /**
+         * Counter that is bumped whenever items, furniture, terrain or fields change, and when
+         * vehicles move or their parts or fuel change.
+         * Caches built by scanning an area of the map (e.g. the crafting inventory) compare it
+         * against the value they were built with to tell whether they need to be rebuilt.
+         */
+        int get_items_revision() const {
+            return items_revision;
+        }
+        void bump_items_revision() {
+            ++items_revision;
+        }
         void spawn_artifact( const tripoint_bub_ms &p, const relic_procgen_id &id, int max_attributes = 5,
                              int power_level = 1000, int max_negative_power = -2000, bool is_resonant = false );
         // TODO: Get rid of untyped overload
@@ -2447,6 +2464,9 @@ class map
         std::set<tripoint_abs_sm> submaps_with_active_items;
         std::set<tripoint_abs_sm> submaps_with_active_items_dirty;
 
+        // @see get_items_revision
+        int items_revision = 0;
+
         /**
          * Cache of coordinate pairs recently checked for visibility.
          */
@@ -2491,6 +2511,12 @@ class map
         }
 
         const pathfinding_cache &get_pathfinding_cache_ref( int zlev ) const;
+        /**
+         * The flags of @p p in the pathfinding cache, which only rebuilds the tiles that changed
+         * since it was last used.  Cheaper than asking the map about the tile, so code walking
+         * lines tile by tile uses it.  Returns std::nullopt for points out of bounds.
+         */
+        std::optional<PathfindingFlags> pathfinding_flags( const tripoint_bub_ms &p ) const;
 
         void update_pathfinding_cache( const tripoint_bub_ms &p ) const;
         void update_pathfinding_cache( int zlev ) const;
@@ -28,6 +28,8 @@ class map_cursor : public visitable
         // inherited from visitable
         VisitResponse visit_items( const std::function<VisitResponse( item *, item * )> &func ) const
         override;
+        template<typename F>
+        VisitResponse visit_items_inline( F &&func ) const;
         std::list<item> remove_items_with( const std::function<bool( const item & )> &filter,
                                            int count = INT_MAX ) override;
 };
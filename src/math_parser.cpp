@@ -177,16 +177,6 @@ bool is_assign_target( thingie const &thing )
            std::holds_alternative<func_diag>( thing.data );
 }
 
-std::vector<double> _eval_params( std::vector<thingie> const &params, const_dialogue const &d )
-{
-    std::vector<double> elems( params.size() );
-    std::transform( params.begin(), params.end(), elems.begin(),
-    [&d]( thingie const & e ) {
-        return e.eval( d );
-    } );
-    return elems;
-}
-
 constexpr void _validate_operand( thingie const &thing, std::string_view symbol )
 {
     if( std::holds_alternative<std::string>( thing.data ) ) {
@@ -214,33 +204,28 @@ func_jmath::func_jmath( std::vector<thingie> &&params_,
                         jmath_func_id const &id_ ) : params( params_ ),
     id( id_ ) {}
 
-double func::eval( const_dialogue const &d ) const
-{
-    return f( _eval_params( params, d ) );
-}
-
-double func_jmath::eval( const_dialogue const &d ) const
-{
-    return id->eval( d, _eval_params( params, d ) );
-}
-
 double var::eval( const_dialogue const &d ) const
 {
-    std::string const str = read_var_value( varinfo, d );
-    if( str.empty() ) {
+    var_value buffer;
+    const var_value *val = find_var_value( varinfo, d, buffer );
+    if( val == nullptr ) {
+        buffer = var_value( varinfo.default_val );
+        val = &buffer;
+    }
+    if( val->empty() ) {
         return 0;
     }
-    if( std::optional<double> ret = svtod( str ); ret ) {
+    if( std::optional<double> ret = val->dbl(); ret ) {
         return *ret;
     }
     throw math::runtime_error( R"(failed to convert variable "%s" with value "%s" to a number)",
-                               varinfo.name, str );
+                               varinfo.name, val->str() );
     return 0;
 }
 
 void var::assign( dialogue &d, double val ) const
 {
-    write_var_value( varinfo.type, varinfo.name, &d, val );
+    write_var_value( varinfo.type, varinfo.key, &d, var_value( val ) );
 }
 
 oper::oper( thingie l_, thingie r_, binary_op::f_t op_ ):
@@ -248,11 +233,6 @@ oper::oper( thingie l_, thingie r_, binary_op::f_t op_ ):
     r( std::make_shared<thingie>( std::move( r_ ) ) ),
     op( op_ ) {}
 
-double oper::eval( const_dialogue const &d ) const
-{
-    return ( *op )( l->eval( d ), r->eval( d ) );
-}
-
 kwarg::kwarg( std::string_view key_, thingie val_ )
     : key( key_ ),
       val( std::make_shared<thingie>( std::move( val_ ) ) ) {}
@@ -262,42 +242,345 @@ ternary::ternary( thingie cond_, thingie mhs_, thingie rhs_ )
       mhs( std::make_shared<thingie>( std::move( mhs_ ) ) ),
       rhs( std::make_shared<thingie>( std::move( rhs_ ) ) ) {}
 
-double ternary::eval( const_dialogue const &d ) const
-{
-    return cond->eval( d ) > 0 ? mhs->eval( d ) : rhs->eval( d );
-}
-
 ass_oper::ass_oper( thingie lhs_, thingie mhs_, thingie rhs_, binary_op::f_t op_ )
     : lhs( std::make_shared<thingie>( std::move( lhs_ ) ) ),
       mhs( std::make_shared<thingie>( std::move( mhs_ ) ) ),
       rhs( std::make_shared<thingie>( std::move( rhs_ ) ) ),
       op( op_ ) {}
 
-double ass_oper::eval( dialogue &d ) const
+namespace
 {
-    std::visit( overloaded{
-        [&d, this]( auto const & v ) -> void
+
+using math_code = math_program::instruction::code;
+
+// rng() and rand() must roll every time and clamp() complains about its arguments when it runs
+bool is_foldable( math_func::f_t f )
+{
+    constexpr std::array<math_func::f_t, 3> impure{ math_rng, rand, clamp };
+    return std::find( impure.begin(), impure.end(), f ) == impure.end();
+}
+
+// The index of a jmath function argument read as _0, _1, ...
+std::optional<int> argument_index( var_info const &info )
+{
+    if( info.type != var_type::context || info.name.empty() || info.name.size() > 3 ||
+        !std::all_of( info.name.begin(), info.name.end(), []( char c ) {
+        return c >= '0' && c <= '9';
+    } ) ) {
+        return std::nullopt;
+    }
+    return std::stoi( info.name );
+}
+
+// Whether evaluating a dialogue function argument may read the dialogue context
+bool reads_context( diag_value const &val )
+{
+    return std::visit( overloaded{
+        []( var_info const & v )
+        {
+            return v.type == var_type::context || v.type == var_type::var;
+        },
+        []( math_exp const & /* v */ )
         {
-            if constexpr( v_has_assign<decltype( v )> )
+            return true;
+        },
+        []( diag_array const & v )
+        {
+            return std::any_of( v.begin(), v.end(), reads_context );
+        },
+        []( auto const & /* v */ )
+        {
+            return false;
+        },
+    },
+    val.data );
+}
+
+class math_compiler
+{
+    public:
+        explicit math_compiler( math_program &prog_ ) : prog( prog_ ) {}
+
+        // Returns the value of the node if it was folded into a constant
+        std::optional<double> compile( thingie const &node );
+
+    private:
+        math_program &prog;
+        int depth = 0;
+
+        math_program::instruction &emit( math_code op, int idx = 0, int nargs = 0 );
+        void push( double val );
+        void grow( int count );
+        // pops the last constants emitted
+        std::vector<double> take_constants( int count );
+        std::optional<double> compile_oper( oper const &v );
+        std::optional<double> compile_func( func const &v );
+        std::optional<double> compile_ternary( ternary const &v );
+        void compile_assignment( ass_oper const &v );
+};
+
+math_program::instruction &math_compiler::emit( math_code op, int idx, int nargs )
+{
+    math_program::instruction &ins = prog.code.emplace_back();
+    ins.op = op;
+    ins.idx = idx;
+    ins.nargs = nargs;
+    return ins;
+}
+
+void math_compiler::push( double val )
+{
+    emit( math_code::constant ).val = val;
+    grow( 1 );
+}
+
+void math_compiler::grow( int count )
+{
+    depth += count;
+    prog.stack_size = std::max( prog.stack_size, depth );
+}
+
+std::vector<double> math_compiler::take_constants( int count )
+{
+    std::vector<double> vals;
+    for( auto it = prog.code.end() - count; it != prog.code.end(); ++it ) {
+        vals.emplace_back( it->val );
+    }
+    prog.code.resize( prog.code.size() - count );
+    depth -= count;
+    return vals;
+}
+
+std::optional<double> math_compiler::compile( thingie const &node )
+{
+    return std::visit( overloaded{
+        [this]( double v ) -> std::optional<double>
+        {
+            push( v );
+            return v;
+        },
+        [this]( var const & v ) -> std::optional<double>
+        {
+            int const idx = static_cast<int>( prog.vars.size() );
+            prog.vars.emplace_back( v );
+            if( std::optional<int> arg = argument_index( v.varinfo ); arg )
             {
-                double const val = op( mhs->eval( d ), rhs->eval( d ) ) ;
-                v.assign( d, val );
+                emit( math_code::load_arg, idx, *arg );
             } else
             {
-                throw math::internal_error( "math called assign() on unexpected node without assign()" );
+                emit( math_code::load_var, idx );
             }
+            grow( 1 );
+            return std::nullopt;
+        },
+        [this]( func_diag const & v ) -> std::optional<double>
+        {
+            emit( math_code::load_diag, static_cast<int>( prog.diags.size() ) );
+            prog.diags.emplace_back( v );
+            grow( 1 );
+            return std::nullopt;
+        },
+        [this]( oper const & v )
+        {
+            return compile_oper( v );
+        },
+        [this]( func const & v )
+        {
+            return compile_func( v );
+        },
+        [this]( func_jmath const & v ) -> std::optional<double>
+        {
+            for( thingie const &param : v.params ) {
+                compile( param );
+            }
+            int const nargs = static_cast<int>( v.params.size() );
+            emit( math_code::call_jmath, static_cast<int>( prog.jmaths.size() ), nargs );
+            prog.jmaths.emplace_back( v.id );
+            grow( 1 - nargs );
+            return std::nullopt;
+        },
+        [this]( ternary const & v )
+        {
+            return compile_ternary( v );
+        },
+        [this]( ass_oper const & v ) -> std::optional<double>
+        {
+            compile_assignment( v );
+            return std::nullopt;
+        },
+        [this]( auto const & /* v */ ) -> std::optional<double>
+        {
+            emit( math_code::fail );
+            grow( 1 );
+            return std::nullopt;
         },
     },
-    lhs->data );
+    node.data );
+}
 
-    return 0;
+std::optional<double> math_compiler::compile_oper( oper const &v )
+{
+    std::optional<double> const l = compile( *v.l );
+    std::optional<double> const r = compile( *v.r );
+    if( l && r ) {
+        take_constants( 2 );
+        double const val = v.op( *l, *r );
+        push( val );
+        return val;
+    }
+    emit( math_code::binary ).bin = v.op;
+    grow( -1 );
+    return std::nullopt;
+}
+
+std::optional<double> math_compiler::compile_func( func const &v )
+{
+    bool folds = is_foldable( v.f );
+    for( thingie const &param : v.params ) {
+        folds = compile( param ).has_value() && folds;
+    }
+    int const nargs = static_cast<int>( v.params.size() );
+    if( folds ) {
+        std::vector<double> const args = take_constants( nargs );
+        double const val = v.f( math_func_args( args.data(), args.size() ) );
+        push( val );
+        return val;
+    }
+    emit( math_code::call, 0, nargs ).f = v.f;
+    grow( 1 - nargs );
+    return std::nullopt;
+}
+
+std::optional<double> math_compiler::compile_ternary( ternary const &v )
+{
+    if( std::optional<double> const cond = compile( *v.cond ); cond ) {
+        take_constants( 1 );
+        return compile( *cond > 0 ? *v.mhs : *v.rhs );
+    }
+    size_t const jump_if_false = prog.code.size();
+    emit( math_code::jump_if_false );
+    grow( -1 );
+    compile( *v.mhs );
+    size_t const jump = prog.code.size();
+    emit( math_code::jump );
+    // only one of the branches leaves its value on the stack
+    grow( -1 );
+    prog.code[jump_if_false].idx = static_cast<int>( prog.code.size() );
+    compile( *v.rhs );
+    prog.code[jump].idx = static_cast<int>( prog.code.size() );
+    return std::nullopt;
+}
+
+void math_compiler::compile_assignment( ass_oper const &v )
+{
+    std::optional<double> const m = compile( *v.mhs );
+    std::optional<double> const r = compile( *v.rhs );
+    if( m && r ) {
+        take_constants( 2 );
+        push( v.op( *m, *r ) );
+    } else {
+        emit( math_code::binary ).bin = v.op;
+        grow( -1 );
+    }
+    emit( math_code::assign, static_cast<int>( prog.targets.size() ) );
+    prog.targets.emplace_back( *v.lhs );
+}
+
+} // namespace
+
+math_program math_program::compile( thingie const &tree )
+{
+    math_program prog;
+    math_compiler( prog ).compile( tree );
+    return prog;
+}
+
+double math_program::run( const_dialogue const &d, dialogue *assign_d,
+                          math_func_args const &args ) const
+{
+    if( code.empty() ) {
+        return 0;
+    }
+    if( assign_d == nullptr && !targets.empty() ) {
+        throw math::runtime_error( "Cannot use assignment operators from eval context" );
+    }
+    std::array<double, inline_stack_size> inline_stack;
+    std::vector<double> heap_stack;
+    double *top = inline_stack.data();
+    if( stack_size > inline_stack_size ) {
+        heap_stack.resize( stack_size );
+        top = heap_stack.data();
+    }
+
+    size_t pc = 0;
+    while( pc < code.size() ) {
+        instruction const &ins = code[pc++];
+        switch( ins.op ) {
+            case math_code::constant:
+                *top++ = ins.val;
+                break;
+            case math_code::load_var:
+                *top++ = vars[ins.idx].eval( d );
+                break;
+            case math_code::load_arg:
+                *top++ = static_cast<size_t>( ins.nargs ) < args.size() ? args[ins.nargs] :
+                         vars[ins.idx].eval( d );
+                break;
+            case math_code::load_diag:
+                *top++ = diags[ins.idx].eval( d );
+                break;
+            case math_code::binary:
+                --top;
+                *( top - 1 ) = ins.bin( *( top - 1 ), *top );
+                break;
+            case math_code::call:
+                top -= ins.nargs;
+                *top = ins.f( math_func_args( top, ins.nargs ) );
+                ++top;
+                break;
+            case math_code::call_jmath:
+                top -= ins.nargs;
+                *top = jmaths[ins.idx]->eval( d, math_func_args( top, ins.nargs ) );
+                ++top;
+                break;
+            case math_code::jump_if_false:
+                if( !( *--top > 0 ) ) {
+                    pc = ins.idx;
+                }
+                break;
+            case math_code::jump:
+                pc = ins.idx;
+                break;
+            case math_code::assign: {
+                double const val = *( top - 1 );
+                std::visit( overloaded{
+                    [assign_d, val]( auto const & v ) -> void
+                    {
+                        if constexpr( v_has_assign<decltype( v )> )
+                        {
+                            v.assign( *assign_d, val );
+                        } else
+                        {
+                            throw math::internal_error( "math called assign() on unexpected node without assign()" );
+                        }
+                    },
+                },
+                targets[ins.idx].data );
+                *( top - 1 ) = 0;
+                break;
+            }
+            case math_code::fail:
+                throw math::internal_error( "math called eval() on unexpected node without eval()" );
+        }
+    }
+    return *( top - 1 );
 }
 
 class math_exp::math_exp_impl
 {
     public:
         math_exp_impl() = default;
-        explicit math_exp_impl( thingie &&t ): tree( t ) {}
+        explicit math_exp_impl( thingie &&t ): tree( t ), program( math_program::compile( tree ) ) {}
 
         bool parse( std::string_view str, bool handle_errors ) {
             if( str.empty() ) {
@@ -312,6 +595,7 @@ class math_exp::math_exp_impl
                     output = {};
                     arity = {};
                     tree = thingie { 0.0 };
+                    program = {};
                     return false;
                 }
 
@@ -320,10 +604,16 @@ class math_exp::math_exp_impl
             return true;
         }
         double eval( const_dialogue const &d ) const {
-            return tree.eval( d );
+            return program.run( d, nullptr, {} );
         }
         double eval( dialogue &d ) const {
-            return tree.eval( d );
+            return program.run( d, &d, {} );
+        }
+        double eval( const_dialogue const &d, math_func_args const &args ) const {
+            return program.run( d, nullptr, args );
+        }
+        bool reads_args_from_context() const {
+            return args_from_context;
         }
 
         math_type_t get_type() const {
@@ -361,6 +651,9 @@ class math_exp::math_exp_impl
         };
         std::stack<arity_t> arity;
         thingie tree{ 0.0 };
+        math_program program;
+        // set if dialogue functions or v_ variables may read jmath arguments from the context
+        bool args_from_context = false;
         std::string_view parse_position;
         parse_state state;
         math_type_t type = math_type_t::ret;
@@ -481,6 +774,7 @@ void math_exp::math_exp_impl::_parse( std::string_view str )
         throw math::internal_error( "Invalid expression.  That's all we know.  Blame andrei." );
     }
     output.pop();
+    program = math_program::compile( tree );
 }
 
 void math_exp::math_exp_impl::parse_string( std::string_view token, std::string_view full )
@@ -639,6 +933,12 @@ thingie math_exp::math_exp_impl::_resolve_proto( thingie &thing, bool assignment
             assignment ? proto.f->fa( proto.scope, args, proto.kwargs ) : func_diag::ass_f{};
 
         _validate_unused_kwargs( proto.kwargs );
+        args_from_context = args_from_context ||
+                            std::any_of( args.begin(), args.end(), reads_context ) ||
+                            std::any_of( proto.kwargs.kwargs.begin(), proto.kwargs.kwargs.end(),
+        []( diag_kwargs::impl_t::value_type const & kw ) {
+            return reads_context( *kw.second );
+        } );
 
         return thingie{ std::in_place_type_t<func_diag>{}, fe, fa };
     }
@@ -892,6 +1192,7 @@ void math_exp::math_exp_impl::new_var( std::string_view str )
         scoped = scoped.substr( 1 );
     }
     validate_string( scoped, " \'" );
+    args_from_context = args_from_context || type == var_type::var;
     output.emplace( std::in_place_type_t<var>(), type, std::string{ scoped } );
 }
 
@@ -962,6 +1263,16 @@ double math_exp::eval( dialogue &d ) const
     return impl->eval( d );
 }
 
+double math_exp::eval( const_dialogue const &d, math_func_args const &args ) const
+{
+    return impl->eval( d, args );
+}
+
+bool math_exp::reads_args_from_context() const
+{
+    return impl->reads_args_from_context();
+}
+
 math_type_t math_exp::get_type() const
 {
     return impl->get_type();
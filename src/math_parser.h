@@ -7,6 +7,7 @@
 
 #include "math_parser_type.h"
 
+class math_func_args;
 struct dialogue;
 struct const_dialogue;
 
@@ -26,6 +27,10 @@ class math_exp
         bool parse( std::string_view str, bool handle_errors = true );
         double eval( dialogue &d ) const;
         double eval( const_dialogue const &d ) const;
+        /** Evaluates the body of a jmath function, reading _0, _1, ... from @p args. */
+        double eval( const_dialogue const &d, math_func_args const &args ) const;
+        /** True if dialogue functions may need the jmath arguments set in the context. */
+        bool reads_args_from_context() const;
 
         math_type_t get_type() const;
 
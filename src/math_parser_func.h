@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <cstdlib>
 #include <string>
 #include <string_view>
@@ -13,10 +14,39 @@
 #include "rng.h"
 #include "units.h"
 
+/** Arguments of a math function, a view of the values on the evaluation stack. */
+class math_func_args
+{
+    public:
+        constexpr math_func_args() = default;
+        constexpr math_func_args( double const *first_, size_t count_ ) : first( first_ ),
+            count( count_ ) {}
+
+        constexpr double operator[]( size_t i ) const {
+            return first[i];
+        }
+        constexpr size_t size() const {
+            return count;
+        }
+        constexpr bool empty() const {
+            return count == 0;
+        }
+        constexpr double const *begin() const {
+            return first;
+        }
+        constexpr double const *end() const {
+            return first + count;
+        }
+
+    private:
+        double const *first = nullptr;
+        size_t count = 0;
+};
+
 struct math_func {
     std::string_view symbol;
     int num_params;
-    using f_t = double ( * )( std::vector<double> const & );
+    using f_t = double ( * )( math_func_args const & );
     f_t f;
 };
 using pmath_func = math_func const *;
@@ -27,12 +57,12 @@ struct math_const {
 };
 using pmath_const = math_const const *;
 
-inline double abs( std::vector<double> const &params )
+inline double abs( math_func_args const &params )
 {
     return std::abs( params[0] );
 }
 
-inline double max( std::vector<double> const &params )
+inline double max( math_func_args const &params )
 {
     if( params.empty() ) {
         return 0;
@@ -40,7 +70,7 @@ inline double max( std::vector<double> const &params )
     return *std::max_element( params.begin(), params.end() );
 }
 
-inline double min( std::vector<double> const &params )
+inline double min( math_func_args const &params )
 {
     if( params.empty() ) {
         return 0;
@@ -48,42 +78,42 @@ inline double min( std::vector<double> const &params )
     return *std::min_element( params.begin(), params.end() );
 }
 
-inline double math_rng( std::vector<double> const &params )
+inline double math_rng( math_func_args const &params )
 {
     return rng_float( params[0], params[1] );
 }
 
-inline double rand( std::vector<double> const &params )
+inline double rand( math_func_args const &params )
 {
     return rng( 0, static_cast<int>( std::round( params[0] ) ) );
 }
 
-inline double sqrt( std::vector<double> const &params )
+inline double sqrt( math_func_args const &params )
 {
     return std::sqrt( params[0] );
 }
 
-inline double log( std::vector<double> const &params )
+inline double log( math_func_args const &params )
 {
     return std::log( params[0] );
 }
 
-inline double sin( std::vector<double> const &params )
+inline double sin( math_func_args const &params )
 {
     return std::sin( params[0] );
 }
 
-inline double cos( std::vector<double> const &params )
+inline double cos( math_func_args const &params )
 {
     return std::cos( params[0] );
 }
 
-inline double tan( std::vector<double> const &params )
+inline double tan( math_func_args const &params )
 {
     return std::tan( params[0] );
 }
 
-inline double clamp( std::vector<double> const &params )
+inline double clamp( math_func_args const &params )
 {
     if( params[2] < params[1] ) {
         debugmsg( "clamp called with hi < lo (%f < %f)", params[2], params[1] );
@@ -92,47 +122,47 @@ inline double clamp( std::vector<double> const &params )
     return std::clamp( params[0], params[1], params[2] );
 }
 
-inline double floor( std::vector<double> const &params )
+inline double floor( math_func_args const &params )
 {
     return std::floor( params[0] );
 }
 
-inline double ceil( std::vector<double> const &params )
+inline double ceil( math_func_args const &params )
 {
     return std::ceil( params[0] );
 }
 
-inline double trunc( std::vector<double> const &params )
+inline double trunc( math_func_args const &params )
 {
     return std::trunc( params[0] );
 }
 
-inline double round( std::vector<double> const &params )
+inline double round( math_func_args const &params )
 {
     return std::round( params[0] );
 }
 
-constexpr double test_( std::vector<double> const &/* params */ )
+constexpr double test_( math_func_args const &/* params */ )
 {
     return 42;
 }
 
-inline double celsius_from_kelvin( std::vector<double> const &params )
+inline double celsius_from_kelvin( math_func_args const &params )
 {
     return units::to_celsius( units::from_kelvin( params[0] ) );
 }
 
-inline double fahrenheit_from_kelvin( std::vector<double> const &params )
+inline double fahrenheit_from_kelvin( math_func_args const &params )
 {
     return units::to_fahrenheit( units::from_kelvin( params[0] ) );
 }
 
-inline double celsius_to_kelvin( std::vector<double> const &params )
+inline double celsius_to_kelvin( math_func_args const &params )
 {
     return units::to_kelvin( units::from_celsius( params[0] ) );
 }
 
-inline double fahrenheit_to_kelvin( std::vector<double> const &params )
+inline double fahrenheit_to_kelvin( math_func_args const &params )
 {
     return units::to_kelvin( units::from_fahrenheit( params[0] ) );
 }
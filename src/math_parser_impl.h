@@ -67,24 +67,18 @@ struct thingie;
 struct oper {
     oper( thingie l_, thingie r_, binary_op::f_t op_ );
 
-    double eval( const_dialogue const &d ) const;
-
     std::shared_ptr<thingie> l, r;
     binary_op::f_t op{};
 };
 struct func {
     explicit func( std::vector<thingie> &&params_, math_func::f_t f_ );
 
-    double eval( const_dialogue const &d ) const;
-
     std::vector<thingie> params;
     math_func::f_t f{};
 };
 struct func_jmath {
     explicit func_jmath( std::vector<thingie> &&params_, jmath_func_id const &id_ );
 
-    double eval( const_dialogue const &d ) const;
-
     std::vector<thingie> params;
     jmath_func_id id;
 };
@@ -149,8 +143,6 @@ struct ternary {
     std::shared_ptr<thingie> cond;
     std::shared_ptr<thingie> mhs;
     std::shared_ptr<thingie> rhs;
-
-    double eval( const_dialogue const &d ) const;
 };
 
 struct ass_oper {
@@ -160,8 +152,6 @@ struct ass_oper {
     std::shared_ptr<thingie> mhs;
     std::shared_ptr<thingie> rhs;
     binary_op::f_t op{};
-
-    double eval( dialogue &d ) const;
 };
 struct thingie {
     thingie() = default;
@@ -171,16 +161,11 @@ struct thingie {
     explicit thingie( std::in_place_type_t<T> /*t*/, Args &&...args )
         : data( std::in_place_type<T>, std::forward<Args>( args )... ) {}
 
-    constexpr double eval( dialogue &d ) const;
-    constexpr double eval( const_dialogue const &d ) const;
-
     using impl_t =
         std::variant<double, std::string, oper, ass_oper, func, func_jmath, func_diag, func_diag_proto, var, kwarg, ternary, array>;
     impl_t data;
 };
 
-template <typename V>
-using f_eval_t = decltype( std::declval<V>().eval( std::declval<const_dialogue const &>() ) );
 template <typename V>
 using f_assign_t =
     decltype( std::declval<V>().assign( std::declval<dialogue &>(), std::declval<double>() ) );
@@ -191,45 +176,53 @@ constexpr bool v_has = false;
 template <typename V, template <typename> class F>
 constexpr bool v_has<V, F, std::void_t<F<V>>> = true;
 
-template <typename T>
-constexpr bool v_has_eval = v_has<T, f_eval_t>;
 template <typename T>
 constexpr bool v_has_assign = v_has<T, f_assign_t>;
 
-constexpr double thingie::eval( const_dialogue const &d ) const
-{
-    return std::visit( overloaded{
-        []( double v )
-        {
-            return v;
-        },
-        []( ass_oper const & /* v */ ) -> double
-        {
-            throw math::runtime_error( "Cannot use assignment operators from eval context" );
-            return 0.0;
-        },
-        [&d]( auto const & v ) -> double
-        {
-            if constexpr( v_has_eval<decltype( v )> )
-            {
-                return v.eval( d );
-            } else
-            {
-                throw math::internal_error( "math called eval() on unexpected node without eval()" );
-                return 0.0;
-            }
-        },
-    },
-    data );
-}
-
-constexpr double thingie::eval( dialogue &d ) const
-{
-    if( std::holds_alternative<ass_oper>( data ) ) {
-        return std::get<ass_oper>( data ).eval( d );
-    }
-    return eval( static_cast<const_dialogue const &>( d ) );
-}
+/**
+ * A parsed expression flattened into instructions for a stack machine.
+ *
+ * Constant subexpressions are folded at compile time, variables keep their pre-resolved keys and
+ * the operands live on a fixed-size stack, so evaluating an expression doesn't walk the tree or
+ * allocate.
+ */
+struct math_program {
+    struct instruction {
+        enum class code : int {
+            constant = 0,  // push val
+            load_var,      // push vars[idx]
+            load_arg,      // push argument nargs of a jmath function, or vars[idx] if there is none
+            load_diag,     // push diags[idx]
+            binary,        // pop rhs and lhs, push bin( lhs, rhs )
+            call,          // pop nargs values, push f( values )
+            call_jmath,    // pop nargs values, push jmaths[idx]( values )
+            jump_if_false, // pop a condition, jump to idx unless it is > 0
+            jump,          // jump to idx
+            assign,        // pop a value, assign it to targets[idx] and push 0
+            fail,          // the expression has a node that can't be evaluated
+        };
+        code op = code::constant;
+        int idx = 0;
+        int nargs = 0;
+        double val = 0;
+        binary_op::f_t bin = nullptr;
+        math_func::f_t f = nullptr;
+    };
+    // keeps the stack out of the heap for all but absurdly deep expressions
+    static constexpr int inline_stack_size = 32;
+
+    std::vector<instruction> code;
+    std::vector<var> vars;
+    std::vector<func_diag> diags;
+    std::vector<jmath_func_id> jmaths;
+    // var or func_diag
+    std::vector<thingie> targets;
+    int stack_size = 0;
+
+    static math_program compile( thingie const &tree );
+    /** @p assign_d is nullptr when evaluating in an eval context. */
+    double run( const_dialogue const &d, dialogue *assign_d, math_func_args const &args ) const;
+};
 
 using op_t =
     std::variant<pbin_op, punary_op, pass_op, pmath_func, jmath_func_id, scoped_diag_proto, paren>;
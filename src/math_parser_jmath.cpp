@@ -1,5 +1,6 @@
 #include "math_parser_jmath.h"
 
+#include <cstddef>
 #include <string>
 #include <string_view>
 
@@ -8,6 +9,7 @@
 #include "generic_factory.h"
 #include "math_parser.h"
 #include "math_parser_diag.h"
+#include "math_parser_func.h"
 
 namespace
 {
@@ -74,12 +76,20 @@ double jmath_func::eval( const_dialogue const &d ) const
     return _exp.eval( d );
 }
 
-double jmath_func::eval( const_dialogue const &d, std::vector<double> const &params ) const
+double jmath_func::eval( const_dialogue const &d, math_func_args const &params ) const
 {
+    if( !_exp.reads_args_from_context() ) {
+        return _exp.eval( d, params );
+    }
     const_dialogue d_next( d );
-    for( std::vector<double>::size_type i = 0; i < params.size(); i++ ) {
+    for( size_t i = 0; i < params.size(); i++ ) {
         d_next.set_value( std::to_string( i ), string_format( "%g", params[i] ) );
     }
 
     return eval( d_next );
 }
+
+double jmath_func::eval( const_dialogue const &d, std::vector<double> const &params ) const
+{
+    return eval( d, math_func_args( params.data(), params.size() ) );
+}
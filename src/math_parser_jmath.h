@@ -10,6 +10,7 @@
 #include "type_id.h"
 
 class JsonObject;
+class math_func_args;
 struct dialogue;
 
 struct jmath_func {
@@ -19,6 +20,7 @@ struct jmath_func {
     int num_params{};
 
     double eval( const_dialogue const &d ) const;
+    double eval( const_dialogue const &d, math_func_args const &params ) const;
     double eval( const_dialogue const &d, std::vector<double> const &params ) const;
 
     void load( const JsonObject &jo, std::string_view src );
@@ -31,6 +31,8 @@ MonsterGroupManager::t_string_set MonsterGroupManager::monster_species_whitelist
 
 static const mtype_id mon_null( "mon_null" );
 
+static const option_handle<float> option_MONSTER_UPGRADE_FACTOR( "MONSTER_UPGRADE_FACTOR" );
+
 static bool monster_whitelist_is_exclusive = false;
 
 /** @relates string_id */
@@ -119,9 +121,9 @@ float mongroup::avg_speed() const
 const MonsterGroup &MonsterGroupManager::GetUpgradedMonsterGroup( const mongroup_id &group )
 {
     const MonsterGroup *groupptr = &group.obj();
-    if( get_option<float>( "MONSTER_UPGRADE_FACTOR" ) > 0 ) {
+    if( option_MONSTER_UPGRADE_FACTOR.get() > 0 ) {
         const time_duration replace_time = groupptr->monster_group_time *
-                                           get_option<float>( "MONSTER_UPGRADE_FACTOR" );
+                                           option_MONSTER_UPGRADE_FACTOR.get();
         while( groupptr->replace_monster_group &&
                calendar::turn - time_point( calendar::start_of_cataclysm ) > replace_time ) {
             groupptr = &groupptr->new_monster_group.obj();
@@ -462,7 +464,7 @@ std::map<mongroup_id, MonsterGroup> &MonsterGroupManager::Get_all_Groups()
 
 void MonsterGroupManager::LoadMonsterGroup( const JsonObject &jo )
 {
-    float mon_upgrade_factor = get_option<float>( "MONSTER_UPGRADE_FACTOR" );
+    float mon_upgrade_factor = option_MONSTER_UPGRADE_FACTOR.get();
 
     MonsterGroup g;
     int freq_total = 0;
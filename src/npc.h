@@ -999,6 +999,14 @@ class npc : public Character
 
         // Interaction and assessment of the world around us
         float danger_assessment() const;
+        /**
+         * Forgets the danger assessment shared by all NPCs during a turn: the explosives about
+         * to go off and how well armed and armoured each character is.  It also refreshes
+         * itself every turn and when the map's items or a character's gear change.
+         */
+        static void clear_threat_cache();
+        /** Explosives close enough and about to go off soon enough for us to get away from. */
+        std::vector<sphere> find_dangerous_explosives() const;
         // Our guess at how much damage we can deal
         float average_damage_dealt();
         bool bravery_check( int diff ) const;
@@ -1459,8 +1467,6 @@ class npc : public Character
         bool sees_dangerous_field( const tripoint_bub_ms &p ) const;
         bool could_move_onto( const tripoint_bub_ms &p ) const;
 
-        std::vector<sphere> find_dangerous_explosives() const;
-
         npc_companion_mission comp_mission;
 
         std::string unique_id;
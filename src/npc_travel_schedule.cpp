@@ -0,0 +1,104 @@
+#include "npc_travel_schedule.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "game_constants.h"
+#include "line.h"
+#include "memory_fast.h"
+#include "npc.h"
+#include "overmapbuffer.h"
+#include "rng.h"
+
+bool npc_travel_schedule::update( const tripoint_abs_ms &center, const int radius )
+{
+    const time_point now = calendar::turn;
+    const tripoint_abs_sm center_sm = project_to<coords::sm>( center );
+    const tripoint_abs_omt center_omt = project_to<coords::omt>( center );
+    // NPCs that stopped travelling or went out of range drop off the schedule
+    std::map<character_id, plan> travelling;
+    bool needs_reload = false;
+    for( const shared_ptr_fast<npc> &guy : overmap_buffer.get_npcs_near( center_sm, radius ) ) {
+        if( !guy || guy->mission != NPC_MISSION_TRAVELLING ||
+            ( guy->is_active() && rl_dist( center, guy->get_location() ) <= SEEX * 2 ) ) {
+            continue;
+        }
+        const auto found = plans.find( guy->getID() );
+        // A plan from the future is left over from before the time was set back
+        plan p = found == plans.end() || found->second.departure > now ? plan{ now, now } :
+                 found->second;
+        if( p.due <= now ) {
+            const bool was_loaded = guy->is_active();
+            if( advance( *guy, p, rl_dist( center_omt, guy->global_omt_location() ) ) ) {
+                const int dist_sm = square_dist( center_sm.xy(), guy->global_sm_location().xy() );
+                needs_reload = needs_reload || was_loaded || dist_sm <= HALF_MAPSIZE;
+            }
+        }
+        if( !guy->has_omt_destination() && calendar::once_every( 1_hours ) && one_in( 3 ) ) {
+            // travelling destination is reached/not set, try different one
+            guy->set_omt_destination();
+        }
+        travelling.emplace( guy->getID(), p );
+    }
+    plans = std::move( travelling );
+    return needs_reload;
+}
+
+// The last batch is due when the NPC arrives, not at the end of the interval
+static time_point next_due( const time_point &departure,
+                            const std::vector<tripoint_abs_omt> &path, const time_duration &interval )
+{
+    const int tiles_left = std::max( static_cast<int>( path.size() ) - 1, 1 );
+    return departure + std::min( interval, time_between_npc_OM_moves * tiles_left );
+}
+
+bool npc_travel_schedule::advance( npc &guy, plan &p, const int distance )
+{
+    const time_point now = calendar::turn;
+    if( !guy.has_omt_destination() ) {
+        p = { now, now };
+        return false;
+    }
+    std::vector<tripoint_abs_omt> &path = guy.omt_path;
+    if( !path.empty() ) {
+        if( rl_dist( path.back(), guy.global_omt_location() ) > 2 ) {
+            // recalculate path, we got distracted doing something else probably
+            path.clear();
+        } else if( path.back() == guy.global_omt_location() ) {
+            path.pop_back();
+        }
+    }
+    const time_duration interval = distance > far_distance ? far_step_interval :
+                                   time_between_npc_OM_moves;
+    if( path.empty() ) {
+        path = overmap_buffer.get_travel_path( guy.global_omt_location(), guy.goal,
+                                               overmap_path_params::for_npc() ).points;
+        if( path.empty() ) { // goal is unreachable, or already reached goal, reset it
+            guy.goal = npc::no_goal_point;
+        }
+        p = { now, now };
+        p.due = next_due( p.departure, path, interval );
+        return false;
+    }
+    // All the tiles reached since the last step, but no more than one batch even if the NPC
+    // was away for longer
+    const int batch_steps = static_cast<int>( far_step_interval / time_between_npc_OM_moves );
+    const int max_steps = std::min( static_cast<int>( path.size() ), batch_steps );
+    const int steps = std::clamp( static_cast<int>( ( now - p.departure ) /
+                                  time_between_npc_OM_moves ), 1, max_steps );
+    path.resize( path.size() - steps + 1 );
+    guy.travel_overmap( path.back() );
+    p.departure += time_between_npc_OM_moves * steps;
+    p.due = next_due( p.departure, path, interval );
+    return true;
+}
+
+std::optional<time_point> npc_travel_schedule::next_step( const character_id &id ) const
+{
+    const auto found = plans.find( id );
+    if( found == plans.end() ) {
+        return std::nullopt;
+    }
+    return found->second.due;
+}
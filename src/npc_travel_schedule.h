@@ -0,0 +1,53 @@
+#pragma once
+#ifndef CATA_SRC_NPC_TRAVEL_SCHEDULE_H
+#define CATA_SRC_NPC_TRAVEL_SCHEDULE_H
+
+#include <map>
+#include <optional>
+
+#include "calendar.h"
+#include "character_id.h"
+#include "coordinates.h"
+#include "map_scale_constants.h"
+
+class npc;
+
+/**
+ * Moves the NPCs that travel across the overmap outside of the reality bubble.
+ *
+ * An NPC covers one overmap tile of its path every @ref time_between_npc_OM_moves.  Rather
+ * than moving every NPC one tile each time, the schedule remembers when each of them left its
+ * last tile and only looks at it again once its next step is due.  NPCs far from the player
+ * are only due every @ref far_step_interval and then cover all the tiles they would have
+ * reached since, nobody is around to see the tiles in between.
+ */
+class npc_travel_schedule
+{
+    public:
+        /** NPCs further than this many overmap tiles from the player move in batches. */
+        static constexpr int far_distance = OMAPX;
+        static constexpr time_duration far_step_interval = 1_hours;
+
+        /**
+         * Moves the travelling NPCs within @p radius submaps of @p center whose steps are due,
+         * @p center being where the player is.
+         * @returns Whether an NPC that moved was or now is close enough to be loaded, the
+         * active NPCs need to be reloaded then.
+         */
+        bool update( const tripoint_abs_ms &center, int radius );
+        /** When the NPC is looked at next, nothing if it isn't on the schedule. */
+        std::optional<time_point> next_step( const character_id &id ) const;
+
+    private:
+        struct plan {
+            // When the NPC left the tile it is on, or started looking for a path
+            time_point departure;
+            time_point due;
+        };
+        std::map<character_id, plan> plans;
+
+        /** Moves @p guy as far along its path as it got by now, @returns whether it moved. */
+        bool advance( npc &guy, plan &p, int distance );
+};
+
+#endif // CATA_SRC_NPC_TRAVEL_SCHEDULE_H
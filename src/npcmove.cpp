@@ -6,10 +6,12 @@
 #include <cmath>
 #include <cstdlib>
 #include <iterator>
+#include <map>
 #include <memory>
 #include <numeric>
 #include <ostream>
 #include <tuple>
+#include <vector>
 
 #include "active_item_cache.h"
 #include "activity_handlers.h"
@@ -43,6 +45,7 @@
 #include "game_constants.h"
 #include "gates.h"
 #include "gun_mode.h"
+#include "hash_utils.h"
 #include "item.h"
 #include "item_factory.h"
 #include "itype.h"
@@ -64,6 +67,7 @@
 #include "overmap.h"
 #include "overmap_location.h"
 #include "overmapbuffer.h"
+#include "pathfinding.h"
 #include "player_activity.h"
 #include "projectile.h"
 #include "ranged.h"
@@ -247,12 +251,13 @@ static bool clear_shot_reach( const tripoint_bub_ms &from, const tripoint_bub_ms
     std::vector<tripoint_bub_ms> path = line_to( from, to );
     path.pop_back();
     creature_tracker &creatures = get_creature_tracker();
+    const map &here = get_map();
     for( const tripoint_bub_ms &p : path ) {
-        Creature *inter = creatures.creature_at( p );
-        if( check_ally && inter != nullptr ) {
+        if( check_ally && creatures.creature_at( p ) != nullptr ) {
             return false;
         }
-        if( get_map().impassable( p ) ) {
+        const std::optional<PathfindingFlags> flags = here.pathfinding_flags( p );
+        if( flags ? flags->is_set( PathfindingFlag::Obstacle ) : here.impassable( p ) ) {
             return false;
         }
     }
@@ -425,34 +430,122 @@ bool npc::could_move_onto( const tripoint_bub_ms &p ) const
     return true;
 }
 
+namespace
+{
+
+// The parts of assessing danger that come out the same for every NPC, worked out once per turn
+// instead of by each NPC on its own
+struct npc_threat_cache {
+    struct explosive {
+        tripoint_bub_ms pos;
+        int safe_range;
+        int charges;
+    };
+    // What a character brings to a fight, regardless of who is looking
+    struct character_assessment {
+        // State of the wielded and worn items when it was assessed, see equipment_state
+        size_t equipment;
+        double weapon_value;
+        float armour;
+    };
+
+    time_point turn = calendar::before_time_starts;
+    bool explosives_valid = false;
+    int items_revision = 0;
+    tripoint_abs_sm map_origin;
+    // Active explosives on the whole map, in the order map::get_active_items_in_radius gives them
+    std::vector<explosive> explosives;
+    std::map<character_id, character_assessment> characters;
+
+    void start_turn() {
+        if( turn != calendar::turn ) {
+            clear();
+            turn = calendar::turn;
+        }
+    }
+    void clear() {
+        explosives_valid = false;
+        explosives.clear();
+        characters.clear();
+    }
+};
+
+npc_threat_cache &get_threat_cache()
+{
+    static npc_threat_cache cache;
+    return cache;
+}
+
+// Changes when the character wields, wears or takes off something, or when one of those items
+// is damaged, reloaded or modded
+size_t equipment_state( const Character &candidate, const item *weapon )
+{
+    std::vector<const item *> equipment;
+    if( weapon != nullptr ) {
+        equipment.push_back( weapon );
+    }
+    candidate.worn.inv_dump( equipment );
+    size_t seed = equipment.size();
+    for( const item *it : equipment ) {
+        cata::hash_combine( seed, it );
+        cata::hash_combine( seed, it->type );
+        cata::hash_combine( seed, it->damage() );
+        cata::hash_combine( seed, it->charges );
+        cata::hash_combine( seed, it->get_contents().contents_state() );
+    }
+    return seed;
+}
+
+} // namespace
+
+void npc::clear_threat_cache()
+{
+    get_threat_cache().clear();
+}
+
 std::vector<sphere> npc::find_dangerous_explosives() const
 {
     std::vector<sphere> result;
 
-    const auto active_items = get_map().get_active_items_in_radius( pos_bub(), MAX_VIEW_DISTANCE,
-                              special_item_type::explosive );
+    map &here = get_map();
+    npc_threat_cache &cache = get_threat_cache();
+    cache.start_turn();
+    if( !cache.explosives_valid || cache.items_revision != here.get_items_revision() ||
+        cache.map_origin != here.get_abs_sub() ) {
+        cache.explosives.clear();
+        const tripoint_bub_ms map_center( HALF_MAPSIZE_X, HALF_MAPSIZE_Y, 0 );
+        for( const item_location &elem : here.get_active_items_in_radius( map_center, MAPSIZE_X,
+                special_item_type::explosive ) ) {
+            const use_function *use = elem->type->get_use( "explosion" );
+
+            if( !use ) {
+                continue;
+            }
 
-    for( const item_location &elem : active_items ) {
-        const use_function *use = elem->type->get_use( "explosion" );
+            const explosion_iuse *actor = dynamic_cast<const explosion_iuse *>( use->get_actor_ptr() );
+            cache.explosives.push_back( { elem.pos_bub(), actor->explosion.safe_range(), elem->charges } );
+        }
+        cache.explosives_valid = true;
+        cache.items_revision = here.get_items_revision();
+        cache.map_origin = here.get_abs_sub();
+    }
 
-        if( !use ) {
+    for( const npc_threat_cache::explosive &elem : cache.explosives ) {
+        if( rl_dist( pos_bub(), elem.pos ) > MAX_VIEW_DISTANCE ) {
             continue;
         }
 
-        const explosion_iuse *actor = dynamic_cast<const explosion_iuse *>( use->get_actor_ptr() );
-        const int safe_range = actor->explosion.safe_range();
-
-        if( rl_dist( pos_bub(), elem.pos_bub() ) >= safe_range ) {
+        if( rl_dist( pos_bub(), elem.pos ) >= elem.safe_range ) {
             continue;   // Far enough.
         }
 
-        const int turns_to_evacuate = 2 * safe_range / speed_rating();
+        const int turns_to_evacuate = 2 * elem.safe_range / speed_rating();
 
-        if( elem->charges > turns_to_evacuate ) {
+        if( elem.charges > turns_to_evacuate ) {
             continue;   // Consider only imminent dangers.
         }
 
-        result.emplace_back( elem.position(), safe_range );
+        result.emplace_back( elem.pos.raw(), elem.safe_range );
     }
 
     return result;
@@ -478,12 +571,27 @@ float npc::evaluate_monster( const monster &target, int dist ) const
 float npc::evaluate_character( const Character &candidate, bool my_gun, bool enemy = true )
 {
     float threat = 0.0f;
-    bool candidate_gun = candidate.get_wielded_item() && candidate.get_wielded_item()->is_gun();
-    const item &candidate_weap = candidate.get_wielded_item() ? *candidate.get_wielded_item() :
-                                 null_item_reference();
-    double candidate_weap_val = candidate.weapon_value( candidate_weap );
+    const item_location candidate_weap_loc = candidate.get_wielded_item();
+    bool candidate_gun = candidate_weap_loc && candidate_weap_loc->is_gun();
+    const item *candidate_weap = candidate_weap_loc ? candidate_weap_loc.get_item() : nullptr;
+
+    // Every NPC looking at the candidate this turn would come up with the same weapon value and
+    // armour, so they are only worked out once
+    npc_threat_cache &cache = get_threat_cache();
+    cache.start_turn();
+    const size_t equipment = equipment_state( candidate, candidate_weap );
+    auto assessed = cache.characters.find( candidate.getID() );
+    if( assessed == cache.characters.end() || assessed->second.equipment != equipment ) {
+        npc_threat_cache::character_assessment assessment;
+        assessment.equipment = equipment;
+        assessment.weapon_value = candidate.weapon_value( candidate_weap ? *candidate_weap :
+                                  null_item_reference() );
+        assessment.armour = estimate_armour( candidate );
+        assessed = cache.characters.insert_or_assign( candidate.getID(), assessment ).first;
+    }
+    double candidate_weap_val = assessed->second.weapon_value;
     float candidate_health =  candidate.hp_percentage() / 100.0f;
-    float armour = estimate_armour( candidate );
+    float armour = assessed->second.armour;
     float speed = std::max( 0.25f, candidate.get_speed() / 100.0f );
     bool is_fleeing = candidate.has_effect( effect_npc_run_away );
     int perception_inverted = std::max( ( 20 - get_per() ), 0 );
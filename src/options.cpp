@@ -304,9 +304,32 @@ static options_manager::cOpt::COPT_VALUE_TYPE get_value_type( const std::string
 }
 
 //add hidden external option with value
+unsigned int options_manager::handle_generation = 1;
+
+static std::vector<std::string> &option_handle_names()
+{
+    static std::vector<std::string> names;
+    return names;
+}
+
+void options_manager::register_handle( const std::string &name )
+{
+    option_handle_names().push_back( name );
+}
+
+void options_manager::check_handles() const
+{
+    for( const std::string &name : option_handle_names() ) {
+        if( !has_option( name ) ) {
+            debugmsg( "option_handle refers to non-existing option %s", name );
+        }
+    }
+}
+
 void options_manager::add_external( const std::string &sNameIn, const std::string &sPageIn,
                                     const std::string &sType )
 {
+    ++handle_generation;
     cOpt thisOpt;
 
     thisOpt.sName = sNameIn;
@@ -1434,6 +1457,7 @@ void options_manager::Page::removeRepeatedEmptyLines()
 
 void options_manager::init()
 {
+    ++handle_generation;
     options.clear();
     for( Page &p : pages_ ) {
         p.items_.clear();
@@ -3969,6 +3993,7 @@ std::string options_manager::show( bool ingame, const bool world_options_only, b
             save();
             if( ingame && world_options_changed ) {
                 world_generator->active_world->WORLD_OPTIONS = ACTIVE_WORLD_OPTIONS;
+                ++handle_generation;
                 world_generator->active_world->save();
             }
             g->on_options_changed();
@@ -3982,6 +4007,8 @@ std::string options_manager::show( bool ingame, const bool world_options_only, b
                 ACTIVE_WORLD_OPTIONS = WOPTIONS_OLD;
             }
         }
+        // the option containers may have been reassigned
+        ++handle_generation;
     }
 
     if( lang_changed ) {
@@ -4047,6 +4074,7 @@ void options_manager::serialize( JsonOut &json ) const
 
 void options_manager::deserialize( const JsonArray &ja )
 {
+    ++handle_generation;
     for( JsonObject joOptions : ja ) {
         joOptions.allow_omitted_members();
 
@@ -4182,8 +4210,14 @@ options_manager::options_container options_manager::get_world_defaults() const
     return result;
 }
 
+void options_manager::invalidate_handles()
+{
+    ++handle_generation;
+}
+
 void options_manager::set_world_options( options_container *options )
 {
+    ++handle_generation;
     if( options == nullptr ) {
         world_options.reset();
     } else {
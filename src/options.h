@@ -20,6 +20,8 @@ class cata_path;
 class JsonArray;
 class JsonOut;
 class JsonObject;
+template<typename T>
+class option_handle;
 
 class options_manager
 {
@@ -59,6 +61,15 @@ class options_manager
         friend options_manager &get_options();
         options_manager();
 
+        template<typename T>
+        friend class option_handle;
+        /**
+         * Bumped whenever option objects may have been replaced (options initialized or loaded,
+         * world options switched or edited), which makes option handles look their option up again.
+         */
+        static unsigned int handle_generation;
+        static void register_handle( const std::string &name );
+
         void addOptionToPage( const std::string &name, const std::string &page );
 
     public:
@@ -230,9 +241,17 @@ class options_manager
         options_container get_world_defaults() const;
 
         void set_world_options( options_container *options );
+        /**
+         * Makes option handles look their option up again.  Call it after replacing an
+         * options_container, e.g. assigning to WORLD::WORLD_OPTIONS, as that destroys the
+         * options the handles point to.
+         */
+        static void invalidate_handles();
 
         /** Check if an option exists? */
         bool has_option( const std::string &name ) const;
+        /** Reports option handles whose option doesn't exist. */
+        void check_handles() const;
 
         cOpt &get_option( const std::string &name );
 
@@ -505,4 +524,37 @@ inline T get_option( const std::string &name, bool convert = false )
     return get_options().get_option( name ).value_as<T>( convert );
 }
 
+/**
+ * Typed reference to an option for code that reads it often, e.g. every turn or for every
+ * monster.  Declare it at file scope next to the other static ids:
+ *
+ *     static const option_handle<bool> option_WANDER_SPAWNS( "WANDER_SPAWNS" );
+ *
+ * The option is looked up on the first get() and again only when the options were replaced, so
+ * reading it skips the string hashing of get_option().  Every handle is checked against the
+ * loaded options by options_manager::check_handles(), which reports a misspelled name.
+ */
+template<typename T>
+class option_handle
+{
+    public:
+        explicit option_handle( const std::string &name ) : name( name ) {
+            options_manager::register_handle( name );
+        }
+
+        T get() const {
+            if( generation != options_manager::handle_generation ) {
+                opt = &get_options().get_option( name );
+                generation = options_manager::handle_generation;
+            }
+            return opt->value_as<T>();
+        }
+
+    private:
+        std::string name;
+        mutable options_manager::cOpt *opt = nullptr;
+        // options_manager::handle_generation starts at 1, so the first get() resolves the option
+        mutable unsigned int generation = 0;
+};
+
 #endif // CATA_SRC_OPTIONS_H
@@ -48,6 +48,7 @@
 #include "overmap_connection.h"
 #include "overmap_location.h"
 #include "overmap_noise.h"
+#include "overmap_road_graph.h"
 #include "overmap_types.h"
 #include "overmapbuffer.h"
 #include "path_info.h"
@@ -68,6 +69,8 @@ static const mongroup_id GROUP_SUBWAY_CITY( "GROUP_SUBWAY_CITY" );
 static const mongroup_id GROUP_SWAMP( "GROUP_SWAMP" );
 static const mongroup_id GROUP_ZOMBIE( "GROUP_ZOMBIE" );
 
+static const option_handle<bool> option_WANDER_SPAWNS( "WANDER_SPAWNS" );
+
 static const oter_str_id oter_central_lab( "central_lab" );
 static const oter_str_id oter_central_lab_core( "central_lab_core" );
 static const oter_str_id oter_central_lab_train_depot( "central_lab_train_depot" );
@@ -3146,14 +3149,56 @@ oter_id overmap::get_default_terrain( int z ) const
 void overmap::init_layers()
 {
     for( int k = 0; k < OVERMAP_LAYERS; ++k ) {
-        const oter_id tid = get_default_terrain( k - OVERMAP_DEPTH );
-        map_layer &l = layer[k];
-        l.terrain.fill( tid );
-        l.visible.fill( om_vision_level::unseen );
-        l.explored.fill( false );
+        layers.loaded[k].reset();
+        layers.saved_terrain[k].clear();
+        layers.saved_view[k].clear();
+        layers.default_terrain[k] = get_default_terrain( k - OVERMAP_DEPTH );
+    }
+}
+
+map_layer &overmap::get_layer( const int k )
+{
+    if( map_layer *const l = layers.loaded[k].get() ) {
+        return *l;
+    }
+    return load_layer( k );
+}
+
+const map_layer &overmap::get_layer( const int k ) const
+{
+    // Loading a layer doesn't change what it contains
+    return const_cast<overmap *>( this )->get_layer( k );
+}
+
+int overmap::debug_loaded_layers() const
+{
+    return std::count_if( layers.loaded.begin(), layers.loaded.end(),
+    []( const std::unique_ptr<map_layer> &l ) {
+        return l != nullptr;
+    } );
+}
+
+lazy_map_layers::lazy_map_layers( const lazy_map_layers &other ) :
+    saved_terrain( other.saved_terrain ), saved_view( other.saved_view ),
+    default_terrain( other.default_terrain )
+{
+    for( size_t k = 0; k < loaded.size(); ++k ) {
+        if( other.loaded[k] ) {
+            loaded[k] = std::make_unique<map_layer>( *other.loaded[k] );
+        }
+    }
+}
+
+lazy_map_layers &lazy_map_layers::operator=( const lazy_map_layers &other )
+{
+    if( this != &other ) {
+        *this = lazy_map_layers( other );
     }
+    return *this;
 }
 
+lazy_map_layers::~lazy_map_layers() = default;
+
 void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
 {
     if( !inbounds( p ) ) {
@@ -3161,7 +3206,7 @@ void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
         return;
     }
 
-    oter_id &current_oter = layer[p.z() + OVERMAP_DEPTH].terrain[p.xy()];
+    oter_id &current_oter = get_layer( p.z() + OVERMAP_DEPTH ).terrain[p.xy()];
     const oter_type_str_id &current_type_id = current_oter->get_type_id();
     const oter_type_str_id &incoming_type_id = id->get_type_id();
     const bool current_type_same = current_type_id == incoming_type_id;
@@ -3192,6 +3237,29 @@ void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
         // We had a predecessor, and it was the same type as the incoming one
         // Don't push another copy.
     }
+
+    terrain_location_index &index = terrain_index[p.z() + OVERMAP_DEPTH];
+    if( index.valid && current_oter != id ) {
+        const oter_id background = get_default_terrain( p.z() );
+        if( current_oter != background ) {
+            std::vector<point_om_omt> &old_locations = index.locations[current_oter];
+            auto it = std::find( old_locations.begin(), old_locations.end(), p.xy() );
+            if( it != old_locations.end() ) {
+                *it = old_locations.back();
+                old_locations.pop_back();
+            }
+            if( old_locations.empty() ) {
+                index.locations.erase( current_oter );
+            }
+        }
+        if( id != background ) {
+            index.locations[id].push_back( p.xy() );
+        }
+    }
+    if( road_graph && p.z() == 0 && current_oter != id &&
+        ( overmap_road_graph::is_road( current_oter ) || overmap_road_graph::is_road( id ) ) ) {
+        road_graph.reset();
+    }
     current_oter = id;
 }
 
@@ -3207,7 +3275,7 @@ const oter_id &overmap::ter( const tripoint_om_omt &p ) const
 
 const oter_id &overmap::ter_unsafe( const tripoint_om_omt &p ) const
 {
-    return layer[p.z() + OVERMAP_DEPTH].terrain[p.xy()];
+    return get_layer( p.z() + OVERMAP_DEPTH ).terrain[p.xy()];
 }
 
 std::optional<mapgen_arguments> *overmap::mapgen_args( const tripoint_om_omt &p )
@@ -3247,7 +3315,7 @@ void overmap::set_seen( const tripoint_om_omt &p, om_vision_level val, bool forc
         return;
     }
 
-    layer[p.z() + OVERMAP_DEPTH].visible[p.xy()] = val;
+    get_layer( p.z() + OVERMAP_DEPTH ).visible[p.xy()] = val;
 
     if( val > om_vision_level::details ) {
         add_extra_note( p );
@@ -3259,7 +3327,7 @@ om_vision_level overmap::seen( const tripoint_om_omt &p ) const
     if( !inbounds( p ) ) {
         return om_vision_level::unseen;
     }
-    return layer[p.z() + OVERMAP_DEPTH].visible[p.xy()];
+    return get_layer( p.z() + OVERMAP_DEPTH ).visible[p.xy()];
 }
 
 bool &overmap::explored( const tripoint_om_omt &p )
@@ -3268,7 +3336,7 @@ bool &overmap::explored( const tripoint_om_omt &p )
         nullbool = false;
         return nullbool;
     }
-    return layer[p.z() + OVERMAP_DEPTH].explored[p.xy()];
+    return get_layer( p.z() + OVERMAP_DEPTH ).explored[p.xy()];
 }
 
 bool overmap::is_explored( const tripoint_om_omt &p ) const
@@ -3276,7 +3344,7 @@ bool overmap::is_explored( const tripoint_om_omt &p ) const
     if( !inbounds( p ) ) {
         return false;
     }
-    return layer[p.z() + OVERMAP_DEPTH].explored[p.xy()];
+    return get_layer( p.z() + OVERMAP_DEPTH ).explored[p.xy()];
 }
 
 bool overmap::mongroup_check( const mongroup &candidate ) const
@@ -3345,7 +3413,7 @@ bool overmap::has_note( const tripoint_om_omt &p ) const
         return false;
     }
 
-    for( const om_note &i : layer[p.z() + OVERMAP_DEPTH].notes ) {
+    for( const om_note &i : get_layer( p.z() + OVERMAP_DEPTH ).notes ) {
         if( i.p == p.xy() ) {
             return true;
         }
@@ -3355,7 +3423,7 @@ bool overmap::has_note( const tripoint_om_omt &p ) const
 
 bool overmap::is_marked_dangerous( const tripoint_om_omt &p ) const
 {
-    for( const om_note &i : layer[p.z() + OVERMAP_DEPTH].notes ) {
+    for( const om_note &i : get_layer( p.z() + OVERMAP_DEPTH ).notes ) {
         if( !i.dangerous ) {
             continue;
         } else if( p.xy() == i.p ) {
@@ -3392,7 +3460,7 @@ const std::string &overmap::note( const tripoint_om_omt &p ) const
         return fallback;
     }
 
-    const auto &notes = layer[p.z() + OVERMAP_DEPTH].notes;
+    const auto &notes = get_layer( p.z() + OVERMAP_DEPTH ).notes;
     const auto it = std::find_if( begin( notes ), end( notes ), [&]( const om_note & n ) {
         return n.p == p.xy();
     } );
@@ -3407,7 +3475,7 @@ void overmap::add_note( const tripoint_om_omt &p, std::string message )
         return;
     }
 
-    auto &notes = layer[p.z() + OVERMAP_DEPTH].notes;
+    auto &notes = get_layer( p.z() + OVERMAP_DEPTH ).notes;
     const auto it = std::find_if( begin( notes ), end( notes ), [&]( const om_note & n ) {
         return n.p == p.xy();
     } );
@@ -3423,7 +3491,7 @@ void overmap::add_note( const tripoint_om_omt &p, std::string message )
 
 void overmap::mark_note_dangerous( const tripoint_om_omt &p, int radius, bool is_dangerous )
 {
-    for( om_note &i : layer[p.z() + OVERMAP_DEPTH].notes ) {
+    for( om_note &i : get_layer( p.z() + OVERMAP_DEPTH ).notes ) {
         if( p.xy() == i.p ) {
             i.dangerous = is_dangerous;
             i.danger_radius = radius;
@@ -3438,7 +3506,7 @@ int overmap::note_danger_radius( const tripoint_om_omt &p ) const
         return -1;
     }
 
-    const auto &notes = layer[p.z() + OVERMAP_DEPTH].notes;
+    const auto &notes = get_layer( p.z() + OVERMAP_DEPTH ).notes;
     const auto it = std::find_if( begin( notes ), end( notes ), [&]( const om_note & n ) {
         return n.p == p.xy();
     } );
@@ -3454,7 +3522,7 @@ void overmap::delete_note( const tripoint_om_omt &p )
 std::vector<point_abs_omt> overmap::find_notes( const int z, const std::string &text )
 {
     std::vector<point_abs_omt> note_locations;
-    map_layer &this_layer = layer[z + OVERMAP_DEPTH];
+    map_layer &this_layer = get_layer( z + OVERMAP_DEPTH );
     for( const om_note &note : this_layer.notes ) {
         if( match_include_exclude( note.text, text ) ) {
             note_locations.push_back( project_combine( pos(), note.p ) );
@@ -3469,7 +3537,7 @@ bool overmap::has_extra( const tripoint_om_omt &p ) const
         return false;
     }
 
-    for( const om_map_extra &i : layer[p.z() + OVERMAP_DEPTH].extras ) {
+    for( const om_map_extra &i : get_layer( p.z() + OVERMAP_DEPTH ).extras ) {
         if( i.p == p.xy() ) {
             return true;
         }
@@ -3485,7 +3553,7 @@ const map_extra_id &overmap::extra( const tripoint_om_omt &p ) const
         return fallback;
     }
 
-    const auto &extras = layer[p.z() + OVERMAP_DEPTH].extras;
+    const auto &extras = get_layer( p.z() + OVERMAP_DEPTH ).extras;
     const auto it = std::find_if( begin( extras ),
     end( extras ), [&]( const om_map_extra & n ) {
         return n.p == p.xy();
@@ -3501,7 +3569,7 @@ void overmap::add_extra( const tripoint_om_omt &p, const map_extra_id &id )
         return;
     }
 
-    auto &extras = layer[p.z() + OVERMAP_DEPTH].extras;
+    auto &extras = get_layer( p.z() + OVERMAP_DEPTH ).extras;
     const auto it = std::find_if( begin( extras ),
     end( extras ), [&]( const om_map_extra & n ) {
         return n.p == p.xy();
@@ -3524,7 +3592,7 @@ void overmap::add_extra_note( const tripoint_om_omt &p )
         return;
     }
 
-    const std::vector<om_map_extra> &layer_extras = layer[p.z() + OVERMAP_DEPTH].extras;
+    const std::vector<om_map_extra> &layer_extras = get_layer( p.z() + OVERMAP_DEPTH ).extras;
     auto extrait = std::find_if( layer_extras.begin(),
     layer_extras.end(), [&p]( const om_map_extra & extra ) {
         return extra.p == p.xy();
@@ -3567,7 +3635,7 @@ void overmap::delete_extra( const tripoint_om_omt &p )
 std::vector<point_abs_omt> overmap::find_extras( const int z, const std::string &text )
 {
     std::vector<point_abs_omt> extra_locations;
-    map_layer &this_layer = layer[z + OVERMAP_DEPTH];
+    map_layer &this_layer = get_layer( z + OVERMAP_DEPTH );
     for( const om_map_extra &extra : this_layer.extras ) {
         const std::string extra_text = extra.id.c_str();
         if( match_include_exclude( extra_text, text ) ) {
@@ -3633,7 +3701,7 @@ void overmap::generate( const overmap *north, const overmap *east,
             for( int j = 0; j < OMAPY; j++ ) {
                 // NOLINTNEXTLINE(modernize-loop-convert)
                 for( int i = 0; i < OMAPX; i++ ) {
-                    layer[z + OVERMAP_DEPTH].terrain[i][j] = omt_outside_defined_omap;
+                    get_layer( z + OVERMAP_DEPTH ).terrain[i][j] = omt_outside_defined_omap;
                 }
             }
         }
@@ -4096,6 +4164,121 @@ std::vector<point_abs_omt> overmap::find_terrain( const std::string_view term, i
     return found;
 }
 
+overmap::terrain_location_index &overmap::get_terrain_index( int z )
+{
+    terrain_location_index &index = terrain_index[z + OVERMAP_DEPTH];
+    if( index.valid ) {
+        return index;
+    }
+    index.locations.clear();
+    const oter_id background = get_default_terrain( z );
+    const map_layer *const this_layer = layers.loaded[z + OVERMAP_DEPTH].get();
+    if( this_layer == nullptr ) {
+        visit_saved_terrain( z + OVERMAP_DEPTH, [&]( const oter_id & oter, int first, int count ) {
+            if( oter != background ) {
+                std::vector<point_om_omt> &locations = index.locations[oter];
+                for( int i = first; i < first + count; i++ ) {
+                    locations.emplace_back( i % OMAPX, i / OMAPX );
+                }
+            }
+        } );
+        index.valid = true;
+        return index;
+    }
+    for( int y = 0; y < OMAPY; y++ ) {
+        for( int x = 0; x < OMAPX; x++ ) {
+            const point_om_omt p( x, y );
+            const oter_id &oter = this_layer->terrain[p];
+            if( oter != background ) {
+                index.locations[oter].push_back( p );
+            }
+        }
+    }
+    index.valid = true;
+    return index;
+}
+
+void overmap::invalidate_location_indices()
+{
+    for( terrain_location_index &index : terrain_index ) {
+        index.valid = false;
+        index.locations.clear();
+    }
+    special_index_valid = false;
+    special_index.clear();
+    road_graph.reset();
+}
+
+const overmap_road_graph &overmap::get_road_graph()
+{
+    if( !road_graph ) {
+        road_graph = make_shared_fast<const overmap_road_graph>( *this );
+    }
+    return *road_graph;
+}
+
+void overmap::find_terrain_locations(
+    const std::vector<std::pair<std::string, ot_match_type>> &types, int z,
+    std::vector<tripoint_om_omt> &result )
+{
+    if( z < -OVERMAP_DEPTH || z > OVERMAP_HEIGHT ) {
+        return;
+    }
+    const auto matches = [&types]( const oter_id & oter ) {
+        return std::any_of( types.begin(), types.end(),
+        [&oter]( const std::pair<std::string, ot_match_type> &type ) {
+            return is_ot_match( type.first, oter, type.second );
+        } );
+    };
+    for( const auto &entry : get_terrain_index( z ).locations ) {
+        if( matches( entry.first ) ) {
+            for( const point_om_omt &p : entry.second ) {
+                result.emplace_back( p, z );
+            }
+        }
+    }
+    const oter_id background = get_default_terrain( z );
+    if( !matches( background ) ) {
+        return;
+    }
+    const map_layer *const this_layer = layers.loaded[z + OVERMAP_DEPTH].get();
+    if( this_layer == nullptr ) {
+        visit_saved_terrain( z + OVERMAP_DEPTH, [&]( const oter_id & oter, int first, int count ) {
+            if( oter == background ) {
+                for( int i = first; i < first + count; i++ ) {
+                    result.emplace_back( i % OMAPX, i / OMAPX, z );
+                }
+            }
+        } );
+        return;
+    }
+    for( int y = 0; y < OMAPY; y++ ) {
+        for( int x = 0; x < OMAPX; x++ ) {
+            const point_om_omt p( x, y );
+            if( this_layer->terrain[p] == background ) {
+                result.emplace_back( p, z );
+            }
+        }
+    }
+}
+
+void overmap::find_special_locations( const overmap_special_id &id,
+                                      std::vector<tripoint_om_omt> &result )
+{
+    if( !special_index_valid ) {
+        load_special_placements();
+        special_index.clear();
+        for( const auto &placement : overmap_special_placements ) {
+            special_index[placement.second].push_back( placement.first );
+        }
+        special_index_valid = true;
+    }
+    const auto it = special_index.find( id );
+    if( it != special_index.end() ) {
+        result.insert( result.end(), it->second.begin(), it->second.end() );
+    }
+}
+
 const city &overmap::get_nearest_city( const tripoint_om_omt &p ) const
 {
     int distance = 999;
@@ -4143,6 +4326,7 @@ void overmap::process_mongroups()
         }
         if( mg.empty() ) {
             zg.erase( it++ );
+            invalidate_hordes();
         } else {
             ++it;
         }
@@ -4152,11 +4336,14 @@ void overmap::process_mongroups()
 void overmap::clear_mon_groups()
 {
     zg.clear();
+    invalidate_hordes();
 }
 
 void overmap::clear_overmap_special_placements()
 {
+    saved_special_placements.clear();
     overmap_special_placements.clear();
+    special_index_valid = false;
 }
 void overmap::clear_cities()
 {
@@ -4314,6 +4501,16 @@ void overmap::migrate_oter_ids( const std::unordered_map<tripoint_om_omt, std::s
     }
 }
 
+void overmap::apply_pending_migrations()
+{
+    std::unordered_map<tripoint_om_omt, std::string> oter_migrations;
+    std::vector<tripoint_abs_omt> camps;
+    oter_migrations.swap( pending_oter_migrations );
+    camps.swap( pending_camps );
+    migrate_oter_ids( oter_migrations );
+    migrate_camps( camps );
+}
+
 void overmap::migrate_camps( const std::vector<tripoint_abs_omt> &points ) const
 {
     for( const tripoint_abs_omt &point : points ) {
@@ -4399,17 +4596,21 @@ void mongroup::wander( const overmap &om )
  */
 void overmap::move_hordes()
 {
-    // Prevent hordes to be moved twice by putting them in here after moving.
-    decltype( zg ) tmpzg;
-    //MOVE ZOMBIE GROUPS
-    for( auto it = zg.begin(); it != zg.end(); ) {
-        mongroup &mg = it->second;
-        if( !mg.horde || mg.behaviour == mongroup::horde_behaviour::nemesis ) {
-            //nemesis hordes have their own move function
-            ++it;
-            continue;
+    // Gather the hordes to move up front, so the update below runs over a flat batch
+    // and a horde that moved is never visited twice.
+    std::vector<decltype( zg )::iterator> batch;
+    for( auto it = zg.begin(); it != zg.end(); ++it ) {
+        const mongroup &mg = it->second;
+        //nemesis hordes have their own move function
+        if( mg.horde && mg.behaviour != mongroup::horde_behaviour::nemesis ) {
+            batch.push_back( it );
         }
+    }
 
+    std::vector<decltype( zg )::iterator> moved;
+    //MOVE ZOMBIE GROUPS
+    for( const decltype( zg )::iterator &it : batch ) {
+        mongroup &mg = it->second;
         if( mg.behaviour == mongroup::horde_behaviour::none ) {
             mg.behaviour =
                 one_in( 2 ) ? mongroup::horde_behaviour::city : mongroup::horde_behaviour::roam;
@@ -4455,18 +4656,21 @@ void overmap::move_hordes()
             if( mg.abs_pos.y() < mg.target.y() ) {
                 mg.abs_pos.y()++;
             }
-
-            // Erase the group at it's old location, add the group with the new location
-            tmpzg.emplace( mg.rel_pos(), mg );
-            zg.erase( it++ );
-        } else {
-            ++it;
+            moved.push_back( it );
         }
     }
-    // and now back into the monster group map.
-    zg.insert( tmpzg.begin(), tmpzg.end() );
+    // Re-key the moved groups under their new location. Moving the map nodes
+    // avoids copying every group along with its monsters.
+    for( const decltype( zg )::iterator &it : moved ) {
+        decltype( zg )::node_type node = zg.extract( it );
+        node.key() = node.mapped().rel_pos();
+        zg.insert( std::move( node ) );
+    }
+    if( !moved.empty() ) {
+        invalidate_hordes();
+    }
 
-    if( get_option<bool>( "WANDER_SPAWNS" ) ) {
+    if( option_WANDER_SPAWNS.get() ) {
 
         // Re-absorb zombies into hordes.
         // Scan over monsters outside the player's view and place them back into hordes.
@@ -4607,6 +4811,7 @@ void overmap::move_nemesis()
                 // Erase the group at its old location, add the group with the new location
                 tmpzg.emplace( mg.rel_pos(), mg );
                 zg.erase( it++ );
+                invalidate_hordes();
 
                 //there is only one nemesis horde, so we can stop looping after we move it
                 break;
@@ -4633,6 +4838,7 @@ bool overmap::remove_nemesis()
         mongroup &mg = it->second;
         if( mg.behaviour == mongroup::horde_behaviour::nemesis ) {
             zg.erase( it++ );
+            invalidate_hordes();
             return true;
         }
         it++;
@@ -4640,6 +4846,37 @@ bool overmap::remove_nemesis()
     return false;
 }
 
+// Side length, in submaps, of the grid cells hordes are bucketed into.
+static constexpr int horde_cell_size = 12;
+
+static point horde_cell( const point_abs_sm &p )
+{
+    return point( divide_round_down( p.x(), horde_cell_size ),
+                  divide_round_down( p.y(), horde_cell_size ) );
+}
+
+const overmap::horde_index &overmap::get_horde_index()
+{
+    if( hordes.valid ) {
+        return hordes;
+    }
+    hordes.groups.clear();
+    hordes.positions.clear();
+    hordes.cells.clear();
+    for( std::pair<const tripoint_om_sm, mongroup> &elem : zg ) {
+        mongroup &mg = elem.second;
+        if( !mg.horde || mg.behaviour == mongroup::horde_behaviour::nemesis ) {
+            continue;
+        }
+        const int index = static_cast<int>( hordes.groups.size() );
+        hordes.cells[horde_cell( mg.abs_pos.xy() )].push_back( index );
+        hordes.groups.push_back( &mg );
+        hordes.positions.push_back( mg.abs_pos );
+    }
+    hordes.valid = true;
+    return hordes;
+}
+
 /**
  * Alert hordes to the signal source such as a loud explosion.
  *
@@ -4650,19 +4887,30 @@ void overmap::signal_hordes( const tripoint_rel_sm &p_rel, const int sig_power )
 {
     tripoint_om_sm p( p_rel.raw() );
     tripoint_abs_sm absp = project_combine( pos(), p );
-    for( auto &elem : zg ) {
-        mongroup &mg = elem.second;
-        if( !mg.horde ) {
-            continue;
-        }
-        const int dist = rl_dist( absp, mg.abs_pos );
+    // nemesis hordes are signaled to the player by their own function and dont react to noise,
+    // so they are not part of the index.
+    const horde_index &index = get_horde_index();
+    // Hordes farther than sig_power along either axis are out of range, so only the
+    // grid cells overlapping that square need to be checked. Visit them in zg order.
+    const point_rel_sm reach( sig_power, sig_power );
+    const point cell_min = horde_cell( absp.xy() - reach );
+    const point cell_max = horde_cell( absp.xy() + reach );
+    std::vector<int> in_reach;
+    for( int y = cell_min.y; y <= cell_max.y; y++ ) {
+        for( int x = cell_min.x; x <= cell_max.x; x++ ) {
+            const auto cell = index.cells.find( point( x, y ) );
+            if( cell != index.cells.end() ) {
+                in_reach.insert( in_reach.end(), cell->second.begin(), cell->second.end() );
+            }
+        }
+    }
+    std::sort( in_reach.begin(), in_reach.end() );
+    for( const int i : in_reach ) {
+        mongroup &mg = *index.groups[i];
+        const int dist = rl_dist( absp, index.positions[i] );
         if( sig_power < dist ) {
             continue;
         }
-        if( mg.behaviour == mongroup::horde_behaviour::nemesis ) {
-            // nemesis hordes are signaled to the player by their own function and dont react to noise
-            continue;
-        }
         // TODO: base this in monster attributes, foremost GOODHEARING.
         const int inter_per_sig_power = 15; //Interest per signal value
         const int min_initial_inter = 30; //Min initial interest for horde
@@ -6663,6 +6911,7 @@ bool overmap::check_overmap_special_type( const overmap_special_id &id,
         const tripoint_om_omt &location ) const
 {
     // Try and find the special associated with this location.
+    load_special_placements();
     auto found_id = overmap_special_placements.find( location );
 
     // There was no special here, so bail.
@@ -6676,6 +6925,7 @@ bool overmap::check_overmap_special_type( const overmap_special_id &id,
 
 std::optional<overmap_special_id> overmap::overmap_special_at( const tripoint_om_omt &p ) const
 {
+    load_special_placements();
     auto it = overmap_special_placements.find( p );
 
     if( it == overmap_special_placements.end() ) {
@@ -7027,6 +7277,7 @@ std::vector<tripoint_om_omt> overmap::place_special(
 
     const bool is_safe_zone = special.has_flag( "SAFE_AT_WORLDGEN" );
 
+    load_special_placements();
     std::optional<mapgen_arguments> *mapgen_args_p = &*mapgen_arg_storage.emplace();
     special_placement_result result = special.place( *this, p, dir, cit, must_be_unexplored );
     for( const std::pair<om_pos_dir, std::string> &join : result.joins_used ) {
@@ -7038,6 +7289,7 @@ std::vector<tripoint_om_omt> overmap::place_special(
         if( is_safe_zone ) {
             safe_at_worldgen.emplace( location );
         }
+        special_index_valid = false;
     }
     // Place spawns.
     const overmap_special_spawns &spawns = special.get_monster_spawns();
@@ -7054,6 +7306,7 @@ std::vector<tripoint_om_omt> overmap::place_special(
             tripoint_om_omt pos = project_to<coords::omt>( it->second.rel_pos() );
             if( safe_at_worldgen.find( pos ) != safe_at_worldgen.end() ) {
                 zg.erase( it++ );
+                invalidate_hordes();
             } else {
                 ++it;
             }
@@ -7414,7 +7667,7 @@ void overmap::place_mongroups()
                         // they won't try very hard to get placed in the world, so there will
                         // probably be fewer zombies than expected.
                         m.horde = true;
-                        if( get_option<bool>( "WANDER_SPAWNS" ) ) {
+                        if( option_WANDER_SPAWNS.get() ) {
                             m.wander( *this );
                         }
                         add_mon_group( m );
@@ -7614,6 +7867,8 @@ void overmap::open( overmap_special_batch &enabled_specials )
         // pointers looks like (north, south, west, east)
         generate( pointers[0], pointers[3], pointers[1], pointers[2], enabled_specials );
     }
+    // Loading and generation write terrain directly, bypassing ter_set.
+    invalidate_location_indices();
 }
 
 // Note: this may throw io errors from std::ofstream
@@ -7631,6 +7886,7 @@ void overmap::save() const
 void overmap::spawn_mon_group( const mongroup &group, int radius )
 {
     tripoint_om_omt pos = project_to<coords::omt>( group.rel_pos() );
+    load_special_placements();
     if( safe_at_worldgen.find( pos ) != safe_at_worldgen.end() ) {
         return;
     }
@@ -7662,6 +7918,7 @@ std::vector<std::reference_wrapper<mongroup>> overmap::debug_unsafe_get_groups_a
 void overmap::add_mon_group( const mongroup &group )
 {
     zg.emplace( group.rel_pos(), group );
+    invalidate_hordes();
 }
 
 void overmap::add_mon_group( const mongroup &group, int radius )
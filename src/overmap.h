@@ -10,6 +10,7 @@
 #include <iosfwd>
 #include <iterator>
 #include <map>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -39,6 +40,7 @@ class cata_path;
 class character_id;
 class npc;
 class overmap_connection;
+class overmap_road_graph;
 struct regional_settings;
 
 namespace pf
@@ -117,6 +119,26 @@ struct map_layer {
     std::vector<om_map_extra> extras;
 };
 
+/**
+ * The z-levels of an overmap, each of them allocated on its first access.  Until then a layer
+ * is kept as the sections it was saved in, or not at all if it was never changed.
+ */
+struct lazy_map_layers {
+    std::array<std::unique_ptr<map_layer>, OVERMAP_LAYERS> loaded;
+    // Saved sections of the layers that are not loaded yet
+    std::array<std::string, OVERMAP_LAYERS> saved_terrain;
+    std::array<std::string, OVERMAP_LAYERS> saved_view;
+    // Terrain of the layers that have neither been loaded nor saved
+    std::array<oter_id, OVERMAP_LAYERS> default_terrain;
+
+    lazy_map_layers() = default;
+    lazy_map_layers( const lazy_map_layers &other );
+    lazy_map_layers( lazy_map_layers && ) noexcept = default;
+    lazy_map_layers &operator=( const lazy_map_layers &other );
+    lazy_map_layers &operator=( lazy_map_layers && ) noexcept = default;
+    ~lazy_map_layers();
+};
+
 struct om_special_sectors {
     std::vector<point_om_omt> sectors;
     int sector_width;
@@ -246,6 +268,24 @@ class overmap
          * coordinates), or empty vector if no matching terrain is found.
          */
         std::vector<point_abs_omt> find_terrain( std::string_view term, int zlevel ) const;
+        /**
+         * Append the local coordinates of every location on z-level @p z whose terrain
+         * matches any of @p types (see @ref is_ot_match) to @p result.
+         * Uses the per-layer terrain index, building it on first use.
+         */
+        void find_terrain_locations( const std::vector<std::pair<std::string, ot_match_type>> &types,
+                                     int z, std::vector<tripoint_om_omt> &result );
+        /**
+         * Append the local coordinates of every location that was placed as part of
+         * the overmap special @p id to @p result.
+         */
+        void find_special_locations( const overmap_special_id &id,
+                                     std::vector<tripoint_om_omt> &result );
+        /**
+         * The roads on the surface of this overmap as a graph, built on first use and rebuilt
+         * after ter_set changes a road.
+         */
+        const overmap_road_graph &get_road_graph();
 
         void ter_set( const tripoint_om_omt &p, const oter_id &id );
         // ter has bounds checking, and returns ot_null when out of bounds.
@@ -340,6 +380,32 @@ class overmap
         // Fill in any gaps in city_tiles that don't connect to the map edge
         void flood_fill_city_tiles();
         std::multimap<tripoint_om_sm, mongroup> zg; // NOLINT(cata-serialize)
+        // The hordes in zg (except the nemesis) in zg order, with their positions bucketed
+        // into a coarse grid so signal_hordes only looks at the ones in range.
+        // Rebuilt lazily; anything that changes zg must call invalidate_hordes().
+        struct horde_index {
+            std::vector<mongroup *> groups;
+            std::vector<tripoint_abs_sm> positions;
+            // Grid cell -> indices into groups/positions, ascending.
+            std::unordered_map<point, std::vector<int>> cells;
+            bool valid = false;
+
+            horde_index() = default;
+            // The pointers refer to the owning overmap's zg, so a copy starts out invalid.
+            horde_index( const horde_index & ) {}
+            horde_index &operator=( const horde_index & ) {
+                groups.clear();
+                positions.clear();
+                cells.clear();
+                valid = false;
+                return *this;
+            }
+        };
+        horde_index hordes; // NOLINT(cata-serialize)
+        const horde_index &get_horde_index();
+        void invalidate_hordes() {
+            hordes.valid = false;
+        }
     public:
         /** Unit test enablers to check if a given mongroup is present. */
         bool mongroup_check( const mongroup &candidate ) const;
@@ -377,7 +443,37 @@ class overmap
         // Random point used for special connections if there's no cities on the overmap, joins to all roads_out
         std::optional<point_om_omt> fallback_road_connection_point; // NOLINT(cata-serialize)
 
-        std::array<map_layer, OVERMAP_LAYERS> layer;
+        lazy_map_layers layers;
+        // Saved overmap_special_placements, parsed on first use
+        std::string saved_special_placements; // NOLINT(cata-serialize)
+        // Found while loading terrain, see apply_pending_migrations
+        std::unordered_map<tripoint_om_omt, std::string>
+                pending_oter_migrations; // NOLINT(cata-serialize)
+        std::vector<tripoint_abs_omt> pending_camps; // NOLINT(cata-serialize)
+
+        // Inverted index of a single z-level, from terrain to the locations holding it.
+        // The layer's default terrain is left out (it covers most of a layer) and is
+        // found by scanning the layer instead.
+        struct terrain_location_index {
+            std::unordered_map<oter_id, std::vector<point_om_omt>> locations;
+            bool valid = false;
+        };
+        // Lazily built on first lookup, then kept current by ter_set.
+        std::array<terrain_location_index, OVERMAP_LAYERS> terrain_index; // NOLINT(cata-serialize)
+        // Inverse of overmap_special_placements, rebuilt lazily after new placements.
+        std::unordered_map<overmap_special_id, std::vector<tripoint_om_omt>>
+                special_index; // NOLINT(cata-serialize)
+        bool special_index_valid = false; // NOLINT(cata-serialize)
+        // Shared, so copies of the overmap don't rebuild it.
+        shared_ptr_fast<const overmap_road_graph> road_graph; // NOLINT(cata-serialize)
+        terrain_location_index &get_terrain_index( int z );
+        void invalidate_location_indices();
+        /**
+         * Calls @p visit with each run of terrain of the layer at index @p k, which isn't loaded,
+         * and the index of the run's first tile in row order.  The layer stays unloaded.
+         */
+        void visit_saved_terrain(
+            int k, const std::function<void( const oter_id &, int, int )> &visit ) const;
         std::unordered_map<tripoint_abs_omt, scent_trace> scents;
 
         // Records the locations where a given overmap special was placed, which
@@ -408,6 +504,10 @@ class overmap
 
         // Initialize
         void init_layers();
+        /** The layer at index @p k (z-level + OVERMAP_DEPTH), loaded if it isn't yet. */
+        map_layer &get_layer( int k );
+        const map_layer &get_layer( int k ) const;
+        void load_special_placements() const;
         // open existing overmap, or generate a new one
         void open( overmap_special_batch &enabled_specials );
     public:
@@ -432,7 +532,17 @@ class overmap
         void serialize( std::ostream &fout ) const;
         // Save per-player overmap view data.
         void serialize_view( std::ostream &fout ) const;
+        /**
+         * Migrates the obsolete terrain and places the camps found while loading.  Called once the
+         * overmap is in the overmap buffer, as placing a camp looks up the overmaps around it.
+         */
+        void apply_pending_migrations();
     private:
+        // Parses the saved sections of a layer into a newly allocated one.
+        map_layer &load_layer( int k );
+        // Migrations the terrain needs are queued, see apply_pending_migrations.
+        void unserialize_terrain( int k, JsonArray layer_json );
+        void serialize_terrain( JsonOut &json, int k ) const;
         void generate( const overmap *north, const overmap *east,
                        const overmap *south, const overmap *west,
                        overmap_special_batch &enabled_specials );
@@ -544,6 +654,8 @@ class overmap
         // DEBUG ONLY!
         void debug_force_add_group( const mongroup &group );
         std::vector<std::reference_wrapper<mongroup>> debug_unsafe_get_groups_at( tripoint_abs_omt &loc );
+        // Number of z-levels that are loaded, see lazy_map_layers
+        int debug_loaded_layers() const;
     private:
         /**
          * Iterate over the overmap and place the quota of specials.
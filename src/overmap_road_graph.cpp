@@ -0,0 +1,436 @@
+#include "overmap_road_graph.h"
+
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <queue>
+
+#include "hash_utils.h"
+#include "line.h"
+#include "omdata.h"
+#include "overmap.h"
+#include "overmapbuffer.h"
+
+overmap_road_graph::overmap_road_graph( const overmap &om )
+{
+    const auto road_at = [&om]( const point_om_omt & p ) {
+        return p.x() >= 0 && p.x() < OMAPX && p.y() >= 0 && p.y() < OMAPY &&
+               is_road( om.ter( tripoint_om_omt( p, 0 ) ) );
+    };
+    const auto add_node = [this]( const point_om_omt & p ) {
+        node_index.emplace( p, static_cast<int>( nodes_.size() ) );
+        nodes_.push_back( { p, {} } );
+    };
+    // Follows every road leaving a node up to the next node
+    const auto trace_from = [&]( const int from ) {
+        const point_om_omt start = nodes_[from].pos;
+        for( const point &d : four_adjacent_offsets ) {
+            point_om_omt cur = start + point_rel_omt( d );
+            if( !road_at( cur ) || edge_index.count( cur ) != 0 ) {
+                continue;
+            }
+            const int edge_id = static_cast<int>( edges_.size() );
+            edge e{ from, -1, {} };
+            point_om_omt prev = start;
+            while( true ) {
+                const auto found = node_index.find( cur );
+                if( found != node_index.end() ) {
+                    e.to = found->second;
+                    break;
+                }
+                edge_index.emplace( cur, std::make_pair( edge_id, static_cast<int>( e.tiles.size() ) ) );
+                e.tiles.push_back( cur );
+                // Tiles that aren't nodes have exactly two roads next to them
+                for( const point &d2 : four_adjacent_offsets ) {
+                    const point_om_omt next = cur + point_rel_omt( d2 );
+                    if( next != prev && road_at( next ) ) {
+                        prev = cur;
+                        cur = next;
+                        break;
+                    }
+                }
+            }
+            // Neighbouring nodes are found from both sides
+            if( e.tiles.empty() && e.to < from ) {
+                continue;
+            }
+            nodes_[from].edges.push_back( edge_id );
+            if( e.to != from ) {
+                nodes_[e.to].edges.push_back( edge_id );
+            }
+            edges_.push_back( std::move( e ) );
+        }
+    };
+
+    for( int y = 0; y < OMAPY; y++ ) {
+        for( int x = 0; x < OMAPX; x++ ) {
+            const point_om_omt p( x, y );
+            if( !road_at( p ) ) {
+                continue;
+            }
+            const int roads_around = std::count_if( four_adjacent_offsets.begin(),
+            four_adjacent_offsets.end(), [&]( const point & d ) {
+                return road_at( p + point_rel_omt( d ) );
+            } );
+            if( roads_around != 2 || x == 0 || y == 0 || x == OMAPX - 1 || y == OMAPY - 1 ) {
+                add_node( p );
+            }
+        }
+    }
+    for( size_t i = 0; i < nodes_.size(); i++ ) {
+        trace_from( static_cast<int>( i ) );
+    }
+    // Loops without any junction get a node of their own
+    for( int y = 0; y < OMAPY; y++ ) {
+        for( int x = 0; x < OMAPX; x++ ) {
+            const point_om_omt p( x, y );
+            if( road_at( p ) && node_index.count( p ) == 0 && edge_index.count( p ) == 0 ) {
+                add_node( p );
+                trace_from( static_cast<int>( nodes_.size() ) - 1 );
+            }
+        }
+    }
+}
+
+bool overmap_road_graph::is_road( const oter_id &oter )
+{
+    switch( oter->get_travel_cost_type() ) {
+        case oter_travel_cost_type::road:
+        case oter_travel_cost_type::dirt_road:
+        case oter_travel_cost_type::trail:
+            return true;
+        default:
+            return false;
+    }
+}
+
+int overmap_road_graph::node_at( const point_om_omt &p ) const
+{
+    const auto it = node_index.find( p );
+    return it == node_index.end() ? -1 : it->second;
+}
+
+std::pair<int, int> overmap_road_graph::edge_at( const point_om_omt &p ) const
+{
+    const auto it = edge_index.find( p );
+    return it == edge_index.end() ? std::make_pair( -1, -1 ) : it->second;
+}
+
+namespace
+{
+
+// A node or an edge of the road graph of an overmap
+struct road_graph_ref {
+    point_abs_om om;
+    int index;
+
+    bool operator==( const road_graph_ref &other ) const {
+        return om == other.om && index == other.index;
+    }
+};
+
+struct road_graph_ref_hash {
+    std::size_t operator()( const road_graph_ref &ref ) const {
+        std::size_t seed = std::hash<point_abs_om>()( ref.om );
+        cata::hash_combine( seed, ref.index );
+        return seed;
+    }
+};
+
+struct road_search_node {
+    road_graph_ref ref;
+    // Cost of the tiles after the source up to and including this node
+    int cost;
+    // Index of the node it was reached from, -1 if it was reached from the source
+    int parent;
+    // Edge of the overmap it was reached along, -1 if it was reached across the overmap border
+    // or is the source
+    int edge;
+    // Whether the edge was traveled from its first node to its last
+    bool forward;
+    bool closed;
+};
+
+struct scored_search_node {
+    int score;
+    int index;
+
+    bool operator>( const scored_search_node &other ) const {
+        return score > other.score;
+    }
+};
+
+} // namespace
+
+pf::simple_path<tripoint_abs_omt> find_road_path( const tripoint_abs_omt &source,
+        const tripoint_abs_omt &dest, const pf::omt_scoring_fn &scorer, const int min_cost,
+        const int radius )
+{
+    pf::simple_path<tripoint_abs_omt> ret;
+    ret.dist = 0;
+    ret.cost = 0;
+    if( source.z() != 0 || dest.z() != 0 ) {
+        return ret;
+    }
+    const auto [source_om, source_local] = project_remain<coords::om>( source.xy() );
+    const auto [dest_om, dest_local] = project_remain<coords::om>( dest.xy() );
+    const point_abs_om om_min( std::min( source_om.x(), dest_om.x() ) - radius,
+                               std::min( source_om.y(), dest_om.y() ) - radius );
+    const point_abs_om om_max( std::max( source_om.x(), dest_om.x() ) + radius,
+                               std::max( source_om.y(), dest_om.y() ) + radius );
+
+    std::unordered_map<point_abs_om, const overmap_road_graph *> graphs;
+    const auto get_graph = [&]( const point_abs_om & om_pos ) -> const overmap_road_graph * {
+        const auto it = graphs.find( om_pos );
+        if( it != graphs.end() )
+        {
+            return it->second;
+        }
+        overmap *om = overmap_buffer.get_existing( om_pos );
+        const overmap_road_graph *graph = om == nullptr ? nullptr : &om->get_road_graph();
+        graphs.emplace( om_pos, graph );
+        return graph;
+    };
+    const overmap_road_graph *source_graph = get_graph( source_om );
+    const overmap_road_graph *dest_graph = get_graph( dest_om );
+    if( source_graph == nullptr || dest_graph == nullptr ) {
+        return ret;
+    }
+    const int source_node = source_graph->node_at( source_local );
+    const auto [source_edge, source_pos] = source_graph->edge_at( source_local );
+    const int dest_node = dest_graph->node_at( dest_local );
+    const auto [dest_edge, dest_pos] = dest_graph->edge_at( dest_local );
+    if( ( source_node < 0 && source_edge < 0 ) || ( dest_node < 0 && dest_edge < 0 ) ) {
+        return ret;
+    }
+    if( source == dest ) {
+        ret.points.push_back( source );
+        return ret;
+    }
+
+    const auto to_abs = []( const point_abs_om & om_pos, const point_om_omt & p ) {
+        return tripoint_abs_omt( project_combine( om_pos, p ), 0 );
+    };
+    const auto tile_cost = [&]( const point_abs_om & om_pos, const point_om_omt & p ) {
+        return scorer( to_abs( om_pos, p ) ).node_cost;
+    };
+    // Cost of the tiles [begin, end) of an edge, -1 if any of them can't be traveled
+    const auto range_cost = [&]( const point_abs_om & om_pos, const overmap_road_graph::edge & e,
+    int begin, int end ) {
+        int sum = 0;
+        for( int i = begin; i < end; i++ ) {
+            const int cost = tile_cost( om_pos, e.tiles[i] );
+            if( cost < 0 ) {
+                return -1;
+            }
+            sum += cost;
+        }
+        return sum;
+    };
+    std::unordered_map<road_graph_ref, int, road_graph_ref_hash> edge_costs;
+    const auto edge_cost = [&]( const road_graph_ref & ref, const overmap_road_graph::edge & e ) {
+        const auto it = edge_costs.find( ref );
+        if( it != edge_costs.end() ) {
+            return it->second;
+        }
+        const int cost = range_cost( ref.om, e, 0, static_cast<int>( e.tiles.size() ) );
+        edge_costs.emplace( ref, cost );
+        return cost;
+    };
+
+    std::vector<road_search_node> found;
+    std::unordered_map<road_graph_ref, int, road_graph_ref_hash> found_index;
+    std::priority_queue<scored_search_node, std::vector<scored_search_node>, std::greater<>> open;
+    const auto relax = [&]( const road_graph_ref & ref, int cost, int parent, int edge,
+    bool forward ) {
+        const auto it = found_index.find( ref );
+        int index;
+        if( it == found_index.end() ) {
+            index = static_cast<int>( found.size() );
+            found.push_back( { ref, cost, parent, edge, forward, false } );
+            found_index.emplace( ref, index );
+        } else {
+            index = it->second;
+            road_search_node &n = found[index];
+            if( n.closed || n.cost <= cost ) {
+                return;
+            }
+            n.cost = cost;
+            n.parent = parent;
+            n.edge = edge;
+            n.forward = forward;
+        }
+        const overmap_road_graph &graph = *get_graph( ref.om );
+        const point_abs_omt p = project_combine( ref.om, graph.nodes()[ref.index].pos );
+        open.push( { cost + octile_dist( p, dest.xy(), min_cost ), index } );
+    };
+
+    // The source is either a node or somewhere along an edge, from where both of the edge's
+    // nodes can be reached
+    if( source_node >= 0 ) {
+        relax( { source_om, source_node }, 0, -1, -1, true );
+    } else {
+        const overmap_road_graph::edge &e = source_graph->edges()[source_edge];
+        const int to_first = range_cost( source_om, e, 0, source_pos );
+        const int first_cost = tile_cost( source_om, source_graph->nodes()[e.from].pos );
+        if( to_first >= 0 && first_cost >= 0 ) {
+            relax( { source_om, e.from }, to_first + first_cost, -1, source_edge, false );
+        }
+        const int to_last = range_cost( source_om, e, source_pos + 1,
+                                        static_cast<int>( e.tiles.size() ) );
+        const int last_cost = tile_cost( source_om, source_graph->nodes()[e.to].pos );
+        if( to_last >= 0 && last_cost >= 0 ) {
+            relax( { source_om, e.to }, to_last + last_cost, -1, source_edge, true );
+        }
+    }
+
+    int best_cost = INT_MAX;
+    // Node the destination was reached from, -1 if it is along the same edge as the source
+    int best_parent = -1;
+    bool best_forward = true;
+    if( dest_edge >= 0 && source_om == dest_om && source_edge == dest_edge ) {
+        const overmap_road_graph::edge &e = dest_graph->edges()[dest_edge];
+        best_forward = dest_pos > source_pos;
+        const int cost = best_forward ? range_cost( dest_om, e, source_pos + 1, dest_pos + 1 ) :
+                         range_cost( dest_om, e, dest_pos, source_pos );
+        if( cost >= 0 ) {
+            best_cost = cost;
+        }
+    }
+
+    while( !open.empty() ) {
+        const scored_search_node top = open.top();
+        open.pop();
+        if( top.score >= best_cost ) {
+            break;
+        }
+        road_search_node &cur = found[top.index];
+        if( cur.closed ) {
+            continue;
+        }
+        cur.closed = true;
+        const road_graph_ref ref = cur.ref;
+        const int cost = cur.cost;
+        if( ref.om == dest_om && ref.index == dest_node ) {
+            best_cost = cost;
+            best_parent = top.index;
+            break;
+        }
+        const overmap_road_graph &graph = *get_graph( ref.om );
+        if( ref.om == dest_om && dest_edge >= 0 ) {
+            const overmap_road_graph::edge &e = graph.edges()[dest_edge];
+            if( e.from == ref.index ) {
+                const int along = range_cost( dest_om, e, 0, dest_pos + 1 );
+                if( along >= 0 && cost + along < best_cost ) {
+                    best_cost = cost + along;
+                    best_parent = top.index;
+                    best_forward = true;
+                }
+            }
+            if( e.to == ref.index ) {
+                const int along = range_cost( dest_om, e, dest_pos,
+                                              static_cast<int>( e.tiles.size() ) );
+                if( along >= 0 && cost + along < best_cost ) {
+                    best_cost = cost + along;
+                    best_parent = top.index;
+                    best_forward = false;
+                }
+            }
+        }
+
+        const overmap_road_graph::node &n = graph.nodes()[ref.index];
+        for( const int edge_id : n.edges ) {
+            const overmap_road_graph::edge &e = graph.edges()[edge_id];
+            if( e.from == e.to ) {
+                continue;
+            }
+            const bool forward = e.from == ref.index;
+            const int next = forward ? e.to : e.from;
+            const int along = edge_cost( { ref.om, edge_id }, e );
+            const int next_cost = tile_cost( ref.om, graph.nodes()[next].pos );
+            if( along >= 0 && next_cost >= 0 ) {
+                relax( { ref.om, next }, cost + along + next_cost, top.index, edge_id, forward );
+            }
+        }
+        // Nodes on the border lead to the node next to them on the neighbouring overmap
+        for( const point &d : four_adjacent_offsets ) {
+            const point_om_omt beyond = n.pos + point_rel_omt( d );
+            if( beyond.x() >= 0 && beyond.x() < OMAPX && beyond.y() >= 0 && beyond.y() < OMAPY ) {
+                continue;
+            }
+            const point_abs_om next_om = ref.om + point_rel_om( d );
+            if( next_om.x() < om_min.x() || next_om.x() > om_max.x() ||
+                next_om.y() < om_min.y() || next_om.y() > om_max.y() ) {
+                continue;
+            }
+            const overmap_road_graph *next_graph = get_graph( next_om );
+            if( next_graph == nullptr ) {
+                continue;
+            }
+            const point_om_omt next_pos( ( beyond.x() + OMAPX ) % OMAPX, ( beyond.y() + OMAPY ) % OMAPY );
+            const int next = next_graph->node_at( next_pos );
+            if( next < 0 ) {
+                continue;
+            }
+            const int next_cost = tile_cost( next_om, next_pos );
+            if( next_cost >= 0 ) {
+                relax( { next_om, next }, cost + next_cost, top.index, -1, true );
+            }
+        }
+    }
+    if( best_cost == INT_MAX ) {
+        return ret;
+    }
+
+    // Walk back from the destination, which gives the points in the order simple_path has them
+    std::vector<tripoint_abs_omt> &points = ret.points;
+    const auto add_tiles = [&]( const point_abs_om & om_pos, const overmap_road_graph::edge & e,
+    int begin, int end, bool reversed ) {
+        if( reversed ) {
+            for( int i = end - 1; i >= begin; i-- ) {
+                points.push_back( to_abs( om_pos, e.tiles[i] ) );
+            }
+        } else {
+            for( int i = begin; i < end; i++ ) {
+                points.push_back( to_abs( om_pos, e.tiles[i] ) );
+            }
+        }
+    };
+    points.push_back( dest );
+    if( dest_node < 0 ) {
+        const overmap_road_graph::edge &e = dest_graph->edges()[dest_edge];
+        if( best_parent < 0 ) {
+            if( best_forward ) {
+                add_tiles( dest_om, e, source_pos + 1, dest_pos, true );
+            } else {
+                add_tiles( dest_om, e, dest_pos + 1, source_pos, false );
+            }
+        } else if( best_forward ) {
+            add_tiles( dest_om, e, 0, dest_pos, true );
+        } else {
+            add_tiles( dest_om, e, dest_pos + 1, static_cast<int>( e.tiles.size() ), false );
+        }
+    }
+    for( int index = best_parent; index >= 0; ) {
+        const road_search_node &n = found[index];
+        const overmap_road_graph &graph = *get_graph( n.ref.om );
+        const tripoint_abs_omt p = to_abs( n.ref.om, graph.nodes()[n.ref.index].pos );
+        if( points.back() != p ) {
+            points.push_back( p );
+        }
+        if( n.edge >= 0 ) {
+            const overmap_road_graph::edge &e = graph.edges()[n.edge];
+            const bool from_source = n.parent < 0;
+            const int begin = from_source && !n.forward ? 0 : from_source ? source_pos + 1 : 0;
+            const int end = from_source && !n.forward ? source_pos : static_cast<int>( e.tiles.size() );
+            add_tiles( n.ref.om, e, begin, end, n.forward );
+        }
+        index = n.parent;
+    }
+    if( points.back() != source ) {
+        points.push_back( source );
+    }
+    ret.cost = best_cost;
+    ret.dist = 24 * static_cast<int>( points.size() - 1 );
+    return ret;
+}
@@ -0,0 +1,76 @@
+#pragma once
+#ifndef CATA_SRC_OVERMAP_ROAD_GRAPH_H
+#define CATA_SRC_OVERMAP_ROAD_GRAPH_H
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "coordinates.h"
+#include "point.h"
+#include "simple_pathfinding.h"
+#include "type_id.h"
+
+class overmap;
+
+/**
+ * The roads, dirt roads and trails on the surface of one overmap, as a graph.
+ *
+ * Nodes are the junctions, dead ends and the road tiles on the edge of the overmap, the edges
+ * are the stretches of road between them.  Nodes on the edge of the overmap are the portals to
+ * the neighbouring overmaps, they connect to the node next to them on the other side.
+ * Only the layout is kept, what it costs to travel a road depends on who travels it and is
+ * looked up during the search.
+ */
+class overmap_road_graph
+{
+    public:
+        struct node {
+            point_om_omt pos;
+            std::vector<int> edges;
+        };
+        struct edge {
+            int from;
+            int to;
+            // The road between the two nodes, from the one after @ref from to the one before @ref to
+            std::vector<point_om_omt> tiles;
+        };
+
+        explicit overmap_road_graph( const overmap &om );
+
+        static bool is_road( const oter_id &oter );
+
+        const std::vector<node> &nodes() const {
+            return nodes_;
+        }
+        const std::vector<edge> &edges() const {
+            return edges_;
+        }
+        /** Index of the node at @p p, -1 if there is none. */
+        int node_at( const point_om_omt &p ) const;
+        /**
+         * The edge @p p is on and its index in the edge's tiles, -1 for both if it isn't part
+         * of any edge.  Nodes aren't part of any edge.
+         */
+        std::pair<int, int> edge_at( const point_om_omt &p ) const;
+
+    private:
+        std::vector<node> nodes_;
+        std::vector<edge> edges_;
+        std::unordered_map<point_om_omt, int> node_index;
+        std::unordered_map<point_om_omt, std::pair<int, int>> edge_index;
+};
+
+/**
+ * Finds the cheapest path from @p source to @p dest along the road graphs of the overmaps that
+ * exist, both must be road tiles on the surface.
+ *
+ * @param scorer Cost of each tile, as for pf::find_overmap_path
+ * @param min_cost The lowest cost @p scorer gives any road tile, for the A* estimate
+ * @param radius Overmaps further than this from both ends aren't searched
+ * @returns The tiles of the path in reverse order, an empty path if there is none
+ */
+pf::simple_path<tripoint_abs_omt> find_road_path( const tripoint_abs_omt &source,
+        const tripoint_abs_omt &dest, const pf::omt_scoring_fn &scorer, int min_cost, int radius );
+
+#endif // CATA_SRC_OVERMAP_ROAD_GRAPH_H
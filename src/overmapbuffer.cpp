@@ -33,6 +33,7 @@
 #include "npc.h"
 #include "overmap.h"
 #include "overmap_connection.h"
+#include "overmap_road_graph.h"
 #include "overmap_types.h"
 #include "path_info.h"
 #include "point.h"
@@ -103,6 +104,7 @@ overmap &overmapbuffer::get( const point_abs_om &p )
     // necessarily the overmap at (x,y)
     fix_mongroups( new_om );
     fix_npcs( new_om );
+    new_om.apply_pending_migrations();
 
     last_requested_overmap = &new_om;
     return new_om;
@@ -119,6 +121,7 @@ void overmapbuffer::create_custom_overmap( const point_abs_om &p, overmap_specia
     overmap &new_om = *( overmaps[ p ] = std::make_unique<overmap>( p ) );
     overmap_count++;
     new_om.populate( specials );
+    new_om.apply_pending_migrations();
 }
 
 void overmapbuffer::fix_mongroups( overmap &new_overmap )
@@ -129,6 +132,7 @@ void overmapbuffer::fix_mongroups( overmap &new_overmap )
         // transformed into spawn points on a submap, the group can then be removed
         if( mg.empty() ) {
             new_overmap.zg.erase( it++ );
+            new_overmap.invalidate_hordes();
             continue;
         }
         // Inside the bounds of the overmap?
@@ -148,6 +152,7 @@ void overmapbuffer::fix_mongroups( overmap &new_overmap )
         overmap &om = get( omp );
         om.spawn_mon_group( mg, 1 );
         new_overmap.zg.erase( it++ );
+        new_overmap.invalidate_hordes();
     }
 }
 
@@ -176,6 +181,7 @@ void overmapbuffer::fix_nemesis( overmap &new_overmap )
         overmap &om = get( omp );
         om.spawn_mon_group( mg, 1 );
         new_overmap.zg.erase( it++ );
+        new_overmap.invalidate_hordes();
         //there should only be one nemesis, so we can break after finding it
         break;
     }
@@ -963,9 +969,91 @@ pf::simple_path<tripoint_abs_omt> overmapbuffer::get_travel_path(
         return pf::omt_score( cur_cost, is_ramp( pos ) );
     };
 
+    // Long trips get to the nearest road, follow the road graph and leave it near the
+    // destination, which only searches the tiles around both ends
+    pf::simple_path<tripoint_abs_omt> road_path{};
+    if( square_dist( src.xy(), dest.xy() ) > road_route_min_distance ) {
+        road_path = get_road_travel_path( src, dest, params, estimate );
+    }
+    // The road may go a long way around, so the direct search still runs.  It gives up on
+    // anything estimated to cost more than the road, which is quick when the road is direct.
+    std::optional<int> max_cost;
+    if( !road_path.points.empty() ) {
+        max_cost = road_path.cost;
+    }
+
     constexpr int radius = 4 * OMAPX; // radius of search in OMTs = 4 overmaps
-    const pf::simple_path<tripoint_abs_omt> &path = pf::find_overmap_path( src, dest, radius, estimate,
-            g->display_om_pathfinding_progress, std::nullopt, params.allow_diagonal );
+    pf::simple_path<tripoint_abs_omt> path = pf::find_overmap_path( src, dest, radius, estimate,
+            g->display_om_pathfinding_progress, max_cost, params.allow_diagonal );
+    if( !road_path.points.empty() && ( path.points.empty() || road_path.cost <= path.cost ) ) {
+        return road_path;
+    }
+    return path;
+}
+
+pf::simple_path<tripoint_abs_omt> overmapbuffer::get_road_travel_path(
+    const tripoint_abs_omt &src, const tripoint_abs_omt &dest, const overmap_path_params &params,
+    const pf::omt_scoring_fn &estimate )
+{
+    // How far from the road the trip may start or end
+    constexpr int road_access_radius = 24;
+
+    int min_cost = INT_MAX;
+    for( const oter_travel_cost_type type : {
+             oter_travel_cost_type::road, oter_travel_cost_type::dirt_road, oter_travel_cost_type::trail
+         } ) {
+        const int cost = params.get_cost( type );
+        if( cost > 0 ) {
+            min_cost = std::min( min_cost, cost );
+        }
+    }
+    if( min_cost == INT_MAX ) {
+        return {};
+    }
+    const auto closest_road = [&]( const tripoint_abs_omt & center ) -> std::optional<tripoint_abs_omt> {
+        for( const tripoint_abs_omt &p : closest_points_first( tripoint_abs_omt( center.xy(), 0 ),
+             road_access_radius ) )
+        {
+            if( overmap_road_graph::is_road( ter_existing( p ) ) && estimate( p ).node_cost >= 0 ) {
+                return p;
+            }
+        }
+        return std::nullopt;
+    };
+    const std::optional<tripoint_abs_omt> entry = closest_road( src );
+    const std::optional<tripoint_abs_omt> exit = closest_road( dest );
+    if( !entry || !exit ) {
+        return {};
+    }
+
+    constexpr int leg_radius = 2 * road_access_radius;
+    const auto find_leg = [&]( const tripoint_abs_omt & from, const tripoint_abs_omt & to ) {
+        if( from == to ) {
+            return pf::simple_path<tripoint_abs_omt> { { from }, 0, 0 };
+        }
+        return pf::find_overmap_path( from, to, leg_radius, estimate, g->display_om_pathfinding_progress,
+                                      std::nullopt, params.allow_diagonal );
+    };
+    const pf::simple_path<tripoint_abs_omt> first_leg = find_leg( src, *entry );
+    if( first_leg.points.empty() ) {
+        return {};
+    }
+    const pf::simple_path<tripoint_abs_omt> road_leg = find_road_path( *entry, *exit, estimate,
+            min_cost, 1 );
+    if( road_leg.points.empty() ) {
+        return {};
+    }
+    const pf::simple_path<tripoint_abs_omt> last_leg = find_leg( *exit, dest );
+    if( last_leg.points.empty() ) {
+        return {};
+    }
+
+    // The legs all list their points from their end, and share the points where they meet
+    pf::simple_path<tripoint_abs_omt> path = last_leg;
+    path.points.insert( path.points.end(), road_leg.points.begin() + 1, road_leg.points.end() );
+    path.points.insert( path.points.end(), first_leg.points.begin() + 1, first_leg.points.end() );
+    path.dist += road_leg.dist + first_leg.dist;
+    path.cost += road_leg.cost + first_leg.cost;
     return path;
 }
 
@@ -1144,6 +1232,160 @@ bool overmapbuffer::is_findable_location( const tripoint_abs_omt &location,
     return true;
 }
 
+namespace
+{
+
+// Position of a point in the sequence produced by closest_points_first: the ring (square
+// distance from the center) and the step along that ring, which starts at ( r, 1 - r )
+// and runs counterclockwise.
+struct spiral_order {
+    int ring = 0;
+    int step = 0;
+
+    bool operator<( const spiral_order &rhs ) const {
+        return std::tie( ring, step ) < std::tie( rhs.ring, rhs.step );
+    }
+};
+
+spiral_order spiral_order_of( const point_rel_omt &d )
+{
+    const int r = std::max( std::abs( d.x() ), std::abs( d.y() ) );
+    if( r == 0 ) {
+        return {};
+    }
+    if( d.x() == r && d.y() > -r ) {
+        return { r, d.y() + r - 1 };
+    }
+    if( d.y() == r ) {
+        return { r, 3 * r - 1 - d.x() };
+    }
+    if( d.x() == -r ) {
+        return { r, 5 * r - 1 - d.y() };
+    }
+    return { r, 7 * r - 1 + d.x() };
+}
+
+// Earliest point of ring r (relative to the search center) that lies within [lo, hi].
+std::optional<spiral_order> first_on_ring( const point_rel_omt &lo, const point_rel_omt &hi,
+        int r )
+{
+    std::optional<spiral_order> first;
+    const auto consider = [&]( int x, int y ) {
+        if( x < lo.x() || x > hi.x() || y < lo.y() || y > hi.y() ) {
+            return;
+        }
+        const spiral_order order = spiral_order_of( point_rel_omt( x, y ) );
+        if( !first || order < *first ) {
+            first = order;
+        }
+    };
+    for( int x = std::max( lo.x(), -r ); x <= std::min( hi.x(), r ); x++ ) {
+        consider( x, -r );
+        consider( x, r );
+    }
+    for( int y = std::max( lo.y(), -r ); y <= std::min( hi.y(), r ); y++ ) {
+        consider( -r, y );
+        consider( r, y );
+    }
+    return first;
+}
+
+struct terrain_match {
+    spiral_order order;
+    tripoint_abs_omt loc;
+
+    bool operator<( const terrain_match &rhs ) const {
+        if( order < rhs.order || rhs.order < order ) {
+            return order < rhs.order;
+        }
+        return loc.z() < rhs.loc.z();
+    }
+};
+
+} // namespace
+
+void overmapbuffer::visit_terrain_matches( const tripoint_abs_omt &origin,
+        const omt_find_params &params, int min_dist, int max_dist, int min_z, int max_z,
+        const int &max_found_dist, const std::function<void( const tripoint_abs_omt & )> &visit )
+{
+    const point_abs_omt center = origin.xy();
+    const point_rel_omt reach( max_dist, max_dist );
+    const point_abs_om om_min = project_to<coords::om>( center - reach );
+    const point_abs_om om_max = project_to<coords::om>( center + reach );
+
+    // Overmaps touched by the search, ordered by the first point a tile-by-tile search
+    // would reach in each of them.
+    using overmap_visit = std::pair<spiral_order, point_abs_om>;
+    std::vector<overmap_visit> to_visit;
+    for( int y = om_min.y(); y <= om_max.y(); y++ ) {
+        for( int x = om_min.x(); x <= om_max.x(); x++ ) {
+            const point_abs_om om_pos( x, y );
+            const point_rel_omt lo = project_to<coords::omt>( om_pos ) - center;
+            const point_rel_omt hi = lo + point_rel_omt( OMAPX - 1, OMAPY - 1 );
+            const int ring = std::max( { min_dist, 0, lo.x(), -hi.x(), lo.y(), -hi.y() } );
+            if( ring > max_dist ) {
+                continue;
+            }
+            if( std::optional<spiral_order> first = first_on_ring( lo, hi, ring ) ) {
+                to_visit.emplace_back( *first, om_pos );
+            }
+        }
+    }
+    std::sort( to_visit.begin(), to_visit.end(),
+    []( const overmap_visit & a, const overmap_visit & b ) {
+        return a.first < b.first;
+    } );
+
+    std::vector<terrain_match> pending;
+    // Visits pending matches that come before bound, returns false once the search is over.
+    const auto visit_pending = [&]( const spiral_order * bound ) {
+        std::sort( pending.begin(), pending.end() );
+        size_t visited = 0;
+        for( ; visited < pending.size(); visited++ ) {
+            const terrain_match &match = pending[visited];
+            if( bound != nullptr && !( match.order < *bound ) ) {
+                break;
+            }
+            if( match.order.ring > max_found_dist ) {
+                return false;
+            }
+            visit( match.loc );
+        }
+        pending.erase( pending.begin(), pending.begin() + visited );
+        return true;
+    };
+
+    std::vector<tripoint_om_omt> locations;
+    for( const overmap_visit &next : to_visit ) {
+        if( !visit_pending( &next.first ) || next.first.ring > max_found_dist ) {
+            return;
+        }
+        overmap *om = params.existing_only ? get_existing( next.second ) : &get( next.second );
+        if( om == nullptr ) {
+            continue;
+        }
+        locations.clear();
+        if( params.om_special ) {
+            om->find_special_locations( *params.om_special, locations );
+        } else {
+            for( int z = min_z; z <= max_z; z++ ) {
+                om->find_terrain_locations( params.types, z, locations );
+            }
+        }
+        for( const tripoint_om_omt &local : locations ) {
+            if( local.z() < min_z || local.z() > max_z ) {
+                continue;
+            }
+            const tripoint_abs_omt loc = project_combine( next.second, local );
+            const spiral_order order = spiral_order_of( loc.xy() - center );
+            if( order.ring >= min_dist && order.ring <= max_dist ) {
+                pending.push_back( { order, loc } );
+            }
+        }
+    }
+    visit_pending( nullptr );
+}
+
 tripoint_abs_omt overmapbuffer::find_closest(
     const tripoint_abs_omt &origin, const std::string &type, int const radius, bool must_be_seen,
     ot_match_type match_type, bool existing_overmaps_only,
@@ -1183,27 +1425,17 @@ tripoint_abs_omt overmapbuffer::find_closest( const tripoint_abs_omt &origin,
     std::vector<tripoint_abs_omt> result;
     int found_dist = std::numeric_limits<int>::max();
 
-    for( const point_abs_omt &loc_xy : closest_points_first( origin.xy(), min_dist, max_dist ) ) {
-        const int dist_xy = square_dist( origin.xy(), loc_xy );
-
-        if( found_dist < dist_xy ) {
-            break;
+    visit_terrain_matches( origin, params, min_dist, max_dist, params.min_z, params.max_z,
+    found_dist, [&]( const tripoint_abs_omt & loc ) {
+        const int dist = square_dist( origin, loc );
+        if( found_dist < dist ) {
+            return;
         }
-
-        for( int z = params.min_z; z <= params.max_z; z++ ) {
-            const tripoint_abs_omt loc( loc_xy, z );
-            const int dist = square_dist( origin, loc );
-
-            if( found_dist < dist ) {
-                continue;
-            }
-
-            if( is_findable_location( loc, params ) ) {
-                found_dist = dist;
-                result.push_back( loc );
-            }
+        if( is_findable_location( loc, params ) ) {
+            found_dist = dist;
+            result.push_back( loc );
         }
-    }
+    } );
 
     return random_entry( result, tripoint_abs_omt::invalid );
 }
@@ -1216,11 +1448,14 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all( const tripoint_abs_omt &o
     const int min_dist = params.min_distance;
     const int max_dist = params.search_range ? params.search_range : OMAPX;
 
-    for( const tripoint_abs_omt &loc : closest_points_first( origin, min_dist, max_dist ) ) {
+    const int no_limit = std::numeric_limits<int>::max();
+
+    visit_terrain_matches( origin, params, min_dist, max_dist, origin.z(), origin.z(), no_limit,
+    [&]( const tripoint_abs_omt & loc ) {
         if( is_findable_location( loc, params ) ) {
             result.push_back( loc );
         }
-    }
+    } );
 
     return result;
 }
@@ -553,6 +553,29 @@ class overmapbuffer
          * see omt_find_params for definitions of the terms
          */
         bool is_findable_location( const tripoint_abs_omt &location, const omt_find_params &params );
+        /**
+         * Calls @p visit for every location whose terrain matches @p params, in the order
+         * closest_points_first( origin.xy(), min_dist, max_dist ) reaches it, with z-levels
+         * min_z to max_z ascending at each point. Candidates come from the per-overmap
+         * terrain index instead of checking every tile. Overmaps are loaded (or generated)
+         * in the order a tile-by-tile search would reach them, and the search stops before
+         * any point farther than @p max_found_dist, which @p visit may lower.
+         */
+        void visit_terrain_matches( const tripoint_abs_omt &origin, const omt_find_params &params,
+                                    int min_dist, int max_dist, int min_z, int max_z,
+                                    const int &max_found_dist,
+                                    const std::function<void( const tripoint_abs_omt & )> &visit );
+        /**
+         * Part of get_travel_path for trips longer than @ref road_route_min_distance: goes to
+         * the closest road, along the road graphs of the overmaps with find_road_path and from
+         * the road closest to @p dest to it.  Returns an empty path if either end is too far from
+         * a road or any of the three legs can't be found.
+         */
+        pf::simple_path<tripoint_abs_omt> get_road_travel_path( const tripoint_abs_omt &src,
+                const tripoint_abs_omt &dest, const overmap_path_params &params,
+                const pf::omt_scoring_fn &estimate );
+        // Trips longer than this many overmap tiles also try the roads
+        static constexpr int road_route_min_distance = OMAPX;
 
         std::unordered_map< point_abs_om, std::unique_ptr< overmap > > overmaps;
         /**
@@ -206,6 +206,99 @@ std::vector<tripoint_bub_ms> map::straight_route( const tripoint_bub_ms &f,
     return ret;
 }
 
+namespace
+{
+
+struct furniture_pathfinding {
+    PathfindingFlags flags;
+    int movecost = 0;
+    // Replaces the move cost of the terrain under it instead of adding to it
+    bool bridge = false;
+};
+
+// Indexed by the int ids of the types
+std::vector<pathfinding_base> terrain_pathfinding;
+std::vector<furniture_pathfinding> furniture_pathfinding_table;
+
+} // namespace
+
+void pathfinding_base::finalize()
+{
+    terrain_pathfinding.clear();
+    terrain_pathfinding.reserve( ter_t::count() );
+    for( int i = 0; i < static_cast<int>( ter_t::count() ); i++ ) {
+        const ter_t &terrain = ter_id( i ).obj();
+        pathfinding_base base;
+        base.movecost = terrain.movecost;
+        // Everything map::shoot does more than leaving a trail for
+        if( terrain.shoot ) {
+            base.flags |= PathfindingFlag::ShotObstacle;
+        }
+        if( terrain.has_flag( ter_furn_flag::TFLAG_GOES_UP ) ) {
+            base.flags |= PathfindingFlag::GoesUp;
+        }
+        if( terrain.has_flag( ter_furn_flag::TFLAG_GOES_DOWN ) ) {
+            base.flags |= PathfindingFlag::GoesDown;
+        }
+        if( terrain.has_flag( ter_furn_flag::TFLAG_RAMP ) ||
+            terrain.has_flag( ter_furn_flag::TFLAG_RAMP_UP ) ) {
+            base.flags |= PathfindingFlag::GoesUp | PathfindingFlag::RampUp;
+        }
+        if( terrain.has_flag( ter_furn_flag::TFLAG_RAMP_DOWN ) ) {
+            base.flags |= PathfindingFlag::GoesDown | PathfindingFlag::RampDown;
+        }
+        if( terrain.has_flag( ter_furn_flag::TFLAG_SMALL_PASSAGE ) ) {
+            base.flags |= PathfindingFlag::RestrictLarge | PathfindingFlag::RestrictHuge;
+        }
+        if( !terrain.trap.obj().is_benign() ) {
+            base.floor_flags |= PathfindingFlag::DangerousTrap;
+        }
+        if( terrain.has_flag( ter_furn_flag::TFLAG_SHARP ) ) {
+            base.floor_flags |= PathfindingFlag::Sharp;
+        }
+        if( terrain.has_flag( ter_furn_flag::TFLAG_CLIMBABLE ) ) {
+            base.obstacle_flags |= PathfindingFlag::Climbable;
+        }
+        terrain_pathfinding.push_back( base );
+    }
+
+    furniture_pathfinding_table.clear();
+    furniture_pathfinding_table.reserve( furn_t::count() );
+    for( int i = 0; i < static_cast<int>( furn_t::count() ); i++ ) {
+        const furn_t &furniture = furn_id( i ).obj();
+        furniture_pathfinding base;
+        // No furniture doesn't change the terrain's move cost
+        if( !furniture.id.is_null() ) {
+            base.movecost = furniture.movecost;
+            base.bridge = furniture.has_flag( "BRIDGE" );
+        }
+        if( furniture.shoot ) {
+            base.flags |= PathfindingFlag::ShotObstacle;
+        }
+        furniture_pathfinding_table.push_back( base );
+    }
+}
+
+pathfinding_base pathfinding_base::of( const ter_id &ter, const furn_id &furn )
+{
+    if( static_cast<size_t>( ter.to_i() ) >= terrain_pathfinding.size() ||
+        static_cast<size_t>( furn.to_i() ) >= furniture_pathfinding_table.size() ) {
+        finalize();
+    }
+    pathfinding_base result = terrain_pathfinding[ter.to_i()];
+    const furniture_pathfinding &furniture = furniture_pathfinding_table[furn.to_i()];
+    result.flags |= furniture.flags;
+    // Same as map::move_cost_internal without fields and vehicles
+    if( result.movecost == 0 || furniture.movecost < 0 ) {
+        result.movecost = 0;
+    } else if( furniture.bridge ) {
+        result.movecost = 2 + furniture.movecost;
+    } else {
+        result.movecost = std::max( result.movecost, 0 ) + furniture.movecost;
+    }
+    return result;
+}
+
 static constexpr int PF_IMPASSABLE = -1;
 static constexpr int PF_IMPASSABLE_FROM_HERE = -2;
 int map::cost_to_pass( const tripoint_bub_ms &cur, const tripoint_bub_ms &p,
@@ -249,7 +342,9 @@ int map::cost_to_pass( const tripoint_bub_ms &cur, const tripoint_bub_ms &p,
     const field &field = tile.get_field();
     const vehicle *veh = veh_at_internal( p, part );
 
-    const int cost = move_cost_internal( furniture, terrain, field, veh, part );
+    const int cost = veh == nullptr && field.field_count() == 0 ?
+                     pathfinding_base::of( tile.get_ter(), tile.get_furn() ).movecost :
+                     move_cost_internal( furniture, terrain, field, veh, part );
 
     // If we can just walk into the tile, great. That's the cost.
     if( cost != 0 ) {
@@ -7,6 +7,7 @@
 #include "coords_fwd.h"
 #include "game_constants.h"
 #include "mdarray.h"
+#include "type_id.h"
 #include "character.h"
 
 // An attribute of a particular map square that is of interest in pathfinding.
@@ -43,6 +44,7 @@ enum class PathfindingFlag : uint8_t {
     RestrictLarge,  // Large cannot enter
     RestrictHuge,   // Huge cannot enter
     Lava,           // Lava terrain
+    ShotObstacle,   // Something map::shoot does more to than leave a trail
 };
 
 class PathfindingFlags
@@ -131,6 +133,24 @@ struct pathfinding_cache {
     cata::mdarray<PathfindingFlags, point_bub_ms> special;
 };
 
+/**
+ * The pathfinding flags and move cost a tile gets from its terrain and furniture alone.
+ * They are worked out for every terrain and furniture type when the game data is finalized,
+ * the traps, fields and vehicles on a tile still have to be added on top of them.
+ */
+struct pathfinding_base {
+    PathfindingFlags flags;
+    // Only set when the tile has no vehicle floor
+    PathfindingFlags floor_flags;
+    // Only set when the tile can't be walked into
+    PathfindingFlags obstacle_flags;
+    // Move cost without fields or vehicles, 0 if the tile can't be walked into
+    int movecost = 0;
+
+    static pathfinding_base of( const ter_id &ter, const furn_id &furn );
+    static void finalize();
+};
+
 struct pathfinding_settings {
     int bash_strength = 0;
     int max_dist = 0;
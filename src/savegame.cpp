@@ -2,7 +2,9 @@
 
 #include <algorithm>
 #include <fstream>
+#include <functional>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <type_traits>
@@ -69,7 +71,7 @@ extern std::map<std::string, std::list<input_event>> quick_shortcuts_map;
  * Changes that break backwards compatibility should bump this number, so the game can
  * load a legacy format loader.
  */
-const int savegame_version = 36;
+const int savegame_version = 37;
 
 /*
  * This is a global set by detected version header in .sav, maps.txt, or overmap.
@@ -136,16 +138,14 @@ void game::serialize( std::ostream &fout )
                  inactive_global_effect_on_condition_vector );
 
     //save queued effect_on_conditions
-    queued_eocs temp_queued( queued_global_effect_on_conditions );
     json.member( "queued_global_effect_on_conditions" );
     json.start_array();
-    while( !temp_queued.empty() ) {
+    for( const queued_eoc *eoc : queued_global_effect_on_conditions.sorted() ) {
         json.start_object();
-        json.member( "time", temp_queued.top().time );
-        json.member( "eoc", temp_queued.top().eoc );
-        json.member( "context", temp_queued.top().context );
+        json.member( "time", eoc->time );
+        json.member( "eoc", eoc->eoc );
+        json.member( "context", eoc->context );
         json.end_object();
-        temp_queued.pop();
     }
     json.end_array();
     global_variables_instance.serialize( json );
@@ -200,6 +200,107 @@ static size_t chkversion( std::istream &fin )
     return fin.tellg();
 }
 
+/*
+ * Overmap files are split into sections that are parsed on their own, so the parts that
+ * aren't needed yet can be left as they are.  After the version header comes a single line
+ * index with the name and length of each section, followed by the sections themselves.
+ */
+using save_sections = std::vector<std::pair<std::string, std::string>>;
+
+static bool has_sections( std::istream &fin )
+{
+    static const std::string prefix = R"({"sections":)";
+    const std::streampos start = fin.tellg();
+    std::string head( prefix.size(), '\0' );
+    fin.read( &head[0], static_cast<std::streamsize>( head.size() ) );
+    const bool found = fin.gcount() == static_cast<std::streamsize>( head.size() ) &&
+                       head == prefix;
+    fin.clear();
+    fin.seekg( start );
+    return found;
+}
+
+// Whether loading the saved terrain of a layer finds any obsolete terrain or camps to place.
+// Terrain ids are the only strings in it, so it is scanned for them without parsing.
+static bool saved_terrain_needs_migration( const std::string &terrain )
+{
+    for( size_t start = terrain.find( '"' ); start != std::string::npos;
+         start = terrain.find( '"', start ) ) {
+        const size_t end = terrain.find( '"', start + 1 );
+        if( end == std::string::npos ) {
+            // Malformed, loading it reports the error.
+            return true;
+        }
+        const std::string id = terrain.substr( start + 1, end - start - 1 );
+        if( overmap::is_oter_id_obsolete( id ) ) {
+            return true;
+        }
+        const oter_str_id oter( id );
+        if( oter.is_valid() && overmap::oter_id_should_have_camp( oter->get_type_id() ) ) {
+            return true;
+        }
+        start = end + 1;
+    }
+    return false;
+}
+
+static void write_sections( std::ostream &fout, const save_sections &sections )
+{
+    JsonOut json( fout );
+    json.start_object();
+    json.member( "sections" );
+    json.start_array();
+    for( const std::pair<std::string, std::string> &section : sections ) {
+        json.start_array();
+        json.write( section.first );
+        json.write( static_cast<int64_t>( section.second.size() ) );
+        json.end_array();
+    }
+    json.end_array();
+    json.end_object();
+    fout << std::endl;
+    for( const std::pair<std::string, std::string> &section : sections ) {
+        fout << section.second;
+    }
+}
+
+// throws std::exception
+static std::unordered_map<std::string, std::string> read_sections( std::istream &fin )
+{
+    std::string index_line;
+    std::getline( fin, index_line );
+    const JsonValue index = json_loader::from_string( index_line );
+    std::unordered_map<std::string, std::string> sections;
+    for( JsonArray section : index.get_object().get_array( "sections" ) ) {
+        std::string text( static_cast<size_t>( section[1].get_int64() ), '\0' );
+        fin.read( &text[0], static_cast<std::streamsize>( text.size() ) );
+        if( fin.gcount() != static_cast<std::streamsize>( text.size() ) ) {
+            section.throw_error( "Section is cut short" );
+        }
+        sections.emplace( section.get_string( 0 ), std::move( text ) );
+    }
+    return sections;
+}
+
+static std::string write_section( const std::function<void( JsonOut & )> &writer )
+{
+    std::ostringstream out;
+    JsonOut json( out );
+    writer( json );
+    out << std::endl;
+    return out.str();
+}
+
+static std::string terrain_section( const int k )
+{
+    return "terrain_" + std::to_string( k - OVERMAP_DEPTH );
+}
+
+static std::string view_section( const int k )
+{
+    return "view_" + std::to_string( k - OVERMAP_DEPTH );
+}
+
 /*
  * Parse an open .sav file.
  */
@@ -404,8 +505,94 @@ void overmap::load_legacy_monstergroups( const JsonArray &jsin )
 void overmap::unserialize( const cata_path &file_name, std::istream &fin )
 {
     size_t json_offset = chkversion( fin );
-    JsonValue jsin = json_loader::from_path_at_offset( file_name, json_offset );
-    unserialize( jsin.get_object() );
+    if( !has_sections( fin ) ) {
+        // Saved before overmaps were split into sections, everything is loaded right away.
+        JsonValue jsin = json_loader::from_path_at_offset( file_name, json_offset );
+        unserialize( jsin.get_object() );
+        return;
+    }
+    std::unordered_map<std::string, std::string> sections = read_sections( fin );
+    // Layers are loaded on their first access, see get_layer, unless their terrain needs
+    // migrating.  That is queued now rather than whenever something happens to look at them.
+    for( int k = 0; k < OVERMAP_LAYERS; ++k ) {
+        const auto it = sections.find( terrain_section( k ) );
+        if( it != sections.end() ) {
+            layers.loaded[k].reset();
+            layers.saved_terrain[k] = std::move( it->second );
+            if( saved_terrain_needs_migration( layers.saved_terrain[k] ) ) {
+                get_layer( k );
+            }
+        }
+    }
+    saved_special_placements = std::move( sections["overmap_special_placements"] );
+    for( const char *name : {
+             "monster_groups", "main"
+         } ) {
+        const auto it = sections.find( name );
+        if( it != sections.end() ) {
+            unserialize( json_loader::from_string( it->second ).get_object() );
+        }
+    }
+}
+
+void overmap::unserialize_terrain( const int k, JsonArray layer_json )
+{
+    const int z = k - OVERMAP_DEPTH;
+    map_layer &l = get_layer( k );
+    int count = 0;
+    std::string tmp_ter;
+    oter_id tmp_otid( 0 );
+    for( int j = 0; j < OMAPY; j++ ) {
+        for( int i = 0; i < OMAPX; i++ ) {
+            if( count == 0 ) {
+                {
+                    JsonArray rle_terrain = layer_json.next_array();
+                    tmp_ter = rle_terrain.next_string();
+                    count = rle_terrain.next_int();
+                    if( rle_terrain.has_more() ) {
+                        rle_terrain.throw_error( 2, "Unexpected value in RLE encoding" );
+                    }
+                }
+                bool is_obsolete = is_oter_id_obsolete( tmp_ter );
+                if( is_obsolete ) {
+                    for( int p = i; p < i + count; p++ ) {
+                        pending_oter_migrations.emplace( tripoint_om_omt( p, j, z ), tmp_ter );
+                    }
+                } else if( oter_str_id( tmp_ter ).is_valid() ) {
+                    tmp_otid = oter_id( tmp_ter );
+                } else {
+                    debugmsg( "Loaded invalid oter_id '%s'", tmp_ter.c_str() );
+                    tmp_otid = oter_omt_obsolete;
+                }
+                if( !is_obsolete &&
+                    oter_id_should_have_camp( oter_str_id( tmp_ter )->get_type_id() ) ) {
+                    for( int p = i; p < i + count; p++ ) {
+                        pending_camps.emplace_back(
+                            project_combine( pos(), tripoint_om_omt( p, j, z ) ) );
+                    }
+                }
+            }
+            count--;
+            l.terrain[i][j] = tmp_otid;
+        }
+    }
+}
+
+void overmap::load_special_placements() const
+{
+    if( saved_special_placements.empty() ) {
+        return;
+    }
+    // Like a layer, parsing them doesn't change what they are
+    overmap &self = const_cast<overmap &>( *this );
+    std::string saved;
+    saved.swap( self.saved_special_placements );
+    try {
+        self.unserialize( json_loader::from_string( saved ).get_object() );
+    } catch( const std::exception &err ) {
+        debugmsg( "overmap (%d,%d) failed to load special placements: %s", loc.x(), loc.y(),
+                  err.what() );
+    }
 }
 
 void overmap::unserialize( const JsonObject &jsobj )
@@ -424,50 +611,11 @@ void overmap::unserialize( const JsonObject &jsobj )
     }
     // Extract layers first so predecessor deduplication can happen.
     if( jsobj.has_member( "layers" ) ) {
-        std::unordered_map<tripoint_om_omt, std::string> oter_id_migrations;
-        std::vector<tripoint_abs_omt> camps_to_place;
         JsonArray layers_json = jsobj.get_array( "layers" );
 
         for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
-            JsonArray layer_json = layers_json.next_array();
-            int count = 0;
-            std::string tmp_ter;
-            oter_id tmp_otid( 0 );
-            for( int j = 0; j < OMAPY; j++ ) {
-                for( int i = 0; i < OMAPX; i++ ) {
-                    if( count == 0 ) {
-                        {
-                            JsonArray rle_terrain = layer_json.next_array();
-                            tmp_ter = rle_terrain.next_string();
-                            count = rle_terrain.next_int();
-                            if( rle_terrain.has_more() ) {
-                                rle_terrain.throw_error( 2, "Unexpected value in RLE encoding" );
-                            }
-                        }
-                        bool is_obsolete = is_oter_id_obsolete( tmp_ter );
-                        if( is_obsolete ) {
-                            for( int p = i; p < i + count; p++ ) {
-                                oter_id_migrations.emplace( tripoint_om_omt( p, j, z - OVERMAP_DEPTH ), tmp_ter );
-                            }
-                        } else if( oter_str_id( tmp_ter ).is_valid() ) {
-                            tmp_otid = oter_id( tmp_ter );
-                        } else {
-                            debugmsg( "Loaded invalid oter_id '%s'", tmp_ter.c_str() );
-                            tmp_otid = oter_omt_obsolete;
-                        }
-                        if( !is_obsolete && oter_id_should_have_camp( oter_str_id( tmp_ter )->get_type_id() ) ) {
-                            for( int p = i; p < i + count; p++ ) {
-                                camps_to_place.emplace_back( project_combine( pos(), tripoint_om_omt( p, j, z - OVERMAP_DEPTH ) ) );
-                            }
-                        }
-                    }
-                    count--;
-                    layer[z].terrain[i][j] = tmp_otid;
-                }
-            }
+            unserialize_terrain( z, layers_json.next_array() );
         }
-        migrate_oter_ids( oter_id_migrations );
-        migrate_camps( camps_to_place );
     }
     for( JsonMember om_member : jsobj ) {
         const std::string name = om_member.name();
@@ -738,7 +886,7 @@ void overmap::unserialize( const JsonObject &jsobj )
                     for( size_t i = 1; i < serialized_predecessors.size(); ++i ) {
                         local_set_ter( serialized_predecessors[i] );
                     }
-                    local_set_ter( layer[p.z() + OVERMAP_DEPTH].terrain[p.xy()] );
+                    local_set_ter( get_layer( p.z() + OVERMAP_DEPTH ).terrain[p.xy()] );
                 }
                 predecessors_.insert_or_assign( p, std::move( om_predecessors ) );
 
@@ -796,7 +944,7 @@ void overmap::unserialize_omap( const JsonValue &jsin, const cata_path &json_pat
                         }
                     }
                     count--;
-                    layer[z + OVERMAP_DEPTH].terrain[i][j] = tmp_otid;
+                    get_layer( z + OVERMAP_DEPTH ).terrain[i][j] = tmp_otid;
                     if( tmp_otid == oter_lake_shore || tmp_otid == oter_lake_surface ) {
                         lake_points.emplace_back( i, j, z );
                     }
@@ -840,7 +988,7 @@ void overmap::unserialize_omap( const JsonValue &jsin, const cata_path &json_pat
                 ter_set( tripoint_om_omt( p.xy(), z ), oter_lake_water_cube );
             }
             ter_set( tripoint_om_omt( p.xy(), settings->overmap_lake.lake_depth ), oter_lake_bed );
-            layer[p.z() + OVERMAP_DEPTH].terrain[p.x()][p.y()] = oter_lake_surface;
+            get_layer( p.z() + OVERMAP_DEPTH ).terrain[p.x()][p.y()] = oter_lake_surface;
         }
     }
     std::unordered_set<tripoint_om_omt> ocean_set;
@@ -870,7 +1018,7 @@ void overmap::unserialize_omap( const JsonValue &jsin, const cata_path &json_pat
                 ter_set( tripoint_om_omt( p.xy(), z ), oter_ocean_water_cube );
             }
             ter_set( tripoint_om_omt( p.xy(), settings->overmap_ocean.ocean_depth ), oter_ocean_bed );
-            layer[p.z() + OVERMAP_DEPTH].terrain[p.x()][p.y()] = oter_ocean_surface;
+            get_layer( p.z() + OVERMAP_DEPTH ).terrain[p.x()][p.y()] = oter_ocean_surface;
         }
     }
     std::unordered_set<tripoint_om_omt> forest_set;
@@ -918,12 +1066,104 @@ static void unserialize_array_from_compacted_sequence( JsonArray &ja, MdArray &a
     }
 }
 
+static void unserialize_visible( JsonArray visible_json, map_layer &l, const bool boolean_vision )
+{
+    if( boolean_vision ) {
+        cata::mdarray<bool, point_om_omt> old_vision;
+        unserialize_array_from_compacted_sequence( visible_json, old_vision );
+        for( int y = 0; y < OMAPY; ++y ) {
+            for( int x = 0; x < OMAPX; ++x ) {
+                point_om_omt idx( x, y );
+                l.visible[idx] = old_vision[idx] ? om_vision_level::full :
+                                 om_vision_level::unseen;
+            }
+        }
+    } else {
+        unserialize_array_from_compacted_sequence( visible_json, l.visible );
+    }
+    if( visible_json.has_more() ) {
+        visible_json.throw_error( "Too many sequences for z visible view" );
+    }
+}
+
+static void unserialize_explored( JsonArray explored_json, map_layer &l )
+{
+    unserialize_array_from_compacted_sequence( explored_json, l.explored );
+    if( explored_json.has_more() ) {
+        explored_json.throw_error( "Too many sequences for z explored view" );
+    }
+}
+
+static void unserialize_notes( const JsonArray &notes_json, map_layer &l )
+{
+    for( JsonArray note_json : notes_json ) {
+        om_note tmp;
+        note_json.read_next( tmp.p.x() );
+        note_json.read_next( tmp.p.y() );
+        note_json.read_next( tmp.text );
+        note_json.read_next( tmp.dangerous );
+        note_json.read_next( tmp.danger_radius );
+        if( note_json.size() > 5 ) {
+            note_json.throw_error( "Too many values for note" );
+        }
+
+        l.notes.push_back( tmp );
+    }
+}
+
+static void unserialize_extras( const JsonArray &extras_json, map_layer &l )
+{
+    for( JsonArray extra_json : extras_json ) {
+        om_map_extra tmp;
+        extra_json.read_next( tmp.p.x() );
+        extra_json.read_next( tmp.p.y() );
+        extra_json.read_next( tmp.id );
+        if( extra_json.has_more() ) {
+            extra_json.throw_error( "Too many values for extra" );
+        }
+
+        l.extras.push_back( tmp );
+    }
+}
+
+// One section of a view saved in sections, see overmap::serialize_view
+static void unserialize_layer_view( map_layer &l, const JsonObject &jsobj )
+{
+    for( JsonMember view_member : jsobj ) {
+        const std::string name = view_member.name();
+        if( name == "visible" ) {
+            unserialize_visible( view_member, l, false );
+        } else if( name == "explored" ) {
+            unserialize_explored( view_member, l );
+        } else if( name == "notes" ) {
+            unserialize_notes( view_member, l );
+        } else if( name == "extras" ) {
+            unserialize_extras( view_member, l );
+        }
+    }
+}
+
 // throws std::exception
 void overmap::unserialize_view( const cata_path &file_name, std::istream &fin )
 {
     size_t json_offset = chkversion( fin );
-    JsonValue jsin = json_loader::from_path_at_offset( file_name, json_offset );
-    unserialize_view( jsin.get_object() );
+    if( !has_sections( fin ) ) {
+        JsonValue jsin = json_loader::from_path_at_offset( file_name, json_offset );
+        unserialize_view( jsin.get_object() );
+        return;
+    }
+    std::unordered_map<std::string, std::string> sections = read_sections( fin );
+    for( int k = 0; k < OVERMAP_LAYERS; ++k ) {
+        const auto it = sections.find( view_section( k ) );
+        if( it == sections.end() ) {
+            continue;
+        }
+        if( map_layer *const l = layers.loaded[k].get() ) {
+            unserialize_layer_view( *l, json_loader::from_string( it->second ).get_object() );
+        } else {
+            layers.saved_view[k] = std::move( it->second );
+        }
+    }
 }
 
 void overmap::unserialize_view( const JsonObject &jsobj )
@@ -933,23 +1173,8 @@ void overmap::unserialize_view( const JsonObject &jsobj )
         if( name == "visible" ) {
             JsonArray visible_json = view_member;
             for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
-                JsonArray visible_by_z_json = visible_json.next_array();
-                if( savegame_loading_version < 34 ) {
-                    cata::mdarray<bool, point_om_omt> old_vision;
-                    unserialize_array_from_compacted_sequence( visible_by_z_json, old_vision );
-                    for( int y = 0; y < OMAPY; ++y ) {
-                        for( int x = 0; x < OMAPX; ++x ) {
-                            point_om_omt idx( x, y );
-                            layer[z].visible[idx] = old_vision[idx] ? om_vision_level::full :
-                                                    om_vision_level::unseen;
-                        }
-                    }
-                } else {
-                    unserialize_array_from_compacted_sequence( visible_by_z_json, layer[z].visible );
-                }
-                if( visible_by_z_json.has_more() ) {
-                    visible_by_z_json.throw_error( "Too many sequences for z visible view" );
-                }
+                unserialize_visible( visible_json.next_array(), get_layer( z ),
+                                     savegame_loading_version < 34 );
             }
             if( visible_json.has_more() ) {
                 visible_json.throw_error( "Too many views by z count" );
@@ -957,11 +1182,7 @@ void overmap::unserialize_view( const JsonObject &jsobj )
         } else if( name == "explored" ) {
             JsonArray explored_json = view_member;
             for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
-                JsonArray explored_by_z_json = explored_json.next_array();
-                unserialize_array_from_compacted_sequence( explored_by_z_json, layer[z].explored );
-                if( explored_by_z_json.has_more() ) {
-                    explored_by_z_json.throw_error( "Too many sequences for z explored view" );
-                }
+                unserialize_explored( explored_json.next_array(), get_layer( z ) );
             }
             if( explored_json.has_more() ) {
                 explored_json.throw_error( "Too many views by z count" );
@@ -969,20 +1190,7 @@ void overmap::unserialize_view( const JsonObject &jsobj )
         } else if( name == "notes" ) {
             JsonArray notes_json = view_member;
             for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
-                JsonArray notes_by_z_json = notes_json.next_array();
-                for( JsonArray note_json : notes_by_z_json ) {
-                    om_note tmp;
-                    note_json.read_next( tmp.p.x() );
-                    note_json.read_next( tmp.p.y() );
-                    note_json.read_next( tmp.text );
-                    note_json.read_next( tmp.dangerous );
-                    note_json.read_next( tmp.danger_radius );
-                    if( note_json.size() > 5 ) {
-                        note_json.throw_error( "Too many values for note" );
-                    }
-
-                    layer[z].notes.push_back( tmp );
-                }
+                unserialize_notes( notes_json.next_array(), get_layer( z ) );
             }
             if( notes_json.has_more() ) {
                 notes_json.throw_error( "Too many notes by z count" );
@@ -990,18 +1198,7 @@ void overmap::unserialize_view( const JsonObject &jsobj )
         } else if( name == "extras" ) {
             JsonArray extras_json = view_member;
             for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
-                JsonArray extras_by_z = extras_json.next_array();
-                for( JsonArray extra_json : extras_by_z ) {
-                    om_map_extra tmp;
-                    extra_json.read_next( tmp.p.x() );
-                    extra_json.read_next( tmp.p.y() );
-                    extra_json.read_next( tmp.id );
-                    if( extra_json.has_more() ) {
-                        extra_json.throw_error( "Too many values for extra" );
-                    }
-
-                    layer[z].extras.push_back( tmp );
-                }
+                unserialize_extras( extras_json.next_array(), get_layer( z ) );
             }
             if( extras_json.has_more() ) {
                 extras_json.throw_error( "Too many extras by z count" );
@@ -1009,6 +1206,60 @@ void overmap::unserialize_view( const JsonObject &jsobj )
         }
     }
 }
+
+map_layer &overmap::load_layer( const int k )
+{
+    std::unique_ptr<map_layer> &l = layers.loaded[k];
+    l = std::make_unique<map_layer>();
+    l->terrain.fill( layers.default_terrain[k] );
+    l->visible.fill( om_vision_level::unseen );
+    l->explored.fill( false );
+    // Taken first, the layer is accessed again while it's parsed
+    std::string terrain;
+    std::string view;
+    terrain.swap( layers.saved_terrain[k] );
+    view.swap( layers.saved_view[k] );
+    try {
+        if( !terrain.empty() ) {
+            unserialize_terrain( k, json_loader::from_string( terrain ).get_array() );
+        }
+        if( !view.empty() ) {
+            unserialize_layer_view( *l, json_loader::from_string( view ).get_object() );
+        }
+    } catch( const std::exception &err ) {
+        debugmsg( "overmap (%d,%d) failed to load z-level %d: %s", loc.x(), loc.y(),
+                  k - OVERMAP_DEPTH, err.what() );
+    }
+    return *l;
+}
+
+void overmap::visit_saved_terrain(
+    const int k, const std::function<void( const oter_id &, int, int )> &visit ) const
+{
+    const std::string &terrain = layers.saved_terrain[k];
+    if( terrain.empty() ) {
+        visit( layers.default_terrain[k], 0, OMAPX * OMAPY );
+        return;
+    }
+    try {
+        const JsonValue terrain_json = json_loader::from_string( terrain );
+        int first = 0;
+        for( JsonArray rle_terrain : terrain_json.get_array() ) {
+            const oter_str_id id( rle_terrain.next_string() );
+            const int count = std::min( rle_terrain.next_int(), OMAPX * OMAPY - first );
+            // Layers with obsolete terrain are loaded right away, see unserialize
+            visit( id.is_valid() ? id.id() : oter_omt_obsolete.id(), first, count );
+            first += count;
+            if( first >= OMAPX * OMAPY ) {
+                break;
+            }
+        }
+    } catch( const std::exception &err ) {
+        debugmsg( "overmap (%d,%d) failed to read z-level %d: %s", loc.x(), loc.y(),
+                  k - OVERMAP_DEPTH, err.what() );
+    }
+}
+
 template<typename MdArray>
 static void serialize_enum_array_to_compacted_sequence( JsonOut &json, const MdArray &array )
 {
@@ -1065,70 +1316,63 @@ static void serialize_array_to_compacted_sequence( JsonOut &json, const MdArray
     json.end_array();
 }
 
-void overmap::serialize_view( std::ostream &fout ) const
+static void serialize_layer_view( JsonOut &json, const map_layer &l )
 {
-    fout << "# version " << savegame_version << std::endl;
-
-    JsonOut json( fout, false );
     json.start_object();
-
     json.member( "visible" );
     json.start_array();
-    for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
-        json.start_array();
-        serialize_enum_array_to_compacted_sequence( json, layer[z].visible );
-        json.end_array();
-        fout << std::endl;
-    }
+    serialize_enum_array_to_compacted_sequence( json, l.visible );
     json.end_array();
 
     json.member( "explored" );
     json.start_array();
-    for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
-        json.start_array();
-        serialize_array_to_compacted_sequence( json, layer[z].explored );
-        json.end_array();
-        fout << std::endl;
-    }
+    serialize_array_to_compacted_sequence( json, l.explored );
     json.end_array();
 
     json.member( "notes" );
     json.start_array();
-    for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
+    for( const om_note &i : l.notes ) {
         json.start_array();
-        for( const om_note &i : layer[z].notes ) {
-            json.start_array();
-            json.write( i.p.x() );
-            json.write( i.p.y() );
-            json.write( i.text );
-            json.write( i.dangerous );
-            json.write( i.danger_radius );
-            json.end_array();
-            fout << std::endl;
-        }
+        json.write( i.p.x() );
+        json.write( i.p.y() );
+        json.write( i.text );
+        json.write( i.dangerous );
+        json.write( i.danger_radius );
         json.end_array();
     }
     json.end_array();
 
     json.member( "extras" );
     json.start_array();
-    for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
+    for( const om_map_extra &i : l.extras ) {
         json.start_array();
-        for( const om_map_extra &i : layer[z].extras ) {
-            json.start_array();
-            json.write( i.p.x() );
-            json.write( i.p.y() );
-            json.write( i.id );
-            json.end_array();
-            fout << std::endl;
-        }
+        json.write( i.p.x() );
+        json.write( i.p.y() );
+        json.write( i.id );
         json.end_array();
     }
     json.end_array();
-
     json.end_object();
 }
 
+void overmap::serialize_view( std::ostream &fout ) const
+{
+    fout << "# version " << savegame_version << std::endl;
+
+    save_sections sections;
+    for( int k = 0; k < OVERMAP_LAYERS; ++k ) {
+        if( const map_layer *const l = layers.loaded[k].get() ) {
+            sections.emplace_back( view_section( k ), write_section( [l]( JsonOut & json ) {
+                serialize_layer_view( json, *l );
+            } ) );
+        } else if( !layers.saved_view[k].empty() ) {
+            sections.emplace_back( view_section( k ), layers.saved_view[k] );
+        }
+        // Otherwise nothing on the layer has been seen
+    }
+    write_sections( fout, sections );
+}
+
 // Compares all fields except position and monsters
 // If any group has monsters, it is never equal to any group (because monsters are unique)
 struct mongroup_bin_eq {
@@ -1188,54 +1432,118 @@ void overmap::save_monster_groups( JsonOut &jout ) const
     jout.end_array();
 }
 
-void overmap::serialize( std::ostream &fout ) const
+void overmap::serialize_terrain( JsonOut &json, const int k ) const
 {
-    fout << "# version " << savegame_version << std::endl;
-
-    JsonOut json( fout, false );
-    json.start_object();
-
-    json.member( "layers" );
     json.start_array();
-    for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
-        const auto &layer_terrain = layer[z].terrain;
-        int count = 0;
-        oter_id last_tertype( -1 );
+    const map_layer *const l = layers.loaded[k].get();
+    if( l == nullptr ) {
+        // Never changed from the default terrain
         json.start_array();
-        for( int j = 0; j < OMAPY; j++ ) {
-            // NOLINTNEXTLINE(modernize-loop-convert)
-            for( int i = 0; i < OMAPX; i++ ) {
-                oter_id t = layer_terrain[i][j];
-                if( t != last_tertype ) {
-                    if( count ) {
-                        json.write( count );
-                        json.end_array();
-                    }
-                    last_tertype = t;
-                    json.start_array();
-                    json.write( t.id() );
-                    count = 1;
-                } else {
-                    count++;
+        json.write( layers.default_terrain[k].id() );
+        json.write( OMAPX * OMAPY );
+        json.end_array();
+        json.end_array();
+        return;
+    }
+    const auto &layer_terrain = l->terrain;
+    int count = 0;
+    oter_id last_tertype( -1 );
+    for( int j = 0; j < OMAPY; j++ ) {
+        // NOLINTNEXTLINE(modernize-loop-convert)
+        for( int i = 0; i < OMAPX; i++ ) {
+            oter_id t = layer_terrain[i][j];
+            if( t != last_tertype ) {
+                if( count ) {
+                    json.write( count );
+                    json.end_array();
                 }
+                last_tertype = t;
+                json.start_array();
+                json.write( t.id() );
+                count = 1;
+            } else {
+                count++;
             }
         }
-        json.write( count );
-        // End the last entry for a z-level.
-        json.end_array();
-        // End the z-level
-        json.end_array();
-        // Insert a newline occasionally so the file isn't totally unreadable.
-        fout << std::endl;
     }
+    json.write( count );
+    // End the last entry for a z-level.
+    json.end_array();
+    // End the z-level
     json.end_array();
+}
+
+void overmap::serialize( std::ostream &fout ) const
+{
+    fout << "# version " << savegame_version << std::endl;
+
+    save_sections sections;
+    for( int k = 0; k < OVERMAP_LAYERS; ++k ) {
+        if( !layers.loaded[k] && !layers.saved_terrain[k].empty() ) {
+            // Not loaded since it was read, so it didn't change
+            sections.emplace_back( terrain_section( k ), layers.saved_terrain[k] );
+        } else {
+            const std::string text = write_section( [this, k]( JsonOut & json ) {
+                serialize_terrain( json, k );
+            } );
+            sections.emplace_back( terrain_section( k ), text );
+        }
+    }
+
+    sections.emplace_back( "monster_groups", write_section( [this]( JsonOut & json ) {
+        json.start_object();
+        save_monster_groups( json );
+        json.end_object();
+    } ) );
+
+    if( !saved_special_placements.empty() ) {
+        sections.emplace_back( "overmap_special_placements", saved_special_placements );
+    } else {
+        const std::string text = write_section( [this]( JsonOut & json ) {
+            // Condense the overmap special placements so that all placements of a given special
+            // are grouped under a single key for that special.
+            std::map<overmap_special_id, std::vector<tripoint_om_omt>> condensed;
+            for( const auto &placement : overmap_special_placements ) {
+                condensed[placement.second].emplace_back( placement.first );
+            }
+
+            json.start_object();
+            json.member( "overmap_special_placements" );
+            json.start_array();
+            for( const auto &placement : condensed ) {
+                json.start_object();
+                json.member( "special", placement.first );
+                json.member( "placements" );
+                json.start_array();
+                // When we have a discriminator for different instances of a given special,
+                // we'd use that that group them, but since that doesn't exist yet we'll
+                // dump all the points of a given special into a single entry.
+                json.start_object();
+                json.member( "points" );
+                json.start_array();
+                for( const tripoint_om_omt &pos : placement.second ) {
+                    json.start_object();
+                    json.member( "p", pos );
+                    json.end_object();
+                }
+                json.end_array();
+                json.end_object();
+                json.end_array();
+                json.end_object();
+            }
+            json.end_array();
+            json.end_object();
+        } );
+        sections.emplace_back( "overmap_special_placements", text );
+    }
+
+    std::ostringstream out;
+    JsonOut json( out, false );
+    json.start_object();
 
     // temporary, to allow user to manually switch regions during play until regionmap is done.
     json.member( "region_id", settings->id );
-    fout << std::endl;
-
-    save_monster_groups( json );
-    fout << std::endl;
+    out << std::endl;
 
     json.member( "cities" );
     json.start_array();
@@ -1251,13 +1559,13 @@ void overmap::serialize( std::ostream &fout ) const
         json.end_object();
     }
     json.end_array();
-    fout << std::endl;
+    out << std::endl;
 
     json.member( "city_tiles", city_tiles );
-    fout << std::endl;
+    out << std::endl;
 
     json.member( "connections_out", connections_out );
-    fout << std::endl;
+    out << std::endl;
 
     json.member( "radios" );
     json.start_array();
@@ -1272,7 +1580,7 @@ void overmap::serialize( std::ostream &fout ) const
         json.end_object();
     }
     json.end_array();
-    fout << std::endl;
+    out << std::endl;
 
     json.member( "monster_map" );
     json.start_array();
@@ -1281,7 +1589,7 @@ void overmap::serialize( std::ostream &fout ) const
         i.second.serialize( json );
     }
     json.end_array();
-    fout << std::endl;
+    out << std::endl;
 
     json.member( "tracked_vehicles" );
     json.start_array();
@@ -1294,7 +1602,7 @@ void overmap::serialize( std::ostream &fout ) const
         json.end_object();
     }
     json.end_array();
-    fout << std::endl;
+    out << std::endl;
 
     json.member( "scent_traces" );
     json.start_array();
@@ -1306,7 +1614,7 @@ void overmap::serialize( std::ostream &fout ) const
         json.end_object();
     }
     json.end_array();
-    fout << std::endl;
+    out << std::endl;
 
     json.member( "npcs" );
     json.start_array();
@@ -1314,7 +1622,7 @@ void overmap::serialize( std::ostream &fout ) const
         json.write( *i );
     }
     json.end_array();
-    fout << std::endl;
+    out << std::endl;
 
     json.member( "camps" );
     json.start_array();
@@ -1322,43 +1630,10 @@ void overmap::serialize( std::ostream &fout ) const
         json.write( i );
     }
     json.end_array();
-    fout << std::endl;
-
-    // Condense the overmap special placements so that all placements of a given special
-    // are grouped under a single key for that special.
-    std::map<overmap_special_id, std::vector<tripoint_om_omt>> condensed_overmap_special_placements;
-    for( const auto &placement : overmap_special_placements ) {
-        condensed_overmap_special_placements[placement.second].emplace_back( placement.first );
-    }
-
-    json.member( "overmap_special_placements" );
-    json.start_array();
-    for( const auto &placement : condensed_overmap_special_placements ) {
-        json.start_object();
-        json.member( "special", placement.first );
-        json.member( "placements" );
-        json.start_array();
-        // When we have a discriminator for different instances of a given special,
-        // we'd use that that group them, but since that doesn't exist yet we'll
-        // dump all the points of a given special into a single entry.
-        json.start_object();
-        json.member( "points" );
-        json.start_array();
-        for( const tripoint_om_omt &pos : placement.second ) {
-            json.start_object();
-            json.member( "p", pos );
-            json.end_object();
-        }
-        json.end_array();
-        json.end_object();
-        json.end_array();
-        json.end_object();
-    }
-    json.end_array();
-    fout << std::endl;
+    out << std::endl;
 
     json.member( "mapgen_arg_storage", mapgen_arg_storage );
-    fout << std::endl;
+    out << std::endl;
     json.member( "mapgen_arg_index" );
     json.start_array();
     for( const std::pair<const tripoint_om_omt, std::optional<mapgen_arguments> *> &p :
@@ -1371,20 +1646,23 @@ void overmap::serialize( std::ostream &fout ) const
         json.end_array();
     }
     json.end_array();
-    fout << std::endl;
+    out << std::endl;
 
     std::vector<std::pair<om_pos_dir, std::string>> flattened_joins_used(
                 joins_used.begin(), joins_used.end() );
     json.member( "joins_used", flattened_joins_used );
-    fout << std::endl;
+    out << std::endl;
 
     std::vector<std::pair<tripoint_om_omt, std::vector<oter_id>>> flattened_predecessors(
         predecessors_.begin(), predecessors_.end() );
     json.member( "predecessors", flattened_predecessors );
-    fout << std::endl;
+    out << std::endl;
 
     json.end_object();
-    fout << std::endl;
+    out << std::endl;
+    sections.emplace_back( "main", out.str() );
+
+    write_sections( fout, sections );
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -1551,17 +1829,19 @@ void weather_manager::unserialize_all( const JsonObject &w )
 void global_variables::unserialize( JsonObject &jo )
 {
     // global variables
-    jo.read( "global_vals", global_values );
+    std::unordered_map<std::string, std::string> loaded_values;
+    jo.read( "global_vals", loaded_values );
     // potentially migrate some variable names
     for( std::pair<std::string, std::string> migration : migrations ) {
-        if( global_values.count( migration.first ) != 0 ) {
-            auto extracted = global_values.extract( migration.first );
+        if( loaded_values.count( migration.first ) != 0 ) {
+            auto extracted = loaded_values.extract( migration.first );
             extracted.key() = migration.second;
-            global_values.insert( std::move( extracted ) );
+            loaded_values.insert( std::move( extracted ) );
         }
     }
 
-    game::legacy_migrate_npctalk_var_prefix( global_values );
+    game::legacy_migrate_npctalk_var_prefix( loaded_values );
+    global_values.from_strings( loaded_values );
 }
 
 void timed_event_manager::unserialize_all( const JsonArray &ja )
@@ -255,6 +255,7 @@ void item_pocket::serialize( JsonOut &json ) const
 
 void item_pocket::deserialize( const JsonObject &data )
 {
+    invalidate_contents_totals();
     data.allow_omitted_members();
     data.read( "contents", contents );
     int saved_type_int;
@@ -1531,16 +1532,14 @@ void Character::store( JsonOut &json ) const
     json.member( "suppress_autohaul", suppress_autohaul );
 
     //save queued effect_on_conditions
-    queued_eocs temp_queued( queued_effect_on_conditions );
     json.member( "queued_effect_on_conditions" );
     json.start_array();
-    while( !temp_queued.empty() ) {
+    for( const queued_eoc *eoc : queued_effect_on_conditions.sorted() ) {
         json.start_object();
-        json.member( "time", temp_queued.top().time );
-        json.member( "eoc", temp_queued.top().eoc );
-        json.member( "context", temp_queued.top().context );
+        json.member( "time", eoc->time );
+        json.member( "eoc", eoc->eoc );
+        json.member( "context", eoc->context );
         json.end_object();
-        temp_queued.pop();
     }
 
     json.end_array();
@@ -3827,17 +3826,19 @@ void Creature::load( const JsonObject &jsin )
     }
 
     // u/npc variables
-    jsin.read( "values", values );
+    std::unordered_map<std::string, std::string> loaded_values;
+    jsin.read( "values", loaded_values );
     // potentially migrate some values
     for( std::pair<std::string, std::string> migration : get_globals().migrations ) {
-        if( values.count( migration.first ) != 0 ) {
-            auto extracted = values.extract( migration.first );
+        if( loaded_values.count( migration.first ) != 0 ) {
+            auto extracted = loaded_values.extract( migration.first );
             extracted.key() = migration.second;
-            values.insert( std::move( extracted ) );
+            loaded_values.insert( std::move( extracted ) );
         }
     }
 
-    game::legacy_migrate_npctalk_var_prefix( values );
+    game::legacy_migrate_npctalk_var_prefix( loaded_values );
+    values.from_strings( loaded_values );
 
     jsin.read( "damage_over_time_map", damage_over_time_map );
 
@@ -0,0 +1,108 @@
+#if defined(TILES)
+#include "sdl_sprite_batch.h"
+
+#include <utility>
+
+#include "cata_assert.h"
+
+int sprite_batch::add( const SDL_Renderer_Ptr &renderer, SDL_Texture *const tex,
+                       const SDL_Rect &srcrect, const SDL_Rect &dstrect, const int angle,
+                       const SDL_RendererFlip flip )
+{
+#if defined(CATA_SPRITE_BATCHING)
+    if( enabled ) {
+        int ret = 0;
+        if( tex != texture ) {
+            ret = flush( renderer );
+            int w = 0;
+            int h = 0;
+            if( SDL_QueryTexture( tex, nullptr, nullptr, &w, &h ) != 0 ) {
+                return -1;
+            }
+            texture = tex;
+            texture_width = static_cast<float>( w );
+            texture_height = static_cast<float>( h );
+        }
+        float u0 = srcrect.x / texture_width;
+        float u1 = ( srcrect.x + srcrect.w ) / texture_width;
+        float v0 = srcrect.y / texture_height;
+        float v1 = ( srcrect.y + srcrect.h ) / texture_height;
+        if( flip & SDL_FLIP_HORIZONTAL ) {
+            std::swap( u0, u1 );
+        }
+        if( flip & SDL_FLIP_VERTICAL ) {
+            std::swap( v0, v1 );
+        }
+        // Rotates clockwise around the center of dstrect, the same as SDL_RenderCopyEx
+        static constexpr int cosines[] = { 1, 0, -1, 0 };
+        static constexpr int sines[] = { 0, 1, 0, -1 };
+        const int quarter = ( ( angle / 90 ) % 4 + 4 ) % 4;
+        cata_assert( angle % 90 == 0 );
+        const float cos_a = cosines[quarter];
+        const float sin_a = sines[quarter];
+        const float cx = dstrect.x + dstrect.w / 2.0f;
+        const float cy = dstrect.y + dstrect.h / 2.0f;
+        const float hw = dstrect.w / 2.0f;
+        const float hh = dstrect.h / 2.0f;
+        const auto corner = [&]( const float x, const float y, const float u, const float v ) {
+            vertices.push_back( SDL_Vertex{
+                SDL_FPoint{ cx + x * cos_a - y * sin_a, cy + x * sin_a + y * cos_a },
+                SDL_Color{ 0xFF, 0xFF, 0xFF, 0xFF },
+                SDL_FPoint{ u, v } } );
+        };
+        const int first = static_cast<int>( vertices.size() );
+        corner( -hw, -hh, u0, v0 );
+        corner( hw, -hh, u1, v0 );
+        corner( hw, hh, u1, v1 );
+        corner( -hw, hh, u0, v1 );
+        indices.insert( indices.end(), {
+            first, first + 1, first + 2, first, first + 2, first + 3
+        } );
+        return ret;
+    }
+#endif
+    calls++;
+    return SDL_RenderCopyEx( renderer.get(), tex, &srcrect, &dstrect, angle, nullptr, flip );
+}
+
+int sprite_batch::flush( const SDL_Renderer_Ptr &renderer )
+{
+#if defined(CATA_SPRITE_BATCHING)
+    if( vertices.empty() ) {
+        return 0;
+    }
+    calls++;
+    const int ret = SDL_RenderGeometry( renderer.get(), texture, vertices.data(),
+                                        static_cast<int>( vertices.size() ), indices.data(),
+                                        static_cast<int>( indices.size() ) );
+    vertices.clear();
+    indices.clear();
+    // A texture that was destroyed meanwhile can come back at the same address
+    texture = nullptr;
+    return ret;
+#else
+    static_cast<void>( renderer );
+    return 0;
+#endif
+}
+
+void sprite_batch::set_enabled( const bool enable )
+{
+#if defined(CATA_SPRITE_BATCHING)
+    cata_assert( vertices.empty() );
+    enabled = enable;
+#else
+    static_cast<void>( enable );
+#endif
+}
+
+bool sprite_batch::is_enabled() const
+{
+#if defined(CATA_SPRITE_BATCHING)
+    return enabled;
+#else
+    return false;
+#endif
+}
+
+#endif // TILES
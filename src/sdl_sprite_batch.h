@@ -0,0 +1,67 @@
+#pragma once
+#ifndef CATA_SRC_SDL_SPRITE_BATCH_H
+#define CATA_SRC_SDL_SPRITE_BATCH_H
+
+#if defined(TILES)
+#include <vector>
+
+#include "sdl_wrappers.h"
+
+/// SDL_RenderGeometry exists since SDL 2.0.18, older versions draw each sprite on its own.
+#if SDL_VERSION_ATLEAST(2,0,18)
+#define CATA_SPRITE_BATCHING 1
+#endif
+
+/**
+ * Collects sprites that are drawn from the same texture and renders them with a single
+ * SDL_RenderGeometry call instead of one SDL_RenderCopyEx per sprite.
+ *
+ * The queued sprites are rendered when a sprite from another texture is added or when
+ * @ref flush is called.  Anything that is not drawn through the batch (rectangles, text,
+ * changes to the clip rectangle or render target) has to call @ref flush first, otherwise
+ * it ends up below the sprites queued before it.
+ */
+class sprite_batch
+{
+    public:
+        /**
+         * Like SDL_RenderCopyEx with the center of @p dstrect as center of rotation.
+         * Only multiples of 90 degrees are supported for @p angle.
+         * @returns 0 on success, a negative value if SDL failed to render.
+         */
+        int add( const SDL_Renderer_Ptr &renderer, SDL_Texture *tex, const SDL_Rect &srcrect,
+                 const SDL_Rect &dstrect, int angle, SDL_RendererFlip flip );
+        /** Renders the queued sprites, @returns like @ref add. */
+        int flush( const SDL_Renderer_Ptr &renderer );
+
+        /**
+         * When disabled, sprites are drawn right away with SDL_RenderCopyEx.  That is faster
+         * on the software renderer, which keeps every sprite on its own texture anyway.
+         */
+        void set_enabled( bool enable );
+        bool is_enabled() const;
+
+        /** Number of calls that went to the renderer since the last @ref reset_draw_calls. */
+        int draw_calls() const {
+            return calls;
+        }
+        void reset_draw_calls() {
+            calls = 0;
+        }
+
+    private:
+#if defined(CATA_SPRITE_BATCHING)
+        bool enabled = true;
+        SDL_Texture *texture = nullptr;
+        // Size of the texture, to map source rectangles to texture coordinates
+        float texture_width = 1.0f;
+        float texture_height = 1.0f;
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+#endif
+        int calls = 0;
+};
+
+#endif // TILES
+
+#endif // CATA_SRC_SDL_SPRITE_BATCH_H
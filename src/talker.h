@@ -3,6 +3,7 @@
 #define CATA_SRC_TALKER_H
 
 #include "coords_fwd.h"
+#include "dialogue_vars.h"
 #include "effect.h"
 #include "item.h"
 #include "messages.h"
@@ -336,6 +337,13 @@ class const_talker
         virtual std::optional<std::string> maybe_get_value( const std::string & ) const {
             return std::nullopt;
         }
+        /**
+         * The typed variables of the talker, or nullptr if it only provides them as strings
+         * through maybe_get_value.
+         */
+        virtual const var_store *get_vars() const {
+            return nullptr;
+        }
 
         // inventory, buying, and selling
         virtual bool is_wearing( const itype_id & ) const {
@@ -715,6 +723,10 @@ class talker: virtual public const_talker
         virtual void add_bionic( const bionic_id & ) {}
         virtual void remove_bionic( const bionic_id & ) {}
         virtual void set_value( const std::string &, const std::string & ) {}
+        /** Like set_value, but talkers with typed variables store @p value as it is. */
+        virtual void set_var( const var_key &key, const var_value &value ) {
+            set_value( key.str(), value.str() );
+        }
         virtual void remove_value( const std::string & ) {}
         virtual std::list<item> use_charges( const itype_id &, int ) {
             return {};
@@ -521,11 +521,21 @@ const
     return me_chr_const->maybe_get_value( var_name );
 }
 
+const var_store *talker_character_const::get_vars() const
+{
+    return &me_chr_const->get_values();
+}
+
 void talker_character::set_value( const std::string &var_name, const std::string &value )
 {
     me_chr->set_value( var_name, value );
 }
 
+void talker_character::set_var( const var_key &key, const var_value &value )
+{
+    me_chr->set_value( key, value );
+}
+
 void talker_character::remove_value( const std::string &var_name )
 {
     me_chr->remove_value( var_name );
@@ -124,6 +124,7 @@ class talker_character_const: virtual public const_talker
         bool is_deaf() const override;
         bool is_mute() const override;
         std::optional<std::string> maybe_get_value( const std::string &var_name ) const override;
+        const var_store *get_vars() const override;
 
         // stats, skills, traits, bionics, magic, and proficiencies
         std::vector<skill_id> skills_teacheable() const override;
@@ -282,6 +283,7 @@ class talker_character: virtual public talker
                        ) override;
         void remove_effect( const efftype_id &old_effect, const std::string &bp ) override;
         void set_value( const std::string &var_name, const std::string &value ) override;
+        void set_var( const var_key &key, const var_value &value ) override;
         void remove_value( const std::string &var_name ) override;
 
         // inventory, buying, and selling
@@ -105,6 +105,11 @@ const
     return me_mon_const->maybe_get_value( var_name );
 }
 
+const var_store *talker_monster_const::get_vars() const
+{
+    return &me_mon_const->get_values();
+}
+
 bool talker_monster_const::has_flag( const flag_id &f ) const
 {
     add_msg_debug( debugmode::DF_TALKER, "Monster %s checked for flag %s", me_mon_const->name(),
@@ -131,6 +136,11 @@ void talker_monster::set_value( const std::string &var_name, const std::string &
     me_mon->set_value( var_name, value );
 }
 
+void talker_monster::set_var( const var_key &key, const var_value &value )
+{
+    me_mon->set_value( key, value );
+}
+
 void talker_monster::remove_value( const std::string &var_name )
 {
     me_mon->remove_value( var_name );
@@ -62,6 +62,7 @@ class talker_monster_const: public const_talker_cloner<talker_monster_const>
         effect get_effect( const efftype_id &effect_id, const bodypart_id &bp ) const override;
 
         std::optional<std::string> maybe_get_value( const std::string &var_name ) const override;
+        const var_store *get_vars() const override;
 
         bool has_flag( const flag_id &f ) const override;
         bool has_species( const species_id &species ) const override;
@@ -116,6 +117,7 @@ class talker_monster: public talker_monster_const, public talker_cloner<talker_m
         void mod_pain( int amount ) override;
 
         void set_value( const std::string &var_name, const std::string &value ) override;
+        void set_var( const var_key &key, const var_value &value ) override;
         void remove_value( const std::string &var_name ) override;
 
         void set_anger( int ) override;
@@ -45,6 +45,8 @@ class temp_crafting_inventory : public read_only_visitable
         // inherited from visitable
         VisitResponse visit_items( const std::function<VisitResponse( item *, item * )> &func ) const
         override;
+        template<typename F>
+        VisitResponse visit_items_inline( F &&func ) const;
 
     private:
         // list of all items in this container
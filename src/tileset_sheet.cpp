@@ -0,0 +1,449 @@
+#if defined(TILES)
+#include "tileset_sheet.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+#include <utility>
+
+#include "cata_assert.h"
+#include "cata_utility.h"
+#include "filesystem.h"
+#include "mmap_file.h"
+#include "point.h"
+#include "rect_range.h"
+#include "sdl_utils.h"
+#include "string_formatter.h"
+
+#include <ghc/fs_std.hpp>
+
+static_assert( tileset_sheet::color_variants == std::tuple_size_v<decltype(
+                   tileset_sheet_params::color_filters )> );
+
+template<typename PixelConverter>
+static SDL_Surface_Ptr apply_color_filter( const SDL_Surface_Ptr &original,
+        PixelConverter pixel_converter )
+{
+    cata_assert( original );
+    SDL_Surface_Ptr surf = create_surface_32( original->w, original->h );
+    cata_assert( surf );
+    throwErrorIf( SDL_BlitSurface( original.get(), nullptr, surf.get(), nullptr ) != 0,
+                  "SDL_BlitSurface failed" );
+
+    SDL_Color *pix = static_cast<SDL_Color *>( surf->pixels );
+
+    for( int y = 0, ey = surf->h; y < ey; ++y ) {
+        for( int x = 0, ex = surf->w; x < ex; ++x, ++pix ) {
+            if( pix->a == 0x00 ) {
+                // This check significantly improves the performance since
+                // vast majority of pixels in the tilesets are completely transparent.
+                continue;
+            }
+            *pix = pixel_converter( *pix );
+        }
+    }
+
+    return surf;
+}
+
+// Copies the pixels as they are, blending would darken the translucent ones on the empty target
+static void blit_unblended( const SDL_Surface_Ptr &src, const SDL_Surface_Ptr &dst,
+                            SDL_Rect dstrect )
+{
+    SDL_BlendMode blend_mode = SDL_BLENDMODE_NONE;
+    throwErrorIf( SDL_GetSurfaceBlendMode( src.get(), &blend_mode ) != 0,
+                  "SDL_GetSurfaceBlendMode failed" );
+    throwErrorIf( SDL_SetSurfaceBlendMode( src.get(), SDL_BLENDMODE_NONE ) != 0,
+                  "SDL_SetSurfaceBlendMode failed" );
+    throwErrorIf( SDL_BlitSurface( src.get(), nullptr, dst.get(), &dstrect ) != 0,
+                  "SDL_BlitSurface failed" );
+    throwErrorIf( SDL_SetSurfaceBlendMode( src.get(), blend_mode ) != 0,
+                  "SDL_SetSurfaceBlendMode failed" );
+}
+
+static bool is_contained( const SDL_Rect &smaller, const SDL_Rect &larger )
+{
+    return smaller.x >= larger.x &&
+           smaller.y >= larger.y &&
+           smaller.x + smaller.w <= larger.x + larger.w &&
+           smaller.y + smaller.h <= larger.y + larger.h;
+}
+
+tileset_sheet tileset_sheet::prepare( const tileset_sheet_params &params )
+{
+    const int sprite_width = params.sprite_width;
+    const int sprite_height = params.sprite_height;
+    cata_assert( sprite_width > 0 );
+    cata_assert( sprite_height > 0 );
+    const std::string image_path = params.image_path.get_unrelative_path().u8string();
+    const SDL_Surface_Ptr tile_atlas = load_image( image_path.c_str() );
+    cata_assert( tile_atlas );
+
+    if( params.color_key ) {
+        const Uint32 key = SDL_MapRGB( tile_atlas->format, 0, 0, 0 );
+        throwErrorIf( SDL_SetColorKey( tile_atlas.get(), SDL_TRUE, key ) != 0,
+                      "SDL_SetColorKey failed" );
+        throwErrorIf( SDL_SetSurfaceRLE( tile_atlas.get(), 1 ), "SDL_SetSurfaceRLE failed" );
+    }
+
+    tileset_sheet sheet;
+    sheet.width = tile_atlas->w;
+    sheet.height = tile_atlas->h;
+
+    int max_tile_ycount = params.max_tile_ycount;
+    // The color variants of each part share a texture when they fit on it together,
+    // which makes the parts smaller. That is never the case with software rendering.
+    sheet.packed = max_tile_ycount >= color_variants;
+    if( sheet.packed ) {
+        max_tile_ycount /= color_variants;
+    }
+    // Range over the tile atlas, wherein each rectangle fits into the maximal
+    // SDL texture size. In other words: a range over the parts into which the
+    // tile atlas needs to be split.
+    const rect_range<SDL_Rect> output_range(
+        params.max_tile_xcount * sprite_width,
+        max_tile_ycount * sprite_height,
+        point( divide_round_up( tile_atlas->w, params.max_tile_xcount * sprite_width ),
+               divide_round_up( tile_atlas->h, max_tile_ycount * sprite_height ) ) );
+
+    std::array<color_pixel_function_pointer, color_variants> filters;
+    for( size_t i = 0; i < filters.size(); ++i ) {
+        filters[i] = get_color_pixel_function( params.color_filters[i] );
+    }
+
+    for( const SDL_Rect sub_rect : output_range ) {
+        cata_assert( sub_rect.x % sprite_width == 0 );
+        cata_assert( sub_rect.y % sprite_height == 0 );
+        cata_assert( sub_rect.w % sprite_width == 0 );
+        cata_assert( sub_rect.h % sprite_height == 0 );
+        SDL_Surface_Ptr smaller_surf;
+
+        if( is_contained( SDL_Rect{ 0, 0, tile_atlas->w, tile_atlas->h }, sub_rect ) ) {
+            // can use tile_atlas directly, it is completely contained in the output rectangle
+        } else {
+            // Need a temporary surface that contains the parts of the tile atlas that fit
+            // into sub_rect. But doesn't always need to be as large as sub_rect.
+            const int w = std::min( tile_atlas->w - sub_rect.x, sub_rect.w );
+            const int h = std::min( tile_atlas->h - sub_rect.y, sub_rect.h );
+            smaller_surf = ::create_surface_32( w, h );
+            cata_assert( smaller_surf );
+            const SDL_Rect inp{ sub_rect.x, sub_rect.y, w, h };
+            throwErrorIf( SDL_BlitSurface( tile_atlas.get(), &inp, smaller_surf.get(),
+                                           nullptr ) != 0, "SDL_BlitSurface failed" );
+        }
+        const SDL_Surface_Ptr &surf_to_use = smaller_surf ? smaller_surf : tile_atlas;
+        cata_assert( surf_to_use );
+
+        part p;
+        p.offset = point( sub_rect.x, sub_rect.y );
+        if( sheet.packed ) {
+            p.surfaces.push_back( create_surface_32( surf_to_use->w,
+                                  surf_to_use->h * color_variants ) );
+        }
+        for( size_t i = 0; i < filters.size(); ++i ) {
+            const SDL_Rect area{ 0, static_cast<int>( i ) * surf_to_use->h,
+                                 surf_to_use->w, surf_to_use->h };
+            if( filters[i] ) {
+                SDL_Surface_Ptr filtered = apply_color_filter( surf_to_use, filters[i] );
+                if( sheet.packed ) {
+                    blit_unblended( filtered, p.surfaces.front(), area );
+                } else {
+                    p.surfaces.push_back( std::move( filtered ) );
+                }
+            } else if( sheet.packed ) {
+                blit_unblended( surf_to_use, p.surfaces.front(), area );
+            } else {
+                p.surfaces.push_back( create_surface_32( surf_to_use->w, surf_to_use->h ) );
+                blit_unblended( surf_to_use, p.surfaces.back(), SDL_Rect{ 0, 0, 0, 0 } );
+            }
+        }
+        sheet.parts.push_back( std::move( p ) );
+    }
+    return sheet;
+}
+
+// FNV-1a, the cache only needs to tell different inputs apart
+static uint64_t hash_bytes( uint64_t hash, const uint8_t *data, const size_t len )
+{
+    for( size_t i = 0; i < len; ++i ) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Identifies the prepared sheet by the content of the image and all the parameters
+static std::optional<uint64_t> sheet_hash( const tileset_sheet_params &params )
+{
+    const std::shared_ptr<mmap_file> image = mmap_file::map_file(
+                params.image_path.get_unrelative_path() );
+    if( !image ) {
+        return std::nullopt;
+    }
+    std::string settings = string_format( "%d %d %d %d %d %s", params.sprite_width,
+                                          params.sprite_height, params.color_key ? 1 : 0,
+                                          params.max_tile_xcount, params.max_tile_ycount,
+                                          params.filter_settings );
+    for( const std::string &filter : params.color_filters ) {
+        settings += " " + filter;
+    }
+    uint64_t hash = 14695981039346656037ULL;
+    hash = hash_bytes( hash, image->base, image->len );
+    return hash_bytes( hash, reinterpret_cast<const uint8_t *>( settings.data() ),
+                       settings.size() );
+}
+
+// Cached sheets are at <cache dir>/<tileset dir>/<image name>.<hash>.sheet
+static fs::path cached_sheet_path( const tileset_sheet_params &params, const uint64_t hash )
+{
+    const fs::path image = params.image_path.get_unrelative_path();
+    std::array<char, 17> hex;
+    std::snprintf( hex.data(), hex.size(), "%016llx", static_cast<unsigned long long>( hash ) );
+    return params.cache_dir / image.parent_path().filename() /
+           fs::u8path( image.stem().u8string() + "." + hex.data() + ".sheet" );
+}
+
+tileset_sheet tileset_sheet::load( const tileset_sheet_params &params )
+{
+    if( params.cache_dir.empty() ) {
+        return prepare( params );
+    }
+    const std::optional<uint64_t> hash = sheet_hash( params );
+    if( !hash ) {
+        return prepare( params );
+    }
+    const fs::path path = cached_sheet_path( params, *hash );
+    if( std::optional<tileset_sheet> cached = load_cached( path ) ) {
+        return std::move( *cached );
+    }
+    tileset_sheet sheet = prepare( params );
+    if( sheet.save_cached( path ) ) {
+        // Sheets of older versions of the image are of no use anymore
+        const fs::path image_stem = params.image_path.get_unrelative_path().stem();
+        std::error_code ec;
+        for( const fs::directory_entry &entry : fs::directory_iterator( path.parent_path(), ec ) ) {
+            const fs::path &other = entry.path();
+            if( other != path && other.extension() == ".sheet" &&
+                other.stem().stem() == image_stem ) {
+                remove_file( other );
+            }
+        }
+    }
+    return sheet;
+}
+
+namespace
+{
+
+// Layout of the cached sheets, the pixels of every surface follow the header
+constexpr char sheet_magic[8] = { 'C', 'D', 'D', 'A', 'S', 'H', 'T', '1' };
+
+struct sheet_header {
+    char magic[8];
+    uint32_t width;
+    uint32_t height;
+    uint32_t packed;
+    uint32_t parts;
+};
+
+struct part_header {
+    int32_t x;
+    int32_t y;
+    uint32_t surfaces;
+};
+
+struct surface_header {
+    uint32_t w;
+    uint32_t h;
+};
+
+template<typename T>
+bool read( const uint8_t *&pos, const uint8_t *const end, T &value )
+{
+    if( static_cast<size_t>( end - pos ) < sizeof( T ) ) {
+        return false;
+    }
+    std::memcpy( &value, pos, sizeof( T ) );
+    pos += sizeof( T );
+    return true;
+}
+
+template<typename T>
+void write( std::ofstream &fout, const T &value )
+{
+    fout.write( reinterpret_cast<const char *>( &value ), sizeof( T ) );
+}
+
+} // namespace
+
+std::optional<tileset_sheet> tileset_sheet::load_cached( const fs::path &path )
+{
+    std::error_code ec;
+    if( !fs::exists( path, ec ) ) {
+        return std::nullopt;
+    }
+    std::shared_ptr<mmap_file> mapping = mmap_file::map_file( path );
+    if( !mapping ) {
+        return std::nullopt;
+    }
+    const uint8_t *pos = mapping->base;
+    const uint8_t *const end = mapping->base + mapping->len;
+    sheet_header header;
+    if( !read( pos, end, header ) ||
+        std::memcmp( header.magic, sheet_magic, sizeof( sheet_magic ) ) != 0 ) {
+        return std::nullopt;
+    }
+    if( header.parts > mapping->len / sizeof( part_header ) ) {
+        return std::nullopt;
+    }
+    tileset_sheet sheet;
+    sheet.width = static_cast<int>( header.width );
+    sheet.height = static_cast<int>( header.height );
+    sheet.packed = header.packed != 0;
+    std::vector<std::vector<surface_header>> sizes( header.parts );
+    for( std::vector<surface_header> &part_sizes : sizes ) {
+        part_header ph;
+        if( !read( pos, end, ph ) || ph.surfaces > color_variants ) {
+            return std::nullopt;
+        }
+        sheet.parts.push_back( part{ point( ph.x, ph.y ), {} } );
+        part_sizes.resize( ph.surfaces );
+        for( surface_header &sh : part_sizes ) {
+            if( !read( pos, end, sh ) ) {
+                return std::nullopt;
+            }
+        }
+    }
+    for( size_t i = 0; i < sizes.size(); ++i ) {
+        for( const surface_header &sh : sizes[i] ) {
+            const size_t bytes = static_cast<size_t>( sh.w ) * sh.h * 4;
+            if( static_cast<size_t>( end - pos ) < bytes ) {
+                return std::nullopt;
+            }
+            // The pixels stay in the mapped file, SDL only reads them. The format is the one of
+            // create_surface_32.
+            SDL_Surface_Ptr surf( SDL_CreateRGBSurfaceWithFormatFrom(
+                                      const_cast<uint8_t *>( pos ), static_cast<int>( sh.w ),
+                                      static_cast<int>( sh.h ), 32, static_cast<int>( sh.w * 4 ),
+                                      SDL_PIXELFORMAT_RGBA32 ) );
+            if( !surf ) {
+                return std::nullopt;
+            }
+            sheet.parts[i].surfaces.push_back( std::move( surf ) );
+            pos += bytes;
+        }
+    }
+    sheet.mapping = std::move( mapping );
+    return sheet;
+}
+
+bool tileset_sheet::save_cached( const fs::path &path ) const
+{
+    if( !assure_dir_exist( path.parent_path() ) ) {
+        return false;
+    }
+    // Written under another name first, so nobody maps a half written sheet
+    const fs::path temp = fs::path( path ).concat( ".temp" );
+    {
+        std::ofstream fout( temp, std::ofstream::binary );
+        if( !fout.good() ) {
+            return false;
+        }
+        sheet_header header;
+        std::memcpy( header.magic, sheet_magic, sizeof( sheet_magic ) );
+        header.width = static_cast<uint32_t>( width );
+        header.height = static_cast<uint32_t>( height );
+        header.packed = packed ? 1 : 0;
+        header.parts = static_cast<uint32_t>( parts.size() );
+        write( fout, header );
+        for( const part &p : parts ) {
+            write( fout, part_header{ p.offset.x, p.offset.y,
+                                      static_cast<uint32_t>( p.surfaces.size() ) } );
+            for( const SDL_Surface_Ptr &surf : p.surfaces ) {
+                write( fout, surface_header{ static_cast<uint32_t>( surf->w ),
+                                             static_cast<uint32_t>( surf->h ) } );
+            }
+        }
+        for( const part &p : parts ) {
+            for( const SDL_Surface_Ptr &surf : p.surfaces ) {
+                const char *row = static_cast<const char *>( surf->pixels );
+                for( int y = 0; y < surf->h; ++y, row += surf->pitch ) {
+                    fout.write( row, static_cast<std::streamsize>( surf->w ) * 4 );
+                }
+            }
+        }
+        if( !fout.good() ) {
+            fout.close();
+            remove_file( temp );
+            return false;
+        }
+    }
+    return rename_file( temp, path );
+}
+
+tileset_sheet_queue::tileset_sheet_queue( std::vector<tileset_sheet_params> params )
+{
+    for( tileset_sheet_params &p : params ) {
+        slots.push_back( std::make_unique<slot>() );
+        slots.back()->params = std::move( p );
+    }
+    const size_t threads = std::max( 1U, std::thread::hardware_concurrency() );
+    ahead = threads;
+    for( size_t i = 0; i < std::min( threads, slots.size() ); ++i ) {
+        workers.emplace_back( &tileset_sheet_queue::work, this );
+    }
+}
+
+tileset_sheet_queue::~tileset_sheet_queue()
+{
+    stopping = true;
+    for( std::thread &worker : workers ) {
+        worker.join();
+    }
+}
+
+void tileset_sheet_queue::work()
+{
+    for( size_t index = next++; index < slots.size(); index = next++ ) {
+        // Don't get too far ahead, every prepared sheet is several times the size of the image
+        while( index >= taken + ahead ) {
+            if( stopping ) {
+                return;
+            }
+            std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+        }
+        if( stopping ) {
+            return;
+        }
+        slot &s = *slots[index];
+        try {
+            s.sheet = tileset_sheet::load( s.params );
+        } catch( ... ) {
+            s.error = std::current_exception();
+        }
+        s.ready.store( true, std::memory_order_release );
+    }
+}
+
+tileset_sheet tileset_sheet_queue::take( const size_t index, const std::function<void()> &idle )
+{
+    cata_assert( index == taken );
+    slot &s = *slots[index];
+    while( !s.ready.load( std::memory_order_acquire ) ) {
+        idle();
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    }
+    taken = index + 1;
+    if( s.error ) {
+        std::rethrow_exception( s.error );
+    }
+    tileset_sheet sheet = std::move( *s.sheet );
+    s.sheet.reset();
+    return sheet;
+}
+
+#endif // TILES
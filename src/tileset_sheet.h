@@ -0,0 +1,128 @@
+#pragma once
+#ifndef CATA_SRC_TILESET_SHEET_H
+#define CATA_SRC_TILESET_SHEET_H
+
+#if defined(TILES)
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
+#include "cata_path.h"
+#include "point.h"
+#include "sdl_wrappers.h"
+
+#include <ghc/fs_std_fwd.hpp>
+
+class mmap_file;
+
+/** How to turn one image of a tileset into the surfaces of its textures. */
+struct tileset_sheet_params {
+    cata_path image_path;
+    int sprite_width = 0;
+    int sprite_height = 0;
+    // Black is transparent, set by the "transparency" of the tileset image
+    bool color_key = false;
+    // Sprites in each direction that fit on a texture
+    int max_tile_xcount = 0;
+    int max_tile_ycount = 0;
+    /** Names of the color_pixel_* functions of the variants, @ref get_color_pixel_function. */
+    std::array<std::string, 5> color_filters;
+    /** Anything else the color filters depend on, like the colors of the custom memory filter. */
+    std::string filter_settings;
+    /** Where to keep the prepared sheets between launches, not kept if empty. */
+    fs::path cache_dir;
+};
+
+/**
+ * A tileset image split into the parts that fit on a texture, with the color variants of
+ * every part.  Preparing it decodes the image and runs the color filters over every pixel,
+ * which is most of the time it takes to load a tileset, but needs no renderer and so can
+ * happen on any thread.
+ */
+class tileset_sheet
+{
+    public:
+        static constexpr int color_variants = 5;
+
+        struct part {
+            // Position in the image
+            point offset;
+            /**
+             * Either a single surface with the variants one below the other, or one surface
+             * per variant, in the order of @ref tileset_sheet_params::color_filters.
+             */
+            std::vector<SDL_Surface_Ptr> surfaces;
+        };
+
+        int width = 0;
+        int height = 0;
+        bool packed = false;
+        std::vector<part> parts;
+
+        /**
+         * Prepares the image, or loads it from the cache when it was prepared with the same
+         * parameters before.
+         * @throws std::exception if the image can't be loaded.
+         */
+        static tileset_sheet load( const tileset_sheet_params &params );
+        /** Prepares the image without looking at the cache. */
+        static tileset_sheet prepare( const tileset_sheet_params &params );
+
+    private:
+        // The pixels of sheets loaded from the cache
+        std::shared_ptr<mmap_file> mapping;
+
+        static std::optional<tileset_sheet> load_cached( const fs::path &path );
+        bool save_cached( const fs::path &path ) const;
+};
+
+/**
+ * Loads the sheets on worker threads, keeping only a few more of them in memory than the
+ * main thread has taken so far.
+ */
+class tileset_sheet_queue
+{
+    public:
+        explicit tileset_sheet_queue( std::vector<tileset_sheet_params> params );
+        ~tileset_sheet_queue();
+
+        tileset_sheet_queue( const tileset_sheet_queue & ) = delete;
+        tileset_sheet_queue &operator=( const tileset_sheet_queue & ) = delete;
+
+        /**
+         * Waits for the sheet of the params at @p index, sheets have to be taken in order.
+         * @param idle Called now and then while waiting.
+         * @throws the exception thrown while loading the sheet.
+         */
+        tileset_sheet take( size_t index, const std::function<void()> &idle );
+
+    private:
+        struct slot {
+            tileset_sheet_params params;
+            std::optional<tileset_sheet> sheet;
+            std::exception_ptr error;
+            std::atomic<bool> ready{ false };
+        };
+        std::vector<std::unique_ptr<slot>> slots;
+        std::atomic<size_t> next{ 0 };
+        std::atomic<size_t> taken{ 0 };
+        std::atomic<bool> stopping{ false };
+        size_t ahead = 1;
+        std::vector<std::thread> workers;
+
+        void work();
+};
+
+#endif // TILES
+
+#endif // CATA_SRC_TILESET_SHEET_H
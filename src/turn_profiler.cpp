@@ -0,0 +1,240 @@
+#include "turn_profiler.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <unordered_map>
+
+#include "json.h"
+#include "string_formatter.h"
+
+namespace turn_profiler
+{
+
+namespace detail
+{
+bool enabled = false;
+bool in_turn = false;
+int depth = 0;
+} // namespace detail
+
+namespace
+{
+
+struct profiler_state {
+    std::vector<std::string> zone_names;
+    std::unordered_map<std::string, int> zone_ids;
+    turn_record current;
+    // Ring buffer of finished turns, next_record is the oldest once it is full
+    std::vector<turn_record> records;
+    size_t next_record = 0;
+};
+
+profiler_state &get_state()
+{
+    static profiler_state state;
+    return state;
+}
+
+double to_milliseconds( std::chrono::nanoseconds d )
+{
+    return std::chrono::duration<double, std::milli>( d ).count();
+}
+
+double to_microseconds( std::chrono::nanoseconds d )
+{
+    return std::chrono::duration<double, std::micro>( d ).count();
+}
+
+} // namespace
+
+void detail::leave( int zone, clock::time_point start )
+{
+    if( !in_turn ) {
+        // the profiler was disabled or cleared while this zone was open
+        return;
+    }
+    const clock::time_point now = clock::now();
+    --depth;
+    turn_record &current = get_state().current;
+    current.events.push_back( { zone, depth, start - current.start, now - start } );
+}
+
+void set_enabled( bool enabled )
+{
+    clear();
+    detail::enabled = enabled;
+}
+
+void clear()
+{
+    profiler_state &state = get_state();
+    state.current = turn_record();
+    state.records.clear();
+    state.next_record = 0;
+    detail::in_turn = false;
+    detail::depth = 0;
+}
+
+int register_zone( const std::string &name )
+{
+    profiler_state &state = get_state();
+    const auto iter = state.zone_ids.find( name );
+    if( iter != state.zone_ids.end() ) {
+        return iter->second;
+    }
+    const int id = static_cast<int>( state.zone_names.size() );
+    state.zone_names.push_back( name );
+    state.zone_ids.emplace( name, id );
+    return id;
+}
+
+const std::string &zone_name( int zone )
+{
+    return get_state().zone_names[zone];
+}
+
+void begin_turn( int turn )
+{
+    if( !detail::enabled ) {
+        return;
+    }
+    turn_record &current = get_state().current;
+    current.turn = turn;
+    current.events.clear();
+    detail::in_turn = true;
+    detail::depth = 0;
+    current.start = clock::now();
+}
+
+void end_turn()
+{
+    if( !detail::in_turn ) {
+        return;
+    }
+    detail::in_turn = false;
+    profiler_state &state = get_state();
+    state.current.duration = clock::now() - state.current.start;
+    if( state.records.size() < history_size ) {
+        state.records.push_back( std::move( state.current ) );
+    } else {
+        state.records[state.next_record] = std::move( state.current );
+        state.next_record = ( state.next_record + 1 ) % history_size;
+    }
+    state.current = turn_record();
+}
+
+std::vector<const turn_record *> history()
+{
+    const profiler_state &state = get_state();
+    std::vector<const turn_record *> res;
+    res.reserve( state.records.size() );
+    for( size_t i = 0; i < state.records.size(); ++i ) {
+        res.push_back( &state.records[( state.next_record + i ) % state.records.size()] );
+    }
+    return res;
+}
+
+std::vector<zone_summary> summarize()
+{
+    const std::vector<const turn_record *> turns = history();
+    // indexed by zone id, so zones are listed in the order their call sites were first reached
+    std::map<int, zone_summary> summaries;
+    std::map<int, std::chrono::nanoseconds> totals;
+    std::map<int, int> calls;
+    for( const turn_record *record : turns ) {
+        std::map<int, std::chrono::nanoseconds> turn_times;
+        for( const zone_event &e : record->events ) {
+            turn_times[e.zone] += e.duration;
+            ++calls[e.zone];
+            summaries.emplace( e.zone, zone_summary{ e.zone, e.depth } );
+        }
+        for( std::pair<const int, zone_summary> &summary : summaries ) {
+            const std::chrono::nanoseconds time = turn_times[summary.first];
+            summary.second.last = time;
+            summary.second.max = std::max( summary.second.max, time );
+            totals[summary.first] += time;
+        }
+    }
+
+    std::vector<zone_summary> res;
+    for( std::pair<const int, zone_summary> &summary : summaries ) {
+        summary.second.average = totals[summary.first] / turns.size();
+        summary.second.calls_per_turn = static_cast<double>( calls[summary.first] ) / turns.size();
+        res.push_back( summary.second );
+    }
+    return res;
+}
+
+std::string summary_table()
+{
+    const std::vector<const turn_record *> turns = history();
+    if( turns.empty() ) {
+        return "No turns recorded.";
+    }
+    std::chrono::nanoseconds turn_total{ 0 };
+    std::chrono::nanoseconds turn_max{ 0 };
+    for( const turn_record *record : turns ) {
+        turn_total += record->duration;
+        turn_max = std::max( turn_max, record->duration );
+    }
+
+    const std::string header = string_format( "zone (last %d turns)", turns.size() );
+    std::string res = string_format( "%-36s %9s %9s %9s %7s\n", header, "last ms", "avg ms",
+                                     "max ms", "calls" );
+    res += string_format( "%-36s %9.3f %9.3f %9.3f %7.1f\n", "turn",
+                          to_milliseconds( turns.back()->duration ),
+                          to_milliseconds( turn_total / turns.size() ),
+                          to_milliseconds( turn_max ), 1.0 );
+    for( const zone_summary &summary : summarize() ) {
+        const std::string name = std::string( 2 * ( summary.depth + 1 ), ' ' ) +
+                                 zone_name( summary.zone );
+        res += string_format( "%-36s %9.3f %9.3f %9.3f %7.1f\n", name,
+                              to_milliseconds( summary.last ), to_milliseconds( summary.average ),
+                              to_milliseconds( summary.max ), summary.calls_per_turn );
+    }
+    return res;
+}
+
+void write_chrome_trace( std::ostream &out )
+{
+    const std::vector<const turn_record *> turns = history();
+    // timestamps are in microseconds, keep nanosecond precision
+    out << std::fixed << std::setprecision( 3 );
+    JsonOut jsout( out );
+    jsout.start_object();
+    jsout.member( "displayTimeUnit", "ms" );
+    jsout.member( "traceEvents" );
+    jsout.start_array();
+    if( !turns.empty() ) {
+        const clock::time_point epoch = turns.front()->start;
+        const auto write_event = [&]( const std::string & name, std::chrono::nanoseconds start,
+        std::chrono::nanoseconds duration, int turn ) {
+            jsout.start_object();
+            jsout.member( "name", name );
+            jsout.member( "cat", "turn" );
+            jsout.member( "ph", "X" );
+            jsout.member( "ts", to_microseconds( start ) );
+            jsout.member( "dur", to_microseconds( duration ) );
+            jsout.member( "pid", 1 );
+            jsout.member( "tid", 1 );
+            jsout.member( "args" );
+            jsout.start_object();
+            jsout.member( "turn", turn );
+            jsout.end_object();
+            jsout.end_object();
+        };
+        for( const turn_record *record : turns ) {
+            const std::chrono::nanoseconds turn_start = record->start - epoch;
+            write_event( "turn", turn_start, record->duration, record->turn );
+            for( const zone_event &e : record->events ) {
+                write_event( zone_name( e.zone ), turn_start + e.start, e.duration, record->turn );
+            }
+        }
+    }
+    jsout.end_array();
+    jsout.end_object();
+}
+
+} // namespace turn_profiler
@@ -0,0 +1,148 @@
+#pragma once
+#ifndef CATA_SRC_TURN_PROFILER_H
+#define CATA_SRC_TURN_PROFILER_H
+
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/**
+ * Lightweight instrumentation of the turn loop.
+ *
+ * A subsystem is marked with PROFILE_ZONE( "name" ), which times the rest of the enclosing scope.
+ * Zones may nest. While the profiler is enabled, every zone entered between begin_turn() and
+ * end_turn() is recorded, and the last @ref history_size turns are kept in a ring buffer. The debug
+ * menu shows a rolling table of those turns and can export them in Chrome's trace_event format
+ * (open the file in chrome://tracing or https://ui.perfetto.dev).
+ *
+ * A zone costs a single branch while the profiler is disabled at runtime, and PROFILE_ZONE expands
+ * to nothing unless the build defines TURN_PROFILER.
+ */
+namespace turn_profiler
+{
+
+using clock = std::chrono::steady_clock;
+
+/** Number of finished turns kept for the rolling table and the trace export. */
+constexpr size_t history_size = 256;
+
+/** One entry into a zone. */
+struct zone_event {
+    int zone;
+    // Number of enclosing zones
+    int depth;
+    // Relative to the start of the turn
+    std::chrono::nanoseconds start;
+    std::chrono::nanoseconds duration;
+};
+
+struct turn_record {
+    // calendar::turn, in turns since the start of the calendar
+    int turn = 0;
+    clock::time_point start;
+    std::chrono::nanoseconds duration{ 0 };
+    std::vector<zone_event> events;
+};
+
+/** Statistics of a zone over the turns in the history. */
+struct zone_summary {
+    int zone;
+    // Depth of the first recorded entry, used to indent the table
+    int depth;
+    std::chrono::nanoseconds last{ 0 };
+    std::chrono::nanoseconds average{ 0 };
+    std::chrono::nanoseconds max{ 0 };
+    double calls_per_turn = 0.0;
+};
+
+namespace detail
+{
+extern bool enabled;
+extern bool in_turn;
+extern int depth;
+void leave( int zone, clock::time_point start );
+} // namespace detail
+
+inline bool is_enabled()
+{
+    return detail::enabled;
+}
+/** Enabling or disabling the profiler drops the recorded history. */
+void set_enabled( bool enabled );
+void clear();
+
+/** Returns the id of the zone called @p name, adding it if it is new. */
+int register_zone( const std::string &name );
+const std::string &zone_name( int zone );
+
+void begin_turn( int turn );
+void end_turn();
+
+/** Finished turns, oldest first. */
+std::vector<const turn_record *> history();
+/** One entry per zone recorded in the history, in the order they were first entered. */
+std::vector<zone_summary> summarize();
+/** Text table of @ref summarize for the debug menu. */
+std::string summary_table();
+void write_chrome_trace( std::ostream &out );
+
+class scoped_zone
+{
+    public:
+        explicit scoped_zone( int zone ) :
+            zone( zone ), active( detail::enabled && detail::in_turn ) {
+            if( active ) {
+                ++detail::depth;
+                start = clock::now();
+            }
+        }
+        ~scoped_zone() {
+            if( active ) {
+                detail::leave( zone, start );
+            }
+        }
+        scoped_zone( const scoped_zone & ) = delete;
+        scoped_zone &operator=( const scoped_zone & ) = delete;
+
+    private:
+        int zone;
+        bool active;
+        clock::time_point start;
+};
+
+/** Calls begin_turn() and end_turn(), so early returns still close the turn. */
+class scoped_turn
+{
+    public:
+        explicit scoped_turn( int turn ) {
+            begin_turn( turn );
+        }
+        ~scoped_turn() {
+            end_turn();
+        }
+        scoped_turn( const scoped_turn & ) = delete;
+        scoped_turn &operator=( const scoped_turn & ) = delete;
+};
+
+} // namespace turn_profiler
+
+#define CATA_PROFILE_CONCAT_IMPL( a, b ) a##b
+#define CATA_PROFILE_CONCAT( a, b ) CATA_PROFILE_CONCAT_IMPL( a, b )
+
+#if defined(TURN_PROFILER)
+// The zone id is looked up once per call site
+#define PROFILE_ZONE( name ) \
+    static const int CATA_PROFILE_CONCAT( profile_zone_id_, __LINE__ ) = \
+            turn_profiler::register_zone( name ); \
+    const turn_profiler::scoped_zone CATA_PROFILE_CONCAT( profile_zone_, __LINE__ )( \
+            CATA_PROFILE_CONCAT( profile_zone_id_, __LINE__ ) )
+#define PROFILE_TURN( turn ) \
+    const turn_profiler::scoped_turn CATA_PROFILE_CONCAT( profile_turn_, __LINE__ )( turn )
+#else
+#define PROFILE_ZONE( name ) static_cast<void>( 0 )
+#define PROFILE_TURN( turn ) static_cast<void>( 0 )
+#endif
+
+#endif // CATA_SRC_TURN_PROFILER_H
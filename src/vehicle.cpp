@@ -234,7 +234,10 @@ vehicle::vehicle( const vproto_id &proto_id )
     }
 }
 
-vehicle::~vehicle() = default;
+vehicle::~vehicle()
+{
+    invalidate_power_grids();
+}
 
 turret_cpu::~turret_cpu() = default;
 
@@ -1561,6 +1564,7 @@ int vehicle::install_part( const point &dp, vehicle_part &&vp )
 
 int vehicle::install_part( const point_rel_ms &dp, vehicle_part &&vp )
 {
+    get_map().bump_items_revision();
     const vpart_info &vpi = vp.info();
     const ret_val<void> valid_mount = can_mount( dp, vpi );
     if( !valid_mount.success() ) {
@@ -2093,6 +2097,7 @@ bool vehicle::remove_part( vehicle_part &vp, RemovePartHandler &handler )
          */
         return false;
     }
+    invalidate_power_grids();
 
     const tripoint_bub_ms part_loc = bub_part_pos( vp );
 
@@ -2215,6 +2220,7 @@ bool vehicle::do_remove_part_actual()
 {
     bool changed = false;
     map &here = get_map();
+    here.bump_items_revision();
     for( std::vector<vehicle_part>::iterator it = parts.end(); it != parts.begin(); /*noop*/ ) {
         --it;
         vehicle_part &vp = *it;
@@ -3516,6 +3522,9 @@ void vehicle::precalc_mounts( int idir, const units::angle &dir,
     if( idir < 0 || idir > 1 ) {
         idir = 0;
     }
+    if( idir == 0 ) {
+        invalidate_power_grids();
+    }
     tileray tdir( dir );
     std::unordered_map<point_rel_ms, tripoint_rel_ms> mount_to_precalc;
     for( vehicle_part &p : parts ) {
@@ -3709,7 +3718,7 @@ int64_t vehicle::fuel_left( const itype_id &ftype,
 {
     int64_t fl = 0;
     if( ftype == fuel_type_battery ) {
-        for( const std::pair<const vehicle *const, float> &pair : search_connected_vehicles() ) {
+        for( const std::pair<vehicle *const, float> &pair : connected_power_grid().vehicles ) {
             const vehicle &veh = *pair.first;
             const float loss = pair.second;
             for( const int part_idx : veh.batteries ) {
@@ -3776,7 +3785,7 @@ int vehicle::fuel_capacity( const itype_id &ftype ) const
 {
     if( ftype == fuel_type_battery ) { // batteries get special treatment due to power cables
         int64_t capacity = 0;
-        for( const std::pair<const vehicle *const, float> &pair : search_connected_vehicles() ) {
+        for( const std::pair<vehicle *const, float> &pair : connected_power_grid().vehicles ) {
             const vehicle &veh = *pair.first;
             for( const int part_idx : veh.batteries ) {
                 const vehicle_part &vp = veh.parts[part_idx];
@@ -5231,7 +5240,7 @@ std::pair<int, int> vehicle::connected_battery_power_level() const
     int total_epower_remaining = 0;
     int total_epower_capacity = 0;
 
-    for( const std::pair<const vehicle *const, float> &pair : search_connected_vehicles() ) {
+    for( const std::pair<vehicle *const, float> &pair : connected_power_grid().vehicles ) {
         int epower_remaining;
         int epower_capacity;
         std::tie( epower_remaining, epower_capacity ) = pair.first->battery_power_level();
@@ -5646,12 +5655,57 @@ std::map<Vehicle *, float> vehicle::search_connected_vehicles( Vehicle *start )
 
 std::map<vehicle *, float> vehicle::search_connected_vehicles()
 {
-    return search_connected_vehicles( this );
+    return connected_power_grid().vehicles;
 }
 
 std::map<const vehicle *, float> vehicle::search_connected_vehicles() const
 {
-    return search_connected_vehicles( this );
+    const std::map<vehicle *, float> &vehicles = connected_power_grid().vehicles;
+    return std::map<const vehicle *, float>( vehicles.begin(), vehicles.end() );
+}
+
+uint64_t vehicle::power_grid_generation = 1;
+
+void vehicle::invalidate_power_grids()
+{
+    ++power_grid_generation;
+}
+
+const vehicle::power_grid &vehicle::connected_power_grid() const
+{
+    if( grid_cache_owner == this && grid_cache_generation == power_grid_generation ) {
+        return grid_cache;
+    }
+    // The search only follows the cables, it doesn't modify any vehicle
+    grid_cache.vehicles = search_connected_vehicles( const_cast<vehicle *>( this ) );
+
+    std::map<vpart_reference, float> batteries;
+    for( const std::pair<vehicle *const, float> &pair : grid_cache.vehicles ) {
+        vehicle *veh = pair.first;
+        for( const int part_idx : veh->batteries ) {
+            const vpart_reference vpr( *veh, part_idx );
+            if( vpr.part().is_fake ) {
+                continue;
+            }
+            batteries.emplace( vpr, pair.second );
+        }
+    }
+    grid_cache.batteries.clear();
+    grid_cache.battery_capacity = 0;
+    double loss = 0.0; // sum of power losses weighted by capacity
+    for( const std::pair<const vpart_reference, float> &pair : batteries ) {
+        const int capacity = pair.first.part().ammo_capacity( ammo_battery );
+        grid_cache.batteries.push_back( { &pair.first.vehicle(),
+                                          static_cast<int>( pair.first.part_index() ), pair.second
+                                        } );
+        grid_cache.battery_capacity += capacity;
+        loss += pair.second * capacity;
+    }
+    grid_cache.weighted_loss = loss / grid_cache.battery_capacity;
+
+    grid_cache_owner = this;
+    grid_cache_generation = power_grid_generation;
+    return grid_cache;
 }
 
 void vehicle::get_connected_vehicles( std::unordered_set<vehicle *> &dest )
@@ -5676,53 +5730,28 @@ void vehicle::get_connected_vehicles( std::unordered_set<vehicle *> &dest )
 std::map<vpart_reference, float> vehicle::search_connected_batteries()
 {
     std::map<vpart_reference, float> result;
-
-    for( const std::pair<vehicle *const, float> &pair : search_connected_vehicles() ) {
-        vehicle *veh = pair.first;
-        const float efficiency = pair.second;
-        for( const int part_idx : veh->batteries ) {
-            const vpart_reference vpr( *veh, part_idx );
-            if( vpr.part().is_fake ) {
-                continue;
-            }
-            result.emplace( vpr, efficiency );
-        }
+    for( const grid_battery &bat : connected_power_grid().batteries ) {
+        result.emplace( vpart_reference( *bat.veh, bat.part ), bat.loss );
     }
-
     return result;
 }
 
-// helper method to calculate power loss weighted by capacity
-static double weighted_power_loss( const std::map<vpart_reference, float> &batteries )
-{
-    double res = 0.0; // sum of power losses
-    int64_t total_capacity = 0; // sum of capacity of all batteries
-    for( const std::pair<const vpart_reference, float> &pair : batteries ) {
-        vehicle_part &vp = pair.first.part();
-        const int capacity = vp.ammo_capacity( ammo_battery );
-        total_capacity += capacity;
-        res += pair.second * capacity;
-    }
-    return res / total_capacity;
-}
-
-// helper method to take a map of batteries, amount of charge, total capacity of batteries
-// and distribute given charge_kj over the batteries as evenly as possible
-static void distribute_charge_evenly( const std::map<vpart_reference, float> &batteries,
-                                      int64_t charge_kj, int64_t total_capacity_kj )
+// helper method to take the batteries of a grid and distribute given charge_kj over them
+// as evenly as possible
+static void distribute_charge_evenly( const vehicle::power_grid &grid, int64_t charge_kj )
 {
     int64_t distributed = 0;
-    for( const std::pair<const vpart_reference, float> &pair : batteries ) {
-        vehicle_part &vp = pair.first.part();
+    for( const vehicle::grid_battery &bat : grid.batteries ) {
+        vehicle_part &vp = bat.veh->part( bat.part );
         const int bat_capacity = vp.ammo_capacity( ammo_battery );
-        const float fraction = static_cast<float>( bat_capacity ) / total_capacity_kj;
+        const float fraction = static_cast<float>( bat_capacity ) / grid.battery_capacity;
         const int portion = charge_kj * fraction;
         vp.ammo_set( fuel_type_battery, portion );
         distributed += portion;
     }
     if( distributed < charge_kj ) { // dump indivisible remainder sequentially
-        for( const std::pair<const vpart_reference, float> &pair : batteries ) {
-            vehicle_part &vp = pair.first.part();
+        for( const vehicle::grid_battery &bat : grid.batteries ) {
+            vehicle_part &vp = bat.veh->part( bat.part );
             const int64_t bat_charge = vp.ammo_remaining();
             const int64_t bat_capacity = vp.ammo_capacity( ammo_battery );
             const int chargeable = std::min( charge_kj - distributed, bat_capacity - bat_charge );
@@ -5740,7 +5769,7 @@ static void distribute_charge_evenly( const std::map<vpart_reference, float> &ba
 
 bool vehicle::is_battery_available() const
 {
-    for( const std::pair<const vehicle *const, float> &pair : search_connected_vehicles() ) {
+    for( const std::pair<vehicle *const, float> &pair : connected_power_grid().vehicles ) {
         const vehicle &veh = *pair.first;
         for( const int part_idx : veh.batteries ) {
             const vehicle_part &vp = veh.parts[part_idx];
@@ -5755,7 +5784,7 @@ bool vehicle::is_battery_available() const
 int64_t vehicle::battery_left( bool apply_loss ) const
 {
     int64_t ret = 0;
-    for( const std::pair<const vehicle *const, float> &pair : search_connected_vehicles() ) {
+    for( const std::pair<vehicle *const, float> &pair : connected_power_grid().vehicles ) {
         const vehicle &veh = *pair.first;
         const float efficiency = 1.0f - ( apply_loss ? pair.second : 0.0f );
         for( const int part_idx : veh.batteries ) {
@@ -5775,19 +5804,16 @@ int vehicle::charge_battery( int amount, bool apply_loss )
     if( amount == 0 ) {
         return 0;
     }
-    const std::map<vpart_reference, float> batteries = search_connected_batteries();
-    if( batteries.empty() ) {
+    const power_grid &grid = connected_power_grid();
+    if( grid.batteries.empty() ) {
         return amount;
     }
-    const double loss = apply_loss ? weighted_power_loss( batteries ) : 0.0;
+    const double loss = apply_loss ? grid.weighted_loss : 0.0;
     int64_t total_charge = 0; // sum of current charge of all batteries
-    int64_t total_capacity = 0; // sum of capacity of all batteries
-    for( const std::pair<const vpart_reference, float> &pair : batteries ) {
-        vehicle_part &vp = pair.first.part();
-        total_charge += vp.ammo_remaining();
-        total_capacity += vp.ammo_capacity( ammo_battery );
+    for( const grid_battery &bat : grid.batteries ) {
+        total_charge += bat.veh->part( bat.part ).ammo_remaining();
     }
-    const int64_t chargeable = total_capacity - total_charge;
+    const int64_t chargeable = grid.battery_capacity - total_charge;
     int64_t lost_amount = roll_remainder( amount * loss );
     int64_t lossy_amount = amount;
     int64_t charged = amount - lost_amount;
@@ -5800,11 +5826,11 @@ int vehicle::charge_battery( int amount, bool apply_loss )
     const int tried_charging = amount;
     amount -= charged + lost_amount;
 
-    distribute_charge_evenly( batteries, total_charge, total_capacity );
+    distribute_charge_evenly( grid, total_charge );
 
     add_msg_debug( debugmode::DF_VEHICLE,
                    "batteries: %d, loss: %.3f, tried charging: %d kJ, actual charged: %d kJ, usable: %d kJ, lost: %d kJ, excess: %d kJ",
-                   batteries.size(), loss, tried_charging, lossy_amount, charged, lost_amount, amount );
+                   grid.batteries.size(), loss, tried_charging, lossy_amount, charged, lost_amount, amount );
 
     return amount; // non zero if batteries couldn't absorb the entire amount
 }
@@ -5818,17 +5844,14 @@ int vehicle::discharge_battery( int amount, bool apply_loss )
     if( amount == 0 ) {
         return 0;
     }
-    const std::map<vpart_reference, float> batteries = search_connected_batteries();
-    if( batteries.empty() ) {
+    const power_grid &grid = connected_power_grid();
+    if( grid.batteries.empty() ) {
         return amount;
     }
-    const double loss = apply_loss ? weighted_power_loss( batteries ) : 0.0;
+    const double loss = apply_loss ? grid.weighted_loss : 0.0;
     int64_t total_charge = 0; // sum of current charge of all batteries
-    int64_t total_capacity = 0; // sum of capacity of all batteries
-    for( const std::pair<const vpart_reference, float> &pair : batteries ) {
-        vehicle_part &vp = pair.first.part();
-        total_charge += vp.ammo_remaining();
-        total_capacity += vp.ammo_capacity( ammo_battery );
+    for( const grid_battery &bat : grid.batteries ) {
+        total_charge += bat.veh->part( bat.part ).ammo_remaining();
     }
 
     int64_t discharged = amount;
@@ -5843,11 +5866,11 @@ int vehicle::discharge_battery( int amount, bool apply_loss )
     const int tried_discharging = amount;
     amount -= discharged;
 
-    distribute_charge_evenly( batteries, total_charge, total_capacity );
+    distribute_charge_evenly( grid, total_charge );
 
     add_msg_debug( debugmode::DF_VEHICLE,
                    "batteries: %d, loss: %.3f, tried discharging: %d kJ, actual discharged: %d kJ, usable: %d kJ, lost: %d kJ, missing: %d kJ",
-                   batteries.size(), loss, tried_discharging, lossy_amount, discharged, lost_amount,
+                   grid.batteries.size(), loss, tried_discharging, lossy_amount, discharged, lost_amount,
                    amount );
 
     return amount; // non zero if batteries couldn't provide the entire amount
@@ -6129,6 +6152,7 @@ std::optional<vehicle_stack::iterator> vehicle::add_item( vehicle_part &vp, cons
             if( !here->merge_charges( itm ) ) {
                 return std::nullopt;
             } else {
+                get_map().bump_items_revision();
                 return std::optional<vehicle_stack::iterator>( istack.get_iterator_from_pointer( here ) );
             }
         }
@@ -6146,6 +6170,7 @@ std::optional<vehicle_stack::iterator> vehicle::add_item( vehicle_part &vp, cons
     active_items.add( *new_pos, point_rel_ms( vp.mount ) );
 
     invalidate_mass();
+    get_map().bump_items_revision();
     return std::optional<vehicle_stack::iterator>( new_pos );
 }
 
@@ -6164,6 +6189,7 @@ vehicle_stack::iterator vehicle::remove_item( vehicle_part &vp,
         const vehicle_stack::const_iterator &it )
 {
     invalidate_mass();
+    get_map().bump_items_revision();
     return vp.items.erase( it );
 }
 
@@ -6432,6 +6458,7 @@ void vehicle::refresh_active_item_cache()
  */
 void vehicle::refresh( const bool remove_fakes )
 {
+    invalidate_power_grids();
     if( no_refresh ) {
         return;
     }
@@ -8453,6 +8480,7 @@ std::set<int> vehicle::advance_precalc_mounts( const point_sm_ms &new_pos,
 {
     map &here = get_map();
     std::set<int> smzs;
+    invalidate_power_grids();
     // when a vehicle part enters the low end of a down ramp, or the high end of an up ramp,
     // it immediately translates down or up a z-level, respectively, ending up on the low
     // end of an up ramp or high end of a down ramp, respectively.  The two ends are set
@@ -5,6 +5,7 @@
 #include <array>
 #include <climits>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iosfwd>
 #include <list>
@@ -871,6 +872,28 @@ class vehicle
         template<typename Vehicle>
         static std::map<Vehicle *, float> search_connected_vehicles( Vehicle *start );
     public:
+        struct grid_battery {
+            vehicle *veh;
+            int part;
+            float loss;
+        };
+        /// What search_connected_vehicles and search_connected_batteries found, kept until
+        /// invalidate_power_grids is called.
+        struct power_grid {
+            std::map<vehicle *, float> vehicles;
+            /// Batteries that aren't fake parts, in the order search_connected_batteries has them
+            std::vector<grid_battery> batteries;
+            int64_t battery_capacity = 0;
+            /// Line loss of the batteries weighted by their capacity
+            double weighted_loss = 0.0;
+        };
+    private:
+        const power_grid &connected_power_grid() const;
+    public:
+        /// Forgets the power grid every vehicle has cached.  Called whenever vehicles are
+        /// created, destroyed or moved, or parts are installed or removed, as any of these can
+        /// change what the cables connect.
+        static void invalidate_power_grids();
         /**
          * Find a possibly off-map vehicle. If necessary, loads up its submap through
          * the global MAPBUFFER and pulls it from there. For this reason, you should only
@@ -2196,6 +2219,13 @@ class vehicle
         // Cached points occupied by the vehicle
         mutable std::set<tripoint_bub_ms> occupied_points; // NOLINT(cata-serialize)
 
+        // Power grid this vehicle is part of, see connected_power_grid
+        mutable power_grid grid_cache; // NOLINT(cata-serialize)
+        // Which vehicle and which generation of the power grids grid_cache was built for
+        mutable const vehicle *grid_cache_owner = nullptr; // NOLINT(cata-serialize)
+        mutable uint64_t grid_cache_generation = 0; // NOLINT(cata-serialize)
+        static uint64_t power_grid_generation;
+
         // Master list of parts installed in the vehicle.
         std::vector<vehicle_part> parts; // NOLINT(cata-serialize)
         // Used in savegame.cpp to only save real parts to json
@@ -313,8 +313,32 @@ int vehicle_part::remaining_ammo_capacity() const
     return base.remaining_ammo_capacity();
 }
 
+namespace
+{
+// Vehicle tools and fuel are part of the crafting inventory, which is rebuilt when
+// map::get_items_revision changes. Batteries are set every turn, mostly to the same charge.
+class fuel_change_watch
+{
+    public:
+        explicit fuel_change_watch( const vehicle_part &vp ) : vp( vp ),
+            ammo( vp.ammo_current() ), qty( vp.ammo_remaining() ) {}
+        fuel_change_watch( const fuel_change_watch & ) = delete;
+        fuel_change_watch &operator=( const fuel_change_watch & ) = delete;
+        ~fuel_change_watch() {
+            if( vp.ammo_current() != ammo || vp.ammo_remaining() != qty ) {
+                get_map().bump_items_revision();
+            }
+        }
+    private:
+        const vehicle_part &vp;
+        itype_id ammo;
+        int qty;
+};
+} // namespace
+
 int vehicle_part::ammo_set( const itype_id &ammo, int qty )
 {
+    const fuel_change_watch watch( *this );
     // We often check if ammo is set to see if tank is empty, if qty == 0 don't set ammo
     if( is_tank() && qty != 0 ) {
         const itype *ammo_itype = item::find_type( ammo );
@@ -354,6 +378,7 @@ int vehicle_part::ammo_set( const itype_id &ammo, int qty )
 
 void vehicle_part::ammo_unset()
 {
+    const fuel_change_watch watch( *this );
     if( is_tank() ) {
         base.clear_items();
     } else if( is_fuel_store() ) {
@@ -363,6 +388,7 @@ void vehicle_part::ammo_unset()
 
 int vehicle_part::ammo_consume( int qty, const tripoint_bub_ms &pos )
 {
+    const fuel_change_watch watch( *this );
     if( is_tank() && !base.empty() ) {
         const int res = std::min( ammo_remaining(), qty );
         item &liquid = base.legacy_front();
@@ -381,6 +407,7 @@ units::energy vehicle_part::consume_energy( const itype_id &ftype, units::energy
         return 0_J;
     }
 
+    const fuel_change_watch watch( *this );
     for( item *const fuel : base.all_items_top() ) {
         if( fuel->typeId() != ftype || !fuel->is_fuel() ) {
             continue;
@@ -0,0 +1,200 @@
+#pragma once
+#ifndef CATA_SRC_VISITABLE_INL_H
+#define CATA_SRC_VISITABLE_INL_H
+
+// Definitions of the templated visit_items_inline / visit_contents_inline functions declared
+// alongside the std::function based visit_items. Include this header where a traversal is hot
+// enough that the visitor should be inlined; the std::function overloads are implemented on top
+// of these templates.
+
+#include "character.h"
+#include "character_attire.h"
+#include "colony.h"
+#include "coordinates.h"
+#include "inventory.h"
+#include "item.h"
+#include "item_contents.h"
+#include "item_pocket.h"
+#include "map.h"
+#include "map_selector.h"
+#include "mapdata.h"
+#include "temp_crafting_inventory.h"
+#include "vehicle.h"
+#include "vehicle_selector.h"
+#include "visitable.h"
+
+/** Visits @p node and then, unless the visitor skips or aborts, everything it contains. */
+template<typename F>
+inline VisitResponse visit_item_inline( F &func, const item *node, item *parent = nullptr )
+{
+    // hack to avoid repetition
+    item *m_node = const_cast<item *>( node );
+
+    switch( func( m_node, parent ) ) {
+        case VisitResponse::ABORT:
+            return VisitResponse::ABORT;
+
+        case VisitResponse::NEXT:
+            if( m_node->visit_contents_inline( func, m_node ) == VisitResponse::ABORT ) {
+                return VisitResponse::ABORT;
+            }
+            [[fallthrough]];
+
+        case VisitResponse::SKIP:
+            return VisitResponse::NEXT;
+    }
+
+    /* never reached but suppresses GCC warning */
+    return VisitResponse::ABORT;
+}
+
+/** Visits the furniture pseudo item and the accessible items on a map tile. */
+template<typename F>
+inline VisitResponse visit_map_items_inline( F &func, map &here, const tripoint_bub_ms &p )
+{
+    // check furniture pseudo items
+    if( here.furn( p ) != furn_str_id::NULL_ID() ) {
+        itype_id it_id = here.furn( p )->crafting_pseudo_item;
+        if( it_id.is_valid() ) {
+            item it( it_id );
+            if( visit_item_inline( func, &it ) == VisitResponse::ABORT ) {
+                return VisitResponse::ABORT;
+            }
+        }
+    }
+
+    // skip inaccessible items
+    if( here.has_flag( ter_furn_flag::TFLAG_SEALED, p ) &&
+        !here.has_flag( ter_furn_flag::TFLAG_LIQUIDCONT, p ) ) {
+        return VisitResponse::NEXT;
+    }
+
+    for( item &e : here.i_at( p ) ) {
+        if( visit_item_inline( func, &e ) == VisitResponse::ABORT ) {
+            return VisitResponse::ABORT;
+        }
+    }
+    return VisitResponse::NEXT;
+}
+
+template<typename F>
+VisitResponse item_pocket::visit_contents_inline( F &func, item *parent )
+{
+    for( item &e : contents ) {
+        if( visit_item_inline( func, &e, parent ) == VisitResponse::ABORT ) {
+            return VisitResponse::ABORT;
+        }
+    }
+    return VisitResponse::NEXT;
+}
+
+template<typename F>
+VisitResponse item_contents::visit_contents_inline( F &func, item *parent )
+{
+    for( item_pocket &pocket : contents ) {
+        if( !pocket.is_type( pocket_type::CONTAINER ) ) {
+            // anything that is not CONTAINER is accessible only via its specific accessor
+            continue;
+        }
+        if( pocket.visit_contents_inline( func, parent ) == VisitResponse::ABORT ) {
+            return VisitResponse::ABORT;
+        }
+    }
+    return VisitResponse::NEXT;
+}
+
+template<typename F>
+VisitResponse item::visit_contents_inline( F &func, item *parent )
+{
+    return contents.visit_contents_inline( func, parent );
+}
+
+template<typename F>
+VisitResponse item::visit_items_inline( F &&func ) const
+{
+    return visit_item_inline( func, this );
+}
+
+template<typename F>
+VisitResponse inventory::visit_items_inline( F &&func ) const
+{
+    for( const std::list<item> &stack : items ) {
+        for( const item &it : stack ) {
+            if( visit_item_inline( func, &it ) == VisitResponse::ABORT ) {
+                return VisitResponse::ABORT;
+            }
+        }
+    }
+    return VisitResponse::NEXT;
+}
+
+template<typename F>
+VisitResponse temp_crafting_inventory::visit_items_inline( F &&func ) const
+{
+    for( item *it : items ) {
+        if( visit_item_inline( func, it ) == VisitResponse::ABORT ) {
+            return VisitResponse::ABORT;
+        }
+    }
+    return VisitResponse::NEXT;
+}
+
+template<typename F>
+VisitResponse outfit::visit_items_inline( F &func ) const
+{
+    for( const item &e : worn ) {
+        if( visit_item_inline( func, &e ) == VisitResponse::ABORT ) {
+            return VisitResponse::ABORT;
+        }
+    }
+    return VisitResponse::NEXT;
+}
+
+template<typename F>
+VisitResponse Character::visit_items_inline( F &&func ) const
+{
+    if( !weapon.is_null() &&
+        visit_item_inline( func, &weapon ) == VisitResponse::ABORT ) {
+        return VisitResponse::ABORT;
+    }
+
+    if( worn.visit_items_inline( func ) == VisitResponse::ABORT ) {
+        return VisitResponse::ABORT;
+    }
+
+    for( const item *e : get_pseudo_items() ) {
+        if( visit_item_inline( func, e ) == VisitResponse::ABORT ) {
+            return VisitResponse::ABORT;
+        }
+    }
+
+    return inv->visit_items_inline( func );
+}
+
+template<typename F>
+VisitResponse map_cursor::visit_items_inline( F &&func ) const
+{
+    map &here = get_map();
+    if( !here.inbounds( pos() ) ) {
+        // needs a temporary map, which the std::function version takes care of
+        return visit_items( func );
+    }
+    return visit_map_items_inline( func, here, pos() );
+}
+
+template<typename F>
+VisitResponse vehicle_cursor::visit_items_inline( F &&func ) const
+{
+    const vehicle_part &vp = veh.part( part );
+    const int idx = veh.part_with_feature( vp.mount, "CARGO", true );
+    if( idx >= 0 ) {
+        for( item &e : veh.get_items( veh.part( idx ) ) ) {
+            if( visit_item_inline( func, &e ) == VisitResponse::ABORT ) {
+                return VisitResponse::ABORT;
+            }
+        }
+    }
+    return VisitResponse::NEXT;
+}
+
+#endif // CATA_SRC_VISITABLE_INL_H
@@ -36,6 +36,7 @@
 #include "veh_type.h"
 #include "vehicle.h"
 #include "vehicle_selector.h"
+#include "visitable-inl.h"
 
 static const bionic_id bio_ups( "bio_ups" );
 
@@ -109,7 +110,7 @@ static int has_quality_internal( const T &self, const quality_id &qual, int leve
 {
     int qty = 0;
 
-    self.visit_items( [&qual, level, &limit, &qty]( item * e, item * ) {
+    self.visit_items_inline( [&qual, level, &limit, &qty]( item * e, item * ) {
         if( e->get_quality( qual ) >= level ) {
             qty = sum_no_wrap( qty, static_cast<int>( e->count() ) );
             if( qty >= limit ) {
@@ -230,7 +231,7 @@ template <typename T>
 static int max_quality_internal( const T &self, const quality_id &qual )
 {
     int res = INT_MIN;
-    self.visit_items( [&res, &qual]( item * e, item * ) {
+    self.visit_items_inline( [&res, &qual]( item * e, item * ) {
         res = std::max( res, e->get_quality( qual ) );
         return VisitResponse::NEXT;
     } );
@@ -317,7 +318,7 @@ static inline std::vector<T> items_with_internal( V &self, const std::function<b
         &filter )
 {
     std::vector<T> res;
-    self.visit_items( [&res, &filter]( const item * node, item * ) {
+    self.visit_items_inline( [&res, &filter]( const item * node, item * ) {
         if( filter( *node ) ) {
             res.push_back( const_cast<T>( node ) );
         }
@@ -339,160 +340,56 @@ std::vector<item *> read_only_visitable::items_with(
     return items_with_internal<item *>( *this, filter );
 }
 
-static VisitResponse visit_internal( const std::function<VisitResponse( item *, item * )> &func,
-                                     const item *node, item *parent = nullptr )
-{
-    // hack to avoid repetition
-    item *m_node = const_cast<item *>( node );
-
-    switch( func( m_node, parent ) ) {
-        case VisitResponse::ABORT:
-            return VisitResponse::ABORT;
-
-        case VisitResponse::NEXT:
-            if( m_node->visit_contents( func, m_node ) == VisitResponse::ABORT ) {
-                return VisitResponse::ABORT;
-            }
-            [[fallthrough]];
-
-        case VisitResponse::SKIP:
-            return VisitResponse::NEXT;
-    }
-
-    /* never reached but suppresses GCC warning */
-    return VisitResponse::ABORT;
-}
-
 VisitResponse item::visit_contents( const std::function<VisitResponse( item *, item * )>
                                     &func, item *parent )
 {
-    return contents.visit_contents( func, parent );
+    return visit_contents_inline( func, parent );
 }
 
 VisitResponse item_contents::visit_contents( const std::function<VisitResponse( item *, item * )>
         &func, item *parent )
 {
-    for( item_pocket &pocket : contents ) {
-        if( !pocket.is_type( pocket_type::CONTAINER ) ) {
-            // anything that is not CONTAINER is accessible only via its specific accessor
-            continue;
-        }
-        switch( pocket.visit_contents( func, parent ) ) {
-            case VisitResponse::ABORT:
-                return VisitResponse::ABORT;
-            default:
-                break;
-        }
-    }
-    return VisitResponse::NEXT;
+    return visit_contents_inline( func, parent );
 }
 
 VisitResponse item_pocket::visit_contents( const std::function<VisitResponse( item *, item * )>
         &func, item *parent )
 {
-    for( item &e : contents ) {
-        switch( visit_internal( func, &e, parent ) ) {
-            case VisitResponse::ABORT:
-                return VisitResponse::ABORT;
-            default:
-                break;
-        }
-    }
-    return VisitResponse::NEXT;
+    return visit_contents_inline( func, parent );
 }
 
 /** @relates visitable */
 VisitResponse item::visit_items(
     const std::function<VisitResponse( item *, item * )> &func ) const
 {
-    return visit_internal( func, this );
+    return visit_items_inline( func );
 }
 
 /** @relates visitable */
 VisitResponse inventory::visit_items(
     const std::function<VisitResponse( item *, item * )> &func ) const
 {
-    for( const auto &stack : items ) {
-        for( const item &it : stack ) {
-            if( visit_internal( func, &it ) == VisitResponse::ABORT ) {
-                return VisitResponse::ABORT;
-            }
-        }
-    }
-    return VisitResponse::NEXT;
+    return visit_items_inline( func );
 }
 
 /** @relates visitable */
 VisitResponse temp_crafting_inventory::visit_items(
     const std::function<VisitResponse( item *, item * )> &func ) const
 {
-    for( item *it : items ) {
-        if( visit_internal( func, it ) == VisitResponse::ABORT ) {
-            return VisitResponse::ABORT;
-        }
-    }
-    return VisitResponse::NEXT;
+    return visit_items_inline( func );
 }
 
 VisitResponse outfit::visit_items( const std::function<VisitResponse( item *, item * )> &func )
 const
 {
-    for( const item &e : worn ) {
-        if( visit_internal( func, &e ) == VisitResponse::ABORT ) {
-            return VisitResponse::ABORT;
-        }
-    }
-    return VisitResponse::NEXT;
+    return visit_items_inline( func );
 }
 
 /** @relates visitable */
 VisitResponse Character::visit_items( const std::function<VisitResponse( item *, item * )> &func )
 const
 {
-    if( !weapon.is_null() &&
-        visit_internal( func, &weapon ) == VisitResponse::ABORT ) {
-        return VisitResponse::ABORT;
-    }
-
-    if( worn.visit_items( func ) == VisitResponse::ABORT ) {
-        return VisitResponse::ABORT;
-    }
-
-    for( const item *e : get_pseudo_items() ) {
-        if( visit_internal( func, e ) == VisitResponse::ABORT ) {
-            return VisitResponse::ABORT;
-        }
-    }
-
-    return inv->visit_items( func );
-}
-
-static VisitResponse visit_items_internal( map *here,
-        const tripoint_bub_ms p, const std::function<VisitResponse( item *, item * )> &func )
-{
-    // check furniture pseudo items
-    if( here->furn( p ) != furn_str_id::NULL_ID() ) {
-        itype_id it_id = here->furn( p )->crafting_pseudo_item;
-        if( it_id.is_valid() ) {
-            item it( it_id );
-            if( visit_internal( func, &it ) == VisitResponse::ABORT ) {
-                return VisitResponse::ABORT;
-            }
-        }
-    }
-
-    // skip inaccessible items
-    if( here->has_flag( ter_furn_flag::TFLAG_SEALED, p ) &&
-        !here->has_flag( ter_furn_flag::TFLAG_LIQUIDCONT, p ) ) {
-        return VisitResponse::NEXT;
-    }
-
-    for( item &e : here->i_at( p ) ) {
-        if( visit_internal( func, &e ) == VisitResponse::ABORT ) {
-            return VisitResponse::ABORT;
-        }
-    }
-    return VisitResponse::NEXT;
+    return visit_items_inline( func );
 }
 
 /** @relates visitable */
@@ -500,7 +397,7 @@ VisitResponse map_cursor::visit_items(
     const std::function<VisitResponse( item *, item * )> &func ) const
 {
     if( get_map().inbounds( pos() ) ) {
-        return visit_items_internal( &get_map(), pos(), func );
+        return visit_map_items_inline( func, get_map(), pos() );
     } else {
         tinymap here; // Tinymap is sufficient. Only looking at single location, so no Z level need.
         // pos returns the pos_bub location of the target relative to the reality bubble
@@ -509,7 +406,7 @@ VisitResponse map_cursor::visit_items(
         tripoint_abs_ms abs_pos = get_map().getglobal( pos() );
         here.load( project_to<coords::omt>( abs_pos ), false );
         tripoint_omt_ms p = here.omt_from_abs( abs_pos );
-        return visit_items_internal( here.cast_to_map(), rebase_bub( p ), func );
+        return visit_map_items_inline( func, *here.cast_to_map(), rebase_bub( p ) );
     }
 }
 
@@ -529,16 +426,7 @@ VisitResponse map_selector::visit_items(
 VisitResponse vehicle_cursor::visit_items(
     const std::function<VisitResponse( item *, item * )> &func ) const
 {
-    const vehicle_part &vp = veh.part( part );
-    const int idx = veh.part_with_feature( vp.mount, "CARGO", true );
-    if( idx >= 0 ) {
-        for( item &e : veh.get_items( veh.part( idx ) ) ) {
-            if( visit_internal( func, &e ) == VisitResponse::ABORT ) {
-                return VisitResponse::ABORT;
-            }
-        }
-    }
-    return VisitResponse::NEXT;
+    return visit_items_inline( func );
 }
 
 /** @relates visitable */
@@ -823,7 +711,7 @@ static int charges_of_internal( const T &self, const M &main, const itype_id &id
 
     bool found_tool_with_UPS = false;
     bool found_bionic_tool = false;
-    self.visit_items( [&]( const item * e, item * ) {
+    self.visit_items_inline( [&]( const item * e, item * ) {
         if( filter( *e ) &&
             ( id == e->typeId() || ( in_tools && id == e->ammo_current() ) ||
               ( id == itype_UPS && e->has_flag( flag_IS_UPS ) ) ) &&
@@ -876,7 +764,7 @@ static std::pair<int, int> kcal_range_of_internal( const T &self, const itype_id
         const std::function<bool( const item & )> &filter, Character &player_character )
 {
     std::pair<int, int> result( INT_MAX, INT_MIN );
-    self.visit_items( [&result, &id, &filter, &player_character]( const item * e, item * ) {
+    self.visit_items_inline( [&result, &id, &filter, &player_character]( const item * e, item * ) {
         if( e->typeId() == id && filter( *e ) ) {
             int kcal = player_character.compute_effective_nutrients( *e ).kcal();
             if( kcal < result.first ) {
@@ -962,7 +850,7 @@ static int amount_of_internal( const T &self, const itype_id &id, bool pseudo, i
                                const std::function<bool( const item & )> &filter )
 {
     int qty = 0;
-    self.visit_items( [&qty, &id, &pseudo, &limit, &filter]( const item * e, item * ) {
+    self.visit_items_inline( [&qty, &id, &pseudo, &limit, &filter]( const item * e, item * ) {
         if( !e->has_flag( STATIC( flag_id( "ITEM_BROKEN" ) ) ) &&
             ( id == STATIC( itype_id( "any" ) ) || e->typeId() == id ) && filter( *e ) &&
             ( pseudo || !e->has_flag( STATIC( flag_id( "PSEUDO" ) ) ) ) ) {
@@ -994,12 +882,12 @@ int inventory::amount_of( const itype_id &what, bool pseudo, int limit,
     if( what.str() == "any" ) {
         for( const auto &kv : binned ) {
             for( const item *it : kv.second ) {
-                res = sum_no_wrap( res, it->amount_of( what, pseudo, limit, filter ) );
+                res = sum_no_wrap( res, amount_of_internal( *it, what, pseudo, limit, filter ) );
             }
         }
     } else {
         for( const item *it : iter->second ) {
-            res = sum_no_wrap( res, it->amount_of( what, pseudo, limit, filter ) );
+            res = sum_no_wrap( res, amount_of_internal( *it, what, pseudo, limit, filter ) );
         }
     }
 
@@ -1020,7 +908,7 @@ int Character::amount_of( const itype_id &what, bool pseudo, int limit,
 
     if( what == itype_apparatus && pseudo ) {
         int qty = 0;
-        visit_items( [&qty, &limit, &filter]( const item * e, item * ) {
+        visit_items_inline( [&qty, &limit, &filter]( const item * e, item * ) {
             if( e->get_quality( qual_SMOKE_PIPE ) >= 1 && filter( *e ) ) {
                 qty = sum_no_wrap( qty, 1 );
             }
@@ -5,6 +5,7 @@
 #include <climits>
 #include <functional>
 #include <list>
+#include <utility>
 #include <vector>
 
 #include "cata_utility.h"
@@ -40,6 +41,18 @@ class read_only_visitable
         virtual VisitResponse visit_items(
             const std::function<VisitResponse( item *, item * )> &func ) const = 0;
 
+        /**
+         * Same traversal as @ref visit_items, but the visitor is a template parameter.
+         * Item, inventory, Character, map_cursor and vehicle_cursor hide this with their own
+         * version which calls the visitor directly, so it can be inlined instead of going
+         * through std::function. Their definitions are in visitable-inl.h, which callers
+         * must include. This fallback calls the virtual @ref visit_items.
+         */
+        template<typename F>
+        VisitResponse visit_items_inline( F &&func ) const {
+            return visit_items( std::forward<F>( func ) );
+        }
+
         /**
          * Determine the immediate parent container (if any) for an item.
          * @param it item to search for which must be contained (at any depth) by this object
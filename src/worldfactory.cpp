@@ -93,6 +93,7 @@ void WORLD::COPY_WORLD( const WORLD *world_to_copy )
 {
     world_name = world_to_copy->world_name + "_copy";
     WORLD_OPTIONS = world_to_copy->WORLD_OPTIONS;
+    options_manager::invalidate_handles();
     active_mod_order = world_to_copy->active_mod_order;
 }
 
@@ -390,6 +391,7 @@ void worldfactory::init()
         // load options into the world
         if( !all_worlds[worldname]->load_options() ) {
             all_worlds[worldname]->WORLD_OPTIONS = get_options().get_world_defaults();
+            options_manager::invalidate_handles();
             all_worlds[worldname]->WORLD_OPTIONS["WORLD_END"].setValue( "delete" );
             save = true;
         }
@@ -434,8 +436,10 @@ void worldfactory::init()
             }
             newworld->world_saves = old_world.world_saves;
             newworld->WORLD_OPTIONS = old_world.WORLD_OPTIONS;
+            options_manager::invalidate_handles();
 
             all_worlds.erase( "save" );
+            options_manager::invalidate_handles();
 
             all_worlds[newworld->world_name] = std::move( newworld );
         } else {
@@ -1785,6 +1789,7 @@ int worldfactory::show_worldgen_basic( WORLD *world )
                        query_yn( _( "Are you sure you want to reset this world?" ) ) ) {
                 // reset
                 world->WORLD_OPTIONS = get_options().get_world_defaults();
+                options_manager::invalidate_handles();
                 world->world_saves.clear();
                 world->active_mod_order = world_generator->get_mod_manager().get_default_mods();
                 wg_slevels = wg_slvl_default;
@@ -1802,6 +1807,7 @@ int worldfactory::show_worldgen_basic( WORLD *world )
                 if( custom_opts && query_yn( _( "Currently using customized advanced options.  "
                                                 "Reset world options to defaults?" ) ) ) {
                     world->WORLD_OPTIONS = get_options().get_world_defaults();
+                    options_manager::invalidate_handles();
                     wg_slevels = wg_slvl_default;
                     custom_opts = false;
                     continue;
@@ -2042,6 +2048,7 @@ void WORLD::load_options( const JsonArray &options_json )
 bool WORLD::load_options()
 {
     WORLD_OPTIONS = get_options().get_world_defaults();
+    options_manager::invalidate_handles();
 
     const cata_path path = folder_path() / PATH_INFO::worldoptions();
     return read_from_file_optional_json( path, [this]( const JsonValue & jsin ) {
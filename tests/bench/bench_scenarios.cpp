@@ -0,0 +1,293 @@
+#include "bench_scenarios.h"
+
+#include <cstdlib>
+#include <optional>
+#include <vector>
+
+#include "avatar.h"
+#include "basecamp.h"
+#include "calendar.h"
+#include "clzones.h"
+#include "coordinates.h"
+#include "faction.h"
+#include "field.h"
+#include "game.h"
+#include "item.h"
+#include "map.h"
+#include "map_scale_constants.h"
+#include "npc.h"
+#include "overmapbuffer.h"
+#include "point.h"
+#include "rng.h"
+#include "type_id.h"
+#include "units.h"
+#include "vehicle.h"
+#include "vpart_position.h"
+
+static const faction_id faction_your_followers( "your_followers" );
+
+static const field_type_str_id field_fd_fire( "fd_fire" );
+
+static const furn_str_id furn_f_bookcase( "f_bookcase" );
+static const furn_str_id furn_f_table( "f_table" );
+
+static const itype_id itype_2x4( "2x4" );
+static const itype_id itype_apple( "apple" );
+static const itype_id itype_meat_cooked( "meat_cooked" );
+static const itype_id itype_rock( "rock" );
+
+static const mtype_id mon_chicken( "mon_chicken" );
+static const mtype_id mon_deer( "mon_deer" );
+static const mtype_id mon_zombie( "mon_zombie" );
+
+static const npc_template_id npc_template_thug( "thug" );
+
+static const ter_str_id ter_t_floor( "t_floor" );
+static const ter_str_id ter_t_grass( "t_grass" );
+static const ter_str_id ter_t_open_air( "t_open_air" );
+static const ter_str_id ter_t_rock( "t_rock" );
+static const ter_str_id ter_t_wall_wood( "t_wall_wood" );
+
+static const trait_id trait_DEBUG_NODMG( "DEBUG_NODMG" );
+
+static const vproto_id vehicle_prototype_car( "car" );
+
+static const zone_type_id zone_type_CAMP_STORAGE( "CAMP_STORAGE" );
+static const zone_type_id zone_type_LOOT_UNSORTED( "LOOT_UNSORTED" );
+
+namespace cata_bench
+{
+
+static tripoint_bub_ms map_center()
+{
+    return tripoint_bub_ms( MAPSIZE_X / 2, MAPSIZE_Y / 2, 0 );
+}
+
+static void place_monsters( const mtype_id &type, int count, int min_radius, int max_radius )
+{
+    const tripoint_bub_ms center = map_center();
+    for( int i = 0; i < count; ++i ) {
+        const tripoint_bub_ms p = center + tripoint_rel_ms( rng( -max_radius, max_radius ),
+                                  rng( -max_radius, max_radius ), 0 );
+        if( square_dist( p, center ) >= min_radius ) {
+            g->place_critter_at( type, p );
+        }
+    }
+}
+
+// Mirrors clear_map() and clear_avatar() of the test helpers, which need Catch.
+void reset_world()
+{
+    map &here = get_map();
+    if( here.get_abs_sub().z() != 0 ) {
+        here.load( tripoint_abs_sm( here.get_abs_sub().xy(), 0 ), false );
+    }
+
+    g->reload_npcs();
+    for( npc &guy : g->all_npcs() ) {
+        guy.die( nullptr );
+    }
+    g->cleanup_dead();
+    g->clear_zombies();
+    zone_manager::get_manager().clear();
+    std::optional<basecamp *> camp;
+    do {
+        const tripoint_abs_omt &avatar_pos = get_avatar().global_omt_location();
+        camp = overmap_buffer.find_camp( avatar_pos.xy() );
+        if( camp && *camp != nullptr ) {
+            ( **camp ).remove_camp( avatar_pos );
+        }
+    } while( camp );
+
+    for( wrapped_vehicle &veh : here.get_vehicles() ) {
+        here.destroy_vehicle( veh.v );
+    }
+    for( int z = -1; z <= OVERMAP_HEIGHT; ++z ) {
+        const ter_id terrain = z == 0 ? ter_t_grass : z < 0 ? ter_t_rock : ter_t_open_air;
+        for( int x = 0; x < MAPSIZE_X; ++x ) {
+            for( int y = 0; y < MAPSIZE_Y; ++y ) {
+                const tripoint_bub_ms p( x, y, z );
+                here.set( p, terrain, furn_str_id::NULL_ID() );
+                here.partial_con_remove( p );
+                if( z == 0 ) {
+                    here.clear_fields( p );
+                    here.i_clear( p );
+                }
+            }
+        }
+    }
+    here.clear_traps();
+    here.process_items();
+
+    calendar::turn = calendar::turn_zero + 12_hours;
+
+    avatar &u = get_avatar();
+    u.cancel_activity();
+    u.clear_effects();
+    u.clear_mutations();
+    u.toggle_trait( trait_DEBUG_NODMG );
+    u.set_all_parts_hp_to_max();
+    u.setpos( map_center() );
+    u.set_moves( 0 );
+
+    here.invalidate_map_cache( 0 );
+    here.build_map_cache( 0, true );
+}
+
+static void setup_horde_siege()
+{
+    map &here = get_map();
+    const tripoint_bub_ms center = map_center();
+    // A wooden shack for the horde to bash on
+    for( int dx = -4; dx <= 4; ++dx ) {
+        for( int dy = -4; dy <= 4; ++dy ) {
+            const bool wall = std::abs( dx ) == 4 || std::abs( dy ) == 4;
+            here.ter_set( center + point_rel_ms( dx, dy ), wall ? ter_t_wall_wood : ter_t_floor );
+        }
+    }
+    place_monsters( mon_zombie, 250, 12, 40 );
+}
+
+static void setup_burning_city_block()
+{
+    map &here = get_map();
+    const tripoint_bub_ms center = map_center();
+    // A 4x4 block of wooden houses full of furniture and lumber, each set on fire
+    for( int house_x = -2; house_x < 2; ++house_x ) {
+        for( int house_y = -2; house_y < 2; ++house_y ) {
+            const tripoint_bub_ms corner = center + point_rel_ms( house_x * 12 + 1,
+                                           house_y * 12 + 1 );
+            for( int dx = 0; dx < 10; ++dx ) {
+                for( int dy = 0; dy < 10; ++dy ) {
+                    const tripoint_bub_ms p = corner + point_rel_ms( dx, dy );
+                    const bool wall = dx == 0 || dy == 0 || dx == 9 || dy == 9;
+                    here.ter_set( p, wall ? ter_t_wall_wood : ter_t_floor );
+                    if( !wall && ( dx + dy ) % 4 == 0 ) {
+                        here.furn_set( p, dx % 2 == 0 ? furn_f_bookcase : furn_f_table );
+                        here.add_item_or_charges( p, item( itype_2x4 ) );
+                    }
+                }
+            }
+            here.add_field( corner + point_rel_ms( 5, 5 ), field_fd_fire, 3 );
+        }
+    }
+    get_avatar().setpos( center + point_rel_ms( 0, -40 ) );
+}
+
+static void setup_large_basecamp()
+{
+    map &here = get_map();
+    const tripoint_bub_ms center = map_center();
+    const tripoint_abs_ms storage_start = here.getglobal( center + point_rel_ms( -10, -10 ) );
+    const tripoint_abs_ms storage_end = here.getglobal( center + point_rel_ms( 10, 10 ) );
+    mapgen_place_zone( storage_start, storage_end, zone_type_CAMP_STORAGE, your_fac, {},
+                       "storage" );
+    mapgen_place_zone( storage_start, storage_end, zone_type_LOOT_UNSORTED, your_fac, {},
+                       "unsorted" );
+    here.add_camp( project_to<coords::omt>( here.getglobal( center ) ), "faction_camp" );
+
+    const std::vector<itype_id> stock = { itype_2x4, itype_apple, itype_meat_cooked, itype_rock };
+    for( int dx = -10; dx <= 10; ++dx ) {
+        for( int dy = -10; dy <= 10; ++dy ) {
+            for( const itype_id &type : stock ) {
+                here.add_item_or_charges( center + point_rel_ms( dx, dy ), item( type ) );
+            }
+        }
+    }
+
+    for( int i = 0; i < 12; ++i ) {
+        const point_bub_ms p = center.xy() + point_rel_ms( rng( -15, 15 ), rng( -15, 15 ) );
+        const character_id id = here.place_npc( p, npc_template_thug );
+        g->load_npcs();
+        if( npc *guy = g->find_npc( id ) ) {
+            guy->set_fac( faction_your_followers );
+            guy->set_attitude( NPCATT_FOLLOW );
+        }
+    }
+}
+
+// Vehicles that get far enough from their lane are moved back, so the convoy stays in the bubble.
+static constexpr int convoy_lane_start = 20;
+static constexpr int convoy_lane_length = 60;
+
+static void setup_vehicle_convoy()
+{
+    map &here = get_map();
+    for( int i = 0; i < 8; ++i ) {
+        const tripoint_bub_ms p( convoy_lane_start, 20 + i * 12, 0 );
+        vehicle *veh = here.add_vehicle( vehicle_prototype_car, p, 0_degrees, 100, 0, false );
+        if( veh == nullptr ) {
+            continue;
+        }
+        veh->tags.insert( "IN_CONTROL_OVERRIDE" );
+        veh->engine_on = true;
+        veh->cruise_velocity = 1000 + 250 * ( i % 3 );
+        veh->velocity = veh->cruise_velocity;
+    }
+    get_avatar().setpos( map_center() + point_rel_ms( 0, -50 ) );
+}
+
+static void vehicle_convoy_turn()
+{
+    map &here = get_map();
+    for( wrapped_vehicle &veh : here.get_vehicles() ) {
+        const int x = veh.v->pos_bub().x();
+        if( x > convoy_lane_start + convoy_lane_length ) {
+            here.displace_vehicle( *veh.v, tripoint_rel_ms( -convoy_lane_length, 0, 0 ) );
+        }
+    }
+}
+
+static void setup_long_wait()
+{
+    map &here = get_map();
+    place_monsters( mon_chicken, 30, 5, 50 );
+    place_monsters( mon_deer, 10, 20, 50 );
+    const tripoint_bub_ms center = map_center();
+    // Food spoiling in a pantry keeps the active item processing busy
+    for( int dx = 2; dx < 8; ++dx ) {
+        for( int dy = 2; dy < 8; ++dy ) {
+            here.add_item_or_charges( center + point_rel_ms( dx, dy ), item( itype_meat_cooked ) );
+            here.add_item_or_charges( center + point_rel_ms( dx, dy ), item( itype_apple ) );
+        }
+    }
+}
+
+const std::vector<scenario> &get_scenarios()
+{
+    static const std::vector<scenario> scenarios = {
+        {
+            "horde_siege", "250 zombies converging on a wooden shack around the avatar",
+            300, setup_horde_siege, {}
+        },
+        {
+            "burning_city_block", "16 furnished wooden houses burning down",
+            300, setup_burning_city_block, {}
+        },
+        {
+            "large_basecamp", "A camp with 12 followers and a 21x21 storage zone full of items",
+            300, setup_large_basecamp, {}
+        },
+        {
+            "vehicle_convoy", "8 unmanned cars driving in parallel lanes",
+            300, setup_vehicle_convoy, vehicle_convoy_turn
+        },
+        {
+            "long_wait", "Waiting an hour among wildlife next to a pantry of spoiling food",
+            3600, setup_long_wait, {}
+        },
+    };
+    return scenarios;
+}
+
+const scenario *find_scenario( const std::string &id )
+{
+    for( const scenario &s : get_scenarios() ) {
+        if( s.id == id ) {
+            return &s;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace cata_bench
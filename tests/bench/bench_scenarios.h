@@ -0,0 +1,38 @@
+#pragma once
+#ifndef CATA_TESTS_BENCH_BENCH_SCENARIOS_H
+#define CATA_TESTS_BENCH_BENCH_SCENARIOS_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace cata_bench
+{
+
+/**
+ * A reproducible situation to run the turn loop in.
+ *
+ * Every scenario starts from the same state: the reality bubble is wiped to flat grass, the
+ * creatures, vehicles, zones and camps are removed, the clock is reset and the avatar stands
+ * in the middle of the map without being able to take damage.  The rng is seeded before
+ * @ref setup runs, so the same seed builds the same world.
+ */
+struct scenario {
+    std::string id;
+    std::string description;
+    int default_turns;
+    std::function<void()> setup;
+    // Called before every turn, may be empty
+    std::function<void()> before_turn;
+};
+
+const std::vector<scenario> &get_scenarios();
+/** Returns nullptr if there is no scenario called @p id. */
+const scenario *find_scenario( const std::string &id );
+
+/** Restores the common starting state described in @ref scenario. */
+void reset_world();
+
+} // namespace cata_bench
+
+#endif // CATA_TESTS_BENCH_BENCH_SCENARIOS_H
@@ -0,0 +1,330 @@
+// Headless benchmark of the turn loop.
+//
+// Loads a fixed set of mods once, then for every selected scenario builds its world from the
+// seed and runs the turn loop for a number of turns, timing every zone of the turn profiler.
+// The results are written as JSON so runs on the same machine can be compared across commits:
+//
+//   tests/cata_bench --scenario horde_siege,long_wait --turns 200 --output bench.json
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+#include "avatar.h"
+#include "bench_scenarios.h"
+#include "cached_options.h"
+#include "cata_utility.h"
+#include "debug.h"
+#include "do_turn.h"
+#include "filesystem.h"
+#include "game.h"
+#include "init_game_state.h"
+#include "json.h"
+#include "rng.h"
+#include "string_formatter.h"
+#include "turn_profiler.h"
+#include "type_id.h"
+#include "worldfactory.h"
+
+// Every allocation made through the global operator new is counted.  The array and nothrow
+// forms call these, aligned allocations are not counted.
+static std::atomic<std::uint64_t> allocation_count{ 0 };
+static std::atomic<std::uint64_t> allocated_bytes{ 0 };
+
+void *operator new( std::size_t size )
+{
+    allocation_count.fetch_add( 1, std::memory_order_relaxed );
+    allocated_bytes.fetch_add( size, std::memory_order_relaxed );
+    if( void *p = std::malloc( size == 0 ? 1 : size ) ) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+// GCC doesn't see that the memory came from the malloc in operator new above
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete( void *p ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete( void *p, std::size_t ) noexcept
+{
+    std::free( p );
+}
+#pragma GCC diagnostic pop
+
+namespace
+{
+
+struct zone_totals {
+    int depth = 0;
+    std::chrono::nanoseconds total{ 0 };
+    std::chrono::nanoseconds max{ 0 };
+    int calls = 0;
+};
+
+struct scenario_result {
+    std::string id;
+    int turns = 0;
+    std::chrono::nanoseconds setup_time{ 0 };
+    std::chrono::nanoseconds total{ 0 };
+    std::chrono::nanoseconds max{ 0 };
+    std::uint64_t allocations = 0;
+    std::uint64_t bytes = 0;
+    long peak_rss_kb = 0;
+    // Indexed by zone id, so zones appear in the order they were first entered
+    std::map<int, zone_totals> zones;
+};
+
+struct bench_options {
+    std::vector<std::string> scenarios;
+    int turns = 0;
+    unsigned int seed = 42;
+    std::vector<mod_id> mods = { mod_id( "dda" ) };
+    std::string user_dir = "./bench_user_dir/";
+    std::string output;
+};
+
+double to_milliseconds( std::chrono::nanoseconds d )
+{
+    return std::chrono::duration<double, std::milli>( d ).count();
+}
+
+// The peak resident set size of the process so far, 0 where it isn't available.
+long peak_rss_kb()
+{
+#if defined(_WIN32)
+    return 0;
+#else
+    rusage usage;
+    if( getrusage( RUSAGE_SELF, &usage ) != 0 ) {
+        return 0;
+    }
+#if defined(__APPLE__)
+    // bytes on macOS, kilobytes everywhere else
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+scenario_result run_scenario( const cata_bench::scenario &s, int turns, unsigned int seed )
+{
+    scenario_result res;
+    res.id = s.id;
+    res.turns = turns;
+
+    const auto setup_start = std::chrono::steady_clock::now();
+    rng_set_engine_seed( seed );
+    cata_bench::reset_world();
+    s.setup();
+    res.setup_time = std::chrono::steady_clock::now() - setup_start;
+
+    turn_profiler::set_enabled( true );
+    avatar &u = get_avatar();
+    const std::uint64_t allocations_before = allocation_count.load();
+    const std::uint64_t bytes_before = allocated_bytes.load();
+    for( int turn = 0; turn < turns; ++turn ) {
+        if( s.before_turn ) {
+            s.before_turn();
+        }
+        // Keep the avatar from acting, there is nobody to take input
+        u.set_moves( 0 );
+        turn_profiler::clear();
+        const auto turn_start = std::chrono::steady_clock::now();
+        do_turn();
+        const std::chrono::nanoseconds turn_time = std::chrono::steady_clock::now() - turn_start;
+        res.total += turn_time;
+        res.max = std::max( res.max, turn_time );
+
+        for( const turn_profiler::turn_record *record : turn_profiler::history() ) {
+            std::map<int, std::chrono::nanoseconds> turn_zones;
+            for( const turn_profiler::zone_event &e : record->events ) {
+                zone_totals &zone = res.zones[e.zone];
+                zone.depth = e.depth;
+                zone.total += e.duration;
+                ++zone.calls;
+                turn_zones[e.zone] += e.duration;
+            }
+            for( const std::pair<const int, std::chrono::nanoseconds> &zone : turn_zones ) {
+                res.zones[zone.first].max = std::max( res.zones[zone.first].max, zone.second );
+            }
+        }
+        if( u.is_dead_state() ) {
+            DebugLog( D_ERROR, DC_ALL ) << "Scenario " << s.id << " ended after " << turn + 1 <<
+                                        " turns";
+            res.turns = turn + 1;
+            break;
+        }
+    }
+    res.allocations = allocation_count.load() - allocations_before;
+    res.bytes = allocated_bytes.load() - bytes_before;
+    res.peak_rss_kb = peak_rss_kb();
+    turn_profiler::set_enabled( false );
+    return res;
+}
+
+void write_results( std::ostream &out, const bench_options &opts,
+                    const std::vector<scenario_result> &results )
+{
+    JsonOut jsout( out, true );
+    jsout.start_object();
+    jsout.member( "seed", opts.seed );
+    jsout.member( "mods", opts.mods );
+#if defined(TURN_PROFILER)
+    jsout.member( "zones_compiled", true );
+#else
+    jsout.member( "zones_compiled", false );
+#endif
+    jsout.member( "scenarios" );
+    jsout.start_array();
+    for( const scenario_result &res : results ) {
+        const int turns = std::max( res.turns, 1 );
+        jsout.start_object();
+        jsout.member( "id", res.id );
+        jsout.member( "turns", res.turns );
+        jsout.member( "setup_ms", to_milliseconds( res.setup_time ) );
+        jsout.member( "total_ms", to_milliseconds( res.total ) );
+        jsout.member( "ms_per_turn", to_milliseconds( res.total / turns ) );
+        jsout.member( "max_turn_ms", to_milliseconds( res.max ) );
+        jsout.member( "allocations", res.allocations );
+        jsout.member( "allocated_bytes", res.bytes );
+        jsout.member( "allocations_per_turn", res.allocations / turns );
+        jsout.member( "peak_rss_kb", res.peak_rss_kb );
+        jsout.member( "zones" );
+        jsout.start_array();
+        for( const std::pair<const int, zone_totals> &zone : res.zones ) {
+            jsout.start_object();
+            jsout.member( "name", turn_profiler::zone_name( zone.first ) );
+            jsout.member( "depth", zone.second.depth );
+            jsout.member( "total_ms", to_milliseconds( zone.second.total ) );
+            jsout.member( "ms_per_turn", to_milliseconds( zone.second.total / turns ) );
+            jsout.member( "max_turn_ms", to_milliseconds( zone.second.max ) );
+            jsout.member( "calls", zone.second.calls );
+            jsout.end_object();
+        }
+        jsout.end_array();
+        jsout.end_object();
+    }
+    jsout.end_array();
+    jsout.end_object();
+    out << std::endl;
+}
+
+void print_usage()
+{
+    printf( "Usage: cata_bench [options]\n"
+            "  --scenario id[,id…]  Scenarios to run (default: all)\n"
+            "  --turns n            Turns to run each scenario for (default: per scenario)\n"
+            "  --seed n             Seed of the random number generator (default: 42)\n"
+            "  --mods mod1[,mod2…]  Mods to load (default: dda)\n"
+            "  --user-dir dirname   Where the world is created (default: ./bench_user_dir/)\n"
+            "  --output filename    Write the results there instead of to stdout\n"
+            "  --list               List the scenarios and exit\n" );
+}
+
+} // namespace
+
+int main( int argc, const char *argv[] )
+{
+    bench_options opts;
+    for( int i = 1; i < argc; ++i ) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if( arg == "--list" ) {
+            for( const cata_bench::scenario &s : cata_bench::get_scenarios() ) {
+                printf( "%-20s %6d turns  %s\n", s.id.c_str(), s.default_turns,
+                        s.description.c_str() );
+            }
+            return EXIT_SUCCESS;
+        } else if( arg == "--scenario" && has_value ) {
+            opts.scenarios = string_split( argv[++i], ',' );
+        } else if( arg == "--turns" && has_value ) {
+            opts.turns = std::atoi( argv[++i] );
+        } else if( arg == "--seed" && has_value ) {
+            opts.seed = static_cast<unsigned int>( std::strtoul( argv[++i], nullptr, 10 ) );
+        } else if( arg == "--mods" && has_value ) {
+            opts.mods.clear();
+            for( const std::string &mod : string_split( argv[++i], ',' ) ) {
+                opts.mods.emplace_back( mod );
+            }
+        } else if( arg == "--user-dir" && has_value ) {
+            opts.user_dir = argv[++i];
+        } else if( arg == "--output" && has_value ) {
+            opts.output = argv[++i];
+        } else {
+            print_usage();
+            return arg == "--help" || arg == "-h" ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+    if( !string_ends_with( opts.user_dir, "/" ) ) {
+        opts.user_dir += "/";
+    }
+
+    std::vector<const cata_bench::scenario *> scenarios;
+    if( opts.scenarios.empty() ) {
+        for( const cata_bench::scenario &s : cata_bench::get_scenarios() ) {
+            scenarios.push_back( &s );
+        }
+    }
+    for( const std::string &id : opts.scenarios ) {
+        const cata_bench::scenario *s = cata_bench::find_scenario( id );
+        if( s == nullptr ) {
+            printf( "Unknown scenario %s, see --list\n", id.c_str() );
+            return EXIT_FAILURE;
+        }
+        scenarios.push_back( s );
+    }
+
+    // NOLINTNEXTLINE(cata-tests-must-restore-global-state)
+    test_mode = true;
+    reset_floating_point_mode();
+    setupDebug( DebugOutput::std_err );
+
+    rng_set_engine_seed( opts.seed );
+    option_overrides_t no_overrides;
+    try {
+        init_global_game_state( opts.mods, no_overrides, opts.user_dir );
+    } catch( const std::exception &err ) {
+        DebugLog( D_ERROR, DC_ALL ) << "Failed to load the game data:\n" << err.what();
+        return EXIT_FAILURE;
+    }
+
+    std::vector<scenario_result> results;
+    for( const cata_bench::scenario *s : scenarios ) {
+        const int turns = opts.turns > 0 ? opts.turns : s->default_turns;
+        DebugLog( D_INFO, DC_ALL ) << "Running " << s->id << " for " << turns << " turns";
+        results.push_back( run_scenario( *s, turns, opts.seed ) );
+    }
+
+    world_generator->delete_world( world_generator->active_world->world_name, true );
+
+    if( opts.output.empty() ) {
+        write_results( std::cout, opts, results );
+    } else {
+        std::ofstream fout( opts.output, std::ios::binary );
+        write_results( fout, opts, results );
+        if( !fout ) {
+            DebugLog( D_ERROR, DC_ALL ) << "Failed to write " << opts.output;
+            return EXIT_FAILURE;
+        }
+    }
+    return debug_has_error_been_observed() ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -5,8 +5,10 @@
 #include "avatar.h"
 #include "cata_catch.h"
 #include "clzones.h"
+#include "game_constants.h"
 #include "item.h"
 #include "item_category.h"
+#include "map.h"
 #include "map_helpers.h"
 #include "player_helpers.h"
 #include "pocket_type.h"
@@ -20,9 +22,16 @@ static const faction_id faction_your_followers( "your_followers" );
 static const itype_id itype_556( "556" );
 static const itype_id itype_ammolink223( "ammolink223" );
 static const itype_id itype_belt223( "belt223" );
+static const itype_id itype_hammer( "hammer" );
+static const itype_id itype_test_apple( "test_apple" );
+static const itype_id itype_test_bitter_almond( "test_bitter_almond" );
+static const itype_id itype_test_milk( "test_milk" );
+static const itype_id itype_test_wine( "test_wine" );
 
 static const vproto_id vehicle_prototype_shopping_cart( "shopping_cart" );
 
+static const zone_type_id zone_type_LOOT_CUSTOM( "LOOT_CUSTOM" );
+static const zone_type_id zone_type_LOOT_DEFAULT( "LOOT_DEFAULT" );
 static const zone_type_id zone_type_LOOT_DRINK( "LOOT_DRINK" );
 static const zone_type_id zone_type_LOOT_FOOD( "LOOT_FOOD" );
 static const zone_type_id zone_type_LOOT_PDRINK( "LOOT_PDRINK" );
@@ -316,3 +325,75 @@ TEST_CASE( "zone_sorting_comestibles_", "[zones][items][food][activities]" )
         }
     }
 }
+
+TEST_CASE( "zone_range_queries_cover_every_zone_tile", "[zones]" )
+{
+    clear_map();
+    zone_manager &zm = zone_manager::get_manager();
+    zm.clear();
+    const tripoint_abs_ms where = get_map().getglobal( tripoint_bub_ms( 60, 60, 0 ) );
+
+    // A 5x5 zone whose closest edge is 10 tiles away
+    mapgen_place_zone( where + tripoint_rel_ms( 10, -2, 0 ), where + tripoint_rel_ms( 14, 2, 0 ),
+                       zone_type_LOOT_FOOD );
+    CHECK_FALSE( zm.has_near( zone_type_LOOT_FOOD, where, 9 ) );
+    CHECK( zm.has_near( zone_type_LOOT_FOOD, where, 10 ) );
+    CHECK( zm.get_near( zone_type_LOOT_FOOD, where, 12 ).size() == 15 );
+    CHECK( zm.get_nearest( zone_type_LOOT_FOOD, where ) == where + tripoint_rel_ms( 10, 0, 0 ) );
+
+    // Adding a zone drops the results of earlier queries
+    mapgen_place_zone( where + tripoint_rel_ms( -11, 0, 0 ), where + tripoint_rel_ms( -11, 0, 0 ),
+                       zone_type_LOOT_FOOD );
+    CHECK( zm.get_near( zone_type_LOOT_FOOD, where, 12 ).size() == 16 );
+    CHECK( zm.get_nearest( zone_type_LOOT_FOOD, where ) == where + tripoint_rel_ms( 10, 0, 0 ) );
+
+    mapgen_place_zone( where + tripoint_rel_ms( 0, 5, 0 ), where + tripoint_rel_ms( 1, 5, 0 ),
+                       zone_type_LOOT_CUSTOM, your_fac, {}, "apple" );
+    const item apple( itype_test_apple );
+    const item almond( itype_test_bitter_almond );
+    CHECK( zm.get_near( zone_type_LOOT_CUSTOM, where, 10, &apple ).size() == 2 );
+    CHECK( zm.get_near( zone_type_LOOT_CUSTOM, where, 10, &almond ).empty() );
+    CHECK( zm.get_near( zone_type_LOOT_CUSTOM, where, 10 ).empty() );
+    zm.clear();
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "zone_sorting_benchmark", "[.][zones][benchmark]" )
+{
+    clear_map();
+    zone_manager &zm = zone_manager::get_manager();
+    zm.clear();
+    const tripoint_abs_ms where = get_map().getglobal( tripoint_bub_ms( 60, 60, 0 ) );
+
+    // 100 3x3 zones in a grid around the player
+    const std::vector<zone_type_id> types = {
+        zone_type_LOOT_FOOD, zone_type_LOOT_DRINK, zone_type_LOOT_PFOOD, zone_type_LOOT_PDRINK,
+        zone_type_LOOT_DEFAULT, zone_type_LOOT_CUSTOM
+    };
+    for( int i = 0; i < 100; i++ ) {
+        const tripoint_abs_ms corner = where + tripoint_rel_ms( -50 + i % 10 * 10,
+                                       -50 + i / 10 * 10, 0 );
+        const zone_type_id &type = types[i % types.size()];
+        mapgen_place_zone( corner, corner + tripoint_rel_ms( 2, 2, 0 ), type, your_fac, {},
+                           type == zone_type_LOOT_CUSTOM ? "hammer" : "" );
+    }
+
+    const std::vector<itype_id> itypes = {
+        itype_test_apple, itype_test_bitter_almond, itype_test_wine, itype_test_milk, itype_hammer
+    };
+    std::vector<item> items;
+    for( int i = 0; i < 5000; i++ ) {
+        items.emplace_back( itypes[i % itypes.size()] );
+    }
+
+    // What sorting loot looks up for every item on the unsorted pile
+    BENCHMARK( "find destinations of 5000 items" ) {
+        size_t destinations = 0;
+        for( const item &it : items ) {
+            const zone_type_id id = zm.get_near_zone_type_for_item( it, where, MAX_VIEW_DISTANCE );
+            destinations += zm.get_near( id, where, MAX_VIEW_DISTANCE, &it ).size();
+        }
+        return destinations;
+    };
+    zm.clear();
+}
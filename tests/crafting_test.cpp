@@ -19,6 +19,7 @@
 #include "character.h"
 #include "craft_command.h"
 #include "game.h"
+#include "game_constants.h"
 #include "inventory.h"
 #include "item.h"
 #include "itype.h"
@@ -2409,3 +2410,110 @@ TEST_CASE( "pseudo_tools_in_crafting_inventory", "[crafting][tools]" )
         clear_map();
     }
 }
+
+TEST_CASE( "crafting_inventory_follows_map_changes", "[crafting][inventory]" )
+{
+    clear_map();
+    clear_avatar();
+    map &here = get_map();
+    avatar &player = get_avatar();
+    player.setpos( tripoint_bub_ms( 60, 60, 0 ) );
+    const tripoint_bub_ms pile_pos( 61, 60, 0 );
+
+    here.add_item( pile_pos, item( itype_hammer ) );
+    REQUIRE( player.crafting_inventory().count_item( itype_hammer ) == 1 );
+
+    WHEN( "the character acts" ) {
+        player.mod_moves( -100 );
+        THEN( "items on the map are still found" ) {
+            CHECK( player.crafting_inventory().count_item( itype_hammer ) == 1 );
+        }
+    }
+    WHEN( "an item is added to the map" ) {
+        here.add_item( pile_pos, item( itype_hammer ) );
+        THEN( "it is found without invalidating the crafting inventory" ) {
+            CHECK( player.crafting_inventory().count_item( itype_hammer ) == 2 );
+        }
+    }
+    WHEN( "the items are removed from the map" ) {
+        here.i_clear( pile_pos );
+        THEN( "they are gone without invalidating the crafting inventory" ) {
+            CHECK( player.crafting_inventory().count_item( itype_hammer ) == 0 );
+        }
+    }
+    WHEN( "a turn passes and the crafting inventory is invalidated" ) {
+        calendar::turn += 1_turns;
+        player.invalidate_crafting_inventory();
+        THEN( "items on the map are still found" ) {
+            CHECK( player.crafting_inventory().count_item( itype_hammer ) == 1 );
+        }
+    }
+    WHEN( "the radius changes back and forth" ) {
+        REQUIRE( player.crafting_inventory( tripoint_bub_ms::zero, -1 )
+                 .count_item( itype_hammer ) == 0 );
+        THEN( "items on the map are found again" ) {
+            CHECK( player.crafting_inventory().count_item( itype_hammer ) == 1 );
+        }
+    }
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "crafting_inventory_large_base_benchmark", "[.][crafting][benchmark]" )
+{
+    clear_map();
+    clear_avatar();
+    map &here = get_map();
+    avatar &player = get_avatar();
+    player.setpos( tripoint_bub_ms( 60, 60, 0 ) );
+
+    // 50 piles of 20 items around the character, like the storage of a large base
+    const std::vector<itype_id> pile_types = {
+        itype_hammer, itype_thread, itype_sheet_cotton, itype_pockknife, itype_candle
+    };
+    int piles = 0;
+    for( const tripoint_bub_ms &p : here.points_in_radius( player.pos_bub(), PICKUP_RANGE ) ) {
+        if( p == player.pos_bub() ) {
+            continue;
+        }
+        for( int i = 0; i < 20; ++i ) {
+            here.add_item( p, item( pile_types[( piles + i ) % pile_types.size()] ) );
+        }
+        if( ++piles == 50 ) {
+            break;
+        }
+    }
+    REQUIRE( player.crafting_inventory().count_item( itype_hammer ) == 200 );
+
+    BENCHMARK( "crafting inventory after invalidation" ) {
+        player.invalidate_crafting_inventory();
+        return player.crafting_inventory().size();
+    };
+    BENCHMARK( "crafting inventory after the character acts" ) {
+        player.mod_moves( -1 );
+        return player.crafting_inventory().size();
+    };
+
+    // What the crafting menu does when it's opened: the availability of the recipes is
+    // checked against the crafting inventory, some turns after it was last built.
+    std::vector<const recipe *> recipes;
+    for( const std::pair<const recipe_id, recipe> &rec : recipe_dict ) {
+        if( !rec.second.is_blueprint() && !rec.second.is_nested() ) {
+            recipes.push_back( &rec.second );
+        }
+        if( recipes.size() == 200 ) {
+            break;
+        }
+    }
+    BENCHMARK( "opening the crafting menu a turn later" ) {
+        calendar::turn += 1_turns;
+        player.mod_moves( -100 );
+        int craftable = 0;
+        for( const recipe *r : recipes ) {
+            craftable += r->deduped_requirements().can_make_with_inventory(
+                             player.crafting_inventory(),
+                             r->get_component_filter( recipe_filter_flags::none ), 1,
+                             craft_flags::start_only );
+        }
+        return craftable;
+    };
+}
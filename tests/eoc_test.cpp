@@ -1,6 +1,11 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include "avatar.h"
 #include "calendar.h"
 #include "cata_catch.h"
+#include "character.h"
 #include "character_martial_arts.h"
 #include "coordinates.h"
 #include "effect_on_condition.h"
@@ -12,6 +17,7 @@
 #include "timed_event.h"
 #include "player_helpers.h"
 #include "point.h"
+#include "rng.h"
 
 static const activity_id ACT_ADD_VARIABLE_COMPLETE( "ACT_ADD_VARIABLE_COMPLETE" );
 static const activity_id ACT_ADD_VARIABLE_DURING( "ACT_ADD_VARIABLE_DURING" );
@@ -126,6 +132,7 @@ static const effect_on_condition_id effect_on_condition_EOC_teleport_test( "EOC_
 static const effect_on_condition_id
 effect_on_condition_EOC_test_weapon_damage( "EOC_test_weapon_damage" );
 static const effect_on_condition_id effect_on_condition_EOC_try_kill( "EOC_try_kill" );
+static const effect_on_condition_id effect_on_condition_PAINREC1_EOC( "PAINREC1_EOC" );
 static const effect_on_condition_id effect_on_condition_run_eocs_1( "run_eocs_1" );
 static const effect_on_condition_id effect_on_condition_run_eocs_2( "run_eocs_2" );
 static const effect_on_condition_id effect_on_condition_run_eocs_3( "run_eocs_3" );
@@ -1546,3 +1553,112 @@ TEST_CASE( "EOC_run_eocs", "[eoc]" )
     CHECK( effect_on_condition_run_eocs_talker_mixes_loc->activate( d2 ) );
     CHECK( globvars.get_global_value( "alpha_name" ) == zombie->get_name() );
 }
+
+static std::vector<int> take_all_due( queued_eocs &queue, const time_point &now )
+{
+    std::vector<int> taken;
+    std::vector<queued_eocs::storage_iter> due;
+    while( queue.take_due( now, due ) ) {
+        for( const queued_eocs::storage_iter &it : due ) {
+            taken.push_back( std::stoi( it->context.at( "i" ) ) );
+            queue.erase( it );
+        }
+    }
+    return taken;
+}
+
+TEST_CASE( "queued_eocs_activation_order", "[eoc]" )
+{
+    const time_point start = calendar::turn;
+    queued_eocs queue;
+    std::vector<std::pair<time_point, int>> expected;
+    // Spread over every level of the wheel and past it, with plenty of EOCs due at the same time
+    const std::vector<int> spans = { 1, 60, 4000, 300000, 20000000, 100000000 };
+    for( int i = 0; i < 3000; ++i ) {
+        const time_point when = start + time_duration::from_turns(
+                                    rng( -5, spans[i % spans.size()] ) );
+        queue.push( queued_eoc{ effect_on_condition_EOC_alive_test, when,
+                                { { "i", std::to_string( i ) } } } );
+        expected.emplace_back( when, i );
+    }
+    // By time, and EOCs due at the same time in the order they were queued.  That order is what
+    // the wheel guarantees, the priority queue it replaced didn't keep any for them.
+    std::sort( expected.begin(), expected.end() );
+
+    std::vector<int> taken;
+    time_point now = start;
+    for( const int step : {
+             0, 1, 1, 7, 63, 64, 65, 5000, 1, 262144, 3000000, 50000000, 60000000
+         } ) {
+        now += time_duration::from_turns( step );
+        const std::vector<int> due = take_all_due( queue, now );
+        taken.insert( taken.end(), due.begin(), due.end() );
+        // Everything due was taken and nothing else
+        for( const queued_eoc &eoc : queue.list ) {
+            CHECK( eoc.time > now );
+        }
+    }
+    REQUIRE( queue.empty() );
+    REQUIRE( taken.size() == expected.size() );
+    for( size_t i = 0; i < taken.size(); ++i ) {
+        CHECK( taken[i] == expected[i].second );
+    }
+}
+
+TEST_CASE( "queued_eocs_clock_set_back", "[eoc]" )
+{
+    const time_point start = calendar::turn;
+    queued_eocs queue;
+    queue.push( queued_eoc{ effect_on_condition_EOC_alive_test, start + 10_minutes,
+                            { { "i", "0" } } } );
+    queue.push( queued_eoc{ effect_on_condition_EOC_alive_test, start + 2_hours,
+                            { { "i", "1" } } } );
+    CHECK( take_all_due( queue, start + 1_hours ) == std::vector<int> { 0 } );
+    // The cursor of the wheel is past this now
+    queue.push( queued_eoc{ effect_on_condition_EOC_alive_test, start + 20_minutes,
+                            { { "i", "2" } } } );
+    CHECK( take_all_due( queue, start + 30_minutes ) == std::vector<int> { 2 } );
+    CHECK( take_all_due( queue, start + 3_hours ) == std::vector<int> { 1 } );
+    CHECK( queue.empty() );
+}
+
+TEST_CASE( "EOC_reactivation_conditions", "[eoc]" )
+{
+    const effect_on_condition &painrec = effect_on_condition_PAINREC1_EOC.obj();
+    REQUIRE( painrec.has_deactivate_condition );
+    CHECK( painrec.reactivated_by[eoc_reactivation::traits] );
+    CHECK_FALSE( painrec.reactivated_by[eoc_reactivation::bionics] );
+    CHECK_FALSE( painrec.reactivated_by[eoc_reactivation::weather] );
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "queued_eocs_many_recurring", "[.][eoc][benchmark]" )
+{
+    // Mods with many recurring EOCs, most of them checking every few minutes
+    queued_eocs queue;
+    std::vector<time_duration> recurrence;
+    for( int i = 0; i < 5000; ++i ) {
+        recurrence.push_back( time_duration::from_turns(
+                                  rng( 1, i % 10 == 0 ? 86400 : 600 ) ) );
+        queue.push( queued_eoc{ effect_on_condition_EOC_alive_test,
+                                calendar::turn + recurrence.back(),
+                                { { "i", std::to_string( i ) } } } );
+    }
+    time_point now = calendar::turn;
+    std::vector<queued_eocs::storage_iter> due;
+
+    BENCHMARK( "an hour of turns" ) {
+        int activations = 0;
+        for( int turn = 0; turn < 3600; ++turn ) {
+            now += 1_turns;
+            while( queue.take_due( now, due ) ) {
+                for( const queued_eocs::storage_iter &it : due ) {
+                    it->time = now + recurrence[std::stoi( it->context.at( "i" ) )];
+                    queue.reschedule( it );
+                    ++activations;
+                }
+            }
+        }
+        return activations;
+    };
+}
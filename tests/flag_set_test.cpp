@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "avatar.h"
+#include "cata_catch.h"
+#include "cata_utility.h"
+#include "coordinates.h"
+#include "flag.h"
+#include "flag_set.h"
+#include "item.h"
+#include "item_factory.h"
+#include "itype.h"
+#include "json.h"
+#include "json_loader.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "player_helpers.h"
+#include "type_id.h"
+
+static const flag_id json_flag_COLD( "COLD" );
+static const flag_id json_flag_FILTHY( "FILTHY" );
+static const flag_id json_flag_HOT( "HOT" );
+static const flag_id json_flag_WET( "WET" );
+
+static const itype_id itype_hammer( "hammer" );
+static const itype_id itype_rock( "rock" );
+
+TEST_CASE( "flag_set_behaves_like_a_set", "[flag][item]" )
+{
+    flag_set flags;
+    CHECK( flags.empty() );
+    CHECK( flags.begin() == flags.end() );
+
+    CHECK( flags.insert( json_flag_WET ) );
+    CHECK_FALSE( flags.insert( json_flag_WET ) );
+    CHECK( flags.insert( json_flag_COLD ) );
+    CHECK( flags.count( json_flag_WET ) == 1 );
+    CHECK( flags.count( json_flag_HOT ) == 0 );
+    CHECK( flags.size() == 2 );
+
+    SECTION( "invalid flags are not stored" ) {
+        CHECK_FALSE( flags.insert( flag_NULL ) );
+        CHECK( flags.count( flag_NULL ) == 0 );
+        CHECK( flags.size() == 2 );
+    }
+
+    SECTION( "iteration visits every flag once" ) {
+        std::vector<flag_id> seen( flags.begin(), flags.end() );
+        std::sort( seen.begin(), seen.end() );
+        std::vector<flag_id> expected = { json_flag_COLD, json_flag_WET };
+        std::sort( expected.begin(), expected.end() );
+        CHECK( seen == expected );
+    }
+
+    SECTION( "erasing the last flag leaves an empty set equal to a new one" ) {
+        CHECK( flags.erase( json_flag_HOT ) == 0 );
+        CHECK( flags.erase( json_flag_WET ) == 1 );
+        CHECK( flags.erase( json_flag_COLD ) == 1 );
+        CHECK( flags.empty() );
+        CHECK( flags == flag_set() );
+    }
+
+    SECTION( "erase_if removes the matching flags" ) {
+        flags.insert( json_flag_HOT );
+        CHECK( erase_if( flags, []( const flag_id & f ) {
+            return f != json_flag_COLD;
+        } ) );
+        CHECK( flags == flag_set{ json_flag_COLD } );
+        CHECK( erase_if( flags, []( const flag_id & ) {
+            return true;
+        } ) );
+        CHECK( flags == flag_set() );
+    }
+
+    SECTION( "equality ignoring some flags" ) {
+        flag_set other = { json_flag_WET, json_flag_HOT };
+        CHECK( flags != other );
+        CHECK( flags.equal_ignoring( other, { json_flag_COLD, json_flag_HOT } ) );
+        CHECK_FALSE( flags.equal_ignoring( other, { json_flag_COLD } ) );
+        CHECK_FALSE( flags.equal_ignoring( flag_set(), { json_flag_COLD } ) );
+    }
+
+    SECTION( "json round trip" ) {
+        std::ostringstream os;
+        JsonOut jsout( os );
+        jsout.write( flags );
+        flag_set loaded;
+        json_loader::from_string( os.str() ).read( loaded );
+        CHECK( loaded == flags );
+    }
+}
+
+TEST_CASE( "item_flags_are_kept_in_flag_set", "[flag][item]" )
+{
+    item rock( itype_rock );
+    CHECK( rock.get_flags().empty() );
+    CHECK_FALSE( rock.has_flag( json_flag_FILTHY ) );
+
+    rock.set_flag( json_flag_FILTHY );
+    CHECK( rock.has_own_flag( json_flag_FILTHY ) );
+    CHECK( rock.has_flag( json_flag_FILTHY ) );
+
+    item other( itype_rock );
+    other.set_flag( json_flag_FILTHY );
+    CHECK( rock.stacks_with( other ) );
+
+    rock.unset_flag( json_flag_FILTHY );
+    CHECK_FALSE( rock.has_flag( json_flag_FILTHY ) );
+    CHECK( rock.get_flags() == flag_set() );
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "item_has_flag_benchmark", "[.][flag][item][benchmark]" )
+{
+    std::vector<item> items;
+    for( const itype *type : item_controller->all() ) {
+        items.emplace_back( type );
+    }
+    std::vector<flag_id> flags;
+    for( const json_flag &f : json_flag::get_all() ) {
+        flags.push_back( f.id );
+    }
+
+    BENCHMARK( "has_flag for every item and flag" ) {
+        int found = 0;
+        for( const item &it : items ) {
+            for( const flag_id &f : flags ) {
+                found += it.has_flag( f );
+            }
+        }
+        return found;
+    };
+
+    clear_map();
+    clear_avatar();
+    Character &you = get_player_character();
+    map &here = get_map();
+    const tripoint_bub_ms pos = you.pos_bub();
+    for( int i = 0; i < 200; ++i ) {
+        here.add_item( pos + tripoint::east, item( i % 2 ? itype_rock : itype_hammer ) );
+    }
+
+    BENCHMARK( "crafting_inventory" ) {
+        you.invalidate_crafting_inventory();
+        return you.crafting_inventory().size();
+    };
+}
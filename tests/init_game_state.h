@@ -0,0 +1,20 @@
+#pragma once
+#ifndef CATA_TESTS_INIT_GAME_STATE_H
+#define CATA_TESTS_INIT_GAME_STATE_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "type_id.h"
+
+using name_value_pair_t = std::pair<std::string, std::string>;
+using option_overrides_t = std::vector<name_value_pair_t>;
+
+// Loads the game data of @p mods and creates a new world using them in @p user_dir, with the
+// avatar standing at the origin of a freshly generated map.  Used by cata_test and cata_bench.
+void init_global_game_state( const std::vector<mod_id> &mods,
+                             option_overrides_t &option_overrides,
+                             const std::string &user_dir );
+
+#endif // CATA_TESTS_INIT_GAME_STATE_H
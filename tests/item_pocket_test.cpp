@@ -28,6 +28,7 @@
 #include "mapgen_helpers.h"
 #include "player_helpers.h"
 #include "ret_val.h"
+#include "rng.h"
 #include "test_data.h"
 #include "type_id.h"
 #include "units.h"
@@ -53,6 +54,8 @@ static const item_group_id
 Item_spawn_data_wallet_science_stylish_full( "wallet_science_stylish_full" );
 static const item_group_id Item_spawn_data_wallet_stylish_full( "wallet_stylish_full" );
 
+static const itype_id itype_rock( "rock" );
+static const itype_id itype_test_9mm_ammo( "test_9mm_ammo" );
 static const itype_id itype_test_backpack( "test_backpack" );
 static const itype_id itype_test_jug_plastic( "test_jug_plastic" );
 static const itype_id itype_test_socks( "test_socks" );
@@ -2928,3 +2931,125 @@ TEST_CASE( "unload_from_spillable_container", "[item][pocket]" )
         }
     }
 }
+
+// Weight and volume of an item with every pocket total recomputed from scratch
+static std::pair<units::mass, units::volume> uncached_totals( const item &it )
+{
+    item_pocket::invalidate_contents_totals();
+    return { it.weight(), it.volume() };
+}
+
+static item_pocket *random_container_pocket( item &top )
+{
+    std::vector<item_pocket *> pockets;
+    for( item_pocket *pocket : top.get_all_contained_pockets() ) {
+        if( pocket->is_type( pocket_type::CONTAINER ) ) {
+            pockets.push_back( pocket );
+        }
+    }
+    for( item *it : top.all_items_ptr( pocket_type::CONTAINER ) ) {
+        for( item_pocket *pocket : it->get_all_contained_pockets() ) {
+            if( pocket->is_type( pocket_type::CONTAINER ) ) {
+                pockets.push_back( pocket );
+            }
+        }
+    }
+    return random_entry( pockets );
+}
+
+TEST_CASE( "cached_pocket_totals_match_recomputed_totals", "[pocket][item]" )
+{
+    rng_set_engine_seed( 4242 );
+    item backpack( itype_test_backpack );
+    const std::vector<itype_id> candidates = { itype_rock, itype_test_socks, itype_test_backpack };
+
+    for( int step = 0; step < 200; ++step ) {
+        CAPTURE( step );
+        // fill the caches so a mutation that fails to invalidate them is noticed
+        backpack.weight();
+        backpack.volume();
+
+        item_pocket *pocket = random_container_pocket( backpack );
+        REQUIRE( pocket != nullptr );
+        const int op = rng( 0, 3 );
+        CAPTURE( op );
+        if( op == 0 ) {
+            pocket->insert_item( item( random_entry( candidates ) ) );
+        } else if( op == 1 ) {
+            pocket->add( item( random_entry( candidates ) ) );
+        } else if( op == 2 ) {
+            bool removed = false;
+            pocket->remove_items_if( [&removed]( const item & ) {
+                return !std::exchange( removed, true );
+            } );
+        } else if( !pocket->empty() ) {
+            pocket->edit_contents().pop_back();
+        }
+
+        const units::mass cached_weight = backpack.weight();
+        const units::volume cached_volume = backpack.volume();
+        const std::pair<units::mass, units::volume> fresh = uncached_totals( backpack );
+        CHECK( cached_weight == fresh.first );
+        CHECK( cached_volume == fresh.second );
+    }
+}
+
+TEST_CASE( "pocket_totals_follow_charges_of_contained_items", "[pocket][item]" )
+{
+    item backpack( itype_test_backpack );
+    item inner( itype_test_backpack );
+    inner.get_all_contained_pockets().front()->add( item( itype_test_9mm_ammo ) );
+    backpack.get_all_contained_pockets().front()->add( inner );
+    std::vector<item *> ammo = backpack.items_with( []( const item & it ) {
+        return it.typeId() == itype_test_9mm_ammo;
+    } );
+    REQUIRE( ammo.size() == 1 );
+    REQUIRE( ammo.front()->charges == 50 );
+
+    // fill the caches first
+    const units::mass full_weight = backpack.weight();
+    const units::volume full_volume = backpack.volume();
+    // written directly, without any mutator to invalidate the totals
+    ammo.front()->charges = 10;
+    const units::mass cached_weight = backpack.weight();
+    const units::volume cached_volume = backpack.volume();
+    CHECK( cached_weight < full_weight );
+    CHECK( cached_volume < full_volume );
+    const std::pair<units::mass, units::volume> fresh = uncached_totals( backpack );
+    CHECK( cached_weight == fresh.first );
+    CHECK( cached_volume == fresh.second );
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "nested_container_weight_benchmark", "[.][pocket][item][benchmark]" )
+{
+    clear_avatar();
+    Character &you = get_player_character();
+    // backpack > 10 backpacks > 10 backpacks > 20 rocks, 2000 rocks in total
+    item outer( itype_test_backpack );
+    item_pocket *outer_pocket = outer.get_all_contained_pockets().front();
+    for( int i = 0; i < 10; ++i ) {
+        item middle( itype_test_backpack );
+        item_pocket *middle_pocket = middle.get_all_contained_pockets().front();
+        for( int j = 0; j < 10; ++j ) {
+            item inner( itype_test_backpack );
+            item_pocket *inner_pocket = inner.get_all_contained_pockets().front();
+            for( int k = 0; k < 20; ++k ) {
+                inner_pocket->add( item( itype_rock ) );
+            }
+            middle_pocket->add( inner );
+        }
+        outer_pocket->add( middle );
+    }
+    REQUIRE( you.wear_item( outer, false ) );
+
+    BENCHMARK( "weight and volume carried" ) {
+        return you.weight_carried_with_tweaks( Character::item_tweaks() ).value() +
+               you.volume_carried().value();
+    };
+    BENCHMARK( "weight and volume carried after a change" ) {
+        item_pocket::invalidate_contents_totals();
+        return you.weight_carried_with_tweaks( Character::item_tweaks() ).value() +
+               you.volume_carried().value();
+    };
+}
@@ -1,11 +1,24 @@
+#include <optional>
+
 #include "cata_catch.h"
 #include "coordinates.h"
 #include "coords_fwd.h"
 #include "game.h"
 #include "map.h"
 #include "map_helpers.h"
+#include "mapdata.h"
+#include "pathfinding.h"
 #include "type_id.h"
 
+static const furn_str_id furn_f_bookcase( "f_bookcase" );
+static const furn_str_id furn_f_table( "f_table" );
+
+static const ter_str_id ter_t_door_c( "t_door_c" );
+static const ter_str_id ter_t_floor( "t_floor" );
+static const ter_str_id ter_t_stairs_up( "t_stairs_up" );
+static const ter_str_id ter_t_wall_wood( "t_wall_wood" );
+static const ter_str_id ter_t_water_sh( "t_water_sh" );
+
 static void place_obstacle( map &m, const std::vector<tripoint_bub_ms> &places )
 {
     const ter_id t_wall_metal( "t_wall_metal" );
@@ -241,3 +254,111 @@ TEST_CASE( "find_clear_path_5tiles_with_obstacles", "[map]" )
     clear_map();
 }
 
+
+TEST_CASE( "pathfinding_base_matches_map_move_cost", "[map][pathfinding]" )
+{
+    map &here = get_map();
+    clear_map();
+    const tripoint_bub_ms p( 10, 10, 0 );
+    const auto check_tile = [&here, &p]() {
+        CAPTURE( here.ter( p ).id().str(), here.furn( p ).id().str() );
+        const pathfinding_base base = pathfinding_base::of( here.ter( p ), here.furn( p ) );
+        CHECK( base.movecost == here.move_cost( p ) );
+    };
+    for( int i = 0; i < static_cast<int>( ter_t::count() ); i++ ) {
+        here.furn_set( p, furn_str_id::NULL_ID() );
+        here.ter_set( p, ter_id( i ) );
+        check_tile();
+    }
+    // Bridges replace the move cost of the water under them
+    for( const ter_str_id &ter : { ter_t_floor, ter_t_water_sh } ) {
+        for( int i = 0; i < static_cast<int>( furn_t::count() ); i++ ) {
+            here.ter_set( p, ter );
+            here.furn_set( p, furn_id( i ) );
+            check_tile();
+        }
+    }
+    clear_map();
+}
+
+TEST_CASE( "pathfinding_flags_of_terrain_and_furniture", "[map][pathfinding]" )
+{
+    map &here = get_map();
+    clear_map();
+    const tripoint_bub_ms p( 10, 10, 0 );
+    const auto flags_with = [&here, &p]( const ter_str_id & ter, const furn_str_id & furn ) {
+        here.ter_set( p, ter );
+        here.furn_set( p, furn );
+        const std::optional<PathfindingFlags> flags = here.pathfinding_flags( p );
+        REQUIRE( flags );
+        return *flags;
+    };
+
+    const PathfindingFlags floor = flags_with( ter_t_floor, furn_str_id::NULL_ID() );
+    CHECK( floor.is_set( PathfindingFlag::Ground ) );
+    CHECK_FALSE( floor.is_set( PathfindingFlag::Slow ) );
+    CHECK_FALSE( floor.is_set( PathfindingFlag::Obstacle ) );
+
+    const PathfindingFlags table = flags_with( ter_t_floor, furn_f_table );
+    CHECK( table.is_set( PathfindingFlag::Slow ) );
+    CHECK_FALSE( table.is_set( PathfindingFlag::Obstacle ) );
+
+    const PathfindingFlags wall = flags_with( ter_t_wall_wood, furn_str_id::NULL_ID() );
+    CHECK( wall.is_set( PathfindingFlag::Obstacle ) );
+    CHECK( wall.is_set( PathfindingFlag::ShotObstacle ) );
+
+    const PathfindingFlags stairs = flags_with( ter_t_stairs_up, furn_str_id::NULL_ID() );
+    CHECK( stairs.is_set( PathfindingFlag::GoesUp ) );
+    CHECK_FALSE( stairs.is_set( PathfindingFlag::GoesDown ) );
+    clear_map();
+}
+
+static constexpr int city_houses = 12;
+static constexpr int city_house_size = 10;
+
+// Rows of furnished wooden houses with a door on each side across most of the map
+static void build_city()
+{
+    clear_map_and_put_player_underground();
+    map &here = get_map();
+    for( int house_x = 0; house_x < city_houses; ++house_x ) {
+        for( int house_y = 0; house_y < city_houses; ++house_y ) {
+            const tripoint_bub_ms corner( 2 + house_x * city_house_size,
+                                          2 + house_y * city_house_size, 0 );
+            for( int dx = 0; dx < city_house_size; ++dx ) {
+                for( int dy = 0; dy < city_house_size; ++dy ) {
+                    const tripoint_bub_ms p = corner + point_rel_ms( dx, dy );
+                    const bool wall = dx == 0 || dy == 0;
+                    const bool door = ( dx == 0 && dy == city_house_size / 2 ) ||
+                                      ( dy == 0 && dx == city_house_size / 2 );
+                    here.ter_set( p, door ? ter_t_door_c : wall ? ter_t_wall_wood : ter_t_floor );
+                    if( !wall && ( dx + dy ) % 3 == 0 ) {
+                        here.furn_set( p, dx % 2 == 0 ? furn_f_bookcase : furn_f_table );
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "route_through_city_benchmark", "[.][map][pathfinding][benchmark]" )
+{
+    build_city();
+    map &here = get_map();
+    const tripoint_bub_ms from( 1, 1, 0 );
+    const tripoint_bub_ms to( city_houses * city_house_size - 3, city_houses * city_house_size - 3,
+                              0 );
+    const pathfinding_settings settings( 0, 1000, 1000, 0, true, false, true, true, false, false );
+    REQUIRE_FALSE( here.route( from, to, settings ).empty() );
+
+    BENCHMARK( "route across the city" ) {
+        return here.route( from, to, settings ).size();
+    };
+    BENCHMARK( "rebuild the pathfinding cache" ) {
+        // What a map shift leaves behind
+        here.set_pathfinding_cache_dirty( 0 );
+        here.update_pathfinding_cache( 0 );
+        return here.pathfinding_flags( from ).has_value();
+    };
+}
@@ -10,11 +10,25 @@
 #include "itype.h"
 #include "game.h"
 #include "game_constants.h"
+#include "level_cache.h"
 #include "map_helpers.h"
 #include "point.h"
+#include "rng.h"
 #include "submap.h"
 #include "type_id.h"
 
+static const furn_str_id furn_f_bookcase( "f_bookcase" );
+static const furn_str_id furn_f_table( "f_table" );
+
+static const ter_str_id ter_t_door_c( "t_door_c" );
+static const ter_str_id ter_t_door_o( "t_door_o" );
+static const ter_str_id ter_t_floor( "t_floor" );
+static const ter_str_id ter_t_grass( "t_grass" );
+static const ter_str_id ter_t_open_air( "t_open_air" );
+static const ter_str_id ter_t_stairs_down( "t_stairs_down" );
+static const ter_str_id ter_t_wall_wood( "t_wall_wood" );
+static const ter_str_id ter_t_window( "t_window" );
+
 TEST_CASE( "map_coordinate_conversion_functions" )
 {
     map &here = get_map();
@@ -302,3 +316,96 @@ TEST_CASE( "active_monster_drops", "[active_item][map]" )
     }
     CHECK( dropped_bag.empty() );
 }
+
+struct built_caches {
+    cata::mdarray<bool, point_bub_ms> outside;
+    cata::mdarray<bool, point_bub_ms> floor;
+    cata::mdarray<float, point_bub_ms> transparency;
+    bool no_floor_gaps;
+};
+
+static built_caches caches_at( int zlev )
+{
+    const level_cache &cache = get_map().get_cache_ref( zlev );
+    return { cache.outside_cache, cache.floor_cache, cache.transparency_cache,
+             cache.no_floor_gaps };
+}
+
+static void check_caches_match( const built_caches &incremental, const built_caches &full )
+{
+    CHECK( incremental.no_floor_gaps == full.no_floor_gaps );
+    int mismatches = 0;
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            if( incremental.outside[x][y] != full.outside[x][y] ||
+                incremental.floor[x][y] != full.floor[x][y] ||
+                incremental.transparency[x][y] != full.transparency[x][y] ) {
+                mismatches++;
+            }
+        }
+    }
+    CHECK( mismatches == 0 );
+}
+
+TEST_CASE( "incremental_map_caches_match_a_full_rebuild", "[map][lightmap]" )
+{
+    clear_map_and_put_player_underground();
+    map &here = get_map();
+    here.build_map_cache( 0, true );
+    const std::vector<ter_str_id> terrains = {
+        ter_t_door_c, ter_t_door_o, ter_t_floor, ter_t_grass, ter_t_open_air, ter_t_stairs_down,
+        ter_t_wall_wood, ter_t_window
+    };
+    const std::vector<furn_str_id> furniture = {
+        furn_str_id::NULL_ID(), furn_f_bookcase, furn_f_table
+    };
+
+    rng_set_engine_seed( 4321 );
+    for( int round = 0; round < 10; round++ ) {
+        CAPTURE( round );
+        for( int edit = 0; edit < 20; edit++ ) {
+            const tripoint_bub_ms p( rng( 0, MAPSIZE_X - 1 ), rng( 0, MAPSIZE_Y - 1 ),
+                                     rng( 0, 1 ) );
+            const ter_str_id ter = random_entry( terrains );
+            here.furn_set( p, furn_str_id::NULL_ID() );
+            here.ter_set( p, ter );
+            if( ter != ter_t_open_air ) {
+                here.furn_set( p, random_entry( furniture ) );
+            }
+        }
+        here.build_map_cache( 0, true );
+        const built_caches ground = caches_at( 0 );
+        const built_caches upstairs = caches_at( 1 );
+
+        here.invalidate_map_cache( 0 );
+        here.invalidate_map_cache( 1 );
+        here.build_map_cache( 0, true );
+        check_caches_match( ground, caches_at( 0 ) );
+        check_caches_match( upstairs, caches_at( 1 ) );
+    }
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "open_a_door_benchmark", "[.][map][lightmap][benchmark]" )
+{
+    clear_map_and_put_player_underground();
+    map &here = get_map();
+    // A room in every submap
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            const bool wall = x % SEEX == 0 || y % SEEY == 0;
+            here.ter_set( tripoint_bub_ms( x, y, 0 ), wall ? ter_t_wall_wood : ter_t_floor );
+        }
+    }
+    // In the wall between two of the rooms
+    const tripoint_bub_ms door( 5 * SEEX + SEEX / 2, 5 * SEEY, 0 );
+    here.build_map_cache( 0, true );
+
+    bool open = false;
+    BENCHMARK( "open or close a door, then build the map cache" ) {
+        open = !open;
+        here.ter_set( door, open ? ter_t_door_o : ter_t_door_c );
+        here.build_map_cache( 0, true );
+        return here.get_cache_ref( 0 ).transparency_cache[door.x()][door.y()];
+    };
+}
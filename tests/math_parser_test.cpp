@@ -2,10 +2,18 @@
 
 #include <cmath>
 #include <locale>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "avatar.h"
+#include "coordinates.h"
 #include "dialogue.h"
+#include "dialogue_vars.h"
 #include "global_vars.h"
+#include "json.h"
+#include "json_loader.h"
 #include "math_parser.h"
 #include "math_parser_func.h"
 #include "npc.h"
@@ -378,3 +386,191 @@ TEST_CASE( "math_parser_dialogue_integration", "[math_parser]" )
     testexp.eval( d );
     CHECK( get_avatar().get_stamina() == 459 );
 }
+
+TEST_CASE( "dialogue_variables_keep_their_type", "[math_parser]" )
+{
+    standard_npc dude;
+    dialogue d( get_talker_for( get_avatar() ), get_talker_for( &dude ) );
+    math_exp testexp;
+    global_variables &globvars = get_globals();
+    globvars.clear_global_values();
+    get_avatar().clear_values();
+
+    // numbers written by math are stored as numbers, and formatted like before when read as strings
+    CHECK( testexp.parse( "u_typed = 1.5" ) );
+    testexp.eval( d );
+    const var_value *u_typed = get_avatar().find_value( var_key( "typed" ) );
+    REQUIRE( u_typed != nullptr );
+    CHECK( u_typed->is_dbl() );
+    CHECK( get_avatar().get_value( "typed" ) == "1.5" );
+    CHECK( testexp.parse( "typed = 1 / 3" ) );
+    testexp.eval( d );
+    CHECK( globvars.get_global_value( "typed" ) == "0.333333" );
+    CHECK( testexp.parse( "typed * 3" ) );
+    // not 0.999999 like it would be with the value parsed back from "%g"
+    CHECK( testexp.eval( d ) == 1.0 );
+
+    // strings stay as they were written
+    globvars.set_global_value( "text", "1.50" );
+    const var_value *text = globvars.find_global_value( var_key( "text" ) );
+    REQUIRE( text != nullptr );
+    CHECK( text->is_str() );
+    CHECK( text->str() == "1.50" );
+    CHECK( text->dbl() == 1.5 );
+    CHECK( testexp.parse( "text + 1" ) );
+    CHECK( testexp.eval( d ) == Approx( 2.5 ) );
+
+    // points
+    const tripoint_abs_ms p( 10, -20, 1 );
+    var_value point( p );
+    CHECK( point.is_tripoint() );
+    CHECK( point.str() == p.to_string() );
+    CHECK( point.tripoint_abs() == p );
+    CHECK( var_value( p.to_string() ).tripoint_abs() == p );
+
+    // saves keep the string format
+    var_store store;
+    store.set( var_key( "dbl" ), var_value( 2.25 ) );
+    store.set( var_key( "str" ), var_value( "hello" ) );
+    store.set( var_key( "point" ), var_value( p ) );
+    const std::unordered_map<std::string, std::string> strings = store.to_strings();
+    CHECK( strings.at( "dbl" ) == "2.25" );
+    CHECK( strings.at( "str" ) == "hello" );
+    CHECK( strings.at( "point" ) == p.to_string() );
+    var_store loaded;
+    loaded.from_strings( strings );
+    CHECK( loaded.to_strings() == strings );
+    REQUIRE( loaded.find( var_key( "dbl" ) ) != nullptr );
+    CHECK( loaded.find( var_key( "dbl" ) )->dbl() == 2.25 );
+
+    // numbers that "%g" would round keep all their digits through a save and load
+    var_store exact;
+    exact.set( var_key( "turn" ), var_value( 52594937.0 ) );
+    exact.set( var_key( "third" ), var_value( 1.0 / 3.0 ) );
+    exact.set( var_key( "dbl" ), var_value( 2.25 ) );
+    std::ostringstream saved;
+    JsonOut jsout( saved );
+    exact.serialize( jsout );
+    std::unordered_map<std::string, std::string> read_strings;
+    json_loader::from_string( saved.str() ).read( read_strings );
+    CHECK( read_strings.at( "dbl" ) == "2.25" );
+    var_store reloaded;
+    reloaded.from_strings( read_strings );
+    for( const char *name : {
+             "turn", "third", "dbl"
+         } ) {
+        CAPTURE( name );
+        REQUIRE( reloaded.find( var_key( name ) ) != nullptr );
+        CHECK( reloaded.find( var_key( name ) )->dbl() == exact.find( var_key( name ) )->dbl() );
+    }
+
+    CHECK( var_key( "point" ) == var_key( std::string( "point" ) ) );
+    CHECK( var_key( "point" ).str() == "point" );
+    CHECK( var_key().empty() );
+
+    globvars.clear_global_values();
+    get_avatar().clear_values();
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "math_parser_recurring_eoc_variables", "[.][math_parser][benchmark]" )
+{
+    standard_npc dude;
+    dialogue d( get_talker_for( get_avatar() ), get_talker_for( &dude ) );
+    get_globals().clear_global_values();
+    get_avatar().clear_values();
+
+    // The kind of bookkeeping recurring EOCs of mods do every turn
+    const std::vector<std::string> sources = {
+        "u_turns_awake += 1",
+        "u_hunger_debt = max( u_hunger_debt - 0.25, 0 )",
+        "u_mana_regen = clamp( u_mana_regen + u_turns_awake / 3600, 0, 10 )",
+        "n_mood = clamp( n_mood + ( u_hunger_debt > 5 ? -1 : 0.5 ), -100, 100 )",
+        "world_timer = world_timer + 1",
+        "world_threat = ( world_timer % 600 == 0 ) ? world_threat + 1 : world_threat",
+        "u_effect_stacks = min( u_effect_stacks + ( world_threat > 3 ? 1 : 0 ), 5 )",
+        "n_last_seen = world_timer",
+    };
+    std::vector<math_exp> exps( sources.size() );
+    for( size_t i = 0; i < sources.size(); ++i ) {
+        REQUIRE( exps[i].parse( sources[i] ) );
+    }
+
+    // 96 evaluations, about what a few mods add up to per turn
+    BENCHMARK( "recurring EOC set" ) {
+        for( int i = 0; i < 12; ++i ) {
+            for( const math_exp &exp : exps ) {
+                exp.eval( d );
+            }
+        }
+        return get_globals().find_global_value( var_key( "world_timer" ) ) != nullptr;
+    };
+    get_globals().clear_global_values();
+    get_avatar().clear_values();
+}
+
+TEST_CASE( "math_parser_compiled_expressions", "[math_parser]" )
+{
+    dialogue d( get_talker_for( get_avatar() ), std::make_unique<talker>() );
+    get_avatar().clear_values();
+    get_avatar().set_value( var_key( "x" ), var_value( 3.0 ) );
+    math_exp testexp;
+
+    // constant subexpressions are folded, the rest is evaluated every time
+    CHECK( testexp.parse( "2 * 3 + u_x * ( 4 - 1 ) + max( 1, 2, u_x )" ) );
+    CHECK( testexp.eval( d ) == Approx( 18 ) );
+    CHECK( testexp.parse( "1 > 0 ? u_x : 1 / 0" ) );
+    CHECK( testexp.eval( d ) == Approx( 3 ) );
+    CHECK( testexp.parse( "u_x > 2 ? u_x > 5 ? 1 : 2 : 3" ) );
+    CHECK( testexp.eval( d ) == Approx( 2 ) );
+    CHECK( testexp.parse( "u_x < 2 ? 1 : u_x < 5 ? 2 : 3" ) );
+    CHECK( testexp.eval( d ) == Approx( 2 ) );
+
+    // deeper than the stack kept inline
+    std::string deep = "u_x";
+    for( int i = 0; i < 40; ++i ) {
+        deep = "1 + ( u_x * " + deep + " )";
+    }
+    CHECK( testexp.parse( deep ) );
+    CHECK( std::isfinite( testexp.eval( d ) ) );
+    CHECK( testexp.eval( d ) > 1e19 );
+
+    // jmath arguments are passed without a round trip through strings
+    CHECK( testexp.parse( "jmath_test_blorg( 2, 1.234567891 )" ) );
+    CHECK( testexp.eval( d ) == Approx( 2 + 3 * 1.234567891 ).epsilon( 1e-12 ) );
+    CHECK( testexp.parse( "alpha_stat_bonus( u_x + 5 )" ) );
+    CHECK( testexp.eval( d ) == Approx( 6 ) );
+    CHECK( testexp.parse( "addiction_rational( 10, 2, u_x )" ) );
+    CHECK( testexp.eval( d ) == Approx( 1.5 ) );
+
+    get_avatar().clear_values();
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "math_parser_jmath_functions", "[.][math_parser][benchmark]" )
+{
+    dialogue d( get_talker_for( get_avatar() ), std::make_unique<talker>() );
+    get_avatar().clear_values();
+    get_avatar().set_value( var_key( "stat" ), var_value( 8.0 ) );
+
+    // jmath functions of the core data, as mutations, addictions and weather use them
+    const std::vector<std::string> sources = {
+        "alpha_stat_bonus( u_stat )",
+        "addiction_rational( 100, 2, u_stat )",
+        "temperature_speed_mod( 65, 0.2 )",
+        "dew_point_factor( 20 )",
+    };
+    std::vector<math_exp> exps( sources.size() );
+    for( size_t i = 0; i < sources.size(); ++i ) {
+        REQUIRE( exps[i].parse( sources[i] ) );
+    }
+
+    BENCHMARK( "core jmath functions" ) {
+        double sum = 0;
+        for( const math_exp &exp : exps ) {
+            sum += exp.eval( d );
+        }
+        return sum;
+    };
+    get_avatar().clear_values();
+}
@@ -1,3 +1,4 @@
+#include <map>
 #include <string>
 #include <vector>
 
@@ -12,9 +13,13 @@
 #include "mtype.h"
 #include "options.h"
 #include "options_helpers.h"
+#include "overmap.h"
+#include "overmapbuffer.h"
 #include "player_helpers.h"
+#include "rng.h"
 
 static const mongroup_id GROUP_PETS( "GROUP_PETS" );
+static const mongroup_id GROUP_ZOMBIE( "GROUP_ZOMBIE" );
 static const mongroup_id GROUP_PET_DOGS( "GROUP_PET_DOGS" );
 
 static const mtype_id mon_null( "mon_null" );
@@ -26,6 +31,11 @@ static const mtype_id mon_test_speed_desc_base( "mon_test_speed_desc_base" );
 static const mtype_id mon_test_speed_desc_base_immobile( "mon_test_speed_desc_base_immobile" );
 static const mtype_id mon_test_zombie_cop( "mon_test_zombie_cop" );
 
+static const oter_str_id oter_forest( "forest" );
+static const oter_str_id oter_forest_thick( "forest_thick" );
+static const oter_str_id oter_forest_water( "forest_water" );
+static const oter_str_id oter_river_center( "river_center" );
+
 static const int max_iters = 10000;
 
 static void spawn_x_monsters( int x, const mongroup_id &grp, const std::vector<mtype_id> &yesspawn,
@@ -415,3 +425,148 @@ TEST_CASE( "mongroup_multi_spawn_restrictions", "[mongroup]" )
         CHECK( counts.count( mon_test_zombie_cop ) > 0 );
     }
 }
+
+using horde_map = std::multimap<tripoint_om_sm, mongroup>;
+
+// Horde movement as overmap::move_hordes did it before moving hordes in batches.
+static void move_hordes_reference( const overmap &om, horde_map &zg )
+{
+    horde_map tmpzg;
+    for( auto it = zg.begin(); it != zg.end(); ) {
+        mongroup &mg = it->second;
+        if( !mg.horde || mg.behaviour == mongroup::horde_behaviour::nemesis ) {
+            ++it;
+            continue;
+        }
+        if( mg.behaviour == mongroup::horde_behaviour::none ) {
+            mg.behaviour =
+                one_in( 2 ) ? mongroup::horde_behaviour::city : mongroup::horde_behaviour::roam;
+        }
+        mg.dec_interest( 1 );
+        if( ( mg.abs_pos.xy() == mg.target ) || mg.interest <= 15 ) {
+            mg.wander( om );
+        }
+        const oter_id &walked_into = om.ter( project_to<coords::omt>( mg.rel_pos() ) );
+        int movement_chance = 1;
+        if( walked_into == oter_forest || walked_into == oter_forest_water ) {
+            movement_chance = 3;
+        } else if( walked_into == oter_forest_thick ) {
+            movement_chance = 6;
+        } else if( walked_into == oter_river_center ) {
+            movement_chance = 10;
+        }
+        if( one_in( movement_chance ) && rng( 0, 100 ) < mg.interest && rng( 0, 200 ) < mg.avg_speed() ) {
+            if( mg.abs_pos.x() > mg.target.x() ) {
+                mg.abs_pos.x()--;
+            }
+            if( mg.abs_pos.x() < mg.target.x() ) {
+                mg.abs_pos.x()++;
+            }
+            if( mg.abs_pos.y() > mg.target.y() ) {
+                mg.abs_pos.y()--;
+            }
+            if( mg.abs_pos.y() < mg.target.y() ) {
+                mg.abs_pos.y()++;
+            }
+            tmpzg.emplace( mg.rel_pos(), mg );
+            zg.erase( it++ );
+        } else {
+            ++it;
+        }
+    }
+    zg.insert( tmpzg.begin(), tmpzg.end() );
+}
+
+// Signal handling as overmap::signal_hordes did it before the horde grid.
+static void signal_hordes_reference( horde_map &zg, const tripoint_abs_sm &absp, int sig_power )
+{
+    for( auto &elem : zg ) {
+        mongroup &mg = elem.second;
+        if( !mg.horde ) {
+            continue;
+        }
+        const int dist = rl_dist( absp, mg.abs_pos );
+        if( sig_power < dist || mg.behaviour == mongroup::horde_behaviour::nemesis ) {
+            continue;
+        }
+        const int calculated_inter = ( sig_power + 1 - dist ) * 15;
+        const int roll = rng( 0, mg.interest );
+        const int min_capped_inter = std::max( 30, calculated_inter );
+        if( roll < min_capped_inter ) {
+            if( rl_dist( absp.xy(), mg.target ) < 5 ) {
+                mg.set_target( midpoint( mg.target, absp.xy() ) );
+                mg.inc_interest( rng( 3, calculated_inter ) );
+            } else {
+                mg.set_target( absp.xy() );
+                mg.set_interest( min_capped_inter );
+            }
+        }
+    }
+}
+
+// Fills the overmap holding the player with hordes, mirrored into the returned map.
+static horde_map place_test_hordes( int count, int spread )
+{
+    const tripoint_abs_sm center = get_player_character().global_sm_location();
+    overmap &om = overmap_buffer.get( project_to<coords::om>( center.xy() ) );
+    om.clear_mon_groups();
+    horde_map placed;
+    for( int i = 0; i < count; i++ ) {
+        const tripoint_abs_sm pos = center + tripoint_rel_sm( rng( -spread, spread ),
+                                    rng( -spread, spread ), 0 );
+        mongroup group( GROUP_ZOMBIE, pos, rng( 5, 50 ) );
+        group.horde = true;
+        group.interest = rng( 15, 100 );
+        group.set_target( pos.xy() + point_rel_sm( rng( -20, 20 ), rng( -20, 20 ) ) );
+        om.debug_force_add_group( group );
+        placed.emplace( group.rel_pos(), group );
+    }
+    return placed;
+}
+
+TEST_CASE( "horde_movement_matches_reference", "[overmap][mongroup]" )
+{
+    override_option wander_spawns( "WANDER_SPAWNS", "false" );
+    clear_avatar();
+    overmap_buffer.clear();
+    rng_set_engine_seed( 1234 );
+    horde_map expected = place_test_hordes( 300, 40 );
+    const tripoint_abs_sm center = get_player_character().global_sm_location();
+    overmap &om = overmap_buffer.get( project_to<coords::om>( center.xy() ) );
+
+    for( int turn = 1; turn <= 60; turn++ ) {
+        rng_set_engine_seed( turn );
+        overmap_buffer.move_hordes();
+        rng_set_engine_seed( turn );
+        move_hordes_reference( om, expected );
+
+        if( turn % 6 == 0 ) {
+            const tripoint_abs_sm source = center + tripoint_rel_sm( turn % 13, -( turn % 7 ), 0 );
+            rng_set_engine_seed( turn + 1000 );
+            overmap_buffer.signal_hordes( source, 15 );
+            rng_set_engine_seed( turn + 1000 );
+            signal_hordes_reference( expected, source, 15 );
+        }
+    }
+
+    for( const std::pair<const tripoint_om_sm, mongroup> &entry : expected ) {
+        CAPTURE( entry.second.abs_pos );
+        CHECK( om.mongroup_check( entry.second ) );
+    }
+}
+
+TEST_CASE( "horde_movement_benchmark", "[.][overmap][mongroup][benchmark]" )
+{
+    override_option wander_spawns( "WANDER_SPAWNS", "false" );
+    clear_avatar();
+    overmap_buffer.clear();
+    place_test_hordes( 5000, 150 );
+    const tripoint_abs_sm center = get_player_character().global_sm_location();
+
+    BENCHMARK( "move_hordes" ) {
+        overmap_buffer.move_hordes();
+    };
+    BENCHMARK( "signal_hordes" ) {
+        overmap_buffer.signal_hordes( center, 20 );
+    };
+}
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <optional>
@@ -11,11 +12,14 @@
 #include "cata_catch.h"
 #include "character.h"
 #include "common_types.h"
+#include "creature.h"
 #include "creature_tracker.h"
 #include "faction.h"
 #include "field.h"
 #include "field_type.h"
 #include "game.h"
+#include "item.h"
+#include "item_location.h"
 #include "line.h"
 #include "map.h"
 #include "map_helpers.h"
@@ -27,6 +31,7 @@
 #include "pimpl.h"
 #include "player_helpers.h"
 #include "point.h"
+#include "rng.h"
 #include "test_data.h"
 #include "text_snippets.h"
 #include "type_id.h"
@@ -43,6 +48,9 @@ static const efftype_id effect_sleep( "sleep" );
 static const item_group_id Item_spawn_data_test_NPC_guns( "test_NPC_guns" );
 static const item_group_id Item_spawn_data_trash_forest( "trash_forest" );
 
+static const itype_id itype_kevlar( "kevlar" );
+static const itype_id itype_test_bomba_act( "test_bomba_act" );
+
 static const trait_id trait_WEB_WEAVER( "WEB_WEAVER" );
 
 static const vpart_id vpart_frame( "frame" );
@@ -654,3 +662,139 @@ TEST_CASE( "npc_prefers_guns", "[npc_ai]" )
     CAPTURE( hostile.get_wielded_item().get_item()->tname() );
     REQUIRE( hostile.get_wielded_item().get_item()->is_gun() );
 }
+
+// 20 NPCs, every other one with a rifle, facing a pack of 100 zombies.  Two lit charges lie
+// among the NPCs when there are @p explosives.
+static std::vector<npc *> spawn_npcs_facing_zombies( bool explosives = false )
+{
+    clear_map();
+    clear_avatar();
+    set_time_to_day();
+    std::vector<npc *> npcs;
+    for( int i = 0; i < 20; i++ ) {
+        npc &guy = spawn_npc( point_bub_ms( 40 + i, 50 + i % 2 ), "thug" );
+        if( i % 2 == 0 ) {
+            arm_shooter( guy, "M24" );
+        }
+        npcs.push_back( &guy );
+    }
+    for( int i = 0; i < 100; i++ ) {
+        spawn_test_monster( "mon_zombie", tripoint_bub_ms( 30 + i % 20 * 2, 60 + i / 20 * 2, 0 ) );
+    }
+    if( explosives ) {
+        for( const tripoint_bub_ms &p : {
+                 tripoint_bub_ms( 43, 48, 0 ), tripoint_bub_ms( 54, 48, 0 )
+             } ) {
+            item charge( itype_test_bomba_act );
+            charge.active = true;
+            charge.charges = 1;
+            get_map().add_item( p, charge );
+        }
+    }
+    return npcs;
+}
+
+struct npc_decision {
+    std::optional<tripoint_bub_ms> target;
+    float danger;
+    std::vector<std::pair<tripoint, int>> explosives;
+
+    bool operator==( const npc_decision &rhs ) const {
+        return target == rhs.target && danger == rhs.danger && explosives == rhs.explosives;
+    }
+};
+
+static std::vector<npc_decision> assess_danger_of_zombies( bool share_threats )
+{
+    g->faction_manager_ptr->create_if_needed();
+    rng_set_engine_seed( 4242 );
+    const std::vector<npc *> npcs = spawn_npcs_facing_zombies( true );
+    npc::clear_threat_cache();
+    std::vector<npc_decision> decisions;
+    for( size_t i = 0; i < npcs.size(); i++ ) {
+        npc *guy = npcs[i];
+        if( i == npcs.size() / 2 ) {
+            // Halfway through the turn the first NPC's rifle is unloaded and its clothes torn
+            npc &first = *npcs.front();
+            first.get_wielded_item()->ammo_unset();
+            for( item_location &worn : first.top_items_loc() ) {
+                worn->set_damage( worn->max_damage() );
+            }
+        }
+        if( !share_threats ) {
+            npc::clear_threat_cache();
+        }
+        guy->regen_ai_cache();
+        npc_decision decision;
+        if( const Creature *target = guy->current_target() ) {
+            decision.target = target->pos_bub();
+        }
+        decision.danger = guy->danger_assessment();
+        for( const sphere &explosive : guy->find_dangerous_explosives() ) {
+            decision.explosives.emplace_back( explosive.center, explosive.radius );
+        }
+        decisions.push_back( decision );
+    }
+    return decisions;
+}
+
+TEST_CASE( "npcs_sharing_threats_decide_the_same", "[npc_ai]" )
+{
+    const std::vector<npc_decision> alone = assess_danger_of_zombies( false );
+    const std::vector<npc_decision> shared = assess_danger_of_zombies( true );
+    CHECK( std::count_if( alone.begin(), alone.end(), []( const npc_decision & d ) {
+        return d.target.has_value();
+    } ) > 0 );
+    CHECK( std::count_if( alone.begin(), alone.end(), []( const npc_decision & d ) {
+        return !d.explosives.empty();
+    } ) > 0 );
+    CHECK( shared == alone );
+}
+
+TEST_CASE( "npcs_sharing_threats_see_gear_change_within_a_turn", "[npc_ai]" )
+{
+    clear_map();
+    clear_avatar();
+    set_time_to_day();
+    g->faction_manager_ptr->create_if_needed();
+    npc &guy = spawn_npc( point_bub_ms( 50, 50 ), "thug" );
+    npc &other = spawn_npc( point_bub_ms( 55, 50 ), "thug" );
+    arm_shooter( other, "M24" );
+    other.wear_item( item( itype_kevlar ), false );
+    npc::clear_threat_cache();
+    const float before = guy.evaluate_character( other, false, true );
+
+    SECTION( "armour is damaged" ) {
+        // Same items and same weight, only their state changes
+        for( item_location &worn : other.top_items_loc() ) {
+            worn->set_damage( worn->max_damage() );
+        }
+    }
+    SECTION( "rifle is unloaded" ) {
+        other.get_wielded_item()->ammo_unset();
+    }
+    SECTION( "armour is taken off" ) {
+        other.worn.remove_worn_items_with( []( item & it ) {
+            return it.typeId() == itype_kevlar;
+        }, other );
+    }
+    const float cached = guy.evaluate_character( other, false, true );
+    npc::clear_threat_cache();
+    const float uncached = guy.evaluate_character( other, false, true );
+    CHECK( cached == uncached );
+    CHECK( uncached <= before );
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "npcs_assess_danger_benchmark", "[.][npc_ai][benchmark]" )
+{
+    g->faction_manager_ptr->create_if_needed();
+    const std::vector<npc *> npcs = spawn_npcs_facing_zombies();
+    BENCHMARK( "20 NPCs assess 100 zombies" ) {
+        npc::clear_threat_cache();
+        for( npc *guy : npcs ) {
+            guy->regen_ai_cache();
+        }
+        return npcs.front()->danger_assessment();
+    };
+}
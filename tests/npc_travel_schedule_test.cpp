@@ -0,0 +1,174 @@
+#include <utility>
+#include <vector>
+
+#include "calendar.h"
+#include "cata_catch.h"
+#include "character_id.h"
+#include "coordinates.h"
+#include "game.h"
+#include "game_constants.h"
+#include "map_scale_constants.h"
+#include "memory_fast.h"
+#include "npc.h"
+#include "npc_travel_schedule.h"
+#include "overmap.h"
+#include "overmapbuffer.h"
+#include "point.h"
+#include "rng.h"
+#include "type_id.h"
+
+static const oter_str_id oter_field( "field" );
+
+static constexpr int travel_overmaps = 2;
+// Far enough to reach every overmap the NPCs travel on
+static constexpr int travel_radius = 8 * OMAPX;
+
+// A square of overmaps that are fields from one end to the other
+static void generate_open_overmaps()
+{
+    overmap_buffer.clear();
+    for( int om_x = 0; om_x < travel_overmaps; om_x++ ) {
+        for( int om_y = 0; om_y < travel_overmaps; om_y++ ) {
+            overmap &om = overmap_buffer.get( point_abs_om( om_x, om_y ) );
+            for( int x = 0; x < OMAPX; x++ ) {
+                for( int y = 0; y < OMAPY; y++ ) {
+                    om.ter_set( tripoint_om_omt( x, y, 0 ), oter_field.id() );
+                }
+            }
+        }
+    }
+}
+
+static shared_ptr_fast<npc> spawn_traveller( const tripoint_abs_omt &start,
+        const tripoint_abs_omt &goal )
+{
+    shared_ptr_fast<npc> guy = make_shared_fast<npc>();
+    guy->setID( g->assign_npc_id() );
+    guy->normalize();
+    guy->spawn_at_omt( start );
+    guy->set_mission( NPC_MISSION_TRAVELLING );
+    guy->goal = goal;
+    overmap_buffer.insert_npc( guy );
+    return guy;
+}
+
+struct trip {
+    time_duration took;
+    int moves;
+};
+
+// Runs the schedule like the game does until the NPC is at its goal, the NPC already has its path
+static trip travel( npc_travel_schedule &schedule, const tripoint_abs_ms &player, npc &guy )
+{
+    const time_point start = calendar::turn;
+    const tripoint_abs_omt goal = guy.goal;
+    tripoint_abs_omt last = guy.global_omt_location();
+    int moves = 0;
+    while( guy.global_omt_location() != goal && calendar::turn < start + 1_days ) {
+        calendar::turn += time_between_npc_OM_moves;
+        schedule.update( player, travel_radius );
+        if( guy.global_omt_location() != last ) {
+            last = guy.global_omt_location();
+            moves++;
+        }
+    }
+    return { calendar::turn - start, moves };
+}
+
+TEST_CASE( "far_npcs_travel_in_batches_at_the_same_speed", "[npc][overmap]" )
+{
+    generate_open_overmaps();
+    const tripoint_abs_omt start( 20, 20, 0 );
+    const tripoint_abs_omt goal( 120, 60, 0 );
+    const tripoint_abs_ms near_player = project_to<coords::ms>( start );
+    const tripoint_abs_ms far_player = project_to<coords::ms>( start + tripoint_rel_omt( 3 * OMAPX,
+                                       0, 0 ) );
+
+    const int path_tiles = static_cast<int>( overmap_buffer.get_travel_path( start, goal,
+                           overmap_path_params::for_npc() ).points.size() ) - 1;
+    REQUIRE( path_tiles >= rl_dist( start, goal ) );
+
+    calendar::turn = calendar::turn_zero;
+    npc_travel_schedule near_schedule;
+    shared_ptr_fast<npc> near_guy = spawn_traveller( start, goal );
+    near_schedule.update( near_player, travel_radius );
+    CHECK( near_schedule.next_step( near_guy->getID() ) ==
+           calendar::turn + time_between_npc_OM_moves );
+    const trip near_trip = travel( near_schedule, near_player, *near_guy );
+    overmap_buffer.remove_npc( near_guy->getID() );
+
+    calendar::turn = calendar::turn_zero;
+    npc_travel_schedule far_schedule;
+    shared_ptr_fast<npc> far_guy = spawn_traveller( start, goal );
+    far_schedule.update( far_player, travel_radius );
+    // Just looked for a path, the first batch of steps is due in an hour
+    CHECK( far_schedule.next_step( far_guy->getID() ) ==
+           calendar::turn + npc_travel_schedule::far_step_interval );
+    const trip far_trip = travel( far_schedule, far_player, *far_guy );
+    overmap_buffer.remove_npc( far_guy->getID() );
+
+    REQUIRE( near_guy->global_omt_location() == goal );
+    REQUIRE( far_guy->global_omt_location() == goal );
+    CHECK( near_guy->mission != NPC_MISSION_TRAVELLING );
+    CHECK( far_guy->mission != NPC_MISSION_TRAVELLING );
+    CHECK( near_trip.took == time_between_npc_OM_moves * near_trip.moves );
+    CHECK( near_trip.moves == path_tiles );
+    // Both arrive at the same time, the one far away with a lot fewer moves
+    CHECK( far_trip.took == near_trip.took );
+    CHECK( far_trip.moves <= path_tiles / 12 + 1 );
+}
+
+static std::vector<shared_ptr_fast<npc>> spawn_travellers( int count )
+{
+    const int size = travel_overmaps * OMAPX;
+    std::vector<shared_ptr_fast<npc>> travellers;
+    for( int i = 0; i < count; i++ ) {
+        travellers.push_back( spawn_traveller(
+                                  tripoint_abs_omt( rng( 0, size - 1 ), rng( 0, size - 1 ), 0 ),
+                                  tripoint_abs_omt( rng( 0, size - 1 ), rng( 0, size - 1 ), 0 ) ) );
+    }
+    return travellers;
+}
+
+static void simulate_week( const tripoint_abs_ms &player )
+{
+    npc_travel_schedule schedule;
+    const time_point end = calendar::turn + 7_days;
+    while( calendar::turn < end ) {
+        calendar::turn += time_between_npc_OM_moves;
+        schedule.update( player, travel_radius );
+    }
+}
+
+static void benchmark_travellers( Catch::Benchmark::Chronometer &meter,
+                                  const tripoint_abs_ms &player )
+{
+    rng_set_engine_seed( 1234 );
+    calendar::turn = calendar::turn_zero;
+    std::vector<shared_ptr_fast<npc>> travellers = spawn_travellers( 300 );
+    meter.measure( [&player] {
+        simulate_week( player );
+    } );
+    for( const shared_ptr_fast<npc> &guy : travellers ) {
+        overmap_buffer.remove_npc( guy->getID() );
+    }
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "overmap_npc_travel_benchmark", "[.][npc][overmap][benchmark]" )
+{
+    generate_open_overmaps();
+    const tripoint_abs_ms near_player = project_to<coords::ms>( tripoint_abs_omt( OMAPX, OMAPY,
+                                        0 ) );
+    const tripoint_abs_ms far_player = project_to<coords::ms>( tripoint_abs_omt( 3 * OMAPX, OMAPY,
+                                       0 ) );
+
+    BENCHMARK_ADVANCED( "300 NPCs for a week near the player" )(
+        Catch::Benchmark::Chronometer meter ) {
+        benchmark_travellers( meter, near_player );
+    };
+    BENCHMARK_ADVANCED( "300 NPCs for a week far from the player" )(
+        Catch::Benchmark::Chronometer meter ) {
+        benchmark_travellers( meter, far_player );
+    };
+}
@@ -1,5 +1,9 @@
+#include <string>
+
 #include "cata_catch.h"
 #include "options.h"
+#include "options_helpers.h"
+#include "worldfactory.h"
 
 static const option_slider_id option_slider_test_world_difficulty( "test_world_difficulty" );
 
@@ -73,3 +77,61 @@ TEST_CASE( "option_slider_test", "[option]" )
     }
     CHECK( checked == 7 );
 }
+
+TEST_CASE( "option_handle_follows_option_changes", "[option]" )
+{
+    const option_handle<bool> wander_spawns( "WANDER_SPAWNS" );
+    const option_handle<float> upgrade_factor( "MONSTER_UPGRADE_FACTOR" );
+    const option_handle<std::string> distance_units( "DISTANCE_UNITS" );
+    CHECK( wander_spawns.get() == get_option<bool>( "WANDER_SPAWNS" ) );
+    CHECK( upgrade_factor.get() == get_option<float>( "MONSTER_UPGRADE_FACTOR" ) );
+    CHECK( distance_units.get() == get_option<std::string>( "DISTANCE_UNITS" ) );
+
+    SECTION( "changed values are seen" ) {
+        const bool old_wander_spawns = wander_spawns.get();
+        {
+            override_option opt( "WANDER_SPAWNS", old_wander_spawns ? "false" : "true" );
+            CHECK( wander_spawns.get() == !old_wander_spawns );
+        }
+        CHECK( wander_spawns.get() == old_wander_spawns );
+    }
+
+    SECTION( "switched world options are seen" ) {
+        REQUIRE( world_generator->active_world != nullptr );
+        options_manager::options_container other_world =
+            world_generator->active_world->WORLD_OPTIONS;
+        other_world["MONSTER_UPGRADE_FACTOR"].setValue( 0.5f );
+        get_options().set_world_options( &other_world );
+        CHECK( upgrade_factor.get() == Approx( 0.5f ) );
+        get_options().set_world_options( &world_generator->active_world->WORLD_OPTIONS );
+        CHECK( upgrade_factor.get() == get_option<float>( "MONSTER_UPGRADE_FACTOR" ) );
+    }
+
+    SECTION( "replaced world options are seen" ) {
+        REQUIRE( world_generator->active_world != nullptr );
+        options_manager::options_container &world_options =
+            world_generator->active_world->WORLD_OPTIONS;
+        const options_manager::options_container old_options = world_options;
+        options_manager::options_container replacement = old_options;
+        replacement["MONSTER_UPGRADE_FACTOR"].setValue( 0.25f );
+        // destroys the option the handle points to, like resetting a world to its defaults
+        world_options = replacement;
+        options_manager::invalidate_handles();
+        CHECK( upgrade_factor.get() == Approx( 0.25f ) );
+        world_options = old_options;
+        options_manager::invalidate_handles();
+        CHECK( upgrade_factor.get() == get_option<float>( "MONSTER_UPGRADE_FACTOR" ) );
+    }
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "option_handle_lookup", "[.][option][benchmark]" )
+{
+    static const option_handle<bool> wander_spawns( "WANDER_SPAWNS" );
+    BENCHMARK( "get_option" ) {
+        return get_option<bool>( "WANDER_SPAWNS" );
+    };
+    BENCHMARK( "option_handle" ) {
+        return wander_spawns.get();
+    };
+}
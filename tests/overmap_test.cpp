@@ -1,10 +1,18 @@
+#include <algorithm>
+#include <limits>
 #include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "all_enum_values.h"
 #include "ammo.h"
 #include "calendar.h"
 #include "cata_catch.h"
+#include "cata_path.h"
+#include "cata_scope_helpers.h"
+#include "cata_utility.h"
 #include "city.h"
 #include "common_types.h"
 #include "coordinates.h"
@@ -14,14 +22,20 @@
 #include "global_vars.h"
 #include "item_factory.h"
 #include "itype.h"
+#include "json_loader.h"
 #include "map.h"
 #include "map_iterator.h"
 #include "mapbuffer.h"
 #include "omdata.h"
 #include "output.h"
 #include "overmap.h"
+#include "overmap_road_graph.h"
 #include "overmap_types.h"
 #include "overmapbuffer.h"
+#include "path_info.h"
+#include "point.h"
+#include "rng.h"
+#include "string_formatter.h"
 #include "test_data.h"
 #include "type_id.h"
 #include "vehicle.h"
@@ -32,6 +46,11 @@ static const oter_str_id oter_cabin_east( "cabin_east" );
 static const oter_str_id oter_cabin_north( "cabin_north" );
 static const oter_str_id oter_cabin_south( "cabin_south" );
 static const oter_str_id oter_cabin_west( "cabin_west" );
+static const oter_str_id oter_empty_rock( "empty_rock" );
+static const oter_str_id oter_field( "field" );
+static const oter_str_id oter_meadow_core( "meadow_core" );
+static const oter_str_id oter_open_air( "open_air" );
+static const oter_str_id oter_road_ew( "road_ew" );
 
 static const overmap_special_id overmap_special_Cabin( "Cabin" );
 static const overmap_special_id overmap_special_Lab( "Lab" );
@@ -622,3 +641,416 @@ TEST_CASE( "overmap_terrain_coverage", "[overmap][slow]" )
         }
     }
 }
+
+// Tile by tile search, as overmapbuffer::find_all did before the terrain index.
+static std::vector<tripoint_abs_omt> find_all_by_scan( const tripoint_abs_omt &origin,
+        const omt_find_params &params )
+{
+    std::vector<tripoint_abs_omt> result;
+    const int max_dist = params.search_range ? params.search_range : OMAPX;
+    for( const tripoint_abs_omt &loc : closest_points_first( origin, params.min_distance,
+            max_dist ) ) {
+        for( const std::pair<std::string, ot_match_type> &type : params.types ) {
+            if( overmap_buffer.check_ot_existing( type.first, type.second, loc ) ) {
+                result.push_back( loc );
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+// Tile by tile search, as overmapbuffer::find_closest did before the terrain index.
+// Returns every location the search would have picked randomly from.
+static std::vector<tripoint_abs_omt> find_closest_by_scan( const tripoint_abs_omt &origin,
+        const omt_find_params &params )
+{
+    std::vector<tripoint_abs_omt> result;
+    int found_dist = std::numeric_limits<int>::max();
+    const int max_dist = params.search_range ? params.search_range : OMAPX * 5;
+    for( const point_abs_omt &loc_xy : closest_points_first( origin.xy(), params.min_distance,
+            max_dist ) ) {
+        if( found_dist < square_dist( origin.xy(), loc_xy ) ) {
+            break;
+        }
+        for( int z = params.min_z; z <= params.max_z; z++ ) {
+            const tripoint_abs_omt loc( loc_xy, z );
+            const int dist = square_dist( origin, loc );
+            if( found_dist < dist ) {
+                continue;
+            }
+            for( const std::pair<std::string, ot_match_type> &type : params.types ) {
+                if( overmap_buffer.check_ot_existing( type.first, type.second, loc ) ) {
+                    found_dist = dist;
+                    result.push_back( loc );
+                    break;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+TEST_CASE( "overmap_terrain_index_matches_full_scan", "[overmap][slow]" )
+{
+    overmap_buffer.clear();
+    for( int x = -1; x <= 1; x++ ) {
+        for( int y = -1; y <= 1; y++ ) {
+            overmap_buffer.get( point_abs_om( x, y ) );
+        }
+    }
+
+    const tripoint_abs_omt origin( 23, 41, 0 );
+    const std::vector<std::pair<std::string, ot_match_type>> queries = {
+        { "road", ot_match_type::type },
+        { "house", ot_match_type::prefix },
+        { "forest", ot_match_type::type },
+        { "field", ot_match_type::type },
+        { "lab", ot_match_type::contains },
+        { "cabin_north", ot_match_type::exact },
+        { "no_such_terrain", ot_match_type::type },
+    };
+
+    for( const std::pair<std::string, ot_match_type> &query : queries ) {
+        CAPTURE( query.first );
+        omt_find_params params;
+        params.types.push_back( query );
+        params.existing_only = true;
+        params.search_range = OMAPX + OMAPX / 2;
+        params.min_distance = 3;
+
+        CHECK( overmap_buffer.find_all( origin, params ) == find_all_by_scan( origin, params ) );
+
+        params.min_z = -2;
+        params.max_z = 2;
+        const std::vector<tripoint_abs_omt> candidates = find_closest_by_scan( origin, params );
+        rng_set_engine_seed( 4321 );
+        const tripoint_abs_omt expected = random_entry( candidates, tripoint_abs_omt::invalid );
+        rng_set_engine_seed( 4321 );
+        CHECK( overmap_buffer.find_closest( origin, params ) == expected );
+    }
+
+    SECTION( "index follows ter_set" ) {
+        omt_find_params params;
+        params.types.emplace_back( "cabin", ot_match_type::type );
+        params.existing_only = true;
+        params.search_range = OMAPX;
+        // Build the index before changing the terrain.
+        overmap_buffer.find_all( origin, params );
+
+        const tripoint_abs_omt changed = origin + tripoint_rel_omt( 17, -5, 0 );
+        const oter_id previous = overmap_buffer.ter( changed );
+        overmap_buffer.ter_set( changed, oter_cabin_north.id() );
+        std::vector<tripoint_abs_omt> found = overmap_buffer.find_all( origin, params );
+        CHECK( std::find( found.begin(), found.end(), changed ) != found.end() );
+        CHECK( found == find_all_by_scan( origin, params ) );
+
+        overmap_buffer.ter_set( changed, previous );
+        found = overmap_buffer.find_all( origin, params );
+        CHECK( found == find_all_by_scan( origin, params ) );
+    }
+}
+
+TEST_CASE( "overmap_find_closest_benchmark", "[.][overmap][benchmark]" )
+{
+    overmap_buffer.clear();
+    for( int x = -2; x <= 2; x++ ) {
+        for( int y = -2; y <= 2; y++ ) {
+            overmap_buffer.get( point_abs_om( x, y ) );
+        }
+    }
+    const tripoint_abs_omt origin( OMAPX / 2, OMAPY / 2, 0 );
+
+    // Missions look for a specific building anywhere within reach, on any z-level.
+    omt_find_params params;
+    params.types.emplace_back( "lab", ot_match_type::contains );
+    params.existing_only = true;
+    BENCHMARK( "find_closest rare terrain" ) {
+        return overmap_buffer.find_closest( origin, params );
+    };
+    BENCHMARK( "find_closest rare terrain, tile scan" ) {
+        return find_closest_by_scan( origin, params ).size();
+    };
+
+    omt_find_params missing;
+    missing.types.emplace_back( "no_such_terrain", ot_match_type::type );
+    missing.existing_only = true;
+    BENCHMARK( "find_closest missing terrain" ) {
+        return overmap_buffer.find_closest( origin, missing );
+    };
+}
+
+static constexpr int road_trip_overmaps = 5;
+
+// Overmaps 0 to 4 in a row, with a road running through the middle of all of them
+static void generate_road_trip_overmaps()
+{
+    overmap_buffer.clear();
+    for( int x = 0; x < road_trip_overmaps; x++ ) {
+        overmap &om = overmap_buffer.get( point_abs_om( x, 0 ) );
+        for( int omt_x = 0; omt_x < OMAPX; omt_x++ ) {
+            om.ter_set( tripoint_om_omt( omt_x, OMAPY / 2, 0 ), oter_road_ew.id() );
+        }
+    }
+}
+
+static const tripoint_abs_omt road_trip_src( 10, OMAPY / 2 + 5, 0 );
+static const tripoint_abs_omt road_trip_dest( road_trip_overmaps * OMAPX - 10, OMAPY / 2 - 3, 0 );
+
+TEST_CASE( "long_overmap_trips_follow_the_road_graph", "[overmap][slow]" )
+{
+    generate_road_trip_overmaps();
+
+    overmap_path_params params = overmap_path_params::for_player();
+    params.only_known_by_player = false;
+    SECTION( "player" ) {}
+    SECTION( "npc" ) {
+        params = overmap_path_params::for_npc();
+    }
+    const pf::simple_path<tripoint_abs_omt> path =
+        overmap_buffer.get_travel_path( road_trip_src, road_trip_dest, params );
+    REQUIRE( path.points.size() > 1 );
+    CHECK( path.points.front() == road_trip_dest );
+    CHECK( path.points.back() == road_trip_src );
+    CHECK( path.cost > 0 );
+    for( size_t i = 1; i < path.points.size(); i++ ) {
+        CAPTURE( path.points[i - 1], path.points[i] );
+        CHECK( square_dist( path.points[i - 1], path.points[i] ) == 1 );
+    }
+    // Away from both ends the path stays on the road
+    for( const tripoint_abs_omt &p : path.points ) {
+        if( p.x() >= OMAPX && p.x() < ( road_trip_overmaps - 1 ) * OMAPX ) {
+            CAPTURE( p );
+            CHECK( overmap_road_graph::is_road( overmap_buffer.ter( p ) ) );
+        }
+    }
+}
+
+TEST_CASE( "long_overmap_trips_skip_roads_that_go_around", "[overmap][slow]" )
+{
+    overmap_buffer.clear();
+    // Open fields between both ends, and a road that leaves them, makes a long detour and comes
+    // back: 60 tiles away, 200 tiles along and 60 tiles back
+    const int y = OMAPY / 2;
+    for( int x = 0; x < 2 * OMAPX; x++ ) {
+        for( int dy = -70; dy <= 5; dy++ ) {
+            overmap_buffer.ter_set( tripoint_abs_omt( x, y + dy, 0 ), oter_field.id() );
+        }
+    }
+    const tripoint_abs_omt src( 20, y, 0 );
+    const tripoint_abs_omt dest( 220, y, 0 );
+    for( int dy = 1; dy <= 60; dy++ ) {
+        overmap_buffer.ter_set( src + tripoint_rel_omt( 0, -dy, 0 ), oter_road_ew.id() );
+        overmap_buffer.ter_set( dest + tripoint_rel_omt( 0, -dy, 0 ), oter_road_ew.id() );
+    }
+    for( int x = src.x(); x <= dest.x(); x++ ) {
+        overmap_buffer.ter_set( tripoint_abs_omt( x, y - 60, 0 ), oter_road_ew.id() );
+    }
+
+    overmap_path_params params = overmap_path_params::for_npc();
+    const pf::simple_path<tripoint_abs_omt> path = overmap_buffer.get_travel_path( src, dest,
+            params );
+    REQUIRE( path.points.size() > 1 );
+    CHECK( path.points.front() == dest );
+    CHECK( path.points.back() == src );
+    // 200 tiles of fields are cheaper than 320 tiles of road
+    CHECK( path.cost <= 201 * params.get_cost( oter_travel_cost_type::field ) );
+    for( const tripoint_abs_omt &p : path.points ) {
+        CAPTURE( p );
+        CHECK( p.y() == y );
+    }
+}
+
+TEST_CASE( "overmap_road_graph_follows_ter_set", "[overmap][slow]" )
+{
+    generate_road_trip_overmaps();
+    overmap &om = overmap_buffer.get( point_abs_om( 2, 0 ) );
+    const tripoint_om_omt changed( OMAPX / 3, OMAPY / 2, 0 );
+    const auto on_graph = [&]() {
+        const overmap_road_graph &graph = om.get_road_graph();
+        return graph.node_at( changed.xy() ) >= 0 || graph.edge_at( changed.xy() ).first >= 0;
+    };
+
+    REQUIRE( on_graph() );
+    om.ter_set( changed, oter_field.id() );
+    CHECK_FALSE( on_graph() );
+    // Both ends of the cut road are dead ends now
+    CHECK( om.get_road_graph().node_at( changed.xy() + point_rel_omt::east ) >= 0 );
+    CHECK( om.get_road_graph().node_at( changed.xy() + point_rel_omt::west ) >= 0 );
+    om.ter_set( changed, oter_road_ew.id() );
+    CHECK( on_graph() );
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "long_overmap_trip_benchmark", "[.][overmap][benchmark]" )
+{
+    generate_road_trip_overmaps();
+
+    overmap_path_params walking = overmap_path_params::for_player();
+    walking.only_known_by_player = false;
+    BENCHMARK( "walk across five overmaps" ) {
+        return overmap_buffer.get_travel_path( road_trip_src, road_trip_dest, walking ).cost;
+    };
+    const overmap_path_params driving = overmap_path_params::for_land_vehicle( 1.0f, false, false );
+    BENCHMARK( "drive across five overmaps" ) {
+        return overmap_buffer.get_travel_path( road_trip_src, road_trip_dest, driving ).cost;
+    };
+}
+
+struct saved_overmap {
+    point_abs_om pos;
+    std::string terrain;
+    std::string view;
+
+    explicit saved_overmap( const overmap &om ) : pos( om.pos() ) {
+        std::ostringstream terrain_out;
+        om.serialize( terrain_out );
+        terrain = terrain_out.str();
+        std::ostringstream view_out;
+        om.serialize_view( view_out );
+        view = view_out.str();
+    }
+
+    std::unique_ptr<overmap> load() const {
+        std::unique_ptr<overmap> om = std::make_unique<overmap>( pos );
+        std::istringstream terrain_in( terrain );
+        om->unserialize( cata_path(), terrain_in );
+        std::istringstream view_in( view );
+        om->unserialize_view( cata_path(), view_in );
+        return om;
+    }
+};
+
+static void check_same_layers( const overmap &expected, const overmap &actual )
+{
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
+        CAPTURE( z );
+        int different_ter = 0;
+        int different_seen = 0;
+        for( int y = 0; y < OMAPY; ++y ) {
+            for( int x = 0; x < OMAPX; ++x ) {
+                const tripoint_om_omt p( x, y, z );
+                different_ter += expected.ter( p ) != actual.ter( p );
+                different_seen += expected.seen( p ) != actual.seen( p );
+            }
+        }
+        CHECK( different_ter == 0 );
+        CHECK( different_seen == 0 );
+    }
+}
+
+TEST_CASE( "overmap_layers_are_loaded_on_first_access", "[overmap]" )
+{
+    overmap_buffer.clear();
+    overmap &om = overmap_buffer.get( point_abs_om() );
+    const tripoint_om_omt noted( 40, 50, -3 );
+    om.set_seen( noted, om_vision_level::full );
+    om.add_note( noted, "cellar" );
+    const saved_overmap saved( om );
+
+    std::unique_ptr<overmap> loaded = saved.load();
+    const int loaded_on_open = loaded->debug_loaded_layers();
+    CHECK( loaded_on_open < OVERMAP_LAYERS );
+
+    // Both the indexed terrain and the layers' default terrain
+    const std::vector<std::pair<std::string, ot_match_type>> searched = {
+        { "field", ot_match_type::type }, { "forest", ot_match_type::prefix },
+        { "empty_rock", ot_match_type::exact }, { "open_air", ot_match_type::exact }
+    };
+    std::vector<tripoint_om_omt> expected_found;
+    std::vector<tripoint_om_omt> found;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
+        om.find_terrain_locations( searched, z, expected_found );
+        loaded->find_terrain_locations( searched, z, found );
+    }
+    CHECK( loaded->debug_loaded_layers() == loaded_on_open );
+    std::sort( expected_found.begin(), expected_found.end() );
+    std::sort( found.begin(), found.end() );
+    CHECK( found.size() == expected_found.size() );
+    CHECK( found == expected_found );
+
+    loaded->ter( tripoint_om_omt( 0, 0, OVERMAP_HEIGHT ) );
+    CHECK( loaded->debug_loaded_layers() <= loaded_on_open + 1 );
+
+    check_same_layers( om, *loaded );
+    CHECK( loaded->debug_loaded_layers() == OVERMAP_LAYERS );
+    CHECK( loaded->note( noted ) == "cellar" );
+
+    SECTION( "layers that were never loaded are saved as they were" ) {
+        std::unique_ptr<overmap> untouched = saved.load();
+        const saved_overmap resaved( *untouched );
+        check_same_layers( om, *resaved.load() );
+        CHECK( resaved.load()->note( noted ) == "cellar" );
+    }
+}
+
+TEST_CASE( "overmap_saved_before_sections_loads_every_layer", "[overmap]" )
+{
+    std::string layers;
+    for( int k = 0; k < OVERMAP_LAYERS; ++k ) {
+        layers += k == 0 ? "" : ",";
+        layers += string_format( R"([["field",%d]])", OMAPX * OMAPY );
+    }
+    const JsonValue legacy = json_loader::from_string( R"({"layers":[)" + layers + "]}" );
+
+    overmap om( point_abs_om( 3, 3 ) );
+    om.unserialize( legacy.get_object() );
+    CHECK( om.debug_loaded_layers() == OVERMAP_LAYERS );
+    CHECK( om.ter( tripoint_om_omt( 10, 20, -OVERMAP_DEPTH ) ) == oter_field.id() );
+    CHECK( om.ter( tripoint_om_omt( 10, 20, OVERMAP_HEIGHT ) ) == oter_field.id() );
+}
+
+TEST_CASE( "overmap_file_saved_before_sections_is_migrated_in_the_buffer", "[overmap]" )
+{
+    restore_on_out_of_scope restore_loading_version( savegame_loading_version );
+    const cata_path legacy = PATH_INFO::base_path() / "tests" / "data" / "legacy_overmap_v36.omap";
+    overmap om( point_abs_om( 3, 3 ) );
+    REQUIRE( read_from_file( legacy, [&]( std::istream & fin ) {
+        om.unserialize( legacy, fin );
+    } ) );
+    CHECK( savegame_loading_version == 36 );
+    CHECK( om.debug_loaded_layers() == OVERMAP_LAYERS );
+    CHECK( om.ter( tripoint_om_omt( 10, 20, -1 ) ) == oter_empty_rock.id() );
+    CHECK( om.ter( tripoint_om_omt( 10, 20, 1 ) ) == oter_open_air.id() );
+    CHECK( om.ter( tripoint_om_omt( 1, 0, 0 ) ) == oter_field.id() );
+
+    // Obsolete terrain is only migrated once the overmap buffer asks for it
+    const tripoint_om_omt obsolete( 0, 0, 0 );
+    CHECK( om.ter( obsolete ) != oter_meadow_core.id() );
+    om.apply_pending_migrations();
+    CHECK( om.ter( obsolete ) == oter_meadow_core.id() );
+    CHECK( om.ter( tripoint_om_omt( 1, 0, 0 ) ) == oter_field.id() );
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "overmap_load_benchmark", "[.][overmap][benchmark]" )
+{
+    overmap_buffer.clear();
+    std::vector<saved_overmap> saved;
+    for( int x = -1; x <= 1; x++ ) {
+        for( int y = -1; y <= 1; y++ ) {
+            saved.emplace_back( overmap_buffer.get( point_abs_om( x, y ) ) );
+        }
+    }
+
+    BENCHMARK( "load overmaps, surface only" ) {
+        int loaded = 0;
+        for( const saved_overmap &s : saved ) {
+            std::unique_ptr<overmap> om = s.load();
+            om->ter( tripoint_om_omt( 0, 0, 0 ) );
+            loaded += om->debug_loaded_layers();
+        }
+        return loaded;
+    };
+    BENCHMARK( "load overmaps, every layer" ) {
+        int loaded = 0;
+        for( const saved_overmap &s : saved ) {
+            std::unique_ptr<overmap> om = s.load();
+            for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
+                om->ter( tripoint_om_omt( 0, 0, z ) );
+            }
+            loaded += om->debug_loaded_layers();
+        }
+        return loaded;
+    };
+}
@@ -14,16 +14,29 @@
 #include "itype.h"
 #include "map.h"
 #include "map_helpers.h"
+#include "npc.h"
+#include "pathfinding.h"
+#include "player_helpers.h"
 #include "pocket_type.h"
 #include "point.h"
 #include "projectile.h"
 #include "ret_val.h"
 #include "type_id.h"
+#include "units.h"
 #include "value_ptr.h"
+#include "vehicle.h"
+
+static const furn_str_id furn_f_table( "f_table" );
 
 static const itype_id itype_308( "308" );
 static const itype_id itype_m1a( "m1a" );
 
+static const ter_str_id ter_t_chainfence( "t_chainfence" );
+static const ter_str_id ter_t_dirt( "t_dirt" );
+static const ter_str_id ter_t_floor_olight( "t_floor_olight" );
+
+static const vproto_id vehicle_prototype_car( "car" );
+
 static tripoint_bub_ms projectile_end_point( const std::vector<tripoint_bub_ms> &range,
         const item &gun, int speed, int proj_range )
 {
@@ -83,3 +96,92 @@ TEST_CASE( "projectiles_through_obstacles", "[projectile]" )
     // But that a bullet without the correct amount cannot
     CHECK( projectile_end_point( range, gun, 10, 3 ) == range[0] );
 }
+
+static bool is_shot_obstacle( const tripoint_bub_ms &p )
+{
+    const std::optional<PathfindingFlags> flags = get_map().pathfinding_flags( p );
+    REQUIRE( flags );
+    return flags->is_set( PathfindingFlag::ShotObstacle );
+}
+
+TEST_CASE( "shot_obstacles_follow_map_changes", "[projectile]" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint_bub_ms p( 60, 60, 0 );
+    CHECK_FALSE( is_shot_obstacle( p ) );
+
+    here.ter_set( p, ter_t_chainfence );
+    CHECK( is_shot_obstacle( p ) );
+    here.ter_set( p, ter_t_dirt );
+    CHECK_FALSE( is_shot_obstacle( p ) );
+
+    // Passable, but with shoot data
+    here.ter_set( p, ter_t_floor_olight );
+    CHECK( is_shot_obstacle( p ) );
+    here.ter_set( p, ter_t_dirt );
+
+    // Nothing that slows projectiles down
+    here.furn_set( p, furn_f_table );
+    CHECK_FALSE( is_shot_obstacle( p ) );
+    here.furn_set( p, furn_str_id::NULL_ID() );
+
+    REQUIRE( here.add_vehicle( vehicle_prototype_car, p, 0_degrees, 0, 0 ) != nullptr );
+    CHECK( is_shot_obstacle( p ) );
+    clear_vehicles();
+    CHECK_FALSE( is_shot_obstacle( p ) );
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "firefight_benchmark", "[.][projectile][benchmark]" )
+{
+    clear_map();
+    map &here = get_map();
+    get_player_character().setpos( tripoint_bub_ms{ 2, 2, 0 } );
+
+    // Two lines of shooters with fences and a car between them, a third of them turrets on the car
+    std::vector<npc *> shooters;
+    std::vector<tripoint_bub_ms> targets;
+    for( int i = 0; i < 20; ++i ) {
+        const point_bub_ms pos( i % 2 == 0 ? 30 : 90, 30 + i * 3 );
+        shooters.push_back( &spawn_npc( pos, "thug" ) );
+        targets.emplace_back( i % 2 == 0 ? 110 : 10, 90 - i * 3, 0 );
+    }
+    for( int y = 25; y < 95; ++y ) {
+        if( y % 5 != 0 ) {
+            here.ter_set( tripoint_bub_ms( 50, y, 0 ), ter_t_chainfence );
+            here.ter_set( tripoint_bub_ms( 70, y, 0 ), ter_t_floor_olight );
+        }
+    }
+    vehicle *car = here.add_vehicle( vehicle_prototype_car, tripoint_bub_ms( 60, 60, 0 ), 0_degrees,
+                                     0, 0 );
+    REQUIRE( car != nullptr );
+    const std::set<tripoint_bub_ms> &car_points = car->get_points();
+    const std::vector<tripoint_bub_ms> turret_positions( car_points.begin(), car_points.end() );
+
+    item gun( itype_m1a );
+    item mag( gun.magazine_default() );
+    mag.ammo_set( itype_308, 20 );
+    gun.put_in( mag, pocket_type::MAGAZINE_WELL );
+    projectile proj;
+    proj.speed = 1000;
+    proj.range = 60;
+    proj.impact = gun.gun_damage();
+    proj.proj_effects = gun.ammo_effects();
+
+    BENCHMARK( "100 turns of 10 round bursts" ) {
+        for( int turn = 0; turn < 100; ++turn ) {
+            for( size_t i = 0; i < shooters.size(); ++i ) {
+                npc &shooter = *shooters[i];
+                const bool turret = i % 3 == 0;
+                const tripoint_bub_ms from = turret ? turret_positions[i % turret_positions.size()] :
+                                             shooter.pos_bub();
+                for( int shot = 0; shot < 10; ++shot ) {
+                    projectile_attack( proj, from, targets[i], dispersion_sources( 600 ), &shooter,
+                                       turret ? car : nullptr );
+                }
+            }
+        }
+        return here.get_items_revision();
+    };
+}
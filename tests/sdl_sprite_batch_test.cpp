@@ -0,0 +1,193 @@
+#if defined(TILES)
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include "cata_catch.h"
+#include "point.h"
+#include "rng.h"
+#include "sdl_sprite_batch.h"
+#include "sdl_utils.h"
+#include "sdl_wrappers.h"
+
+static constexpr int sprite_size = 16;
+
+// Software rendering into a surface, needs no window
+struct headless_renderer {
+    SDL_Surface_Ptr surface;
+    SDL_Renderer_Ptr renderer;
+
+    headless_renderer( const int width, const int height ) :
+        surface( create_surface_32( width, height ) ),
+        renderer( SDL_CreateSoftwareRenderer( surface.get() ) ) {
+        REQUIRE( renderer );
+    }
+
+    SDL_Color pixel( const point &p ) const {
+        const Uint8 *row = static_cast<const Uint8 *>( surface->pixels ) + p.y * surface->pitch;
+        const Uint32 value = reinterpret_cast<const Uint32 *>( row )[p.x];
+        SDL_Color color;
+        SDL_GetRGBA( value, surface->format, &color.r, &color.g, &color.b, &color.a );
+        return color;
+    }
+};
+
+static const std::array<SDL_Color, 4> quarter_colors = {{
+        { 0xFF, 0x00, 0x00, 0xFF }, { 0x00, 0xFF, 0x00, 0xFF },
+        { 0x00, 0x00, 0xFF, 0xFF }, { 0xFF, 0xFF, 0xFF, 0xFF }
+    }
+};
+
+// A row of sprites with each quarter in another color, to tell rotations and flips apart
+static SDL_Texture_Ptr quartered_sprites( const headless_renderer &target, const int count )
+{
+    const SDL_Surface_Ptr surf = create_surface_32( sprite_size * count, sprite_size );
+    const int half = sprite_size / 2;
+    for( int i = 0; i < count; i++ ) {
+        for( int q = 0; q < 4; q++ ) {
+            const SDL_Rect quarter{ i * sprite_size + q % 2 * half, q / 2 * half, half, half };
+            const SDL_Color &c = quarter_colors[q];
+            FillRect( surf, &quarter, SDL_MapRGBA( surf->format, c.r, c.g, c.b, c.a ) );
+        }
+    }
+    return CreateTextureFromSurface( target.renderer, surf );
+}
+
+struct sprite_draw {
+    int sprite;
+    SDL_Rect dst;
+    int angle;
+    SDL_RendererFlip flip;
+};
+
+static void draw( headless_renderer &target, sprite_batch &batch,
+                  const std::vector<SDL_Texture *> &textures,
+                  const std::vector<sprite_draw> &draws )
+{
+    for( const sprite_draw &d : draws ) {
+        const SDL_Rect src{ d.sprite * sprite_size, 0, sprite_size, sprite_size };
+        SDL_Texture *const tex = textures[static_cast<size_t>( d.sprite ) % textures.size()];
+        REQUIRE( batch.add( target.renderer, tex, src, d.dst, d.angle, d.flip ) == 0 );
+    }
+    REQUIRE( batch.flush( target.renderer ) == 0 );
+}
+
+TEST_CASE( "sprite_batch_draws_like_render_copy", "[tiles]" )
+{
+    const int scale = 2;
+    const int tile = sprite_size * scale;
+    std::vector<sprite_draw> draws;
+    const std::array<std::pair<int, SDL_RendererFlip>, 5> orientations = {{
+            { 0, SDL_FLIP_NONE },
+            { 0, SDL_FLIP_HORIZONTAL },
+            { 0, static_cast<SDL_RendererFlip>( SDL_FLIP_HORIZONTAL | SDL_FLIP_VERTICAL ) },
+            { 90, SDL_FLIP_NONE },
+            { -90, SDL_FLIP_NONE }
+        }
+    };
+    for( size_t i = 0; i < orientations.size(); i++ ) {
+        draws.push_back( { 0, SDL_Rect{ static_cast<int>( i ) * tile, 0, tile, tile },
+                           orientations[i].first, orientations[i].second } );
+    }
+
+    const int width = tile * static_cast<int>( orientations.size() );
+    headless_renderer immediate( width, tile );
+    headless_renderer batched( width, tile );
+    const SDL_Texture_Ptr immediate_tex = quartered_sprites( immediate, 1 );
+    const SDL_Texture_Ptr batched_tex = quartered_sprites( batched, 1 );
+    sprite_batch immediate_batch;
+    immediate_batch.set_enabled( false );
+    sprite_batch batch;
+    draw( immediate, immediate_batch, { immediate_tex.get() }, draws );
+    draw( batched, batch, { batched_tex.get() }, draws );
+
+    CHECK( immediate_batch.draw_calls() == static_cast<int>( draws.size() ) );
+    if( batch.is_enabled() ) {
+        CHECK( batch.draw_calls() == 1 );
+    }
+    // The middle of each quarter, away from the edges where rasterization may differ
+    for( size_t i = 0; i < orientations.size(); i++ ) {
+        for( int q = 0; q < 4; q++ ) {
+            const point p( static_cast<int>( i ) * tile + ( q % 2 * 2 + 1 ) * tile / 4,
+                           ( q / 2 * 2 + 1 ) * tile / 4 );
+            CAPTURE( i, q );
+            CHECK( batched.pixel( p ) == immediate.pixel( p ) );
+        }
+    }
+}
+
+TEST_CASE( "sprite_batch_flushes_when_the_texture_changes", "[tiles]" )
+{
+    headless_renderer target( sprite_size * 4, sprite_size );
+    const SDL_Texture_Ptr first = quartered_sprites( target, 2 );
+    const SDL_Texture_Ptr second = quartered_sprites( target, 2 );
+    sprite_batch batch;
+    if( !batch.is_enabled() ) {
+        return;
+    }
+    std::vector<sprite_draw> draws;
+    for( int i = 0; i < 4; i++ ) {
+        draws.push_back( { i % 2, SDL_Rect{ i * sprite_size, 0, sprite_size, sprite_size }, 0,
+                           SDL_FLIP_NONE } );
+    }
+    SECTION( "all from one texture" ) {
+        draw( target, batch, { first.get() }, draws );
+        CHECK( batch.draw_calls() == 1 );
+    }
+    SECTION( "alternating between two textures" ) {
+        draw( target, batch, { first.get(), second.get() }, draws );
+        CHECK( batch.draw_calls() == 4 );
+    }
+}
+
+// Three layers (terrain, furniture and an overlay) of a zoomed out 200x100 tile view
+static std::vector<sprite_draw> zoomed_out_view( const int sprites )
+{
+    std::vector<sprite_draw> draws;
+    for( int layer = 0; layer < 3; layer++ ) {
+        for( int y = 0; y < 100; y++ ) {
+            for( int x = 0; x < 200; x++ ) {
+                const SDL_Rect dst{ x * sprite_size, y * sprite_size, sprite_size, sprite_size };
+                draws.push_back( { rng( 0, sprites - 1 ), dst, 90 * rng( -1, 1 ), SDL_FLIP_NONE } );
+            }
+        }
+    }
+    return draws;
+}
+
+// Benchmarks are skipped by default by using [.] tag
+// Synthetic: it times sprite_batch alone on the software renderer, which cata_tiles never
+// batches for (see its constructor), so it only compares the overhead of the two ways of
+// submitting sprites.  It says nothing about a frame of cata_tiles::draw, or about
+// a GPU renderer, where the draw calls saved are what matters.
+TEST_CASE( "sprite_batch_synthetic_benchmark", "[.][tiles][benchmark]" )
+{
+    headless_renderer target( 200 * sprite_size, 100 * sprite_size );
+    const SDL_Texture_Ptr atlas = quartered_sprites( target, 16 );
+    rng_set_engine_seed( 1234 );
+    const std::vector<sprite_draw> draws = zoomed_out_view( 16 );
+
+    sprite_batch immediate;
+    immediate.set_enabled( false );
+    sprite_batch batch;
+    draw( target, immediate, { atlas.get() }, draws );
+    draw( target, batch, { atlas.get() }, draws );
+    CHECK( immediate.draw_calls() == 60000 );
+    if( batch.is_enabled() ) {
+        CHECK( batch.draw_calls() == 1 );
+    }
+
+    BENCHMARK( "synthetic frame, drawing each sprite" ) {
+        immediate.reset_draw_calls();
+        draw( target, immediate, { atlas.get() }, draws );
+        return immediate.draw_calls();
+    };
+    BENCHMARK( "synthetic frame, batched sprites" ) {
+        batch.reset_draw_calls();
+        draw( target, batch, { atlas.get() }, draws );
+        return batch.draw_calls();
+    };
+}
+
+#endif // TILES
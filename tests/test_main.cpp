@@ -16,43 +16,29 @@
 #include <utility>
 #include <vector>
 
-#include "calendar.h"
 #include "cata_catch.h"
-#include "coordinates.h"
 #if defined(_MSC_VER)
 #include <io.h>
 #else
 #include <unistd.h>
 #endif
 
-#include "avatar.h"
 #include "cached_options.h"
-#include "cata_assert.h"
 #include "cata_scope_helpers.h"
 #include "cata_utility.h"
-#include "color.h"
 #include "compatibility.h"
 #include "debug.h"
-#include "filesystem.h"
 #include "game.h"
+#include "init_game_state.h"
 #include "json.h"
-#include "map.h"
 #include "messages.h"
-#include "options.h"
 #include "output.h"
-#include "overmap.h"
-#include "overmapbuffer.h"
-#include "path_info.h"
 #include "rng.h"
 #include "type_id.h"
-#include "weather.h"
 #include "worldfactory.h"
 
 static const mod_id MOD_INFORMATION_dda( "dda" );
 
-using name_value_pair_t = std::pair<std::string, std::string>;
-using option_overrides_t = std::vector<name_value_pair_t>;
-
 static std::vector<mod_id> mods;
 static std::string user_dir;
 static bool dont_save{ false };
@@ -81,88 +67,6 @@ static std::vector<mod_id> extract_mod_selection( const std::string_view mod_str
     return ret;
 }
 
-static void init_global_game_state( const std::vector<mod_id> &mods,
-                                    option_overrides_t &option_overrides,
-                                    const std::string &user_dir )
-{
-    if( !assure_dir_exist( user_dir ) ) {
-        // NOLINTNEXTLINE(misc-static-assert,cert-dcl03-c)
-        cata_fatal( "Unable to make user_dir directory '%s'.  Check permissions.", user_dir );
-    }
-
-    PATH_INFO::init_base_path( "" );
-    PATH_INFO::init_user_dir( user_dir );
-    PATH_INFO::set_standard_filenames();
-
-    if( !assure_dir_exist( PATH_INFO::config_dir() ) ) {
-        // NOLINTNEXTLINE(misc-static-assert,cert-dcl03-c)
-        cata_fatal( "Unable to make config directory.  Check permissions." );
-    }
-
-    if( !assure_dir_exist( PATH_INFO::savedir() ) ) {
-        // NOLINTNEXTLINE(misc-static-assert,cert-dcl03-c)
-        cata_fatal( "Unable to make save directory.  Check permissions." );
-    }
-
-    if( !assure_dir_exist( PATH_INFO::templatedir() ) ) {
-        // NOLINTNEXTLINE(misc-static-assert,cert-dcl03-c)
-        cata_fatal( "Unable to make templates directory.  Check permissions." );
-    }
-
-    get_options().init();
-    get_options().load();
-
-    // Apply command-line option overrides for test suite execution.
-    if( !option_overrides.empty() ) {
-        for( const name_value_pair_t &option : option_overrides ) {
-            if( get_options().has_option( option.first ) ) {
-                options_manager::cOpt &opt = get_options().get_option( option.first );
-                opt.setValue( option.second );
-            }
-        }
-    }
-    init_colors();
-
-    g = std::make_unique<game>( );
-    g->new_game = true;
-    g->load_static_data();
-
-    world_generator->set_active_world( nullptr );
-    world_generator->init();
-    // Using unicode characters in the world name to test path encoding
-#ifndef _WIN32
-    const std::string test_world_name = "Test World 测试世界 " + std::to_string( getpid() );
-#else
-    const std::string test_world_name = "Test World 测试世界";
-#endif
-    WORLD *test_world = world_generator->make_new_world( test_world_name, mods );
-    cata_assert( test_world != nullptr );
-    world_generator->set_active_world( test_world );
-    cata_assert( world_generator->active_world != nullptr );
-
-    calendar::set_eternal_season( get_option<bool>( "ETERNAL_SEASON" ) );
-    calendar::set_season_length( get_option<int>( "SEASON_LENGTH" ) );
-
-    g->load_core_data();
-    g->load_world_modfiles();
-
-    get_avatar() = avatar();
-    get_avatar().create( character_type::NOW );
-    get_avatar().setID( g->assign_npc_id(), false );
-
-    get_map() = map();
-
-    overmap_special_batch empty_specials( point_abs_om{} );
-    overmap_buffer.create_custom_overmap( point_abs_om{}, empty_specials );
-
-    map &here = get_map();
-    // TODO: fix point types
-    here.load( tripoint_abs_sm( here.get_abs_sub() ), false );
-    get_avatar().move_to( tripoint_abs_ms::zero );
-
-    get_weather().update_weather();
-}
-
 // Split s on separator sep, returning parts as a pair. Returns empty string as
 // second value if no separator found.
 static name_value_pair_t split_pair( const std::string &s, const char sep )
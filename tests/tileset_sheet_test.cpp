@@ -0,0 +1,220 @@
+#if defined(TILES)
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "cata_catch.h"
+#include "filesystem.h"
+#include "json.h"
+#include "json_loader.h"
+#include "path_info.h"
+#include "tileset_sheet.h"
+
+#include <ghc/fs_std.hpp>
+
+static fs::path test_cache_dir()
+{
+    return fs::u8path( PATH_INFO::user_dir() ) / "tileset_sheet_test";
+}
+
+static tileset_sheet_params tinytile_params( const int max_tile_xcount, const int max_tile_ycount )
+{
+    tileset_sheet_params params;
+    params.image_path = PATH_INFO::gfxdir() / "tinytile.png";
+    params.sprite_width = 16;
+    params.sprite_height = 16;
+    params.color_key = true;
+    params.max_tile_xcount = max_tile_xcount;
+    params.max_tile_ycount = max_tile_ycount;
+    params.color_filters = {{
+            "color_pixel_none", "color_pixel_grayscale", "color_pixel_nightvision",
+            "color_pixel_overexposed", "color_pixel_sepia_light"
+        }
+    };
+    params.cache_dir = test_cache_dir();
+    return params;
+}
+
+static bool same_pixels( const SDL_Surface_Ptr &a, const SDL_Surface_Ptr &b )
+{
+    if( a->w != b->w || a->h != b->h ) {
+        return false;
+    }
+    for( int y = 0; y < a->h; ++y ) {
+        const char *row_a = static_cast<const char *>( a->pixels ) + y * a->pitch;
+        const char *row_b = static_cast<const char *>( b->pixels ) + y * b->pitch;
+        if( std::memcmp( row_a, row_b, static_cast<size_t>( a->w ) * 4 ) != 0 ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void check_same_sheet( const tileset_sheet &a, const tileset_sheet &b )
+{
+    CHECK( a.width == b.width );
+    CHECK( a.height == b.height );
+    CHECK( a.packed == b.packed );
+    REQUIRE( a.parts.size() == b.parts.size() );
+    for( size_t i = 0; i < a.parts.size(); ++i ) {
+        CAPTURE( i );
+        CHECK( a.parts[i].offset == b.parts[i].offset );
+        REQUIRE( a.parts[i].surfaces.size() == b.parts[i].surfaces.size() );
+        for( size_t s = 0; s < a.parts[i].surfaces.size(); ++s ) {
+            CHECK( same_pixels( a.parts[i].surfaces[s], b.parts[i].surfaces[s] ) );
+        }
+    }
+}
+
+TEST_CASE( "tileset_sheet_is_the_same_from_the_cache", "[tiles]" )
+{
+    std::error_code ec;
+    fs::remove_all( test_cache_dir(), ec );
+
+    SECTION( "variants packed on one texture" ) {
+        const tileset_sheet_params params = tinytile_params( 128, 256 );
+        const tileset_sheet prepared = tileset_sheet::prepare( params );
+        CHECK( prepared.packed );
+        CHECK( prepared.parts.size() == 1 );
+        // The first load writes the cache, the second one reads it
+        check_same_sheet( prepared, tileset_sheet::load( params ) );
+        check_same_sheet( prepared, tileset_sheet::load( params ) );
+    }
+    SECTION( "atlas split into parts" ) {
+        const tileset_sheet_params params = tinytile_params( 4, 2 );
+        const tileset_sheet prepared = tileset_sheet::prepare( params );
+        CHECK_FALSE( prepared.packed );
+        CHECK( prepared.parts.size() == 8 );
+        check_same_sheet( prepared, tileset_sheet::load( params ) );
+        check_same_sheet( prepared, tileset_sheet::load( params ) );
+    }
+    SECTION( "other parameters don't use the same cached sheet" ) {
+        tileset_sheet_params params = tinytile_params( 128, 256 );
+        tileset_sheet::load( params );
+        params.color_filters[4] = "color_pixel_darken";
+        check_same_sheet( tileset_sheet::prepare( params ), tileset_sheet::load( params ) );
+    }
+
+    fs::remove_all( test_cache_dir(), ec );
+}
+
+TEST_CASE( "tileset_sheet_queue_returns_the_sheets_in_order", "[tiles]" )
+{
+    std::vector<tileset_sheet_params> params;
+    for( int i = 1; i <= 6; ++i ) {
+        params.push_back( tinytile_params( i, i ) );
+        params.back().cache_dir.clear();
+    }
+    tileset_sheet_queue queue( params );
+    for( size_t i = 0; i < params.size(); ++i ) {
+        CAPTURE( i );
+        check_same_sheet( tileset_sheet::prepare( params[i] ), queue.take( i, []() {} ) );
+    }
+}
+
+TEST_CASE( "tileset_sheet_queue_passes_on_errors", "[tiles]" )
+{
+    std::vector<tileset_sheet_params> params = {
+        tinytile_params( 16, 16 ), tinytile_params( 16, 16 )
+    };
+    params[1].image_path = PATH_INFO::gfxdir() / "no_such_image.png";
+    for( tileset_sheet_params &p : params ) {
+        p.cache_dir.clear();
+    }
+    tileset_sheet_queue queue( params );
+    CHECK( queue.take( 0, []() {} ).width == 256 );
+    CHECK_THROWS( queue.take( 1, []() {} ) );
+}
+
+// The bundled tileset with the most image data, which takes the longest to load
+static cata_path largest_bundled_tileset()
+{
+    cata_path largest;
+    std::uintmax_t largest_size = 0;
+    for( const cata_path &dir : get_directories_with( "tile_config.json", PATH_INFO::gfxdir(),
+            true ) ) {
+        std::uintmax_t size = 0;
+        for( const cata_path &image : get_files_from_path( ".png", dir, false, true ) ) {
+            size += fs::file_size( image.get_unrelative_path() );
+        }
+        if( size > largest_size ) {
+            largest = dir;
+            largest_size = size;
+        }
+    }
+    return largest;
+}
+
+// The images of a tileset with their sprite sizes, as cata_tiles reads them
+static std::vector<tileset_sheet_params> tileset_params( const cata_path &tileset_root )
+{
+    const JsonValue config_json = json_loader::from_path( tileset_root / "tile_config.json" );
+    const JsonObject config = config_json.get_object();
+    config.allow_omitted_members();
+    JsonObject tile_info = config.get_array( "tile_info" ).next_object();
+    tile_info.allow_omitted_members();
+    const int tile_width = tile_info.get_int( "width" );
+    const int tile_height = tile_info.get_int( "height" );
+    std::vector<tileset_sheet_params> params;
+    for( const JsonObject tile_part_def : config.get_array( "tiles-new" ) ) {
+        tile_part_def.allow_omitted_members();
+        tileset_sheet_params p = tinytile_params( 128, 256 );
+        p.image_path = tileset_root / tile_part_def.get_string( "file" );
+        p.sprite_width = tile_part_def.get_int( "sprite_width", tile_width );
+        p.sprite_height = tile_part_def.get_int( "sprite_height", tile_height );
+        p.color_key = tile_part_def.has_object( "transparency" );
+        params.push_back( p );
+    }
+    return params;
+}
+
+// Benchmarks are skipped by default by using [.] tag
+// A cold load prepares every image of the largest bundled tileset, a warm one reads them
+// back from the cache, which is written before the benchmarks.
+TEST_CASE( "tileset_sheet_benchmark", "[.][tiles][benchmark]" )
+{
+    const cata_path tileset = largest_bundled_tileset();
+    REQUIRE( !tileset.empty() );
+    WARN( "Loading the images of " << tileset );
+    const std::vector<tileset_sheet_params> params = tileset_params( tileset );
+    REQUIRE( !params.empty() );
+    std::error_code ec;
+    fs::remove_all( test_cache_dir(), ec );
+    for( const tileset_sheet_params &p : params ) {
+        tileset_sheet::load( p );
+    }
+
+    BENCHMARK( "cold load, preparing every image" ) {
+        size_t parts = 0;
+        for( const tileset_sheet_params &p : params ) {
+            parts += tileset_sheet::prepare( p ).parts.size();
+        }
+        return parts;
+    };
+    BENCHMARK( "cold load, preparing every image on worker threads" ) {
+        std::vector<tileset_sheet_params> uncached = params;
+        for( tileset_sheet_params &p : uncached ) {
+            p.cache_dir.clear();
+        }
+        tileset_sheet_queue queue( uncached );
+        size_t parts = 0;
+        for( size_t i = 0; i < uncached.size(); ++i ) {
+            parts += queue.take( i, []() {} ).parts.size();
+        }
+        return parts;
+    };
+    BENCHMARK( "warm load, every image from the cache" ) {
+        size_t parts = 0;
+        for( const tileset_sheet_params &p : params ) {
+            parts += tileset_sheet::load( p ).parts.size();
+        }
+        return parts;
+    };
+
+    fs::remove_all( test_cache_dir(), ec );
+}
+
+#endif // TILES
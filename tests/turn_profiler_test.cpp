@@ -0,0 +1,122 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "cata_catch.h"
+#include "json.h"
+#include "json_loader.h"
+#include "turn_profiler.h"
+
+// The classes are used directly so the tests don't depend on the TURN_PROFILER build flag.
+
+static void profile_turn( int turn, int zone_outer, int zone_inner )
+{
+    const turn_profiler::scoped_turn profiled_turn( turn );
+    const turn_profiler::scoped_zone outer( zone_outer );
+    for( int i = 0; i < 3; ++i ) {
+        const turn_profiler::scoped_zone inner( zone_inner );
+    }
+}
+
+TEST_CASE( "turn_profiler_records_nested_zones", "[turn_profiler]" )
+{
+    const int zone_outer = turn_profiler::register_zone( "test_outer" );
+    const int zone_inner = turn_profiler::register_zone( "test_inner" );
+    CHECK( turn_profiler::register_zone( "test_outer" ) == zone_outer );
+    CHECK( turn_profiler::zone_name( zone_inner ) == "test_inner" );
+
+    SECTION( "nothing is recorded while disabled" ) {
+        turn_profiler::set_enabled( false );
+        profile_turn( 1, zone_outer, zone_inner );
+        CHECK( turn_profiler::history().empty() );
+    }
+
+    SECTION( "zones are recorded with their depth" ) {
+        turn_profiler::set_enabled( true );
+        profile_turn( 1, zone_outer, zone_inner );
+        profile_turn( 2, zone_outer, zone_inner );
+        const std::vector<const turn_profiler::turn_record *> turns = turn_profiler::history();
+        REQUIRE( turns.size() == 2 );
+        CHECK( turns[0]->turn == 1 );
+        CHECK( turns[1]->turn == 2 );
+        const std::vector<turn_profiler::zone_event> &events = turns[1]->events;
+        REQUIRE( events.size() == 4 );
+        // zones are recorded when they are left, so the outer zone is last
+        CHECK( events.back().zone == zone_outer );
+        CHECK( events.back().depth == 0 );
+        for( size_t i = 0; i < 3; ++i ) {
+            CHECK( events[i].zone == zone_inner );
+            CHECK( events[i].depth == 1 );
+            CHECK( events[i].start >= events.back().start );
+            CHECK( events[i].duration <= events.back().duration );
+        }
+        CHECK( events.back().duration <= turns[1]->duration );
+
+        const std::vector<turn_profiler::zone_summary> summaries = turn_profiler::summarize();
+        REQUIRE( summaries.size() == 2 );
+        CHECK( summaries[0].zone == zone_outer );
+        CHECK( summaries[0].calls_per_turn == Approx( 1.0 ) );
+        CHECK( summaries[1].zone == zone_inner );
+        CHECK( summaries[1].calls_per_turn == Approx( 3.0 ) );
+        CHECK( summaries[1].max >= summaries[1].average );
+    }
+
+    SECTION( "only the last turns are kept" ) {
+        turn_profiler::set_enabled( true );
+        const int turns = static_cast<int>( turn_profiler::history_size ) + 10;
+        for( int turn = 0; turn < turns; ++turn ) {
+            profile_turn( turn, zone_outer, zone_inner );
+        }
+        const std::vector<const turn_profiler::turn_record *> history = turn_profiler::history();
+        REQUIRE( history.size() == turn_profiler::history_size );
+        CHECK( history.front()->turn == 10 );
+        CHECK( history.back()->turn == turns - 1 );
+    }
+
+    SECTION( "chrome trace has one event per zone and turn" ) {
+        turn_profiler::set_enabled( true );
+        profile_turn( 1, zone_outer, zone_inner );
+        profile_turn( 2, zone_outer, zone_inner );
+        std::ostringstream os;
+        turn_profiler::write_chrome_trace( os );
+        JsonObject jo = json_loader::from_string( os.str() );
+        CHECK( jo.get_string( "displayTimeUnit" ) == "ms" );
+        JsonArray events = jo.get_array( "traceEvents" );
+        CHECK( events.size() == 10 );
+        for( JsonObject event : events ) {
+            CHECK( event.get_string( "ph" ) == "X" );
+            CHECK( event.get_float( "dur" ) >= 0.0 );
+            CHECK( event.get_float( "ts" ) >= 0.0 );
+            event.allow_omitted_members();
+        }
+    }
+
+    turn_profiler::set_enabled( false );
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "turn_profiler_zone_overhead", "[.][turn_profiler][benchmark]" )
+{
+    const int zone = turn_profiler::register_zone( "test_empty" );
+
+    turn_profiler::set_enabled( false );
+    BENCHMARK( "disabled zone" ) {
+        const turn_profiler::scoped_zone empty( zone );
+        return turn_profiler::is_enabled();
+    };
+
+    turn_profiler::set_enabled( true );
+    // Keep a turn open so every zone is recorded, and restart it before the events pile up.
+    turn_profiler::begin_turn( 0 );
+    int entered = 0;
+    BENCHMARK( "enabled zone" ) {
+        if( ++entered % 10000 == 0 ) {
+            turn_profiler::end_turn();
+            turn_profiler::begin_turn( entered );
+        }
+        const turn_profiler::scoped_zone empty( zone );
+        return entered;
+    };
+    turn_profiler::end_turn();
+    turn_profiler::set_enabled( false );
+}
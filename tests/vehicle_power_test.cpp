@@ -1,3 +1,4 @@
+#include <cstdint>
 #include <cstdlib>
 #include <vector>
 
@@ -17,6 +18,8 @@
 static const efftype_id effect_blind( "blind" );
 
 static const itype_id fuel_type_battery( "battery" );
+static const itype_id itype_test_power_cord( "test_power_cord" );
+static const itype_id itype_test_power_cord_25_loss( "test_power_cord_25_loss" );
 
 static const vpart_id vpart_frame( "frame" );
 static const vpart_id vpart_small_storage_battery( "small_storage_battery" );
@@ -37,6 +40,62 @@ static void reset_player()
     player_character.add_effect( effect_blind, 1_turns, true );
 }
 
+// Plugs a cord of the given type from source into target, like linking the item does
+static void connect_debug_cord( const tripoint_bub_ms &source, const tripoint_bub_ms &target,
+                                const itype_id &cord_type )
+{
+    map &here = get_map();
+    const optional_vpart_position target_vp = here.veh_at( target );
+    const optional_vpart_position source_vp = here.veh_at( source );
+
+    item cord( cord_type );
+    cord.set_var( "source_x", source.x() );
+    cord.set_var( "source_y", source.y() );
+    cord.set_var( "source_z", source.z() );
+    cord.set_var( "state", "pay_out_cable" );
+    cord.active = true;
+
+    if( !target_vp ) {
+        debugmsg( "missing target at %s", target.to_string() );
+    }
+    vehicle *const target_veh = &target_vp->vehicle();
+    vehicle *const source_veh = &source_vp->vehicle();
+    if( source_veh == target_veh ) {
+        debugmsg( "source same as target" );
+    }
+
+    tripoint_abs_ms target_global = here.getglobal( target );
+    const vpart_id vpid( cord.typeId().str() );
+
+    point_rel_ms vcoords = source_vp->mount_pos();
+    vehicle_part source_part( vpid, item( cord ) );
+    source_part.target.first = target_global;
+    source_part.target.second = target_veh->global_square_location();
+    source_veh->install_part( vcoords, std::move( source_part ) );
+
+    vcoords = target_vp->mount_pos();
+    vehicle_part target_part( vpid, item( cord ) );
+    tripoint_bub_ms source_global( cord.get_var( "source_x", 0 ),
+                                   cord.get_var( "source_y", 0 ),
+                                   cord.get_var( "source_z", 0 ) );
+    target_part.target.first = here.getglobal( source_global );
+    target_part.target.second = source_veh->global_square_location();
+    target_veh->install_part( vcoords, std::move( target_part ) );
+}
+
+// A battery on a frame, the way it is placed as an appliance
+static vehicle *place_battery( const tripoint_bub_ms &p )
+{
+    map &here = get_map();
+    vehicle *veh = here.add_vehicle( vehicle_prototype_none, p, 0_degrees, 0, 0 );
+    REQUIRE( veh != nullptr );
+    REQUIRE( veh->install_part( point_rel_ms::zero, vpart_frame ) != -1 );
+    REQUIRE( veh->install_part( point_rel_ms::zero, vpart_small_storage_battery ) != -1 );
+    veh->refresh();
+    here.add_vehicle_to_cache( veh );
+    return veh;
+}
+
 TEST_CASE( "power_loss_to_cables", "[vehicle][power]" )
 {
     clear_vehicles();
@@ -44,46 +103,6 @@ TEST_CASE( "power_loss_to_cables", "[vehicle][power]" )
     build_test_map( ter_id( "t_pavement" ) );
     map &here = get_map();
 
-    const auto connect_debug_cord = [&here]( const tripoint_bub_ms & source,
-    const tripoint_bub_ms & target ) {
-        const optional_vpart_position target_vp = here.veh_at( target );
-        const optional_vpart_position source_vp = here.veh_at( source );
-
-        item cord( "test_power_cord_25_loss" );
-        cord.set_var( "source_x", source.x() );
-        cord.set_var( "source_y", source.y() );
-        cord.set_var( "source_z", source.z() );
-        cord.set_var( "state", "pay_out_cable" );
-        cord.active = true;
-
-        if( !target_vp ) {
-            debugmsg( "missing target at %s", target.to_string() );
-        }
-        vehicle *const target_veh = &target_vp->vehicle();
-        vehicle *const source_veh = &source_vp->vehicle();
-        if( source_veh == target_veh ) {
-            debugmsg( "source same as target" );
-        }
-
-        tripoint_abs_ms target_global = here.getglobal( target );
-        const vpart_id vpid( cord.typeId().str() );
-
-        point_rel_ms vcoords = source_vp->mount_pos();
-        vehicle_part source_part( vpid, item( cord ) );
-        source_part.target.first = target_global;
-        source_part.target.second = target_veh->global_square_location();
-        source_veh->install_part( vcoords, std::move( source_part ) );
-
-        vcoords = target_vp->mount_pos();
-        vehicle_part target_part( vpid, item( cord ) );
-        tripoint_bub_ms source_global( cord.get_var( "source_x", 0 ),
-                                       cord.get_var( "source_y", 0 ),
-                                       cord.get_var( "source_z", 0 ) );
-        target_part.target.first = here.getglobal( source_global );
-        target_part.target.second = source_veh->global_square_location();
-        target_veh->install_part( vcoords, std::move( target_part ) );
-    };
-
     const std::vector<tripoint_bub_ms> placements { { 4, 10, 0 }, { 6, 10, 0 }, { 8, 10, 0 } };
     std::vector<vpart_reference> batteries;
     for( const tripoint_bub_ms &p : placements ) {
@@ -101,7 +120,7 @@ TEST_CASE( "power_loss_to_cables", "[vehicle][power]" )
     // connect first to second and second to third, each cord is 25% lossy
     // third battery will on average take twice as many charges to charge as the first
     for( size_t i = 0; i < placements.size() - 1; i++ ) {
-        connect_debug_cord( placements[i], placements[i + 1] );
+        connect_debug_cord( placements[i], placements[i + 1], itype_test_power_cord_25_loss );
     }
     const optional_vpart_position ovp_first = here.veh_at( placements[0] );
     REQUIRE( ovp_first.has_value() );
@@ -131,6 +150,73 @@ TEST_CASE( "power_loss_to_cables", "[vehicle][power]" )
     }
 }
 
+TEST_CASE( "power_grid_follows_cable_and_vehicle_changes", "[vehicle][power]" )
+{
+    clear_vehicles();
+    reset_player();
+    build_test_map( ter_id( "t_pavement" ) );
+    map &here = get_map();
+
+    const std::vector<tripoint_bub_ms> placements { { 4, 10, 0 }, { 6, 10, 0 }, { 8, 10, 0 } };
+    std::vector<vehicle *> vehs;
+    for( const tripoint_bub_ms &p : placements ) {
+        vehs.push_back( place_battery( p ) );
+    }
+    vehicle &first = *vehs[0];
+    CHECK( first.search_connected_vehicles().size() == 1 );
+    connect_debug_cord( placements[0], placements[1], itype_test_power_cord );
+    CHECK( first.search_connected_vehicles().size() == 2 );
+    connect_debug_cord( placements[1], placements[2], itype_test_power_cord );
+    CHECK( first.search_connected_vehicles().size() == 3 );
+    CHECK( first.search_connected_batteries().size() == 3 );
+
+    const int capacity = first.connected_battery_power_level().second;
+    CHECK( first.charge_battery( capacity, false ) == 0 );
+    CHECK( first.connected_battery_power_level().first == capacity );
+
+    here.destroy_vehicle( vehs[2] );
+    CHECK( first.search_connected_vehicles().size() == 2 );
+    CHECK( first.search_connected_batteries().size() == 2 );
+    CHECK( first.connected_battery_power_level().second == capacity / 3 * 2 );
+    CHECK( first.discharge_battery( capacity, false ) == capacity / 3 );
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "power_grid_of_large_base_benchmark", "[.][vehicle][power][benchmark]" )
+{
+    clear_vehicles();
+    reset_player();
+    build_test_map( ter_id( "t_pavement" ) );
+
+    // 100 appliances in rows going back and forth, each plugged into the one before it
+    std::vector<vehicle *> appliances;
+    tripoint_bub_ms prev;
+    for( int i = 0; i < 100; ++i ) {
+        const int row = i / 10;
+        const int col = row % 2 == 0 ? i % 10 : 9 - i % 10;
+        const tripoint_bub_ms p( 10 + col * 2, 10 + row * 2, 0 );
+        appliances.push_back( place_battery( p ) );
+        if( i > 0 ) {
+            connect_debug_cord( prev, p, itype_test_power_cord );
+        }
+        prev = p;
+    }
+    REQUIRE( appliances.front()->search_connected_vehicles().size() == 100 );
+
+    BENCHMARK( "one day" ) {
+        // Every appliance stores and draws a little power every ten minutes
+        int64_t stored = 0;
+        for( time_duration t = 0_turns; t < 1_days; t += 10_minutes ) {
+            for( vehicle *veh : appliances ) {
+                veh->charge_battery( 2 );
+                veh->discharge_battery( 1 );
+                stored += veh->connected_battery_power_level().first;
+            }
+        }
+        return stored;
+    };
+}
+
 TEST_CASE( "Solar_power", "[vehicle][power]" )
 {
     clear_vehicles();
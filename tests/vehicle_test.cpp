@@ -13,6 +13,7 @@
 #include "activity_actor_definitions.h"
 #include "player_helpers.h"
 #include "point.h"
+#include "rng.h"
 #include "type_id.h"
 #include "units.h"
 #include "veh_appliance.h"
@@ -787,3 +788,98 @@ TEST_CASE( "autopilot_tests", "[vehicle][autopilot]" )
     CHECK( test_autopilot_moving( vehicle_prototype_car, vpart_id::NULL_ID() ) == 0 );
     CHECK( test_autopilot_moving( vehicle_prototype_car, vpart_programmable_autopilot ) == 9 );
 }
+
+// Ten lanes of cars, the two in the middle of each lane close enough to be stepped together.
+static std::vector<tripoint_bub_ms> drive_traffic( bool broad_phase )
+{
+    clear_avatar();
+    clear_map_and_put_player_underground();
+    clear_vehicles();
+    map &here = get_map();
+    std::vector<vehicle *> cars;
+    for( int lane = 0; lane < 10; ++lane ) {
+        for( const int x : { 10, 30, 38, 60 } ) {
+            const tripoint_bub_ms p( x, 10 + lane * 11, 0 );
+            vehicle *veh = here.add_vehicle( vehicle_prototype_car, p, 0_degrees, 100, 0, false );
+            REQUIRE( veh != nullptr );
+            veh->tags.insert( "IN_CONTROL_OVERRIDE" );
+            veh->engine_on = true;
+            veh->cruise_velocity = 400;
+            veh->velocity = 400;
+            cars.push_back( veh );
+        }
+    }
+
+    for( int turn = 0; turn < 10; ++turn ) {
+        here.vehmove( broad_phase );
+    }
+    std::vector<tripoint_bub_ms> positions;
+    for( const vehicle *veh : cars ) {
+        positions.push_back( veh->pos_bub() );
+    }
+    return positions;
+}
+
+TEST_CASE( "vehicles_move_the_same_with_and_without_broad_phase", "[vehicle]" )
+{
+    const std::vector<tripoint_bub_ms> serial = drive_traffic( false );
+    const std::vector<tripoint_bub_ms> broad_phase = drive_traffic( true );
+    CHECK( broad_phase == serial );
+    CHECK( serial.front().x() > 10 );
+    clear_vehicles( &get_map() );
+}
+
+struct crash_result {
+    std::vector<tripoint_bub_ms> positions;
+    int parked_damage = 0;
+    int rammer_velocity = 0;
+};
+
+// A fast car behind a parked one in the same lane, and another car parked alongside that one.
+static crash_result ram_parked_car( bool broad_phase )
+{
+    clear_avatar();
+    clear_map_and_put_player_underground();
+    clear_vehicles();
+    map &here = get_map();
+    std::vector<vehicle *> cars;
+    for( const tripoint_bub_ms &p : {
+             tripoint_bub_ms( 20, 60, 0 ), tripoint_bub_ms( 36, 60, 0 ),
+             tripoint_bub_ms( 36, 58, 0 )
+         } ) {
+        vehicle *veh = here.add_vehicle( vehicle_prototype_car, p, 0_degrees, 100, 0, false );
+        REQUIRE( veh != nullptr );
+        cars.push_back( veh );
+    }
+    vehicle &rammer = *cars.front();
+    rammer.tags.insert( "IN_CONTROL_OVERRIDE" );
+    rammer.engine_on = true;
+    rammer.cruise_velocity = 3000;
+    rammer.velocity = 3000;
+
+    rng_set_engine_seed( 4242 );
+    for( int turn = 0; turn < 5; ++turn ) {
+        here.vehmove( broad_phase );
+    }
+    crash_result result;
+    for( const vehicle *veh : cars ) {
+        result.positions.push_back( veh->pos_bub() );
+    }
+    for( const vpart_reference &vpr : cars[1]->get_all_parts() ) {
+        result.parked_damage += vpr.part().damage();
+    }
+    result.rammer_velocity = rammer.velocity;
+    return result;
+}
+
+TEST_CASE( "vehicles_in_reach_of_each_other_still_collide", "[vehicle]" )
+{
+    const crash_result serial = ram_parked_car( false );
+    const crash_result broad_phase = ram_parked_car( true );
+    CHECK( serial.parked_damage > 0 );
+    CHECK( serial.rammer_velocity < 3000 );
+    CHECK( broad_phase.positions == serial.positions );
+    CHECK( broad_phase.parked_damage == serial.parked_damage );
+    CHECK( broad_phase.rammer_velocity == serial.rammer_velocity );
+    clear_vehicles( &get_map() );
+}
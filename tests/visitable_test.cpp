@@ -1,12 +1,17 @@
 #include "cata_catch.h"
 
 #include "calendar.h"
+#include "character.h"
 #include "inventory.h"
 #include "item.h"
+#include "pimpl.h"
+#include "player_helpers.h"
 #include "pocket_type.h"
 #include "ret_val.h"
 #include "type_id.h"
 
+static const itype_id itype_bottle_plastic( "bottle_plastic" );
+static const itype_id itype_rock( "rock" );
 static const itype_id itype_water( "water" );
 
 TEST_CASE( "visitable_summation" )
@@ -24,3 +29,33 @@ TEST_CASE( "visitable_summation" )
 
     CHECK( test_inv.charges_of( itype_water, item::INFINITE_CHARGES ) > 1 );
 }
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "visitable_large_inventory_benchmark", "[.][visitable][benchmark]" )
+{
+    clear_avatar();
+    Character &you = get_player_character();
+    for( int i = 0; i < 1000; ++i ) {
+        item bottle_of_water( itype_bottle_plastic, calendar::turn );
+        item water_in_bottle( itype_water, calendar::turn );
+        water_in_bottle.charges = 1 + i % 2;
+        bottle_of_water.put_in( water_in_bottle, pocket_type::CONTAINER );
+        you.inv->add_item( bottle_of_water );
+        you.inv->add_item( item( itype_rock, calendar::turn ) );
+    }
+    REQUIRE( you.charges_of( itype_water ) == 1500 );
+    REQUIRE( you.has_amount( itype_rock, 1000 ) );
+
+    BENCHMARK( "Character::charges_of" ) {
+        return you.charges_of( itype_water );
+    };
+    BENCHMARK( "Character::has_amount" ) {
+        return you.has_amount( itype_rock, 1000 );
+    };
+    BENCHMARK( "inventory::charges_of" ) {
+        return you.inv->charges_of( itype_water );
+    };
+    BENCHMARK( "inventory::has_amount" ) {
+        return you.inv->has_amount( itype_rock, 1000 );
+    };
+}